@@ -0,0 +1,104 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/spline_interpolation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// keys and channel values along a curve with the given number of base points
+void generateBaseValues(
+  const size_t num_base, const size_t num_channels, std::vector<double> & base_keys,
+  std::vector<std::vector<double>> & base_values)
+{
+  base_keys.resize(num_base);
+  base_values.assign(num_channels, std::vector<double>(num_base));
+  for (size_t i = 0; i < num_base; ++i) {
+    base_keys.at(i) = static_cast<double>(i);
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      base_values.at(ch).at(i) = std::sin(0.1 * i + ch) * (ch + 1.0);
+    }
+  }
+}
+
+std::vector<double> generateQueryKeys(const double max_key, const double interval)
+{
+  std::vector<double> query_keys;
+  for (double s = 0.0; s < max_key; s += interval) {
+    query_keys.push_back(s);
+  }
+  query_keys.push_back(max_key);
+  return query_keys;
+}
+}  // namespace
+
+int main()
+{
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  constexpr int iterations = 200;
+  constexpr size_t num_channels = 4;  // e.g. x, y, z and velocity of a trajectory
+
+  std::cout << "# spline interpolation of " << num_channels << " channels" << std::endl;
+  std::cout << "base points, query points, per channel [ms], multi channel [ms], max error"
+            << std::endl;
+  for (const size_t num_base : {10, 100, 1000, 10000}) {
+    std::vector<double> base_keys;
+    std::vector<std::vector<double>> base_values;
+    generateBaseValues(num_base, num_channels, base_keys, base_values);
+    const auto query_keys = generateQueryKeys(base_keys.back(), 0.1);
+
+    std::vector<std::vector<double>> per_channel_values(num_channels);
+    const auto per_channel_start = steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        const SplineInterpolation s(base_keys, base_values.at(ch));
+        per_channel_values.at(ch) = s.getSplineInterpolatedValues(query_keys);
+      }
+    }
+    const auto per_channel_end = steady_clock::now();
+
+    std::vector<std::vector<double>> multi_channel_values;
+    MultiChannelSplineInterpolation multi_channel_spline;
+    const auto multi_channel_start = steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      multi_channel_spline.calcSplineCoefficients(base_keys, base_values);
+      multi_channel_spline.getSplineInterpolatedValues(query_keys, multi_channel_values);
+    }
+    const auto multi_channel_end = steady_clock::now();
+
+    double max_error = 0.0;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t k = 0; k < query_keys.size(); ++k) {
+        max_error = std::max(
+          max_error,
+          std::abs(per_channel_values.at(ch).at(k) - multi_channel_values.at(ch).at(k)));
+      }
+    }
+
+    const auto to_ms = [&](const auto & start, const auto & end) {
+      return duration<double, std::milli>(end - start).count() / iterations;
+    };
+    std::cout << num_base << ", " << query_keys.size() << ", "
+              << to_ms(per_channel_start, per_channel_end) << ", "
+              << to_ms(multi_channel_start, multi_channel_end) << ", " << max_error << std::endl;
+  }
+
+  return 0;
+}
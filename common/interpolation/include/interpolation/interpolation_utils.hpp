@@ -52,7 +52,9 @@ inline bool isNotDecreasing(const std::vector<double> & x)
   return true;
 }
 
-inline std::vector<double> validateKeys(
+// NOTE: Unlike validateKeys, query keys are neither copied nor cropped. The caller has to crop the
+//       front and back query keys which may be slightly out of base keys.
+inline void validateKeysWithoutCropping(
   const std::vector<double> & base_keys, const std::vector<double> & query_keys)
 {
   // when vectors are empty
@@ -78,6 +80,12 @@ inline std::vector<double> validateKeys(
     base_keys.back() + epsilon < query_keys.back()) {
     throw std::invalid_argument("query_keys is out of base_keys");
   }
+}
+
+inline std::vector<double> validateKeys(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys)
+{
+  validateKeysWithoutCropping(base_keys, query_keys);
 
   // NOTE: Due to calculation error of double, a query key may be slightly out of base keys.
   //       Therefore, query keys are cropped here.
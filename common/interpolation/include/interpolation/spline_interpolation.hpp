@@ -105,4 +105,78 @@ private:
     const std::vector<double> & base_keys, const std::vector<double> & base_values);
 };
 
+// non-static spline interpolation of multiple channels sharing the same base keys
+// NOTE: The tridiagonal matrix depends only on the base keys. It is factorized once and all the
+//       channels are solved in the same pass. The results are the same as SplineInterpolation
+//       applied to each channel.
+//
+// Usage:
+// ```
+// MultiChannelSplineInterpolation spline(base_keys, {base_x_values, base_y_values});
+// // interpolated values of channel ch at query_keys.at(i) are values.at(ch).at(i)
+// const auto values = spline.getSplineInterpolatedValues(query_keys);
+// // write to the buffer of the caller, which is not reallocated when the capacity is enough
+// std::vector<std::vector<double>> diff_values;
+// spline.getSplineInterpolatedDiffValues(query_keys, diff_values);
+// ```
+class MultiChannelSplineInterpolation
+{
+public:
+  MultiChannelSplineInterpolation() = default;
+  MultiChannelSplineInterpolation(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+  {
+    calcSplineCoefficients(base_keys, base_values);
+  }
+
+  //!< @brief calculate spline coefficients of all the channels.
+  //!< @details base_values.at(ch) are the values of channel ch on base_keys.
+  //            Internal buffers are reused when the number of base keys and channels do not grow.
+  void calcSplineCoefficients(
+    const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values);
+
+  //!< @brief get values of spline interpolation of all the channels on designated sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedValues(
+    const std::vector<double> & query_keys) const;
+  void getSplineInterpolatedValues(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const;
+
+  //!< @brief get 1st differential values of spline interpolation of all the channels on designated
+  //          sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedDiffValues(
+    const std::vector<double> & query_keys) const;
+  void getSplineInterpolatedDiffValues(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const;
+
+  //!< @brief get 2nd differential values of spline interpolation of all the channels on designated
+  //          sampling points.
+  std::vector<std::vector<double>> getSplineInterpolatedQuadDiffValues(
+    const std::vector<double> & query_keys) const;
+  void getSplineInterpolatedQuadDiffValues(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const;
+
+  size_t getSize() const { return base_keys_.size(); }
+  size_t getNumChannels() const { return num_channels_; }
+
+private:
+  std::vector<double> base_keys_;
+  size_t num_channels_{0};
+
+  // spline coefficients stored as [segment * num_channels_ + channel] so that all the channels of
+  // a segment are contiguous
+  interpolation::MultiSplineCoef multi_spline_coef_;
+
+  // buffers of the coefficient calculation
+  std::vector<double> diff_keys_;
+  std::vector<double> diff_values_;
+  std::vector<double> tdma_p_;
+  std::vector<double> tdma_den_;
+  std::vector<double> v_;
+
+  template <class Evaluate>
+  void evaluate(
+    const std::vector<double> & query_keys, std::vector<std::vector<double>> & values,
+    const Evaluate & evaluate_channel) const;
+};
+
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
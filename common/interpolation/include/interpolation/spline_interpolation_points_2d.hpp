@@ -82,9 +82,7 @@ public:
 
 private:
   void calcSplineCoefficientsInner(const std::vector<geometry_msgs::msg::Point> & points);
-  SplineInterpolation spline_x_;
-  SplineInterpolation spline_y_;
-  SplineInterpolation spline_z_;
+  MultiChannelSplineInterpolation spline_xyz_;
 
   std::vector<double> base_s_vec_;
 };
@@ -287,3 +287,188 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
 
   return res;
 }
+
+void MultiChannelSplineInterpolation::calcSplineCoefficients(
+  const std::vector<double> & base_keys, const std::vector<std::vector<double>> & base_values)
+{
+  // throw exceptions for invalid arguments
+  if (base_values.empty()) {
+    throw std::invalid_argument("The number of channels is zero.");
+  }
+  for (const auto & channel_values : base_values) {
+    interpolation_utils::validateKeysAndValues(base_keys, channel_values);
+  }
+
+  const size_t num_base = base_keys.size();  // N+1
+  const size_t num_channels = base_values.size();
+  num_channels_ = num_channels;
+
+  diff_keys_.resize(num_base - 1);                     // N
+  diff_values_.resize((num_base - 1) * num_channels);  // N x channels
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    diff_keys_[i] = base_keys[i + 1] - base_keys[i];
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      diff_values_[i * num_channels + ch] = base_values[ch][i + 1] - base_values[ch][i];
+    }
+  }
+
+  // v of all the channels, whose front and back are zero
+  v_.assign(num_base * num_channels, 0.0);
+  if (num_base > 2) {
+    // factorize the tridiagonal matrix which is common to all the channels
+    // NOTE: The same operations as solveTridiagonalMatrixAlgorithm are applied so that the results
+    //       are the same as SplineInterpolation.
+    const size_t num_row = num_base - 2;  // N-1
+    tdma_den_.resize(num_row);
+    tdma_p_.resize(num_row);
+    tdma_den_[0] = 2 * (diff_keys_[0] + diff_keys_[1]);
+    if (num_row != 1) {
+      tdma_p_[0] = -diff_keys_[1] / tdma_den_[0];
+    }
+    for (size_t i = 1; i < num_row; ++i) {
+      const double b = 2 * (diff_keys_[i] + diff_keys_[i + 1]);
+      tdma_den_[i] = b + diff_keys_[i] * tdma_p_[i - 1];
+      tdma_p_[i] = -diff_keys_[i] / tdma_den_[i];
+    }
+
+    // forward substitution of all the channels, where q_i is stored in v_{i+1}
+    for (size_t i = 0; i < num_row; ++i) {
+      double * q = &v_[(i + 1) * num_channels];
+      const double * prev_q = &v_[i * num_channels];
+      const double * diff_values = &diff_values_[i * num_channels];
+      const double * next_diff_values = &diff_values_[(i + 1) * num_channels];
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        const double d =
+          6.0 * (next_diff_values[ch] / diff_keys_[i + 1] - diff_values[ch] / diff_keys_[i]);
+        q[ch] = i == 0 ? d / tdma_den_[0] : (d - diff_keys_[i] * prev_q[ch]) / tdma_den_[i];
+      }
+    }
+
+    // backward substitution of all the channels
+    for (size_t i = 1; i < num_row; ++i) {
+      const size_t j = num_row - 1 - i;
+      double * x = &v_[(j + 1) * num_channels];
+      const double * next_x = &v_[(j + 2) * num_channels];
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        x[ch] = tdma_p_[j] * next_x[ch] + x[ch];
+      }
+    }
+  }
+
+  // calculate a, b, c, d of spline coefficients
+  auto & coef = multi_spline_coef_;
+  coef.a.resize((num_base - 1) * num_channels);  // N x channels
+  coef.b.resize((num_base - 1) * num_channels);
+  coef.c.resize((num_base - 1) * num_channels);
+  coef.d.resize((num_base - 1) * num_channels);
+  for (size_t i = 0; i < num_base - 1; ++i) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      const size_t idx = i * num_channels + ch;
+      const double v = v_[idx];
+      const double next_v = v_[idx + num_channels];
+      coef.a[idx] = (next_v - v) / 6.0 / diff_keys_[i];
+      coef.b[idx] = v / 2.0;
+      coef.c[idx] = diff_values_[idx] / diff_keys_[i] - diff_keys_[i] * (2 * v + next_v) / 6.0;
+      coef.d[idx] = base_values[ch][i];
+    }
+  }
+
+  base_keys_.assign(base_keys.begin(), base_keys.end());
+}
+
+template <class Evaluate>
+void MultiChannelSplineInterpolation::evaluate(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> & values,
+  const Evaluate & evaluate_channel) const
+{
+  // throw exceptions for invalid arguments
+  interpolation_utils::validateKeysWithoutCropping(base_keys_, query_keys);
+
+  const size_t num_query = query_keys.size();
+  values.resize(num_channels_);
+  for (auto & channel_values : values) {
+    channel_values.resize(num_query);
+  }
+
+  size_t j = 0;
+  for (size_t k = 0; k < num_query; ++k) {
+    // crop the query keys in the same way as interpolation_utils::validateKeys
+    double query_key = query_keys[k];
+    if (k == 0) {
+      query_key = std::max(query_key, base_keys_.front());
+    }
+    if (k == num_query - 1) {
+      query_key = std::min(query_key, base_keys_.back());
+    }
+
+    while (j + 2 < base_keys_.size() && base_keys_[j + 1] < query_key) {
+      ++j;
+    }
+
+    const double ds = query_key - base_keys_[j];
+    for (size_t ch = 0; ch < num_channels_; ++ch) {
+      values[ch][k] = evaluate_channel(j * num_channels_ + ch, ds);
+    }
+  }
+}
+
+std::vector<std::vector<double>> MultiChannelSplineInterpolation::getSplineInterpolatedValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> values;
+  getSplineInterpolatedValues(query_keys, values);
+  return values;
+}
+
+void MultiChannelSplineInterpolation::getSplineInterpolatedValues(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const
+{
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
+  const auto & d = multi_spline_coef_.d;
+
+  evaluate(query_keys, values, [&](const size_t idx, const double ds) {
+    return d[idx] + (c[idx] + (b[idx] + a[idx] * ds) * ds) * ds;
+  });
+}
+
+std::vector<std::vector<double>> MultiChannelSplineInterpolation::getSplineInterpolatedDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> values;
+  getSplineInterpolatedDiffValues(query_keys, values);
+  return values;
+}
+
+void MultiChannelSplineInterpolation::getSplineInterpolatedDiffValues(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const
+{
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
+
+  evaluate(query_keys, values, [&](const size_t idx, const double ds) {
+    return c[idx] + (2.0 * b[idx] + 3.0 * a[idx] * ds) * ds;
+  });
+}
+
+std::vector<std::vector<double>>
+MultiChannelSplineInterpolation::getSplineInterpolatedQuadDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<std::vector<double>> values;
+  getSplineInterpolatedQuadDiffValues(query_keys, values);
+  return values;
+}
+
+void MultiChannelSplineInterpolation::getSplineInterpolatedQuadDiffValues(
+  const std::vector<double> & query_keys, std::vector<std::vector<double>> & values) const
+{
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+
+  evaluate(query_keys, values, [&](const size_t idx, const double ds) {
+    return 2.0 * b[idx] + 6.0 * a[idx] * ds;
+  });
+}
@@ -14,6 +14,7 @@
 
 #include "interpolation/spline_interpolation_points_2d.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace
@@ -76,10 +77,10 @@ std::array<std::vector<double>, 3> slerp2dFromXY(
   const std::vector<double> & base_y_values, const std::vector<double> & query_keys)
 {
   // calculate spline coefficients
-  SplineInterpolation interpolator_x(base_keys, base_x_values);
-  SplineInterpolation interpolator_y(base_keys, base_y_values);
-  const auto diff_x = interpolator_x.getSplineInterpolatedDiffValues(query_keys);
-  const auto diff_y = interpolator_y.getSplineInterpolatedDiffValues(query_keys);
+  MultiChannelSplineInterpolation interpolator(base_keys, {base_x_values, base_y_values});
+  const auto diff_xy = interpolator.getSplineInterpolatedDiffValues(query_keys);
+  const auto & diff_x = diff_xy.at(0);
+  const auto & diff_y = diff_xy.at(1);
 
   // calculate yaw
   std::vector<double> yaw_vec;
@@ -88,9 +89,8 @@ std::array<std::vector<double>, 3> slerp2dFromXY(
     yaw_vec.push_back(yaw);
   }
   // interpolate base_keys at query_keys
-  return {
-    interpolator_x.getSplineInterpolatedValues(query_keys),
-    interpolator_y.getSplineInterpolatedValues(query_keys), yaw_vec};
+  auto xy = interpolator.getSplineInterpolatedValues(query_keys);
+  return {std::move(xy.at(0)), std::move(xy.at(1)), yaw_vec};
 }
 
 template <typename T>
@@ -137,14 +137,12 @@ geometry_msgs::msg::Point SplineInterpolationPoints2d::getSplineInterpolatedPoin
     whole_s = base_s_vec_.back();
   }
 
-  const double x = spline_x_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double y = spline_y_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double z = spline_z_.getSplineInterpolatedValues({whole_s}).at(0);
+  const auto xyz = spline_xyz_.getSplineInterpolatedValues({whole_s});
 
   geometry_msgs::msg::Point geom_point;
-  geom_point.x = x;
-  geom_point.y = y;
-  geom_point.z = z;
+  geom_point.x = xyz.at(0).at(0);
+  geom_point.y = xyz.at(1).at(0);
+  geom_point.z = xyz.at(2).at(0);
   return geom_point;
 }
 
@@ -157,8 +155,9 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const auto diff_xyz = spline_xyz_.getSplineInterpolatedDiffValues({whole_s});
+  const double diff_x = diff_xyz.at(0).at(0);
+  const double diff_y = diff_xyz.at(1).at(0);
 
   return std::atan2(diff_y, diff_x);
 }
@@ -166,7 +165,7 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedYaws() const
 {
   std::vector<double> yaw_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
+  for (size_t i = 0; i < spline_xyz_.getSize(); ++i) {
     const double yaw = getSplineInterpolatedYaw(i, 0.0);
     yaw_vec.push_back(yaw);
   }
@@ -183,11 +182,13 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const auto diff_xyz = spline_xyz_.getSplineInterpolatedDiffValues({whole_s});
+  const double diff_x = diff_xyz.at(0).at(0);
+  const double diff_y = diff_xyz.at(1).at(0);
 
-  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
-  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
+  const auto quad_diff_xyz = spline_xyz_.getSplineInterpolatedQuadDiffValues({whole_s});
+  const double quad_diff_x = quad_diff_xyz.at(0).at(0);
+  const double quad_diff_y = quad_diff_xyz.at(1).at(0);
 
   return (diff_x * quad_diff_y - quad_diff_x * diff_y) /
          std::pow(std::pow(diff_x, 2) + std::pow(diff_y, 2), 1.5);
@@ -196,7 +197,7 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures() const
 {
   std::vector<double> curvature_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
+  for (size_t i = 0; i < spline_xyz_.getSize(); ++i) {
     const double curvature = getSplineInterpolatedCurvature(i, 0.0);
     curvature_vec.push_back(curvature);
   }
@@ -233,7 +234,5 @@ void SplineInterpolationPoints2d::calcSplineCoefficientsInner(
   const auto & base_z_vec = base.at(3);
 
   // calculate spline coefficients
-  spline_x_ = SplineInterpolation(base_s_vec_, base_x_vec);
-  spline_y_ = SplineInterpolation(base_s_vec_, base_y_vec);
-  spline_z_ = SplineInterpolation(base_s_vec_, base_z_vec);
+  spline_xyz_.calcSplineCoefficients(base_s_vec_, {base_x_vec, base_y_vec, base_z_vec});
 }
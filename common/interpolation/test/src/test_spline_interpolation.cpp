@@ -267,3 +267,89 @@ TEST(spline_interpolation, SplineInterpolation)
     }
   }
 }
+
+TEST(spline_interpolation, MultiChannelSplineInterpolation)
+{
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<std::vector<double>> base_values{
+    {-1.2, 0.5, 1.0, 1.2, 2.0, 1.0},
+    {0.0, 2.0, -3.0, 1.0, 4.5, 0.3},
+    {1.0, 1.0, 1.0, 1.0, 1.0, 1.0}};
+  const std::vector<double> query_keys{-1.5, 0.0, 1.0, 8.0, 12.0, 18.0, 20.0};
+
+  {
+    // same as SplineInterpolation of each channel
+    MultiChannelSplineInterpolation s(base_keys, base_values);
+    EXPECT_EQ(s.getSize(), base_keys.size());
+    EXPECT_EQ(s.getNumChannels(), base_values.size());
+
+    const auto values = s.getSplineInterpolatedValues(query_keys);
+    const auto diff_values = s.getSplineInterpolatedDiffValues(query_keys);
+    const auto quad_diff_values = s.getSplineInterpolatedQuadDiffValues(query_keys);
+    ASSERT_EQ(values.size(), base_values.size());
+    for (size_t ch = 0; ch < base_values.size(); ++ch) {
+      const SplineInterpolation ans(base_keys, base_values.at(ch));
+      EXPECT_EQ(values.at(ch), ans.getSplineInterpolatedValues(query_keys));
+      EXPECT_EQ(diff_values.at(ch), ans.getSplineInterpolatedDiffValues(query_keys));
+      EXPECT_EQ(quad_diff_values.at(ch), ans.getSplineInterpolatedQuadDiffValues(query_keys));
+    }
+  }
+
+  {
+    // query_keys slightly out of base_keys are cropped
+    const MultiChannelSplineInterpolation s(base_keys, base_values);
+    const std::vector<double> query_keys{-1.5 - 1e-4, 20.0 + 1e-4};
+    const auto values = s.getSplineInterpolatedValues(query_keys);
+    for (size_t ch = 0; ch < base_values.size(); ++ch) {
+      EXPECT_NEAR(values.at(ch).front(), base_values.at(ch).front(), epsilon);
+      EXPECT_NEAR(values.at(ch).back(), base_values.at(ch).back(), epsilon);
+    }
+  }
+
+  {
+    // query_keys on the last base key stay in the last segment
+    const MultiChannelSplineInterpolation s(base_keys, base_values);
+    const std::vector<double> query_keys{15.0, 20.0, 20.0, 20.0 + 1e-4};
+    const auto values = s.getSplineInterpolatedValues(query_keys);
+    for (size_t ch = 0; ch < base_values.size(); ++ch) {
+      for (size_t k = 1; k < query_keys.size(); ++k) {
+        EXPECT_NEAR(values.at(ch).at(k), base_values.at(ch).back(), epsilon);
+      }
+    }
+  }
+
+  {
+    // the buffer of the caller and the coefficients are reused
+    MultiChannelSplineInterpolation s(base_keys, base_values);
+    std::vector<std::vector<double>> values;
+    s.getSplineInterpolatedValues(query_keys, values);
+    const double * data = values.at(0).data();
+    s.getSplineInterpolatedValues({0.0, 3.0}, values);
+    EXPECT_EQ(values.at(0).size(), 2U);
+    EXPECT_EQ(values.at(0).data(), data);
+
+    const std::vector<double> short_base_keys{0.0, 1.0, 3.0};
+    s.calcSplineCoefficients(short_base_keys, {{0.0, 1.0, 0.5}});
+    const SplineInterpolation ans(short_base_keys, {0.0, 1.0, 0.5});
+    EXPECT_EQ(
+      s.getSplineInterpolatedValues({0.5, 2.0}).at(0), ans.getSplineInterpolatedValues({0.5, 2.0}));
+  }
+
+  {
+    // two base keys
+    const MultiChannelSplineInterpolation s({0.0, 2.0}, {{0.0, 1.0}, {1.0, 3.0}});
+    const auto values = s.getSplineInterpolatedValues({0.5, 1.0});
+    EXPECT_NEAR(values.at(0).at(1), 0.5, epsilon);
+    EXPECT_NEAR(values.at(1).at(0), 1.5, epsilon);
+  }
+
+  {
+    // invalid arguments
+    EXPECT_THROW(MultiChannelSplineInterpolation(base_keys, {}), std::invalid_argument);
+    EXPECT_THROW(
+      MultiChannelSplineInterpolation(base_keys, {base_values.at(0), {0.0, 1.0}}),
+      std::invalid_argument);
+    const MultiChannelSplineInterpolation s(base_keys, base_values);
+    EXPECT_THROW(s.getSplineInterpolatedValues({0.0, 30.0}), std::invalid_argument);
+  }
+}
@@ -0,0 +1,473 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+#define MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/geometry/boost_geometry.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+#include "tier4_autoware_utils/math/normalization.hpp"
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <autoware_auto_planning_msgs/msg/path_point.hpp>
+#include <autoware_auto_planning_msgs/msg/path_point_with_lane_id.hpp>
+#include <autoware_auto_planning_msgs/msg/trajectory_point.hpp>
+
+#include <tf2/utils.h>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace motion_utils
+{
+/**
+ * @brief Immutable index of a points container for repeated queries on the same path.
+ * It holds the cumulative arc length, an rtree of the points and the yaw of each point, so that
+ * arc length queries are O(1) and nearest queries are O(log n) instead of O(n).
+ * The results are the same as the functions in trajectory.hpp, except that arc lengths are
+ * differences of the cumulative sum and may differ from them by rounding errors.
+ * @note The points are referenced, not copied. The container must outlive the index and must not
+ * be modified while the index is used.
+ */
+template <class T>
+class TrajectoryIndex
+{
+public:
+  explicit TrajectoryIndex(const T & points);
+  // The points are referenced, so a temporary container would dangle
+  explicit TrajectoryIndex(T &&) = delete;
+
+  const T & points() const { return points_; }
+  size_t size() const { return points_.size(); }
+  bool empty() const { return points_.empty(); }
+
+  /**
+   * @brief arc length from the front point to the point of idx
+   */
+  double arcLength(const size_t idx) const { return arc_lengths_.at(idx); }
+
+  /**
+   * @brief yaw of the point of idx
+   */
+  double yaw(const size_t idx) const { return yaws_.at(idx); }
+
+  size_t findNearestIndex(const geometry_msgs::msg::Point & point) const;
+  std::optional<size_t> findNearestIndex(
+    const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw) const;
+
+  double calcLongitudinalOffsetToSegment(
+    const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+    const bool throw_exception) const;
+
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const;
+
+private:
+  using RtreeValue = std::pair<tier4_autoware_utils::Point2d, size_t>;
+  using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
+
+  // margin to visit the points whose distance differs from the minimum only by rounding errors
+  static constexpr double squared_dist_margin = 1e-6;
+
+  const T & points_;
+  std::vector<double> arc_lengths_;
+  std::vector<double> yaws_;
+  // index of the first following point which is not overlapping, same as removeOverlapPoints()
+  std::vector<size_t> next_non_overlap_indices_;
+  Rtree rtree_;
+};
+
+template <class T>
+TrajectoryIndex<T>::TrajectoryIndex(const T & points) : points_(points)
+{
+  arc_lengths_.reserve(points_.size());
+  yaws_.reserve(points_.size());
+  next_non_overlap_indices_.reserve(points_.size());
+
+  std::vector<RtreeValue> rtree_values;
+  rtree_values.reserve(points_.size());
+  for (size_t i = 0; i < points_.size(); ++i) {
+    const auto & point = tier4_autoware_utils::getPoint(points_.at(i));
+    arc_lengths_.push_back(
+      i == 0 ? 0.0
+             : arc_lengths_.back() +
+                 tier4_autoware_utils::calcDistance2d(points_.at(i - 1), points_.at(i)));
+    yaws_.push_back(tf2::getYaw(tier4_autoware_utils::getPose(points_.at(i)).orientation));
+    rtree_values.emplace_back(tier4_autoware_utils::Point2d(point.x, point.y), i);
+
+    constexpr double eps = 1.0E-08;
+    size_t next_idx = i + 1;
+    for (; next_idx < points_.size(); ++next_idx) {
+      const auto & next_point = tier4_autoware_utils::getPoint(points_.at(next_idx));
+      if (std::abs(point.x - next_point.x) >= eps || std::abs(point.y - next_point.y) >= eps) {
+        break;
+      }
+    }
+    next_non_overlap_indices_.push_back(next_idx);
+  }
+  // packing algorithm
+  rtree_ = Rtree(rtree_values);
+}
+
+template <class T>
+size_t TrajectoryIndex<T>::findNearestIndex(const geometry_msgs::msg::Point & point) const
+{
+  validateNonEmpty(points_);
+
+  // the points are visited in ascending order of the distance, and the lowest index among the
+  // nearest points is returned as the linear search does
+  double min_dist = std::numeric_limits<double>::max();
+  size_t min_idx = 0;
+  const tier4_autoware_utils::Point2d query_point(point.x, point.y);
+  for (auto itr = rtree_.qbegin(boost::geometry::index::nearest(query_point, points_.size()));
+       itr != rtree_.qend(); ++itr) {
+    const size_t i = itr->second;
+    const auto dist = tier4_autoware_utils::calcSquaredDistance2d(points_.at(i), point);
+    if (dist > min_dist + squared_dist_margin) {
+      break;
+    }
+    if (dist < min_dist || (dist == min_dist && i < min_idx)) {
+      min_dist = dist;
+      min_idx = i;
+    }
+  }
+  return min_idx;
+}
+
+template <class T>
+std::optional<size_t> TrajectoryIndex<T>::findNearestIndex(
+  const geometry_msgs::msg::Pose & pose, const double max_dist, const double max_yaw) const
+{
+  try {
+    validateNonEmpty(points_);
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return {};
+  }
+
+  const double max_squared_dist = max_dist * max_dist;
+  const double pose_yaw = tf2::getYaw(pose.orientation);
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  std::optional<size_t> min_idx;
+  const tier4_autoware_utils::Point2d query_point(pose.position.x, pose.position.y);
+  for (auto itr = rtree_.qbegin(boost::geometry::index::nearest(query_point, points_.size()));
+       itr != rtree_.qend(); ++itr) {
+    const size_t i = itr->second;
+    const auto squared_dist = tier4_autoware_utils::calcSquaredDistance2d(points_.at(i), pose);
+    if (
+      squared_dist > max_squared_dist + squared_dist_margin ||
+      squared_dist > min_squared_dist + squared_dist_margin) {
+      break;
+    }
+    if (
+      squared_dist > max_squared_dist || squared_dist > min_squared_dist ||
+      (squared_dist == min_squared_dist && min_idx && *min_idx < i)) {
+      continue;
+    }
+
+    const auto yaw = tier4_autoware_utils::normalizeRadian(pose_yaw - yaws_.at(i));
+    if (std::fabs(yaw) > max_yaw) {
+      continue;
+    }
+
+    min_squared_dist = squared_dist;
+    min_idx = i;
+  }
+
+  return min_idx;
+}
+
+template <class T>
+double TrajectoryIndex<T>::calcLongitudinalOffsetToSegment(
+  const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception) const
+{
+  // invalid cases are reported by the function without the index
+  if (
+    points_.empty() || seg_idx >= points_.size() - 1 ||
+    next_non_overlap_indices_.at(seg_idx) >= points_.size()) {
+    return motion_utils::calcLongitudinalOffsetToSegment(
+      points_, seg_idx, p_target, throw_exception);
+  }
+
+  const auto p_front = tier4_autoware_utils::getPoint(points_.at(seg_idx));
+  const auto p_back =
+    tier4_autoware_utils::getPoint(points_.at(next_non_overlap_indices_.at(seg_idx)));
+
+  const Eigen::Vector3d segment_vec{p_back.x - p_front.x, p_back.y - p_front.y, 0};
+  const Eigen::Vector3d target_vec{p_target.x - p_front.x, p_target.y - p_front.y, 0};
+
+  return segment_vec.dot(target_vec) / segment_vec.norm();
+}
+
+template <class T>
+double TrajectoryIndex<T>::calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+{
+  try {
+    validateNonEmpty(points_);
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return 0.0;
+  }
+
+  if (src_idx == dst_idx) {
+    return 0.0;
+  }
+  return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+}
+
+extern template class TrajectoryIndex<std::vector<autoware_auto_planning_msgs::msg::PathPoint>>;
+extern template class TrajectoryIndex<
+  std::vector<autoware_auto_planning_msgs::msg::PathPointWithLaneId>>;
+extern template class TrajectoryIndex<
+  std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>>;
+
+/**
+ * @brief find nearest point index to a given point with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param point given point
+ * @return index of nearest point
+ */
+template <class T>
+size_t findNearestIndex(const TrajectoryIndex<T> & index, const geometry_msgs::msg::Point & point)
+{
+  return index.findNearestIndex(point);
+}
+
+/**
+ * @brief find nearest point index to a given pose with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param pose given pose
+ * @param max_dist max distance used to get squared distance for finding the nearest point to given
+ * pose
+ * @param max_yaw max yaw used for finding nearest point to given pose
+ * @return index of nearest point (index or none if not found)
+ */
+template <class T>
+std::optional<size_t> findNearestIndex(
+  const TrajectoryIndex<T> & index, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max())
+{
+  return index.findNearestIndex(pose, max_dist, max_yaw);
+}
+
+/**
+ * @brief calculate longitudinal offset from seg_idx point to the nearest point to p_target with a
+ * prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param seg_idx segment index of point at beginning of length
+ * @param p_target target point at end of length
+ * @param throw_exception flag to enable/disable exception throwing
+ * @return signed length
+ */
+template <class T>
+double calcLongitudinalOffsetToSegment(
+  const TrajectoryIndex<T> & index, const size_t seg_idx,
+  const geometry_msgs::msg::Point & p_target, const bool throw_exception = false)
+{
+  return index.calcLongitudinalOffsetToSegment(seg_idx, p_target, throw_exception);
+}
+
+/**
+ * @brief find nearest segment index to point with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param point point to which to find nearest segment index
+ * @return nearest index
+ */
+template <class T>
+size_t findNearestSegmentIndex(
+  const TrajectoryIndex<T> & index, const geometry_msgs::msg::Point & point)
+{
+  const size_t nearest_idx = findNearestIndex(index, point);
+
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == index.size() - 1) {
+    return index.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(index, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+
+/**
+ * @brief find nearest segment index to pose with a prebuilt index
+ * @param index index of points of trajectory, path, ..
+ * @param pose pose to which to find nearest segment index
+ * @param max_dist max distance used for finding the nearest index to given pose
+ * @param max_yaw max yaw used for finding nearest index to given pose
+ * @return nearest index
+ */
+template <class T>
+std::optional<size_t> findNearestSegmentIndex(
+  const TrajectoryIndex<T> & index, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max())
+{
+  const auto nearest_idx = findNearestIndex(index, pose, max_dist, max_yaw);
+
+  if (!nearest_idx) {
+    return std::nullopt;
+  }
+
+  if (*nearest_idx == 0) {
+    return 0;
+  }
+  if (*nearest_idx == index.size() - 1) {
+    return index.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(index, *nearest_idx, pose.position);
+
+  if (signed_length <= 0) {
+    return *nearest_idx - 1;
+  }
+
+  return *nearest_idx;
+}
+
+/**
+ * @brief calculate length of 2D distance between two points, specified by start and end points
+ * indices, with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param src_idx index of start point
+ * @param dst_idx index of end point
+ * @return length of distance between two points.
+ * Length is positive if dst_idx is greater that src_idx and negative otherwise.
+ */
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryIndex<T> & index, const size_t src_idx, const size_t dst_idx)
+{
+  return index.calcSignedArcLength(src_idx, dst_idx);
+}
+
+/**
+ * @brief calculate length of 2D distance between two points, specified by start point and end point
+ * index, with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param src_point start point
+ * @param dst_idx index of end point
+ * @return length of distance between two points.
+ */
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryIndex<T> & index, const geometry_msgs::msg::Point & src_point,
+  const size_t dst_idx)
+{
+  try {
+    validateNonEmpty(index.points());
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return 0.0;
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+
+  return signed_length_on_traj - signed_length_src_offset;
+}
+
+/**
+ * @brief calculate length of 2D distance between two points, specified by start index and end
+ * point, with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param src_idx index of start point
+ * @param dst_point end point
+ * @return length of distance between two points
+ */
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryIndex<T> & index, const size_t src_idx,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  try {
+    validateNonEmpty(index.points());
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return 0.0;
+  }
+
+  return -calcSignedArcLength(index, dst_point, src_idx);
+}
+
+/**
+ * @brief calculate length of 2D distance between two points, specified by start point and end
+ * point, with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @param src_point start point
+ * @param dst_point end point
+ * @return length of distance between two points.
+ */
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryIndex<T> & index, const geometry_msgs::msg::Point & src_point,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  try {
+    validateNonEmpty(index.points());
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return 0.0;
+  }
+
+  const size_t src_seg_idx = findNearestSegmentIndex(index, src_point);
+  const size_t dst_seg_idx = findNearestSegmentIndex(index, dst_point);
+
+  const double signed_length_on_traj = calcSignedArcLength(index, src_seg_idx, dst_seg_idx);
+  const double signed_length_src_offset =
+    calcLongitudinalOffsetToSegment(index, src_seg_idx, src_point);
+  const double signed_length_dst_offset =
+    calcLongitudinalOffsetToSegment(index, dst_seg_idx, dst_point);
+
+  return signed_length_on_traj - signed_length_src_offset + signed_length_dst_offset;
+}
+
+/**
+ * @brief calculate length of 2D distance for whole points container with a prebuilt index
+ * @param index index of points of trajectory, path, ...
+ * @return length of 2D distance for points container
+ */
+template <class T>
+double calcArcLength(const TrajectoryIndex<T> & index)
+{
+  try {
+    validateNonEmpty(index.points());
+  } catch (const std::exception & e) {
+    log_error(e.what());
+    return 0.0;
+  }
+
+  return calcSignedArcLength(index, 0, index.size() - 1);
+}
+
+}  // namespace motion_utils
+
+#endif  // MOTION_UTILS__TRAJECTORY__TRAJECTORY_INDEX_HPP_
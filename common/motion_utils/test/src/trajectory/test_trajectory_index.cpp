@@ -0,0 +1,171 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "motion_utils/trajectory/trajectory_index.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using motion_utils::TrajectoryIndex;
+using TrajectoryPointArray = std::vector<TrajectoryPoint>;
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromRPY;
+
+constexpr double epsilon = 1e-6;
+
+static_assert(
+  !std::is_constructible_v<TrajectoryIndex<TrajectoryPointArray>, TrajectoryPointArray &&>,
+  "TrajectoryIndex must not reference a temporary container");
+static_assert(
+  std::is_constructible_v<TrajectoryIndex<TrajectoryPointArray>, const TrajectoryPointArray &>);
+
+geometry_msgs::msg::Pose createPose(double x, double y, double yaw)
+{
+  geometry_msgs::msg::Pose p;
+  p.position = createPoint(x, y, 0.0);
+  p.orientation = createQuaternionFromRPY(0.0, 0.0, yaw);
+  return p;
+}
+
+// curved trajectory with some overlapping points
+TrajectoryPointArray generateTestTrajectoryPointArray(
+  const size_t num_points, const double point_interval, const double delta_theta)
+{
+  TrajectoryPointArray traj;
+  double x = 0.0;
+  double y = 0.0;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * delta_theta;
+    TrajectoryPoint p;
+    p.pose = createPose(x, y, theta);
+    traj.push_back(p);
+    if (i % 7 == 3) {
+      traj.push_back(p);
+    }
+    x += point_interval * std::cos(theta);
+    y += point_interval * std::sin(theta);
+  }
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_index, arcLength)
+{
+  using motion_utils::calcArcLength;
+  using motion_utils::calcSignedArcLength;
+
+  const auto traj = generateTestTrajectoryPointArray(50, 1.0, 0.05);
+  const TrajectoryIndex<TrajectoryPointArray> index(traj);
+
+  EXPECT_NEAR(calcArcLength(index), calcArcLength(traj), epsilon);
+  for (size_t src_idx = 0; src_idx < traj.size(); src_idx += 3) {
+    for (size_t dst_idx = 0; dst_idx < traj.size(); dst_idx += 5) {
+      EXPECT_NEAR(
+        calcSignedArcLength(index, src_idx, dst_idx), calcSignedArcLength(traj, src_idx, dst_idx),
+        epsilon);
+    }
+  }
+
+  // Empty
+  const TrajectoryPointArray empty_traj;
+  const TrajectoryIndex<TrajectoryPointArray> empty_index(empty_traj);
+  EXPECT_DOUBLE_EQ(calcArcLength(empty_index), 0.0);
+  EXPECT_DOUBLE_EQ(calcSignedArcLength(empty_index, 0, 0), 0.0);
+}
+
+TEST(trajectory_index, findNearestIndex)
+{
+  using motion_utils::findNearestIndex;
+  using motion_utils::findNearestSegmentIndex;
+
+  const auto traj = generateTestTrajectoryPointArray(50, 1.0, 0.05);
+  const TrajectoryIndex<TrajectoryPointArray> index(traj);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position_dist(-10.0, 40.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto pose = createPose(position_dist(engine), position_dist(engine), yaw_dist(engine));
+
+    EXPECT_EQ(findNearestIndex(index, pose.position), findNearestIndex(traj, pose.position));
+    EXPECT_EQ(
+      findNearestSegmentIndex(index, pose.position), findNearestSegmentIndex(traj, pose.position));
+    EXPECT_EQ(findNearestIndex(index, pose), findNearestIndex(traj, pose));
+    EXPECT_EQ(findNearestIndex(index, pose, 5.0, 1.0), findNearestIndex(traj, pose, 5.0, 1.0));
+    EXPECT_EQ(
+      findNearestSegmentIndex(index, pose, 10.0, 0.5),
+      findNearestSegmentIndex(traj, pose, 10.0, 0.5));
+  }
+
+  // Overlapping points return the lowest index
+  EXPECT_EQ(findNearestIndex(index, traj.at(3).pose.position), 3U);
+
+  // Equidistant points return the lowest index
+  const auto straight_traj = generateTestTrajectoryPointArray(10, 1.0, 0.0);
+  const TrajectoryIndex<TrajectoryPointArray> straight_index(straight_traj);
+  EXPECT_EQ(findNearestIndex(straight_index, createPoint(2.5, 1.0, 0.0)), 2U);
+  EXPECT_EQ(findNearestIndex(straight_index, createPose(2.5, 1.0, 0.0)), 2U);
+
+  // Empty
+  const TrajectoryPointArray empty_traj;
+  const TrajectoryIndex<TrajectoryPointArray> empty_index(empty_traj);
+  EXPECT_THROW(
+    findNearestIndex(empty_index, geometry_msgs::msg::Point{}), std::invalid_argument);
+  EXPECT_EQ(findNearestIndex(empty_index, geometry_msgs::msg::Pose{}), std::nullopt);
+}
+
+TEST(trajectory_index, calcSignedArcLengthFromPoint)
+{
+  using motion_utils::calcLongitudinalOffsetToSegment;
+  using motion_utils::calcSignedArcLength;
+
+  const auto traj = generateTestTrajectoryPointArray(50, 1.0, 0.05);
+  const TrajectoryIndex<TrajectoryPointArray> index(traj);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position_dist(-10.0, 40.0);
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto src_point = createPoint(position_dist(engine), position_dist(engine), 0.0);
+    const auto dst_point = createPoint(position_dist(engine), position_dist(engine), 0.0);
+    const size_t idx = i % traj.size();
+
+    EXPECT_NEAR(
+      calcSignedArcLength(index, src_point, idx), calcSignedArcLength(traj, src_point, idx),
+      epsilon);
+    EXPECT_NEAR(
+      calcSignedArcLength(index, idx, dst_point), calcSignedArcLength(traj, idx, dst_point),
+      epsilon);
+    EXPECT_NEAR(
+      calcSignedArcLength(index, src_point, dst_point),
+      calcSignedArcLength(traj, src_point, dst_point), epsilon);
+    if (idx + 1 < traj.size()) {
+      EXPECT_NEAR(
+        calcLongitudinalOffsetToSegment(index, idx, src_point),
+        calcLongitudinalOffsetToSegment(traj, idx, src_point), epsilon);
+    }
+  }
+
+  // Out of range
+  EXPECT_THROW(
+    calcLongitudinalOffsetToSegment(index, traj.size() - 1, createPoint(0.0, 0.0, 0.0), true),
+    std::out_of_range);
+}
@@ -54,6 +54,9 @@ private:
   bool m_work_initialized = false;
   // Exitflag
   int64_t m_exitflag;
+  // Sparsity patterns of the problem in the current work (values are not stored)
+  CSC_Matrix m_P_pattern;
+  CSC_Matrix m_A_pattern;
 
   // Runs the solver on the stored problem.
   std::tuple<std::vector<double>, std::vector<double>, int64_t, int64_t, int64_t> solve();
@@ -122,6 +125,19 @@ public:
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u);
 
+  /// \brief Solves convex quadratic programs (QPs) given as Eigen sparse matrices.
+  /// \details Unlike the overload with dense matrices, the workspace is kept after the
+  /// \details optimization. When the problem size and the sparsity patterns of P and A are the same
+  /// \details as the previous problem, only the values are updated in the workspace instead of
+  /// \details setting up the solver again, and the solver is warm started from the previous
+  /// \details solution. Sparse matrices can be built from triplets by
+  /// \details Eigen::SparseMatrix::setFromTriplets. If the workspace cannot be set up or updated,
+  /// \details the problem is not solved, the solution status is OSQP_UNSOLVED and getExitFlag()
+  /// \details returns the error.
+  std::tuple<std::vector<double>, std::vector<double>, int64_t, int64_t, int64_t> optimize(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
+
   /// \brief Converts the input data and sets up the workspace object.
   /// \param P (n,n) matrix defining relations between parameters.
   /// \param A (m,n) matrix defining parameter constraints relative to the lower and upper bound.
@@ -131,10 +147,24 @@ public:
   int64_t initializeProblem(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u);
+  int64_t initializeProblem(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
   int64_t initializeProblem(
     CSC_Matrix P, CSC_Matrix A, const std::vector<double> & q, const std::vector<double> & l,
     const std::vector<double> & u);
 
+  /// \brief Updates the values of the problem in the workspace object if the problem size and the
+  /// \brief sparsity patterns of P and A are unchanged, otherwise sets up the workspace again.
+  /// \param P (n,n) upper trapezoidal CSC matrix defining relations between parameters.
+  /// \param A (m,n) CSC matrix defining parameter constraints.
+  /// \param q (n) vector defining the linear cost of the problem.
+  /// \param l (m) vector defining the lower bound problem constraint.
+  /// \param u (m) vector defining the upper bound problem constraint.
+  int64_t updateProblem(
+    const CSC_Matrix & P, const CSC_Matrix & A, const std::vector<double> & q,
+    const std::vector<double> & l, const std::vector<double> & u);
+
   // Setter functions for warm start
   bool setWarmStart(
     const std::vector<double> & primal_variables, const std::vector<double> & dual_variables);
@@ -150,8 +180,10 @@ public:
   //   l_new: (m) vector defining the lower bound problem constraint.
   //   u_new: (m) vector defining the upper bound problem constraint.
   void updateP(const Eigen::MatrixXd & P_new);
+  void updateP(const Eigen::SparseMatrix<double> & P_new);
   void updateCscP(const CSC_Matrix & P_csc);
   void updateA(const Eigen::MatrixXd & A_new);
+  void updateA(const Eigen::SparseMatrix<double> & A_new);
   void updateCscA(const CSC_Matrix & A_csc);
   void updateQ(const std::vector<double> & q_new);
   void updateL(const std::vector<double> & l_new);
@@ -185,6 +217,14 @@ public:
   }
   /// \brief Get the runtime of the latest problem solved
   inline double getRunTime() const { return m_latest_work_info.run_time; }
+  /// \brief Get the time to set up the workspace used for the latest problem solved
+  inline double getSetupTime() const { return m_latest_work_info.setup_time; }
+  /// \brief Get the time to update the workspace for the latest problem solved
+  inline double getUpdateTime() const { return m_latest_work_info.update_time; }
+  /// \brief Get the solve time of the latest problem solved
+  inline double getSolveTime() const { return m_latest_work_info.solve_time; }
+  /// \brief Get the polish time of the latest problem solved
+  inline double getPolishTime() const { return m_latest_work_info.polish_time; }
   /// \brief Get the objective value the latest problem solved
   inline double getObjVal() const { return m_latest_work_info.obj_val; }
   /// \brief Returns flag asserting interface condition (Healthy condition: 0).
@@ -18,11 +18,13 @@
 #include "osqp_interface/csc_matrix_conv.hpp"
 
 #include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -31,6 +33,43 @@ namespace common
 {
 namespace osqp
 {
+namespace
+{
+template <class Matrix>
+void validateProblemSize(
+  const Matrix & P, const Matrix & A, const std::vector<double> & q, const std::vector<double> & l,
+  const std::vector<double> & u)
+{
+  // check if arguments are valid
+  std::stringstream ss;
+  if (P.rows() != P.cols()) {
+    ss << "P.rows() and P.cols() are not the same. P.rows() = " << P.rows()
+       << ", P.cols() = " << P.cols();
+    throw std::invalid_argument(ss.str());
+  }
+  if (P.rows() != static_cast<int>(q.size())) {
+    ss << "P.rows() and q.size() are not the same. P.rows() = " << P.rows()
+       << ", q.size() = " << q.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (P.rows() != A.cols()) {
+    ss << "P.rows() and A.cols() are not the same. P.rows() = " << P.rows()
+       << ", A.cols() = " << A.cols();
+    throw std::invalid_argument(ss.str());
+  }
+  if (A.rows() != static_cast<int>(l.size())) {
+    ss << "A.rows() and l.size() are not the same. A.rows() = " << A.rows()
+       << ", l.size() = " << l.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (A.rows() != static_cast<int>(u.size())) {
+    ss << "A.rows() and u.size() are not the same. A.rows() = " << A.rows()
+       << ", u.size() = " << u.size();
+    throw std::invalid_argument(ss.str());
+  }
+}
+}  // namespace
+
 OSQPInterface::OSQPInterface(const c_float eps_abs, const bool polish)
 : m_work{nullptr, OSQPWorkspaceDeleter}
 {
@@ -97,6 +136,11 @@ void OSQPInterface::updateP(const Eigen::MatrixXd & P_new)
     m_work.get(), P_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(P_csc.m_vals.size()));
 }
 
+void OSQPInterface::updateP(const Eigen::SparseMatrix<double> & P_new)
+{
+  updateCscP(calCSCMatrixTrapezoidal(P_new));
+}
+
 void OSQPInterface::updateCscP(const CSC_Matrix & P_csc)
 {
   osqp_update_P(
@@ -118,6 +162,11 @@ void OSQPInterface::updateA(const Eigen::MatrixXd & A_new)
   return;
 }
 
+void OSQPInterface::updateA(const Eigen::SparseMatrix<double> & A_new)
+{
+  updateCscA(calCSCMatrix(A_new));
+}
+
 void OSQPInterface::updateCscA(const CSC_Matrix & A_csc)
 {
   osqp_update_A(
@@ -287,39 +336,22 @@ int64_t OSQPInterface::initializeProblem(
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
   const std::vector<double> & l, const std::vector<double> & u)
 {
-  // check if arguments are valid
-  std::stringstream ss;
-  if (P.rows() != P.cols()) {
-    ss << "P.rows() and P.cols() are not the same. P.rows() = " << P.rows()
-       << ", P.cols() = " << P.cols();
-    throw std::invalid_argument(ss.str());
-  }
-  if (P.rows() != static_cast<int>(q.size())) {
-    ss << "P.rows() and q.size() are not the same. P.rows() = " << P.rows()
-       << ", q.size() = " << q.size();
-    throw std::invalid_argument(ss.str());
-  }
-  if (P.rows() != A.cols()) {
-    ss << "P.rows() and A.cols() are not the same. P.rows() = " << P.rows()
-       << ", A.cols() = " << A.cols();
-    throw std::invalid_argument(ss.str());
-  }
-  if (A.rows() != static_cast<int>(l.size())) {
-    ss << "A.rows() and l.size() are not the same. A.rows() = " << A.rows()
-       << ", l.size() = " << l.size();
-    throw std::invalid_argument(ss.str());
-  }
-  if (A.rows() != static_cast<int>(u.size())) {
-    ss << "A.rows() and u.size() are not the same. A.rows() = " << A.rows()
-       << ", u.size() = " << u.size();
-    throw std::invalid_argument(ss.str());
-  }
+  validateProblemSize(P, A, q, l, u);
 
   CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
   CSC_Matrix A_csc = calCSCMatrix(A);
   return initializeProblem(P_csc, A_csc, q, l, u);
 }
 
+int64_t OSQPInterface::initializeProblem(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
+{
+  validateProblemSize(P, A, q, l, u);
+
+  return initializeProblem(calCSCMatrixTrapezoidal(P), calCSCMatrix(A), q, l, u);
+}
+
 int64_t OSQPInterface::initializeProblem(
   CSC_Matrix P_csc, CSC_Matrix A_csc, const std::vector<double> & q, const std::vector<double> & l,
   const std::vector<double> & u)
@@ -360,6 +392,39 @@ int64_t OSQPInterface::initializeProblem(
   m_work.reset(workspace);
   m_work_initialized = true;
 
+  m_P_pattern = CSC_Matrix{{}, std::move(P_csc.m_row_idxs), std::move(P_csc.m_col_idxs)};
+  m_A_pattern = CSC_Matrix{{}, std::move(A_csc.m_row_idxs), std::move(A_csc.m_col_idxs)};
+
+  return m_exitflag;
+}
+
+int64_t OSQPInterface::updateProblem(
+  const CSC_Matrix & P_csc, const CSC_Matrix & A_csc, const std::vector<double> & q,
+  const std::vector<double> & l, const std::vector<double> & u)
+{
+  const bool is_same_structure =
+    m_work_initialized && m_exitflag == 0 && m_param_n == static_cast<int64_t>(q.size()) &&
+    m_data->m == static_cast<c_int>(l.size()) && hasSameSparsityPattern(P_csc, m_P_pattern) &&
+    hasSameSparsityPattern(A_csc, m_A_pattern);
+  if (!is_same_structure) {
+    return initializeProblem(P_csc, A_csc, q, l, u);
+  }
+
+  // update only the values, keeping the factorization structure and the previous solution
+  const c_int P_exitflag = osqp_update_P_A(
+    m_work.get(), P_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(P_csc.m_vals.size()),
+    A_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(A_csc.m_vals.size()));
+  const c_int q_exitflag = osqp_update_lin_cost(m_work.get(), q.data());
+  const c_int bounds_exitflag = osqp_update_bounds(m_work.get(), l.data(), u.data());
+
+  // a failed update leaves the workspace inconsistent, so it is set up again at the next update
+  if (P_exitflag != 0) {
+    m_exitflag = P_exitflag;
+  } else if (q_exitflag != 0) {
+    m_exitflag = q_exitflag;
+  } else {
+    m_exitflag = bounds_exitflag;
+  }
   return m_exitflag;
 }
 
@@ -416,6 +481,29 @@ OSQPInterface::optimize(
   return result;
 }
 
+std::tuple<std::vector<double>, std::vector<double>, int64_t, int64_t, int64_t>
+OSQPInterface::optimize(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
+{
+  validateProblemSize(P, A, q, l, u);
+
+  // Set up the workspace, or update it when the structure of the problem is unchanged.
+  // The workspace is kept for the next optimization.
+  if (updateProblem(calCSCMatrixTrapezoidal(P), calCSCMatrix(A), q, l, u) != 0) {
+    // The error is available from getExitFlag(), and the problem is reported as unsolved
+    m_latest_work_info = OSQPInfo{};
+    m_latest_work_info.status_val = OSQP_UNSOLVED;
+    std::snprintf(m_latest_work_info.status, sizeof(m_latest_work_info.status), "%s", "unsolved");
+    return std::make_tuple(
+      std::vector<double>(q.size(), 0.0), std::vector<double>(l.size(), 0.0), 0,
+      static_cast<int64_t>(OSQP_UNSOLVED), 0);
+  }
+
+  // Run the solver on the stored problem representation.
+  return solve();
+}
+
 void OSQPInterface::logUnsolvedStatus(const std::string & prefix_message) const
 {
   const int status = getStatus();
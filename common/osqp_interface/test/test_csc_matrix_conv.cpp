@@ -16,6 +16,7 @@
 #include "osqp_interface/csc_matrix_conv.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <string>
 #include <tuple>
@@ -164,6 +165,50 @@ TEST(TestCscMatrixConv, Trapezoidal)
     EXPECT_EQ(e.what(), std::string("Matrix must be square (n, n)"));
   }
 }
+TEST(TestCscMatrixConv, Sparse)
+{
+  using autoware::common::osqp::calCSCMatrix;
+  using autoware::common::osqp::calCSCMatrixTrapezoidal;
+  using autoware::common::osqp::CSC_Matrix;
+  using autoware::common::osqp::hasSameSparsityPattern;
+
+  Eigen::MatrixXd square(3, 3);
+  square << 1.0, 0.0, 3.0, 2.0, 6.0, 7.0, 0.0, 0.0, 5.0;
+  Eigen::SparseMatrix<double> square_sparse = square.sparseView();
+
+  // Same as the dense matrix
+  const CSC_Matrix dense_m = calCSCMatrix(square);
+  const CSC_Matrix sparse_m = calCSCMatrix(square_sparse);
+  EXPECT_EQ(sparse_m.m_vals, dense_m.m_vals);
+  EXPECT_TRUE(hasSameSparsityPattern(sparse_m, dense_m));
+
+  const CSC_Matrix dense_trap_m = calCSCMatrixTrapezoidal(square);
+  const CSC_Matrix sparse_trap_m = calCSCMatrixTrapezoidal(square_sparse);
+  EXPECT_EQ(sparse_trap_m.m_vals, dense_trap_m.m_vals);
+  EXPECT_TRUE(hasSameSparsityPattern(sparse_trap_m, dense_trap_m));
+
+  // Explicitly stored zeros are kept
+  square_sparse.coeffRef(2, 0) = 0.0;
+  square_sparse.coeffRef(0, 1) = 0.0;
+  const CSC_Matrix sparse_zero_m = calCSCMatrix(square_sparse);
+  ASSERT_EQ(sparse_zero_m.m_vals.size(), size_t(8));
+  EXPECT_EQ(sparse_zero_m.m_vals[2], 0.0);
+  EXPECT_EQ(sparse_zero_m.m_row_idxs[2], c_int(2));
+  EXPECT_FALSE(hasSameSparsityPattern(sparse_zero_m, dense_m));
+
+  const CSC_Matrix sparse_zero_trap_m = calCSCMatrixTrapezoidal(square_sparse);
+  ASSERT_EQ(sparse_zero_trap_m.m_vals.size(), size_t(6));
+  EXPECT_EQ(sparse_zero_trap_m.m_vals[1], 0.0);
+  EXPECT_EQ(sparse_zero_trap_m.m_row_idxs[1], c_int(0));
+
+  try {
+    const CSC_Matrix rect_m = calCSCMatrixTrapezoidal(Eigen::SparseMatrix<double>(1, 2));
+    FAIL() << "calCSCMatrixTrapezoidal should fail with non-square inputs";
+  } catch (const std::invalid_argument & e) {
+    EXPECT_EQ(e.what(), std::string("Matrix must be square (n, n)"));
+  }
+}
+
 TEST(TestCscMatrixConv, Print)
 {
   using autoware::common::osqp::calCSCMatrix;
@@ -16,6 +16,7 @@
 #include "osqp_interface/osqp_interface.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <tuple>
 #include <vector>
@@ -161,4 +162,86 @@ TEST(TestOsqpInterface, BasicQp)
     EXPECT_EQ(osqp.getTakenIter(), 1);
   }
 }
+
+TEST(TestOsqpInterface, SparseQp)
+{
+  auto check_result =
+    [](const std::tuple<std::vector<double>, std::vector<double>, int, int, int> & result) {
+      EXPECT_EQ(std::get<2>(result), 1);  // polish succeeded
+      EXPECT_EQ(std::get<3>(result), 1);  // solution succeeded
+
+      static const auto ep = 1.0e-8;
+
+      const auto prime_val = std::get<0>(result);
+      ASSERT_EQ(prime_val.size(), size_t(2));
+      EXPECT_NEAR(prime_val[0], 0.3, ep);
+      EXPECT_NEAR(prime_val[1], 0.7, ep);
+
+      const auto dual_val = std::get<1>(result);
+      ASSERT_EQ(dual_val.size(), size_t(4));
+      EXPECT_NEAR(dual_val[0], -2.9, ep);
+      EXPECT_NEAR(dual_val[1], 0.0, ep);
+      EXPECT_NEAR(dual_val[2], 0.2, ep);
+      EXPECT_NEAR(dual_val[3], 0.0, ep);
+    };
+
+  const Eigen::MatrixXd P = (Eigen::MatrixXd(2, 2) << 4, 1, 1, 2).finished();
+  const Eigen::MatrixXd A = (Eigen::MatrixXd(4, 2) << 1, 1, 1, 0, 0, 1, 0, 1).finished();
+  const Eigen::SparseMatrix<double> P_sparse = P.sparseView();
+  const Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+  const std::vector<double> q = {1.0, 1.0};
+  const std::vector<double> l = {1.0, 0.0, 0.0, -autoware::common::osqp::INF};
+  const std::vector<double> u = {1.0, 0.7, 0.7, autoware::common::osqp::INF};
+
+  std::tuple<std::vector<double>, std::vector<double>, int, int, int> result;
+  autoware::common::osqp::OSQPInterface osqp;
+
+  // Set up the workspace at the first optimization
+  result = osqp.optimize(P_sparse, A_sparse, q, l, u);
+  check_result(result);
+
+  // Same structure: the workspace is updated and warm started from the previous solution
+  osqp.updateCheckTermination(1);
+  result = osqp.optimize(P_sparse, A_sparse, q, l, u);
+  check_result(result);
+  EXPECT_EQ(osqp.getTakenIter(), 1);
+
+  // Same structure with different values: the primal solution does not change with scaled costs
+  const Eigen::SparseMatrix<double> P_scaled = 2.0 * P_sparse;
+  const std::vector<double> q_scaled = {2.0, 2.0};
+  result = osqp.optimize(P_scaled, A_sparse, q_scaled, l, u);
+  EXPECT_EQ(std::get<3>(result), 1);
+  EXPECT_NEAR(std::get<0>(result)[0], 0.3, 1.0e-8);
+  EXPECT_NEAR(std::get<0>(result)[1], 0.7, 1.0e-8);
+
+  // Different structure: the workspace is set up again
+  // An explicitly stored zero is a part of the sparsity pattern.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  for (Eigen::Index i = 0; i < A.rows(); ++i) {
+    for (Eigen::Index j = 0; j < A.cols(); ++j) {
+      A_triplets.emplace_back(i, j, A(i, j));
+    }
+  }
+  Eigen::SparseMatrix<double> A_dense_pattern(A.rows(), A.cols());
+  A_dense_pattern.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  osqp.updateCheckTermination(25);
+  result = osqp.optimize(P_sparse, A_dense_pattern, q, l, u);
+  check_result(result);
+
+  // Invalid bounds: the update fails and the problem is not solved
+  const std::vector<double> l_invalid = {1.0, 1.0, 0.0, -autoware::common::osqp::INF};
+  result = osqp.optimize(P_sparse, A_dense_pattern, q, l_invalid, u);
+  EXPECT_NE(osqp.getExitFlag(), 0);
+  EXPECT_NE(std::get<3>(result), 1);
+  EXPECT_NE(osqp.getStatus(), 1);
+
+  // The workspace is set up again after the failure
+  result = osqp.optimize(P_sparse, A_dense_pattern, q, l, u);
+  EXPECT_EQ(osqp.getExitFlag(), 0);
+  check_result(result);
+
+  // Invalid problem size
+  EXPECT_THROW(
+    osqp.optimize(P_sparse, A_sparse, q, std::vector<double>(3, 0.0), u), std::invalid_argument);
+}
 }  // namespace
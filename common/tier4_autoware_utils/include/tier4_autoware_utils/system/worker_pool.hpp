@@ -0,0 +1,63 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__WORKER_POOL_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+// Threads kept alive between the callbacks, so that a node running its work in parallel on every
+// cycle does not create and join threads for every cycle
+class WorkerPool
+{
+public:
+  using Job = std::function<void(const size_t worker_index)>;
+
+  // The calling thread of run() is the worker 0, so thread_num - 1 threads are created
+  explicit WorkerPool(const size_t thread_num);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  size_t getThreadNum() const { return threads_.size() + 1; }
+
+  // Run the job once on every worker and wait for all of them. The job is expected to take its
+  // tasks from a shared counter. The first exception thrown by the job is rethrown.
+  void run(const Job & job);
+
+private:
+  void work(const size_t worker_index);
+
+  std::vector<std::thread> threads_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_condition_;
+  std::condition_variable finish_condition_;
+  const Job * job_{nullptr};
+  uint64_t generation_{0};
+  size_t running_num_{0};
+  std::exception_ptr exception_{nullptr};
+  bool stop_{false};
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__WORKER_POOL_HPP_
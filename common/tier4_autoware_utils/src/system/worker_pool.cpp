@@ -0,0 +1,104 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/worker_pool.hpp"
+
+namespace tier4_autoware_utils
+{
+WorkerPool::WorkerPool(const size_t thread_num)
+{
+  for (size_t i = 1; i < thread_num; i++) {
+    threads_.emplace_back([this, i]() { work(i); });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_condition_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::run(const Job & job)
+{
+  if (threads_.empty()) {
+    job(0);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    generation_++;
+    running_num_ = threads_.size();
+    exception_ = nullptr;
+  }
+  start_condition_.notify_all();
+
+  std::exception_ptr exception = nullptr;
+  try {
+    job(0);
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  finish_condition_.wait(lock, [this]() { return running_num_ == 0; });
+  job_ = nullptr;
+  if (!exception) {
+    exception = exception_;
+  }
+  lock.unlock();
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void WorkerPool::work(const size_t worker_index)
+{
+  uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_condition_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+    if (stop_) {
+      return;
+    }
+    generation = generation_;
+    const Job * job = job_;
+    lock.unlock();
+
+    std::exception_ptr exception = nullptr;
+    try {
+      (*job)(worker_index);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    lock.lock();
+    if (exception && !exception_) {
+      exception_ = exception;
+    }
+    if (--running_num_ == 0) {
+      finish_condition_.notify_one();
+    }
+  }
+}
+}  // namespace tier4_autoware_utils
@@ -0,0 +1,81 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(system, WorkerPool_run_all_workers)
+{
+  using tier4_autoware_utils::WorkerPool;
+
+  for (const size_t thread_num : {1, 2, 4}) {
+    WorkerPool pool(thread_num);
+    EXPECT_EQ(pool.getThreadNum(), thread_num);
+
+    std::vector<std::atomic<int>> call_num(thread_num);
+    pool.run([&](const size_t worker_index) { call_num.at(worker_index)++; });
+    for (const auto & num : call_num) {
+      EXPECT_EQ(num.load(), 1);
+    }
+  }
+}
+
+TEST(system, WorkerPool_shared_counter)
+{
+  using tier4_autoware_utils::WorkerPool;
+
+  WorkerPool pool(4);
+  constexpr size_t task_num = 1000;
+
+  // The pool is reused for several runs, as a node does for every callback
+  for (int i = 0; i < 10; i++) {
+    std::vector<int> done(task_num, 0);
+    std::atomic<size_t> next_index{0};
+    pool.run([&](const size_t /*worker_index*/) {
+      for (size_t j = next_index++; j < task_num; j = next_index++) {
+        done.at(j)++;
+      }
+    });
+    for (const auto d : done) {
+      EXPECT_EQ(d, 1);
+    }
+  }
+}
+
+TEST(system, WorkerPool_rethrow)
+{
+  using tier4_autoware_utils::WorkerPool;
+
+  WorkerPool pool(3);
+  EXPECT_THROW(
+    pool.run([](const size_t worker_index) {
+      if (worker_index == 2) {
+        throw std::runtime_error("worker");
+      }
+    }),
+    std::runtime_error);
+  EXPECT_THROW(
+    pool.run([](const size_t /*worker_index*/) { throw std::runtime_error("all"); }),
+    std::runtime_error);
+
+  // The pool is still usable after an exception
+  std::atomic<size_t> call_num{0};
+  pool.run([&](const size_t /*worker_index*/) { call_num++; });
+  EXPECT_EQ(call_num.load(), 3u);
+}
@@ -0,0 +1,158 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpc_lateral_controller/mpc_condensing.hpp"
+#include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_dynamics.hpp"
+#include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_kinematics.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using autoware::motion::control::mpc_lateral_controller::DynamicsBicycleModel;
+using autoware::motion::control::mpc_lateral_controller::KinematicsBicycleModel;
+using autoware::motion::control::mpc_lateral_controller::VehicleModelInterface;
+namespace MPCCondensing = autoware::motion::control::mpc_lateral_controller::MPCCondensing;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// discrete matrices of each step along a curve with the given horizon
+struct StepMatrices
+{
+  MatrixXd Ad_ex;
+  MatrixXd Bd_ex;
+  MatrixXd Wd_ex;
+  MatrixXd Cd;
+};
+
+StepMatrices generateStepMatrices(VehicleModelInterface & model, const int N)
+{
+  const int DIM_X = model.getDimX();
+  const int DIM_U = model.getDimU();
+  const int DIM_Y = model.getDimY();
+  StepMatrices s;
+  s.Ad_ex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  s.Bd_ex = MatrixXd::Zero(DIM_X * N, DIM_U);
+  s.Wd_ex = MatrixXd::Zero(DIM_X * N, 1);
+  MatrixXd Ad(DIM_X, DIM_X);
+  MatrixXd Bd(DIM_X, DIM_U);
+  MatrixXd Wd(DIM_X, 1);
+  s.Cd = MatrixXd(DIM_Y, DIM_X);
+  for (int i = 0; i < N; ++i) {
+    model.setVelocity(10.0);
+    model.setCurvature(0.01 * std::sin(0.1 * i));
+    model.calculateDiscreteMatrix(Ad, Bd, s.Cd, Wd, 0.1);
+    s.Ad_ex.block(i * DIM_X, 0, DIM_X, DIM_X) = Ad;
+    s.Bd_ex.block(i * DIM_X, 0, DIM_X, DIM_U) = Bd;
+    s.Wd_ex.block(i * DIM_X, 0, DIM_X, 1) = Wd;
+  }
+  return s;
+}
+
+void benchmark(const std::string & name, VehicleModelInterface & model)
+{
+  const int DIM_X = model.getDimX();
+  const int DIM_U = model.getDimU();
+  const int DIM_Y = model.getDimY();
+  constexpr int iterations = 20;
+
+  std::cout << "# " << name << std::endl;
+  std::cout << "horizon, dense [ms], condensing [ms], max error" << std::endl;
+  for (const int N : {25, 50, 100, 200, 400}) {
+    const auto s = generateStepMatrices(model, N);
+    const VectorXd x0 = VectorXd::Constant(DIM_X, 0.1);
+
+    // dense: the matrices are allocated every cycle and the cost is calculated with full products
+    MatrixXd H_dense;
+    MatrixXd f_dense;
+    const auto dense_start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+      MatrixXd Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
+      MatrixXd Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
+      MatrixXd Wex = MatrixXd::Zero(DIM_X * N, 1);
+      MatrixXd Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
+      MatrixXd Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+      for (int i = 0; i < N; ++i) {
+        const MatrixXd Ad = s.Ad_ex.block(i * DIM_X, 0, DIM_X, DIM_X);
+        if (i == 0) {
+          Aex.block(0, 0, DIM_X, DIM_X) = Ad;
+          Wex.block(0, 0, DIM_X, 1) = s.Wd_ex.block(0, 0, DIM_X, 1);
+        } else {
+          Aex.block(i * DIM_X, 0, DIM_X, DIM_X) = Ad * Aex.block((i - 1) * DIM_X, 0, DIM_X, DIM_X);
+          for (int j = 0; j < i; ++j) {
+            Bex.block(i * DIM_X, j * DIM_U, DIM_X, DIM_U) =
+              Ad * Bex.block((i - 1) * DIM_X, j * DIM_U, DIM_X, DIM_U);
+          }
+          Wex.block(i * DIM_X, 0, DIM_X, 1) =
+            Ad * Wex.block((i - 1) * DIM_X, 0, DIM_X, 1) + s.Wd_ex.block(i * DIM_X, 0, DIM_X, 1);
+        }
+        Bex.block(i * DIM_X, i * DIM_U, DIM_X, DIM_U) = s.Bd_ex.block(i * DIM_X, 0, DIM_X, DIM_U);
+        Cex.block(i * DIM_Y, i * DIM_X, DIM_Y, DIM_X) = s.Cd;
+        Qex.block(i * DIM_Y, i * DIM_Y, DIM_Y, DIM_Y) = MatrixXd::Identity(DIM_Y, DIM_Y);
+      }
+      const MatrixXd CB = Cex * Bex;
+      const MatrixXd QCB = Qex * CB;
+      H_dense = MatrixXd::Zero(DIM_U * N, DIM_U * N);
+      H_dense.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
+      H_dense.triangularView<Eigen::Lower>() = H_dense.transpose();
+      f_dense = (Cex * (Aex * x0 + Wex)).transpose() * QCB;
+    }
+    const auto dense_end = std::chrono::steady_clock::now();
+
+    // condensing: the matrices are reused and the cost is condensed with the block structure
+    MatrixXd Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
+    MatrixXd Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
+    MatrixXd Wex = MatrixXd::Zero(DIM_X * N, 1);
+    MatrixXd Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
+    MatrixXd Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+    MPCCondensing::CondensingWorkspace workspace;
+    const auto condensing_start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+      for (int i = 0; i < N; ++i) {
+        Bex.block(i * DIM_X, i * DIM_U, DIM_X, DIM_U) = s.Bd_ex.block(i * DIM_X, 0, DIM_X, DIM_U);
+        Cex.block(i * DIM_Y, i * DIM_X, DIM_Y, DIM_X) = s.Cd;
+        Qex.block(i * DIM_Y, i * DIM_Y, DIM_Y, DIM_Y) = MatrixXd::Identity(DIM_Y, DIM_Y);
+      }
+      Wex = s.Wd_ex;
+      MPCCondensing::calcPredictionMatrix(DIM_X, DIM_U, s.Ad_ex, Aex, Bex, Wex);
+      MPCCondensing::calcCondensedCost(
+        DIM_X, DIM_U, DIM_Y, s.Ad_ex, Aex, Bex, Wex, Cex, Qex, x0, workspace);
+    }
+    const auto condensing_end = std::chrono::steady_clock::now();
+
+    const auto to_ms = [&](const auto start, const auto end) {
+      return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    };
+    const double error = std::max(
+      (workspace.H - H_dense).cwiseAbs().maxCoeff(), (workspace.f - f_dense).cwiseAbs().maxCoeff());
+    std::cout << N << ", " << to_ms(dense_start, dense_end) << ", "
+              << to_ms(condensing_start, condensing_end) << ", " << error << std::endl;
+  }
+}
+
+int main()
+{
+  KinematicsBicycleModel kinematics(2.7, 0.6, 0.27);
+  benchmark("kinematics", kinematics);
+
+  DynamicsBicycleModel dynamics(2.7, 600.0, 600.0, 500.0, 500.0, 155494.663, 155494.663);
+  benchmark("dynamics", dynamics);
+
+  return 0;
+}
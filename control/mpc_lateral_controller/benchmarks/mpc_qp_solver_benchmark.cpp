@@ -0,0 +1,260 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compare the QP solvers of the MPC on the problems along a velocity and curvature profile.
+// The profile is read from a csv file of "velocity,curvature" lines, e.g. exported from a recorded
+// trajectory, or a synthetic S-curve is used without the argument.
+//   usage: mpc_qp_solver_benchmark [profile.csv]
+
+#include "mpc_lateral_controller/mpc_condensing.hpp"
+#include "mpc_lateral_controller/qp_solver/qp_solver_osqp.hpp"
+#include "mpc_lateral_controller/qp_solver/qp_solver_riccati.hpp"
+#include "mpc_lateral_controller/qp_solver/qp_solver_unconstraint_fast.hpp"
+#include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_kinematics.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::motion::control::mpc_lateral_controller::KinematicsBicycleModel;
+using autoware::motion::control::mpc_lateral_controller::QPSolverEigenLeastSquareLLT;
+using autoware::motion::control::mpc_lateral_controller::QPSolverInterface;
+using autoware::motion::control::mpc_lateral_controller::QPSolverOSQP;
+using autoware::motion::control::mpc_lateral_controller::QPSolverRiccati;
+namespace MPCCondensing = autoware::motion::control::mpc_lateral_controller::MPCCondensing;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+constexpr double dt = 0.1;
+constexpr double ctrl_period = 0.03;
+constexpr double steer_lim = 0.61;
+constexpr double steer_rate_lim = 20.0 * M_PI / 180.0;
+
+// velocity and curvature of each point
+using Profile = std::vector<std::pair<double, double>>;
+
+Profile loadProfile(const std::string & path)
+{
+  Profile profile;
+  std::ifstream ifs(path);
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream iss(line);
+    double v = 0.0;
+    double k = 0.0;
+    if (iss >> v >> k) {
+      profile.emplace_back(v, k);
+    }
+  }
+  return profile;
+}
+
+Profile generateProfile(const int size)
+{
+  Profile profile;
+  for (int i = 0; i < size; ++i) {
+    profile.emplace_back(8.0 + 2.0 * std::sin(0.01 * i), 0.05 * std::sin(0.03 * i));
+  }
+  return profile;
+}
+
+// the MPC problem of the window starting from the given index with the weights of the default
+struct Problem
+{
+  MatrixXd Ad_ex;
+  MatrixXd Bd_ex;
+  MatrixXd Wd_ex;
+  MatrixXd Aex;
+  MatrixXd Bex;
+  MatrixXd Wex;
+  MatrixXd Cex;
+  MatrixXd Qex;
+  MatrixXd R;
+  MatrixXd r;
+  VectorXd x0;
+  MatrixXd A;
+  // R and A in the sparse form, as the MPC passes them to the multi-stage solver
+  Eigen::SparseMatrix<double, Eigen::RowMajor> R_sparse;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> A_sparse;
+  VectorXd lb;
+  VectorXd ub;
+  VectorXd lbA;
+  VectorXd ubA;
+};
+
+Problem generateProblem(
+  KinematicsBicycleModel & model, const Profile & profile, const size_t start, const int N)
+{
+  const int DIM_X = model.getDimX();
+  const int DIM_U = model.getDimU();
+  const int DIM_Y = model.getDimY();
+
+  Problem p;
+  p.Ad_ex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  p.Bd_ex = MatrixXd::Zero(DIM_X * N, DIM_U);
+  p.Wd_ex = MatrixXd::Zero(DIM_X * N, 1);
+  p.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  p.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
+  p.Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
+  p.Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+  p.R = MatrixXd::Zero(DIM_U * N, DIM_U * N);
+  VectorXd u_ref(DIM_U * N);
+
+  MatrixXd Ad(DIM_X, DIM_X);
+  MatrixXd Bd(DIM_X, DIM_U);
+  MatrixXd Wd(DIM_X, 1);
+  MatrixXd Cd(DIM_Y, DIM_X);
+  MatrixXd Uref(DIM_U, 1);
+  for (int i = 0; i < N; ++i) {
+    const auto [v, k] = profile.at(std::min(start + i, profile.size() - 1));
+    model.setVelocity(v);
+    model.setCurvature(k);
+    model.calculateDiscreteMatrix(Ad, Bd, Cd, Wd, dt);
+    model.calculateReferenceInput(Uref);
+    p.Ad_ex.block(i * DIM_X, 0, DIM_X, DIM_X) = Ad;
+    p.Bd_ex.block(i * DIM_X, 0, DIM_X, DIM_U) = Bd;
+    p.Wd_ex.block(i * DIM_X, 0, DIM_X, 1) = Wd;
+    p.Bex.block(i * DIM_X, i * DIM_U, DIM_X, DIM_U) = Bd;
+    p.Cex.block(i * DIM_Y, i * DIM_X, DIM_Y, DIM_X) = Cd;
+    p.Qex(i * DIM_Y, i * DIM_Y) = i == N - 1 ? 1.0 : 0.1;
+    p.Qex(i * DIM_Y + 1, i * DIM_Y + 1) = (i == N - 1 ? 0.1 : 0.0) + 0.3 * v * v;
+    p.R(i, i) = 1.0 + 0.25 * v * v;
+    u_ref(i) = Uref(0, 0);
+  }
+  p.r = -(u_ref.transpose() * p.R).transpose();
+  p.Wex = p.Wd_ex;
+  MPCCondensing::calcPredictionMatrix(DIM_X, DIM_U, p.Ad_ex, p.Aex, p.Bex, p.Wex);
+
+  // steering acceleration weight
+  const double steer_acc_r = 1.0e-6 / std::pow(dt, 4);
+  const Eigen::Matrix3d D =
+    steer_acc_r * (Eigen::Matrix3d() << 1.0, -2.0, 1.0, -2.0, 4.0, -2.0, 1.0, -2.0, 1.0).finished();
+  for (int i = 1; i < N - 1; ++i) {
+    p.R.block(i - 1, i - 1, 3, 3) += D;
+  }
+
+  const double steer0 = std::atan(profile.at(start).second * 2.7);
+  p.x0 = VectorXd::Zero(DIM_X);
+  p.x0(0) = 0.3 * std::sin(0.05 * static_cast<double>(start));  // lateral error
+  p.x0(2) = steer0;
+
+  p.A = MatrixXd::Identity(DIM_U * N, DIM_U * N);
+  for (int i = 1; i < DIM_U * N; ++i) {
+    p.A(i, i - 1) = -1.0;
+  }
+  p.R_sparse = p.R.sparseView();
+  p.A_sparse = p.A.sparseView();
+  p.lb = VectorXd::Constant(DIM_U * N, -steer_lim);
+  p.ub = VectorXd::Constant(DIM_U * N, steer_lim);
+  p.ubA = VectorXd::Constant(DIM_U * N, steer_rate_lim * dt);
+  p.lbA = -p.ubA;
+  p.ubA(0) = steer0 + steer_rate_lim * ctrl_period;
+  p.lbA(0) = steer0 - steer_rate_lim * ctrl_period;
+  return p;
+}
+
+// solve the condensed problem, including the condensing as the MPC does
+bool solveCondensed(
+  QPSolverInterface & solver, const Problem & p, const int DIM_X, const int DIM_Y,
+  MPCCondensing::CondensingWorkspace & ws, VectorXd & u)
+{
+  MPCCondensing::calcCondensedCost(
+    DIM_X, 1, DIM_Y, p.Ad_ex, p.Aex, p.Bex, p.Wex, p.Cex, p.Qex, p.x0, ws);
+  ws.H += p.R;
+  ws.f += p.r.transpose();
+  return solver.solve(ws.H, ws.f.transpose(), p.A, p.lb, p.ub, p.lbA, p.ubA, u);
+}
+
+bool solveMultiStage(
+  QPSolverInterface & solver, const Problem & p, const int DIM_X, const int DIM_Y,
+  MPCCondensing::CondensingWorkspace & ws, VectorXd & u)
+{
+  MPCCondensing::calcStateWeight(DIM_X, DIM_Y, p.Cex, p.Qex, ws.Qbar);
+  return solver.solveMultiStage(
+    p.Ad_ex, p.Bd_ex, p.Wd_ex, ws.Qbar, p.x0, p.R_sparse, p.r, p.A_sparse, p.lb, p.ub, p.lbA,
+    p.ubA, u);
+}
+
+int main(int argc, char ** argv)
+{
+  const Profile profile = argc > 1 ? loadProfile(argv[1]) : generateProfile(2000);
+  if (profile.empty()) {
+    std::cerr << "failed to load the profile: " << argv[1] << std::endl;
+    return 1;
+  }
+
+  KinematicsBicycleModel model(2.7, steer_lim, 0.27);
+  const int DIM_X = model.getDimX();
+  const int DIM_Y = model.getDimY();
+  const auto logger = rclcpp::get_logger("mpc_qp_solver_benchmark");
+  constexpr size_t num_problems = 20;
+
+  std::cout << "horizon, unconstraint_fast [ms], osqp [ms], riccati [ms], riccati iterations, "
+               "max |u_riccati - u_osqp|"
+            << std::endl;
+  for (const int N : {25, 50, 100, 200, 400}) {
+    const size_t stride = std::max<size_t>(profile.size() / num_problems, 1);
+    std::vector<Problem> problems;
+    for (size_t start = 0; start < profile.size() && problems.size() < num_problems;
+         start += stride) {
+      problems.push_back(generateProblem(model, profile, start, N));
+    }
+
+    QPSolverEigenLeastSquareLLT llt;
+    QPSolverOSQP osqp(logger);
+    QPSolverRiccati riccati(logger);
+    MPCCondensing::CondensingWorkspace ws;
+    double time_llt = 0.0;
+    double time_osqp = 0.0;
+    double time_riccati = 0.0;
+    double error = 0.0;
+    int64_t iterations = 0;
+    for (const auto & p : problems) {
+      VectorXd u_llt;
+      VectorXd u_osqp;
+      VectorXd u_riccati;
+      const auto t0 = std::chrono::steady_clock::now();
+      solveCondensed(llt, p, DIM_X, DIM_Y, ws, u_llt);
+      const auto t1 = std::chrono::steady_clock::now();
+      const bool osqp_solved = solveCondensed(osqp, p, DIM_X, DIM_Y, ws, u_osqp);
+      const auto t2 = std::chrono::steady_clock::now();
+      const bool riccati_solved = solveMultiStage(riccati, p, DIM_X, DIM_Y, ws, u_riccati);
+      const auto t3 = std::chrono::steady_clock::now();
+
+      time_llt += std::chrono::duration<double, std::milli>(t1 - t0).count();
+      time_osqp += std::chrono::duration<double, std::milli>(t2 - t1).count();
+      time_riccati += std::chrono::duration<double, std::milli>(t3 - t2).count();
+      iterations = std::max(iterations, riccati.getTakenIter());
+      if (osqp_solved && riccati_solved) {
+        error = std::max(error, (u_riccati - u_osqp).lpNorm<Eigen::Infinity>());
+      }
+    }
+
+    const double num = static_cast<double>(problems.size());
+    std::cout << N << ", " << time_llt / num << ", " << time_osqp / num << ", "
+              << time_riccati / num << ", " << iterations << ", " << error << std::endl;
+  }
+
+  return 0;
+}
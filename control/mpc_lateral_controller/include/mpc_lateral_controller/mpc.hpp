@@ -16,6 +16,7 @@
 #define MPC_LATERAL_CONTROLLER__MPC_HPP_
 
 #include "mpc_lateral_controller/lowpass_filter.hpp"
+#include "mpc_lateral_controller/mpc_condensing.hpp"
 #include "mpc_lateral_controller/mpc_trajectory.hpp"
 #include "mpc_lateral_controller/qp_solver/qp_solver_interface.hpp"
 #include "mpc_lateral_controller/steering_predictor.hpp"
@@ -47,6 +48,7 @@ using tier4_debug_msgs::msg::Float32MultiArrayStamped;
 
 using Eigen::MatrixXd;
 using Eigen::VectorXd;
+using SparseMatrixXd = Eigen::SparseMatrix<double, Eigen::RowMajor>;
 
 // Weight factors used in Model Predictive Control
 struct MPCWeight
@@ -174,16 +176,21 @@ struct MPCData
  * Xex = Aex * X0 + Bex * Uex * Wex
  * Yex = Cex * Xex
  * Cost = Xex' * Qex * Xex + (Uex - Uref_ex)' * R1ex * (Uex - Uref_ex) +  Uex' * R2ex * Uex
+ * Ad_ex is the discrete state matrix Ad of each step stacked vertically, which is used to condense
+ * the cost with the structure of the prediction matrices. R1ex and R2ex are banded and kept sparse.
  */
 struct MPCMatrix
 {
+  MatrixXd Ad_ex;  // Ad of each step, stacked vertically
+  MatrixXd Bd_ex;  // Bd of each step, stacked vertically
+  MatrixXd Wd_ex;  // Wd of each step, stacked vertically
   MatrixXd Aex;
   MatrixXd Bex;
   MatrixXd Wex;
   MatrixXd Cex;
   MatrixXd Qex;
-  MatrixXd R1ex;
-  MatrixXd R2ex;
+  SparseMatrixXd R1ex;
+  SparseMatrixXd R2ex;
   MatrixXd Uref_ex;
 
   MPCMatrix() = default;
@@ -222,6 +229,11 @@ private:
   double m_min_prediction_length = 5.0;  // Minimum prediction distance.
 
   rclcpp::Publisher<Trajectory>::SharedPtr m_debug_frenet_predicted_trajectory_pub;
+
+  // Workspaces reused across the control cycles to avoid the allocation of the large matrices.
+  MPCMatrix m_mpc_matrix;
+  MPCCondensing::CondensingWorkspace m_condensing_workspace;
+
   /**
    * @brief Get variables for MPC calculation.
    * @param trajectory The reference trajectory.
@@ -254,9 +266,9 @@ private:
    * @brief Generate the MPC matrix using the reference trajectory and vehicle model.
    * @param reference_trajectory The reference trajectory used for linearization.
    * @param prediction_dt The prediction time step.
-   * @return The generated MPC matrix.
+   * @return The generated MPC matrix, which is stored in the workspace of this class.
    */
-  MPCMatrix generateMPCMatrix(
+  const MPCMatrix & generateMPCMatrix(
     const MPCTrajectory & reference_trajectory, const double prediction_dt);
 
   /**
@@ -310,7 +322,7 @@ private:
    * @param prediction_dt The prediction time step.
    * @param R The R matrix to modify.
    */
-  void addSteerWeightR(const double prediction_dt, MatrixXd & R) const;
+  void addSteerWeightR(const double prediction_dt, SparseMatrixXd & R) const;
 
   /**
    * @brief Add weights related to lateral jerk, steering rate, and steering acceleration to the f
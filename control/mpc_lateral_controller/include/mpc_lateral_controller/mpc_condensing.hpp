@@ -0,0 +1,93 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MPC_LATERAL_CONTROLLER__MPC_CONDENSING_HPP_
+#define MPC_LATERAL_CONTROLLER__MPC_CONDENSING_HPP_
+
+#include <Eigen/Core>
+
+namespace autoware::motion::control::mpc_lateral_controller
+{
+namespace MPCCondensing
+{
+
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+/**
+ * @brief buffers of the condensing, which are reused across the control cycles to avoid the
+ * allocation as long as the horizon and the vehicle model do not change
+ */
+struct CondensingWorkspace
+{
+  MatrixXd Qbar;  // C' * Q * C of each step, stacked vertically
+  MatrixXd P;     // state cost of each step accumulated backward from the terminal step
+  MatrixXd BtP;   // B' * P of each step, stacked vertically
+  MatrixXd e;     // free response of the state: Aex * x0 + Wex
+  MatrixXd g;     // gradient of the state cost accumulated backward from the terminal step
+  MatrixXd H;     // condensed hessian of the state cost
+  MatrixXd f;     // condensed gradient of the state cost (row vector)
+};
+
+/**
+ * @brief propagate the discrete dynamics of each step over the horizon to get the prediction
+ * matrices of Xex = Aex * x0 + Bex * Uex + Wex. The vehicle models with known dimensions are
+ * computed with compile-time-sized blocks, and only the lower triangular blocks of Bex are written.
+ * @param [in] dim_x dimension of state x
+ * @param [in] dim_u dimension of input u
+ * @param [in] Ad_ex Ad of each step, stacked vertically
+ * @param [out] Aex prediction matrix of the initial state
+ * @param [inout] Bex prediction matrix of the input, whose diagonal blocks are Bd of each step
+ * @param [inout] Wex prediction matrix of the disturbance, which is Wd of each step on input
+ */
+void calcPredictionMatrix(
+  const int dim_x, const int dim_u, const MatrixXd & Ad_ex, MatrixXd & Aex, MatrixXd & Bex,
+  MatrixXd & Wex);
+
+/**
+ * @brief calculate the weight of the state of each step Cd' * Q * Cd from the block diagonal Cex
+ * and Qex
+ * @param [in] dim_x dimension of state x
+ * @param [in] dim_y dimension of output y
+ * @param [in] Cex block diagonal output matrix
+ * @param [in] Qex block diagonal weight of the output
+ * @param [out] Qbar weight of the state of each step, stacked vertically
+ */
+void calcStateWeight(
+  const int dim_x, const int dim_y, const MatrixXd & Cex, const MatrixXd & Qex, MatrixXd & Qbar);
+
+/**
+ * @brief condense the state cost Yex' * Qex * Yex (Yex = Cex * Xex) into the input space as
+ * 1/2 * Uex' * H * Uex + f * Uex with the backward recursion on the block structure, which costs
+ * O(N^2) blocks instead of the O(N^3) dense products of (Cex * Bex)' * Qex * (Cex * Bex).
+ * @param [in] dim_x dimension of state x
+ * @param [in] dim_u dimension of input u
+ * @param [in] dim_y dimension of output y
+ * @param [in] Ad_ex Ad of each step, stacked vertically
+ * @param [in] Aex prediction matrix of the initial state
+ * @param [in] Bex prediction matrix of the input
+ * @param [in] Wex prediction matrix of the disturbance
+ * @param [in] Cex block diagonal output matrix
+ * @param [in] Qex block diagonal weight of the output
+ * @param [in] x0 initial state
+ * @param [inout] workspace buffers of the condensing. The results are written to H and f.
+ */
+void calcCondensedCost(
+  const int dim_x, const int dim_u, const int dim_y, const MatrixXd & Ad_ex, const MatrixXd & Aex,
+  const MatrixXd & Bex, const MatrixXd & Wex, const MatrixXd & Cex, const MatrixXd & Qex,
+  const VectorXd & x0, CondensingWorkspace & workspace);
+
+}  // namespace MPCCondensing
+}  // namespace autoware::motion::control::mpc_lateral_controller
+#endif  // MPC_LATERAL_CONTROLLER__MPC_CONDENSING_HPP_
@@ -16,6 +16,7 @@
 #define MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_INTERFACE_HPP_
 
 #include <Eigen/Core>
+#include <Eigen/Sparse>
 
 namespace autoware::motion::control::mpc_lateral_controller
 {
@@ -46,6 +47,44 @@ public:
     const Eigen::VectorXd & lb, const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a,
     const Eigen::VectorXd & ub_a, Eigen::VectorXd & u) = 0;
 
+  /**
+   * @brief whether the solver takes the problem in the multi-stage form with solveMultiStage()
+   */
+  virtual bool isMultiStage() const { return false; }
+
+  /**
+   * @brief solve QP problem in the multi-stage form, where the state of each stage is kept in the
+   * problem instead of being condensed into the input:
+   * minimize J = sum_i 1/2 * x(i+1)' * q_ex(i) * x(i+1) + 1/2 * u' * r_mat * u + r_vec' * u
+   * subject to x(i+1) = a_ex(i) * x(i) + b_ex(i) * u(i) + w_ex(i), x(0) = x0
+   * @param [in] a_ex state matrix of each stage, stacked vertically
+   * @param [in] b_ex input matrix of each stage, stacked vertically
+   * @param [in] w_ex disturbance of each stage, stacked vertically
+   * @param [in] q_ex weight of the state of each stage, stacked vertically
+   * @param [in] x0 initial state
+   * @param [in] r_mat weight of the input, which is assumed to be banded. It is sparse so that
+   * the problem is passed without the dense matrices of the horizon squared.
+   * @param [in] r_vec linear term of the input
+   * @param [in] a sparse parameter matrix for constraint lb_a < a*u < ub_a, assumed to be banded
+   * @param [in] lb parameter matrix for constraint lb < u < ub
+   * @param [in] ub parameter matrix for constraint lb < u < ub
+   * @param [in] lb_a parameter matrix for constraint lb_a < a*u < ub_a
+   * @param [in] ub_a parameter matrix for constraint lb_a < a*u < ub_a
+   * @param [out] u optimal variable vector
+   * @return true if the problem was solved
+   */
+  virtual bool solveMultiStage(
+    const Eigen::MatrixXd & /*a_ex*/, const Eigen::MatrixXd & /*b_ex*/,
+    const Eigen::MatrixXd & /*w_ex*/, const Eigen::MatrixXd & /*q_ex*/,
+    const Eigen::VectorXd & /*x0*/,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor> & /*r_mat*/,
+    const Eigen::MatrixXd & /*r_vec*/, const Eigen::SparseMatrix<double, Eigen::RowMajor> & /*a*/,
+    const Eigen::VectorXd & /*lb*/, const Eigen::VectorXd & /*ub*/,
+    const Eigen::VectorXd & /*lb_a*/, const Eigen::VectorXd & /*ub_a*/, Eigen::VectorXd & /*u*/)
+  {
+    return false;
+  }
+
   virtual int64_t getTakenIter() const { return 0; }
   virtual double getRunTime() const { return 0.0; }
   virtual double getObjVal() const { return 0.0; }
@@ -0,0 +1,106 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_RICCATI_HPP_
+#define MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_RICCATI_HPP_
+
+#include "mpc_lateral_controller/qp_solver/qp_solver_interface.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include <Eigen/Core>
+
+namespace autoware::motion::control::mpc_lateral_controller
+{
+
+/**
+ * Solver for QP problems using a primal-dual interior point method (Mehrotra predictor-corrector).
+ * In the multi-stage form, the newton step of each iteration is solved with the Riccati recursion
+ * over the stages, so that the computational cost is linear in the prediction horizon instead of
+ * cubic for the condensed problem. The band of the input weight and the constraint matrix (e.g.
+ * the steering rate weight and limit) is carried by the previous inputs appended to the state.
+ * Both are taken as the sparse matrices, and only their nonzeros are read.
+ */
+class QPSolverRiccati : public QPSolverInterface
+{
+public:
+  /**
+   * @brief buffers of the Riccati recursion, which are reused across the control cycles to avoid
+   * the allocation as long as the horizon and the vehicle model do not change
+   */
+  struct Workspace
+  {
+    Eigen::MatrixXd r_band;  // lower band of the input weight: (i, k) block is r_mat(i, i - k)
+    Eigen::MatrixXd m_band;  // lower band of the input weight with the barrier of the constraints
+    Eigen::MatrixXd p;       // cost-to-go of the augmented state of each stage, stacked vertically
+    Eigen::MatrixXd k;       // feedback gain of each stage, stacked vertically
+    Eigen::MatrixXd r_inv;   // inverse of the input hessian of each stage, stacked vertically
+    Eigen::MatrixXd d;       // feedforward of each stage, stacked vertically
+    Eigen::MatrixXd x;       // state of each stage, stacked vertically
+  };
+
+  /**
+   * @brief constructor
+   */
+  explicit QPSolverRiccati(const rclcpp::Logger & logger);
+
+  /**
+   * @brief destructor
+   */
+  ~QPSolverRiccati() = default;
+
+  /**
+   * @brief solve the condensed QP problem : minimize j = 1/2 * u' * h_mat * u + f_vec' * u
+   * The newton step is solved with the dense Cholesky decomposition.
+   * @param [in] h_mat parameter matrix in object function
+   * @param [in] f_vec parameter matrix in object function
+   * @param [in] a parameter matrix for constraint lb_a < a*u < ub_a
+   * @param [in] lb parameter matrix for constraint lb < U < ub
+   * @param [in] ub parameter matrix for constraint lb < U < ub
+   * @param [in] lb_a parameter matrix for constraint lb_a < a*u < ub_a
+   * @param [in] ub_a parameter matrix for constraint lb_a < a*u < ub_a
+   * @param [out] u optimal variable vector
+   * @return true if the problem was solved
+   */
+  bool solve(
+    const Eigen::MatrixXd & h_mat, const Eigen::MatrixXd & f_vec, const Eigen::MatrixXd & a,
+    const Eigen::VectorXd & lb, const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a,
+    const Eigen::VectorXd & ub_a, Eigen::VectorXd & u) override;
+
+  bool isMultiStage() const override { return true; }
+
+  /**
+   * @brief solve the QP problem in the multi-stage form. See QPSolverInterface for the problem.
+   * The newton step is solved with the Riccati recursion.
+   */
+  bool solveMultiStage(
+    const Eigen::MatrixXd & a_ex, const Eigen::MatrixXd & b_ex, const Eigen::MatrixXd & w_ex,
+    const Eigen::MatrixXd & q_ex, const Eigen::VectorXd & x0,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor> & r_mat, const Eigen::MatrixXd & r_vec,
+    const Eigen::SparseMatrix<double, Eigen::RowMajor> & a, const Eigen::VectorXd & lb,
+    const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a, const Eigen::VectorXd & ub_a,
+    Eigen::VectorXd & u) override;
+
+  int64_t getTakenIter() const override { return iter_; }
+  double getRunTime() const override { return run_time_; }
+  double getObjVal() const override { return obj_val_; }
+
+private:
+  Workspace ws_;
+  rclcpp::Logger logger_;
+  int64_t iter_{0};
+  double run_time_{0.0};
+  double obj_val_{0.0};
+};
+}  // namespace autoware::motion::control::mpc_lateral_controller
+#endif  // MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_RICCATI_HPP_
@@ -74,7 +74,7 @@ bool MPC::calculateMPC(
   }
 
   // generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex
-  const auto mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
+  const auto & mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
 
   // solve Optimization problem
   const auto [success_opt, Uex] = executeOptimization(
@@ -408,7 +408,7 @@ MPCTrajectory MPC::applyVelocityDynamicsFilter(
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Uref_ex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCMatrix MPC::generateMPCMatrix(
+const MPCMatrix & MPC::generateMPCMatrix(
   const MPCTrajectory & reference_trajectory, const double prediction_dt)
 {
   const int N = m_param.prediction_horizon;
@@ -417,15 +417,28 @@ MPCMatrix MPC::generateMPCMatrix(
   const int DIM_U = m_vehicle_model_ptr->getDimU();
   const int DIM_Y = m_vehicle_model_ptr->getDimY();
 
-  MPCMatrix m;
-  m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
-  m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
-  m.Wex = MatrixXd::Zero(DIM_X * N, 1);
-  m.Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  m.Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
-  m.R1ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.R2ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.Uref_ex = MatrixXd::Zero(DIM_U * N, 1);
+  // The matrices are reused across the control cycles. They are cleared only when the size
+  // changes since the blocks other than the ones written below are always zero.
+  MPCMatrix & m = m_mpc_matrix;
+  const auto resize = [](MatrixXd & mat, const int rows, const int cols) {
+    if (mat.rows() != rows || mat.cols() != cols) {
+      mat.setZero(rows, cols);
+    }
+  };
+  resize(m.Ad_ex, DIM_X * N, DIM_X);
+  resize(m.Bd_ex, DIM_X * N, DIM_U);
+  resize(m.Wd_ex, DIM_X * N, 1);
+  resize(m.Aex, DIM_X * N, DIM_X);
+  resize(m.Bex, DIM_X * N, DIM_U * N);
+  resize(m.Wex, DIM_X * N, 1);
+  resize(m.Cex, DIM_Y * N, DIM_X * N);
+  resize(m.Qex, DIM_Y * N, DIM_Y * N);
+  resize(m.Uref_ex, DIM_U * N, 1);
+  // the weights are banded: the diagonal blocks and the steering rate and acceleration terms
+  m.R1ex.resize(DIM_U * N, DIM_U * N);
+  m.R1ex.reserve(Eigen::VectorXi::Constant(DIM_U * N, DIM_U + 4));
+  m.R2ex.resize(DIM_U * N, DIM_U * N);
+  m.R2ex.reserve(Eigen::VectorXi::Constant(DIM_U * N, 3));
 
   // weight matrix depends on the vehicle model
   MatrixXd Q = MatrixXd::Zero(DIM_Y, DIM_Y);
@@ -470,28 +483,21 @@ MPCMatrix MPC::generateMPCMatrix(
     Q_adaptive(1, 1) += ref_vx_squared * mpc_weight.heading_error_squared_vel;
     R_adaptive(0, 0) += ref_vx_squared * mpc_weight.steering_input_squared_vel;
 
-    // update mpc matrix
+    // update mpc matrix of each step. Aex, Wex and Bex are propagated over the horizon later.
     int idx_x_i = i * DIM_X;
-    int idx_x_i_prev = (i - 1) * DIM_X;
     int idx_u_i = i * DIM_U;
     int idx_y_i = i * DIM_Y;
-    if (i == 0) {
-      m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
-      m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
-      m.Wex.block(0, 0, DIM_X, 1) = Wd;
-    } else {
-      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int j = 0; j < i; ++j) {
-        int idx_u_j = j * DIM_U;
-        m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) =
-          Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
-      }
-      m.Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
-    }
+    m.Ad_ex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad;
+    m.Bd_ex.block(idx_x_i, 0, DIM_X, DIM_U) = Bd;
+    m.Wd_ex.block(idx_x_i, 0, DIM_X, 1) = Wd;
     m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
     m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
     m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
-    m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
+    for (int r = 0; r < DIM_U; ++r) {
+      for (int c = 0; c < DIM_U; ++c) {
+        m.R1ex.coeffRef(idx_u_i + r, idx_u_i + c) = R_adaptive(r, c);
+      }
+    }
 
     // get reference input (feed-forward)
     m_vehicle_model_ptr->setCurvature(ref_smooth_k);
@@ -502,16 +508,24 @@ MPCMatrix MPC::generateMPCMatrix(
     m.Uref_ex.block(i * DIM_U, 0, DIM_U, 1) = Uref;
   }
 
+  // predict dynamics: Aex, Wex and the lower triangular blocks of Bex
+  m.Wex = m.Wd_ex;
+  MPCCondensing::calcPredictionMatrix(DIM_X, DIM_U, m.Ad_ex, m.Aex, m.Bex, m.Wex);
+
   // add lateral jerk : weight for (v * {u(i) - u(i-1)} )^2
   for (int i = 0; i < N - 1; ++i) {
     const double ref_vx = reference_trajectory.vx.at(i);
     const double ref_k = reference_trajectory.k.at(i) * sign_vx;
     const double j = ref_vx * ref_vx * getWeight(ref_k).lat_jerk / (DT * DT);
-    const Eigen::Matrix2d J = (Eigen::Matrix2d() << j, -j, -j, j).finished();
-    m.R2ex.block(i, i, 2, 2) += J;
+    m.R2ex.coeffRef(i, i) += j;
+    m.R2ex.coeffRef(i, i + 1) -= j;
+    m.R2ex.coeffRef(i + 1, i) -= j;
+    m.R2ex.coeffRef(i + 1, i + 1) += j;
   }
 
   addSteerWeightR(prediction_dt, m.R1ex);
+  m.R1ex.makeCompressed();
+  m.R2ex.makeCompressed();
 
   return m;
 }
@@ -549,24 +563,43 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
     return {false, {}};
   }
 
-  const int DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
+  const int DIM_X = m_vehicle_model_ptr->getDimX();
+  const int DIM_U = m_vehicle_model_ptr->getDimU();
+  const int DIM_Y = m_vehicle_model_ptr->getDimY();
+  const int DIM_U_N = m_param.prediction_horizon * DIM_U;
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for
-  // a good way.  //NOLINT
-  MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
-  H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
-  H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
+  // The state cost is condensed with the block structure of the prediction matrices instead of
+  // the dense products, which are heavy for the long horizon. The multi-stage solver takes the
+  // state cost of each step as it is and the banded input weight as the sparse matrix, so that
+  // no dense matrix of the horizon squared is made for it.
+  auto & ws = m_condensing_workspace;
+  const bool is_multi_stage = m_qpsolver_ptr->isMultiStage();
+  SparseMatrixXd R;
+  if (is_multi_stage) {
+    MPCCondensing::calcStateWeight(DIM_X, DIM_Y, m.Cex, m.Qex, ws.Qbar);
+    R = m.R1ex + m.R2ex;
+    ws.f.noalias() = -m.Uref_ex.transpose() * m.R1ex;
+  } else {
+    MPCCondensing::calcCondensedCost(
+      DIM_X, DIM_U, DIM_Y, m.Ad_ex, m.Aex, m.Bex, m.Wex, m.Cex, m.Qex, x0, ws);
+    ws.H += m.R1ex;
+    ws.H += m.R2ex;
+    ws.f.noalias() -= m.Uref_ex.transpose() * m.R1ex;
+  }
+  MatrixXd & f = ws.f;
   addSteerWeightF(prediction_dt, f);
 
-  MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
-  for (int i = 1; i < DIM_U_N; i++) {
-    A(i, i - 1) = -1.0;
+  // steering rate: A = [1, 0, ...; -1, 1, 0, ...; ...]
+  SparseMatrixXd A(DIM_U_N, DIM_U_N);
+  A.reserve(Eigen::VectorXi::Constant(DIM_U_N, 2));
+  for (int i = 0; i < DIM_U_N; i++) {
+    if (i > 0) {
+      A.insert(i, i - 1) = -1.0;
+    }
+    A.insert(i, i) = 1.0;
   }
+  A.makeCompressed();
 
   // steering angle limit
   VectorXd lb = VectorXd::Constant(DIM_U_N, -m_steer_lim);  // min steering angle
@@ -580,7 +613,11 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
   lbA(0) = m_raw_steer_cmd_prev - steer_rate_limits(0) * m_ctrl_period;
 
   auto t_start = std::chrono::system_clock::now();
-  bool solve_result = m_qpsolver_ptr->solve(H, f.transpose(), A, lb, ub, lbA, ubA, Uex);
+  bool solve_result =
+    is_multi_stage
+      ? m_qpsolver_ptr->solveMultiStage(
+          m.Ad_ex, m.Bd_ex, m.Wd_ex, ws.Qbar, x0, R, f.transpose(), A, lb, ub, lbA, ubA, Uex)
+      : m_qpsolver_ptr->solve(ws.H, f.transpose(), MatrixXd(A), lb, ub, lbA, ubA, Uex);
   auto t_end = std::chrono::system_clock::now();
   if (!solve_result) {
     warn_throttle("qp solver error");
@@ -599,21 +636,30 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
   return {true, Uex};
 }
 
-void MPC::addSteerWeightR(const double prediction_dt, MatrixXd & R) const
+void MPC::addSteerWeightR(const double prediction_dt, SparseMatrixXd & R) const
 {
   const int N = m_param.prediction_horizon;
   const double DT = prediction_dt;
 
+  // add the symmetric block to the band of R
+  const auto add_block = [&R](const int i, const auto & D) {
+    for (int r = 0; r < D.rows(); ++r) {
+      for (int c = 0; c < D.cols(); ++c) {
+        R.coeffRef(i + r, i + c) += D(r, c);
+      }
+    }
+  };
+
   // add steering rate : weight for (u(i) - u(i-1) / dt )^2
   {
     const double steer_rate_r = m_param.nominal_weight.steer_rate / (DT * DT);
     const Eigen::Matrix2d D = steer_rate_r * (Eigen::Matrix2d() << 1.0, -1.0, -1.0, 1.0).finished();
     for (int i = 0; i < N - 1; ++i) {
-      R.block(i, i, 2, 2) += D;
+      add_block(i, D);
     }
     if (N > 1) {
       // steer rate i = 0
-      R(0, 0) += m_param.nominal_weight.steer_rate / (m_ctrl_period * m_ctrl_period);
+      R.coeffRef(0, 0) += m_param.nominal_weight.steer_rate / (m_ctrl_period * m_ctrl_period);
     }
   }
 
@@ -628,16 +674,16 @@ void MPC::addSteerWeightR(const double prediction_dt, MatrixXd & R) const
       steer_acc_r *
       (Eigen::Matrix3d() << 1.0, -2.0, 1.0, -2.0, 4.0, -2.0, 1.0, -2.0, 1.0).finished();
     for (int i = 1; i < N - 1; ++i) {
-      R.block(i - 1, i - 1, 3, 3) += D;
+      add_block(i - 1, D);
     }
     if (N > 1) {
       // steer acc i = 1
-      R(0, 0) += steer_acc_r * 1.0 + steer_acc_r_cp2 * 1.0 + steer_acc_r_cp1 * 2.0;
-      R(1, 0) += steer_acc_r * -1.0 + steer_acc_r_cp1 * -1.0;
-      R(0, 1) += steer_acc_r * -1.0 + steer_acc_r_cp1 * -1.0;
-      R(1, 1) += steer_acc_r * 1.0;
+      R.coeffRef(0, 0) += steer_acc_r * 1.0 + steer_acc_r_cp2 * 1.0 + steer_acc_r_cp1 * 2.0;
+      R.coeffRef(1, 0) += steer_acc_r * -1.0 + steer_acc_r_cp1 * -1.0;
+      R.coeffRef(0, 1) += steer_acc_r * -1.0 + steer_acc_r_cp1 * -1.0;
+      R.coeffRef(1, 1) += steer_acc_r * 1.0;
       // steer acc i = 0
-      R(0, 0) += steer_acc_r_cp4 * 1.0;
+      R.coeffRef(0, 0) += steer_acc_r_cp4 * 1.0;
     }
   }
 }
@@ -810,15 +856,15 @@ bool MPC::isValid(const MPCMatrix & m) const
 {
   if (
     m.Aex.array().isNaN().any() || m.Bex.array().isNaN().any() || m.Cex.array().isNaN().any() ||
-    m.Wex.array().isNaN().any() || m.Qex.array().isNaN().any() || m.R1ex.array().isNaN().any() ||
-    m.R2ex.array().isNaN().any() || m.Uref_ex.array().isNaN().any()) {
+    m.Wex.array().isNaN().any() || m.Qex.array().isNaN().any() || m.R1ex.coeffs().isNaN().any() ||
+    m.R2ex.coeffs().isNaN().any() || m.Uref_ex.array().isNaN().any()) {
     return false;
   }
 
   if (
     m.Aex.array().isInf().any() || m.Bex.array().isInf().any() || m.Cex.array().isInf().any() ||
-    m.Wex.array().isInf().any() || m.Qex.array().isInf().any() || m.R1ex.array().isInf().any() ||
-    m.R2ex.array().isInf().any() || m.Uref_ex.array().isInf().any()) {
+    m.Wex.array().isInf().any() || m.Qex.array().isInf().any() || m.R1ex.coeffs().isInf().any() ||
+    m.R2ex.coeffs().isInf().any() || m.Uref_ex.array().isInf().any()) {
     return false;
   }
 
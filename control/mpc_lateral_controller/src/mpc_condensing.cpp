@@ -0,0 +1,223 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpc_lateral_controller/mpc_condensing.hpp"
+
+#include <type_traits>
+
+namespace autoware::motion::control::mpc_lateral_controller
+{
+namespace MPCCondensing
+{
+namespace
+{
+template <int N>
+using Dim = std::integral_constant<int, N>;
+
+/**
+ * @brief call func with the compile-time dimensions (DIM_X, DIM_U) of the vehicle models, or with
+ * Eigen::Dynamic for the unknown ones.
+ * kinematics_no_delay: (2, 1), kinematics: (3, 1), dynamics: (4, 1)
+ */
+template <typename Func>
+void dispatchDimension(const int dim_x, const int dim_u, Func && func)
+{
+  if (dim_u == 1) {
+    switch (dim_x) {
+      case 2:
+        return func(Dim<2>{}, Dim<1>{});
+      case 3:
+        return func(Dim<3>{}, Dim<1>{});
+      case 4:
+        return func(Dim<4>{}, Dim<1>{});
+      default:
+        break;
+    }
+  }
+  func(Dim<Eigen::Dynamic>{}, Dim<Eigen::Dynamic>{});
+}
+
+template <typename Mat>
+void resize(Mat & mat, const Eigen::Index rows, const Eigen::Index cols)
+{
+  if (mat.rows() != rows || mat.cols() != cols) {
+    mat.resize(rows, cols);
+  }
+}
+
+template <int DX, int DU>
+void calcPredictionMatrixImpl(
+  const int dim_x, const int dim_u, const MatrixXd & Ad_ex, MatrixXd & Aex, MatrixXd & Bex,
+  MatrixXd & Wex)
+{
+  const int N = static_cast<int>(Ad_ex.rows()) / dim_x;
+  if (N == 0) {
+    return;
+  }
+
+  Aex.block<DX, DX>(0, 0, dim_x, dim_x) = Ad_ex.block<DX, DX>(0, 0, dim_x, dim_x);
+  for (int i = 1; i < N; ++i) {
+    const int idx_x_i = i * dim_x;
+    const int idx_x_i_prev = (i - 1) * dim_x;
+    const Eigen::Matrix<double, DX, DX> Ad = Ad_ex.block<DX, DX>(idx_x_i, 0, dim_x, dim_x);
+
+    Aex.block<DX, DX>(idx_x_i, 0, dim_x, dim_x).noalias() =
+      Ad * Aex.block<DX, DX>(idx_x_i_prev, 0, dim_x, dim_x);
+    Wex.block<DX, 1>(idx_x_i, 0, dim_x, 1).noalias() +=
+      Ad * Wex.block<DX, 1>(idx_x_i_prev, 0, dim_x, 1);
+    // lower triangular blocks: Bex(i, j) = Ad(i) * Bex(i - 1, j) for j < i
+    for (int j = 0; j < i; ++j) {
+      const int idx_u_j = j * dim_u;
+      Bex.block<DX, DU>(idx_x_i, idx_u_j, dim_x, dim_u).noalias() =
+        Ad * Bex.block<DX, DU>(idx_x_i_prev, idx_u_j, dim_x, dim_u);
+    }
+  }
+}
+
+template <int DX, int DY>
+void calcStateWeightImpl(
+  const int dim_x, const int dim_y, const MatrixXd & Cex, const MatrixXd & Qex, MatrixXd & Qbar)
+{
+  const int N = static_cast<int>(Cex.cols()) / dim_x;
+  resize(Qbar, N * dim_x, dim_x);
+  for (int i = 0; i < N; ++i) {
+    const auto Cd = Cex.block<DY, DX>(i * dim_y, i * dim_x, dim_y, dim_x);
+    const auto Q = Qex.block<DY, DY>(i * dim_y, i * dim_y, dim_y, dim_y);
+    Qbar.block<DX, DX>(i * dim_x, 0, dim_x, dim_x).noalias() = Cd.transpose() * Q * Cd;
+  }
+}
+
+/*
+ * With Bex(i, j) = Ad(i) * ... * Ad(j + 1) * Bd(j) and Qbar(i) = Cd(i)' * Q(i) * Cd(i),
+ *   H(j, k) = sum_{i >= j} Bex(i, j)' * Qbar(i) * Bex(i, k) = Bd(j)' * P(j) * Bex(j, k)  (j >= k)
+ *   f(k)    = sum_{i >= k} e(i)' * Qbar(i) * Bex(i, k)      = (Bd(k)' * g(k))'
+ * where
+ *   P(j) = Qbar(j) + Ad(j + 1)' * P(j + 1) * Ad(j + 1),  P(N - 1) = Qbar(N - 1)
+ *   g(k) = Qbar(k) * e(k) + Ad(k + 1)' * g(k + 1),       g(N - 1) = Qbar(N - 1) * e(N - 1)
+ *   e    = Aex * x0 + Wex
+ */
+template <int DX, int DU, int DY>
+void calcCondensedCostImpl(
+  const int dim_x, const int dim_u, const int dim_y, const MatrixXd & Ad_ex, const MatrixXd & Aex,
+  const MatrixXd & Bex, const MatrixXd & Wex, const MatrixXd & Cex, const MatrixXd & Qex,
+  const VectorXd & x0, CondensingWorkspace & ws)
+{
+  const int N = static_cast<int>(Ad_ex.rows()) / dim_x;
+
+  calcStateWeightImpl<DX, DY>(dim_x, dim_y, Cex, Qex, ws.Qbar);
+  resize(ws.P, N * dim_x, dim_x);
+  resize(ws.BtP, N * dim_u, dim_x);
+  resize(ws.e, N * dim_x, 1);
+  resize(ws.g, N * dim_x, 1);
+  resize(ws.H, N * dim_u, N * dim_u);
+  resize(ws.f, 1, N * dim_u);
+  if (N == 0) {
+    return;
+  }
+
+  ws.e.noalias() = Aex * x0;
+  ws.e += Wex;
+
+  // backward recursion of the state cost
+  const int idx_x_last = (N - 1) * dim_x;
+  const auto Qbar_last = ws.Qbar.block<DX, DX>(idx_x_last, 0, dim_x, dim_x);
+  ws.P.block<DX, DX>(idx_x_last, 0, dim_x, dim_x) = Qbar_last;
+  ws.g.block<DX, 1>(idx_x_last, 0, dim_x, 1).noalias() =
+    Qbar_last * ws.e.block<DX, 1>(idx_x_last, 0, dim_x, 1);
+  for (int j = N - 2; j >= 0; --j) {
+    const int idx_x_j = j * dim_x;
+    const int idx_x_next = (j + 1) * dim_x;
+    const auto Ad_next = Ad_ex.block<DX, DX>(idx_x_next, 0, dim_x, dim_x);
+    const auto Qbar = ws.Qbar.block<DX, DX>(idx_x_j, 0, dim_x, dim_x);
+
+    const Eigen::Matrix<double, DX, DX> P_Ad =
+      ws.P.block<DX, DX>(idx_x_next, 0, dim_x, dim_x) * Ad_next;
+    ws.P.block<DX, DX>(idx_x_j, 0, dim_x, dim_x) = Qbar;
+    ws.P.block<DX, DX>(idx_x_j, 0, dim_x, dim_x).noalias() += Ad_next.transpose() * P_Ad;
+
+    ws.g.block<DX, 1>(idx_x_j, 0, dim_x, 1).noalias() =
+      Qbar * ws.e.block<DX, 1>(idx_x_j, 0, dim_x, 1);
+    ws.g.block<DX, 1>(idx_x_j, 0, dim_x, 1).noalias() +=
+      Ad_next.transpose() * ws.g.block<DX, 1>(idx_x_next, 0, dim_x, 1);
+  }
+
+  for (int j = 0; j < N; ++j) {
+    const int idx_x_j = j * dim_x;
+    const int idx_u_j = j * dim_u;
+    const auto Bd = Bex.block<DX, DU>(idx_x_j, idx_u_j, dim_x, dim_u);
+
+    ws.BtP.block<DU, DX>(idx_u_j, 0, dim_u, dim_x).noalias() =
+      Bd.transpose() * ws.P.block<DX, DX>(idx_x_j, 0, dim_x, dim_x);
+    ws.f.block<1, DU>(0, idx_u_j, 1, dim_u).noalias() =
+      ws.g.block<DX, 1>(idx_x_j, 0, dim_x, 1).transpose() * Bd;
+
+    // the lower triangular blocks and their transposes
+    const auto BtP = ws.BtP.block<DU, DX>(idx_u_j, 0, dim_u, dim_x);
+    for (int k = 0; k <= j; ++k) {
+      const int idx_u_k = k * dim_u;
+      ws.H.block<DU, DU>(idx_u_j, idx_u_k, dim_u, dim_u).noalias() =
+        BtP * Bex.block<DX, DU>(idx_x_j, idx_u_k, dim_x, dim_u);
+      if (k != j) {
+        ws.H.block<DU, DU>(idx_u_k, idx_u_j, dim_u, dim_u) =
+          ws.H.block<DU, DU>(idx_u_j, idx_u_k, dim_u, dim_u).transpose();
+      }
+    }
+  }
+}
+}  // namespace
+
+void calcPredictionMatrix(
+  const int dim_x, const int dim_u, const MatrixXd & Ad_ex, MatrixXd & Aex, MatrixXd & Bex,
+  MatrixXd & Wex)
+{
+  dispatchDimension(dim_x, dim_u, [&](auto DX, auto DU) {
+    calcPredictionMatrixImpl<decltype(DX)::value, decltype(DU)::value>(
+      dim_x, dim_u, Ad_ex, Aex, Bex, Wex);
+  });
+}
+
+void calcStateWeight(
+  const int dim_x, const int dim_y, const MatrixXd & Cex, const MatrixXd & Qex, MatrixXd & Qbar)
+{
+  dispatchDimension(dim_x, 1, [&](auto DX, auto /*DU*/) {
+    constexpr int DIM_X = decltype(DX)::value;
+    if (dim_y == 2) {
+      calcStateWeightImpl<DIM_X, 2>(dim_x, dim_y, Cex, Qex, Qbar);
+    } else {
+      calcStateWeightImpl<DIM_X, Eigen::Dynamic>(dim_x, dim_y, Cex, Qex, Qbar);
+    }
+  });
+}
+
+void calcCondensedCost(
+  const int dim_x, const int dim_u, const int dim_y, const MatrixXd & Ad_ex, const MatrixXd & Aex,
+  const MatrixXd & Bex, const MatrixXd & Wex, const MatrixXd & Cex, const MatrixXd & Qex,
+  const VectorXd & x0, CondensingWorkspace & workspace)
+{
+  dispatchDimension(dim_x, dim_u, [&](auto DX, auto DU) {
+    constexpr int DIM_X = decltype(DX)::value;
+    constexpr int DIM_U = decltype(DU)::value;
+    // the output of all the vehicle models is [lateral error, yaw error]
+    if (dim_y == 2) {
+      calcCondensedCostImpl<DIM_X, DIM_U, 2>(
+        dim_x, dim_u, dim_y, Ad_ex, Aex, Bex, Wex, Cex, Qex, x0, workspace);
+    } else {
+      calcCondensedCostImpl<DIM_X, DIM_U, Eigen::Dynamic>(
+        dim_x, dim_u, dim_y, Ad_ex, Aex, Bex, Wex, Cex, Qex, x0, workspace);
+    }
+  });
+}
+
+}  // namespace MPCCondensing
+}  // namespace autoware::motion::control::mpc_lateral_controller
@@ -16,6 +16,7 @@
 
 #include "motion_utils/trajectory/trajectory.hpp"
 #include "mpc_lateral_controller/qp_solver/qp_solver_osqp.hpp"
+#include "mpc_lateral_controller/qp_solver/qp_solver_riccati.hpp"
 #include "mpc_lateral_controller/qp_solver/qp_solver_unconstraint_fast.hpp"
 #include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_dynamics.hpp"
 #include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_kinematics.hpp"
@@ -210,6 +211,11 @@ std::shared_ptr<QPSolverInterface> MpcLateralController::createQPSolverInterface
     return qpsolver_ptr;
   }
 
+  if (qp_solver_type == "riccati") {
+    qpsolver_ptr = std::make_shared<QPSolverRiccati>(logger_);
+    return qpsolver_ptr;
+  }
+
   RCLCPP_ERROR(logger_, "qp_solver_type is undefined");
   return qpsolver_ptr;
 }
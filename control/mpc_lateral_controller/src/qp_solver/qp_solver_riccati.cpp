@@ -0,0 +1,662 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mpc_lateral_controller/qp_solver/qp_solver_riccati.hpp"
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+namespace autoware::motion::control::mpc_lateral_controller
+{
+namespace
+{
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+using SparseRowMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+constexpr int64_t max_iteration = 50;
+constexpr double primal_tolerance = 1.0e-8;
+constexpr double dual_tolerance = 1.0e-8;  // relative to the gradient at u = 0
+constexpr double duality_gap_tolerance = 1.0e-10;
+constexpr double min_bound_width = 1.0e-8;  // the equality constraints are relaxed by this width
+constexpr double infinity_bound = 1.0e20;   // the bounds beyond this are ignored
+constexpr double step_ratio = 0.99;         // fraction to the boundary of the step
+
+/**
+ * @brief constraints lb < u < ub and lb_a < a * u < ub_a in the form of G * u <= h with
+ * G = [I; a; -I; -a] and h = [ub; ub_a; -lb; -lb_a]
+ */
+class Constraint
+{
+public:
+  Constraint(
+    const SparseRowMatrix & a, const VectorXd & lb, const VectorXd & ub, const VectorXd & lb_a,
+    const VectorXd & ub_a)
+  : a_(a), n_(static_cast<int>(lb.size())), m_(n_ + static_cast<int>(a.rows()))
+  {
+    h_.resize(2 * m_);
+    active_.resize(2 * m_);
+    for (int j = 0; j < m_; ++j) {
+      double lower = j < n_ ? lb(j) : lb_a(j - n_);
+      double upper = j < n_ ? ub(j) : ub_a(j - n_);
+      // the interior point method needs the interior of the feasible region
+      if (upper - lower < 2.0 * min_bound_width) {
+        const double center = 0.5 * (upper + lower);
+        lower = center - min_bound_width;
+        upper = center + min_bound_width;
+      }
+      h_(j) = upper;
+      h_(m_ + j) = -lower;
+      active_(j) = upper < infinity_bound ? 1.0 : 0.0;
+      active_(m_ + j) = lower > -infinity_bound ? 1.0 : 0.0;
+    }
+  }
+
+  int dimU() const { return n_; }
+  int size() const { return 2 * m_; }
+  const SparseRowMatrix & a() const { return a_; }
+  const VectorXd & h() const { return h_; }
+  const VectorXd & active() const { return active_; }
+
+  // G * u
+  void multiply(const VectorXd & u, VectorXd & gu) const
+  {
+    gu.head(n_) = u;
+    gu.segment(n_, m_ - n_).noalias() = a_ * u;
+    gu.tail(m_) = -gu.head(m_);
+  }
+
+  // G' * v
+  void multiplyTranspose(const VectorXd & v, VectorXd & gtv) const
+  {
+    const VectorXd d = v.head(m_) - v.tail(m_);
+    gtv = d.head(n_);
+    gtv.noalias() += a_.transpose() * d.tail(m_ - n_);
+  }
+
+  // diagonal weight of the rows of I and a in G' * diag(w) * G
+  void splitWeight(const VectorXd & w, VectorXd & w_box, VectorXd & w_a) const
+  {
+    w_box = w.head(n_) + w.segment(m_, n_);
+    w_a = w.segment(n_, m_ - n_) + w.tail(m_ - n_);
+  }
+
+  // band width of a in the blocks of dim_u
+  int calcBandWidth(const int dim_u) const
+  {
+    int band = 0;
+    for (int r = 0; r < a_.outerSize(); ++r) {
+      int min_block = -1;
+      int max_block = -1;
+      for (SparseRowMatrix::InnerIterator it(a_, r); it; ++it) {
+        const int block = static_cast<int>(it.col()) / dim_u;
+        min_block = min_block < 0 ? block : std::min(min_block, block);
+        max_block = std::max(max_block, block);
+      }
+      band = std::max(band, max_block - min_block);
+    }
+    return band;
+  }
+
+private:
+  SparseRowMatrix a_;
+  int n_;  // dimension of u
+  int m_;  // rows of [I; a]
+  VectorXd h_;
+  VectorXd active_;  // 0 for the ignored bounds
+};
+
+/**
+ * @brief condensed problem: 1/2 * u' * h_mat * u + f' * u, whose newton step is solved with the
+ * dense Cholesky decomposition
+ */
+class CondensedProblem
+{
+public:
+  CondensedProblem(const MatrixXd & h_mat, const MatrixXd & f_vec, const Constraint & constraint)
+  : h_mat_(h_mat), f_(Eigen::Map<const VectorXd>(f_vec.data(), f_vec.size())), c_(constraint)
+  {
+  }
+
+  void gradient(const VectorXd & u, VectorXd & grad) const
+  {
+    grad = f_;
+    grad.noalias() += h_mat_ * u;
+  }
+
+  double objective(const VectorXd & u) const { return 0.5 * u.dot(h_mat_ * u) + f_.dot(u); }
+
+  bool factorize(const VectorXd & w_box, const VectorXd & w_a)
+  {
+    m_ = h_mat_;
+    m_.diagonal() += w_box;
+    m_ += MatrixXd(c_.a().transpose() * w_a.asDiagonal() * c_.a());
+    llt_.compute(m_);
+    return llt_.info() == Eigen::Success;
+  }
+
+  // du = -M^-1 * rho
+  void solve(const VectorXd & rho, VectorXd & du) const { du = -llt_.solve(rho); }
+
+  // minimizer of the problem with the factorized hessian
+  void solveAffine(VectorXd & u) const { solve(f_, u); }
+
+private:
+  const MatrixXd & h_mat_;
+  const VectorXd f_;
+  const Constraint & c_;
+  MatrixXd m_;
+  Eigen::LLT<MatrixXd> llt_;
+};
+
+// band width of the symmetric matrix in the blocks of dim_u
+int calcBandWidth(const SparseRowMatrix & mat, const int dim_u)
+{
+  int band = 0;
+  for (int r = 0; r < mat.outerSize(); ++r) {
+    for (SparseRowMatrix::InnerIterator it(mat, r); it; ++it) {
+      if (it.value() != 0.0) {
+        band = std::max(band, r / dim_u - static_cast<int>(it.col()) / dim_u);
+      }
+    }
+  }
+  return band;
+}
+
+template <int N>
+using Dim = std::integral_constant<int, N>;
+
+// call the function with the fixed size of the augmented state and the input when the small
+// matrices of each stage fit in the fixed size, which avoids the overhead of the dynamic size
+template <typename Func>
+void dispatchDimension(const int dim_s, const int dim_u, Func && func)
+{
+  if (dim_u == 1) {
+    switch (dim_s) {
+      case 3:
+        return func(Dim<3>{}, Dim<1>{});
+      case 4:
+        return func(Dim<4>{}, Dim<1>{});
+      case 5:
+        return func(Dim<5>{}, Dim<1>{});
+      case 6:
+        return func(Dim<6>{}, Dim<1>{});
+      default:
+        break;
+    }
+  }
+  func(Dim<Eigen::Dynamic>{}, Dim<Eigen::Dynamic>{});
+}
+
+/**
+ * @brief multi-stage problem, whose newton step is solved with the Riccati recursion.
+ * The band of the input weight is handled by the augmented state s(i) = [x(i); u(i-1); ...;
+ * u(i-band)], so that the cross terms between the inputs become the ones between the state and
+ * the input of the stage:
+ *   stage cost : 1/2 * s' * Q(i) * s + u' * S(i) * s + 1/2 * u' * R(i) * u + rho(i)' * u
+ *   dynamics   : s(i+1) = A(i) * s(i) + B(i) * u(i) + c(i)
+ *   Q(i) = diag(q_ex(i-1), 0), S(i) = [0, M(i, i-1), ..., M(i, i-band)], R(i) = M(i, i)
+ *   A(i) = [a_ex(i), 0; 0, shift], B(i) = [b_ex(i); I; 0], c(i) = [w_ex(i); 0]
+ * The Riccati recursion for the value function V(i)(s) = 1/2 * s' * P(i) * s + p(i)' * s is
+ *   Rhat = R(i) + B' * P(i+1) * B,  Shat = S(i) + B' * P(i+1) * A,  K(i) = -Rhat^-1 * Shat
+ *   P(i) = Q(i) + A' * P(i+1) * A + Shat' * K(i)
+ *   v = P(i+1) * c(i) + p(i+1),  rhat = rho(i) + B' * v,  d(i) = -Rhat^-1 * rhat
+ *   p(i) = A' * v + K(i)' * rhat
+ * and the inputs are u(i) = K(i) * s(i) + d(i) from s(0) = [x0; 0].
+ * @tparam DS dimension of the augmented state, or Eigen::Dynamic
+ * @tparam DU dimension of the input, or Eigen::Dynamic
+ */
+template <int DS, int DU>
+class MultiStageProblem
+{
+  using MatrixS = Eigen::Matrix<double, DS, DS>;
+  using MatrixSU = Eigen::Matrix<double, DS, DU>;
+  using MatrixUS = Eigen::Matrix<double, DU, DS>;
+  using MatrixU = Eigen::Matrix<double, DU, DU>;
+  using VectorS = Eigen::Matrix<double, DS, 1>;
+  using VectorU = Eigen::Matrix<double, DU, 1>;
+
+public:
+  MultiStageProblem(
+    const MatrixXd & a_ex, const MatrixXd & b_ex, const MatrixXd & w_ex, const MatrixXd & q_ex,
+    const VectorXd & x0, const SparseRowMatrix & r_mat, const MatrixXd & r_vec, const int band,
+    const Constraint & constraint, QPSolverRiccati::Workspace & ws)
+  : a_ex_(a_ex),
+    b_ex_(b_ex),
+    w_ex_(w_ex),
+    q_ex_(q_ex),
+    x0_(x0),
+    r_vec_(Eigen::Map<const VectorXd>(r_vec.data(), r_vec.size())),
+    c_(constraint),
+    ws_(ws),
+    dim_x_(static_cast<int>(a_ex.cols())),
+    dim_u_(static_cast<int>(b_ex.cols())),
+    N_(static_cast<int>(a_ex.rows()) / dim_x_),
+    band_(band),
+    dim_s_(dim_x_ + band_ * dim_u_)
+  {
+    resize(ws_.r_band, N_ * dim_u_, (band_ + 1) * dim_u_);
+    resize(ws_.m_band, N_ * dim_u_, (band_ + 1) * dim_u_);
+    resize(ws_.p, (N_ + 1) * dim_s_, dim_s_);
+    resize(ws_.k, N_ * dim_u_, dim_s_);
+    resize(ws_.r_inv, N_ * dim_u_, dim_u_);
+    resize(ws_.d, N_ * dim_u_, 1);
+    resize(ws_.x, (N_ + 1) * dim_x_, 1);
+
+    // lower band of the input weight, which is symmetric
+    ws_.r_band.setZero();
+    for (int r = 0; r < r_mat.outerSize(); ++r) {
+      for (SparseRowMatrix::InnerIterator it(r_mat, r); it; ++it) {
+        const int c = static_cast<int>(it.col());
+        const int k = r / dim_u_ - c / dim_u_;
+        if (0 <= k && k <= band_) {
+          ws_.r_band(r, k * dim_u_ + c % dim_u_) = it.value();
+        }
+      }
+    }
+
+    a_aug_ = MatrixS::Zero(dim_s_, dim_s_);
+    b_aug_ = MatrixSU::Zero(dim_s_, dim_u_);
+    if (band_ > 0) {
+      b_aug_.block(dim_x_, 0, dim_u_, dim_u_).setIdentity();
+      a_aug_.block(dim_x_ + dim_u_, dim_x_, (band_ - 1) * dim_u_, (band_ - 1) * dim_u_)
+        .setIdentity();
+    }
+  }
+
+  void gradient(const VectorXd & u, VectorXd & grad)
+  {
+    simulate(u);
+    grad = r_vec_;
+    multiplyBand(ws_.r_band, u, grad);
+
+    // adjoint: lambda(i+1) = q_ex(i) * x(i+1) + a_ex(i+1)' * lambda(i+2), grad(i) = b_ex(i)' * ...
+    VectorXd lambda = VectorXd::Zero(dim_x_);
+    for (int i = N_ - 1; i >= 0; --i) {
+      if (i < N_ - 1) {
+        lambda = a_ex_.block((i + 1) * dim_x_, 0, dim_x_, dim_x_).transpose() * lambda;
+      }
+      lambda.noalias() +=
+        q_ex_.block(i * dim_x_, 0, dim_x_, dim_x_) * ws_.x.block((i + 1) * dim_x_, 0, dim_x_, 1);
+      grad.segment(i * dim_u_, dim_u_).noalias() +=
+        b_ex_.block(i * dim_x_, 0, dim_x_, dim_u_).transpose() * lambda;
+    }
+  }
+
+  double objective(const VectorXd & u)
+  {
+    simulate(u);
+    VectorXd ru = VectorXd::Zero(u.size());
+    multiplyBand(ws_.r_band, u, ru);
+    double obj = 0.5 * u.dot(ru) + r_vec_.dot(u);
+    for (int i = 0; i < N_; ++i) {
+      const VectorXd x = ws_.x.block((i + 1) * dim_x_, 0, dim_x_, 1);
+      obj += 0.5 * x.dot(q_ex_.block(i * dim_x_, 0, dim_x_, dim_x_) * x);
+    }
+    return obj;
+  }
+
+  bool factorize(const VectorXd & w_box, const VectorXd & w_a)
+  {
+    // M = r_mat + diag(w_box) + a' * diag(w_a) * a
+    ws_.m_band = ws_.r_band;
+    for (int r = 0; r < N_ * dim_u_; ++r) {
+      ws_.m_band(r, r % dim_u_) += w_box(r);
+    }
+    const auto & a = c_.a();
+    for (int j = 0; j < a.outerSize(); ++j) {
+      for (SparseRowMatrix::InnerIterator it1(a, j); it1; ++it1) {
+        for (SparseRowMatrix::InnerIterator it2(a, j); it2; ++it2) {
+          const int r = static_cast<int>(it1.col());
+          const int c = static_cast<int>(it2.col());
+          const int k = r / dim_u_ - c / dim_u_;
+          if (k >= 0) {
+            ws_.m_band(r, k * dim_u_ + c % dim_u_) += w_a(j) * it1.value() * it2.value();
+          }
+        }
+      }
+    }
+
+    // backward recursion of the cost-to-go
+    MatrixS P = MatrixS::Zero(dim_s_, dim_s_);
+    addStateWeight(N_, P);
+    blockP(N_) = P;
+    MatrixUS BtP(dim_u_, dim_s_);
+    MatrixUS S_hat(dim_u_, dim_s_);
+    MatrixU R_hat(dim_u_, dim_u_);
+    MatrixS PA(dim_s_, dim_s_);
+    for (int i = N_ - 1; i >= 0; --i) {
+      setStageDynamics(i);
+      BtP.noalias() = b_aug_.transpose() * P;
+
+      S_hat.setZero();
+      for (int k = 1; k <= band_ && i - k >= 0; ++k) {
+        S_hat.block(0, dim_x_ + (k - 1) * dim_u_, dim_u_, dim_u_) = bandBlock(ws_.m_band, i, k);
+      }
+      S_hat.noalias() += BtP * a_aug_;
+      R_hat = bandBlock(ws_.m_band, i, 0);
+      R_hat.noalias() += BtP * b_aug_;
+
+      llt_.compute(R_hat);
+      if (llt_.info() != Eigen::Success) {
+        return false;
+      }
+      MatrixU R_inv = MatrixU::Identity(dim_u_, dim_u_);
+      llt_.solveInPlace(R_inv);
+      const MatrixUS K = -R_inv * S_hat;
+      blockRInv(i) = R_inv;
+      blockK(i) = K;
+
+      PA.noalias() = P * a_aug_;
+      P.noalias() = a_aug_.transpose() * PA;
+      P.noalias() += S_hat.transpose() * K;
+      addStateWeight(i, P);
+      P = 0.5 * (P + P.transpose()).eval();
+      blockP(i) = P;
+    }
+    return true;
+  }
+
+  // du = -M^-1 * rho, where the state is not affected by x0 and w_ex
+  void solve(const VectorXd & rho, VectorXd & du) { solveImpl(rho, false, du); }
+
+  // minimizer of the problem with the factorized hessian, including x0 and w_ex
+  void solveAffine(VectorXd & u) { solveImpl(r_vec_, true, u); }
+
+private:
+  template <typename Mat>
+  static void resize(Mat & mat, const Eigen::Index rows, const Eigen::Index cols)
+  {
+    if (mat.rows() != rows || mat.cols() != cols) {
+      mat.resize(rows, cols);
+    }
+  }
+
+  auto blockP(const int i) { return ws_.p.template block<DS, DS>(i * dim_s_, 0, dim_s_, dim_s_); }
+  auto blockK(const int i) { return ws_.k.template block<DU, DS>(i * dim_u_, 0, dim_u_, dim_s_); }
+  auto blockRInv(const int i)
+  {
+    return ws_.r_inv.template block<DU, DU>(i * dim_u_, 0, dim_u_, dim_u_);
+  }
+
+  auto bandBlock(const MatrixXd & band, const int i, const int k) const
+  {
+    return band.template block<DU, DU>(i * dim_u_, k * dim_u_, dim_u_, dim_u_);
+  }
+
+  // out += M * u with the lower band of the symmetric M
+  void multiplyBand(const MatrixXd & band, const VectorXd & u, VectorXd & out) const
+  {
+    for (int i = 0; i < N_; ++i) {
+      for (int k = 0; k <= band_ && i - k >= 0; ++k) {
+        const auto M = bandBlock(band, i, k);
+        out.template segment<DU>(i * dim_u_, dim_u_).noalias() +=
+          M * u.template segment<DU>((i - k) * dim_u_, dim_u_);
+        if (k > 0) {
+          out.template segment<DU>((i - k) * dim_u_, dim_u_).noalias() +=
+            M.transpose() * u.template segment<DU>(i * dim_u_, dim_u_);
+        }
+      }
+    }
+  }
+
+  // add the weight of the augmented state of the stage i: diag(q_ex(i-1), 0)
+  void addStateWeight(const int i, MatrixS & P) const
+  {
+    if (i > 0) {
+      P.block(0, 0, dim_x_, dim_x_) += q_ex_.block((i - 1) * dim_x_, 0, dim_x_, dim_x_);
+    }
+  }
+
+  void setStageDynamics(const int i)
+  {
+    a_aug_.block(0, 0, dim_x_, dim_x_) = a_ex_.block(i * dim_x_, 0, dim_x_, dim_x_);
+    b_aug_.block(0, 0, dim_x_, dim_u_) = b_ex_.block(i * dim_x_, 0, dim_x_, dim_u_);
+  }
+
+  void simulate(const VectorXd & u)
+  {
+    ws_.x.block(0, 0, dim_x_, 1) = x0_;
+    for (int i = 0; i < N_; ++i) {
+      auto x_next = ws_.x.block((i + 1) * dim_x_, 0, dim_x_, 1);
+      x_next = w_ex_.block(i * dim_x_, 0, dim_x_, 1);
+      x_next.noalias() +=
+        a_ex_.block(i * dim_x_, 0, dim_x_, dim_x_) * ws_.x.block(i * dim_x_, 0, dim_x_, 1);
+      x_next.noalias() +=
+        b_ex_.block(i * dim_x_, 0, dim_x_, dim_u_) * u.segment(i * dim_u_, dim_u_);
+    }
+  }
+
+  void solveImpl(const VectorXd & rho, const bool with_affine, VectorXd & u)
+  {
+    VectorS p = VectorS::Zero(dim_s_);
+    VectorS c = VectorS::Zero(dim_s_);
+    VectorS v(dim_s_);
+    VectorU r_hat(dim_u_);
+    for (int i = N_ - 1; i >= 0; --i) {
+      setStageDynamics(i);
+      if (with_affine) {
+        c.head(dim_x_) = w_ex_.block(i * dim_x_, 0, dim_x_, 1);
+      }
+      v.noalias() = blockP(i + 1) * c;
+      v += p;
+      r_hat = rho.template segment<DU>(i * dim_u_, dim_u_);
+      r_hat.noalias() += b_aug_.transpose() * v;
+      ws_.d.template block<DU, 1>(i * dim_u_, 0, dim_u_, 1).noalias() = -blockRInv(i) * r_hat;
+      p.noalias() = a_aug_.transpose() * v;
+      p.noalias() += blockK(i).transpose() * r_hat;
+    }
+
+    u.resize(N_ * dim_u_);
+    VectorS s = VectorS::Zero(dim_s_);
+    VectorS s_next(dim_s_);
+    if (with_affine) {
+      s.head(dim_x_) = x0_;
+    }
+    for (int i = 0; i < N_; ++i) {
+      setStageDynamics(i);
+      auto u_i = u.template segment<DU>(i * dim_u_, dim_u_);
+      u_i = ws_.d.template block<DU, 1>(i * dim_u_, 0, dim_u_, 1);
+      u_i.noalias() += blockK(i) * s;
+      s_next.noalias() = a_aug_ * s;
+      s_next.noalias() += b_aug_ * u_i;
+      if (with_affine) {
+        s_next.head(dim_x_) += w_ex_.block(i * dim_x_, 0, dim_x_, 1);
+      }
+      s = s_next;
+    }
+  }
+
+  const MatrixXd & a_ex_;
+  const MatrixXd & b_ex_;
+  const MatrixXd & w_ex_;
+  const MatrixXd & q_ex_;
+  const VectorXd & x0_;
+  const VectorXd r_vec_;
+  const Constraint & c_;
+  QPSolverRiccati::Workspace & ws_;
+  const int dim_x_;
+  const int dim_u_;
+  const int N_;
+  const int band_;
+  const int dim_s_;
+  MatrixS a_aug_;
+  MatrixSU b_aug_;
+  Eigen::LLT<MatrixU> llt_;
+};
+
+// maximum step length in (0, 1] to keep v + alpha * dv >= 0
+double calcMaxStep(const VectorXd & v, const VectorXd & dv, const VectorXd & active)
+{
+  double alpha = 1.0;
+  for (Eigen::Index j = 0; j < v.size(); ++j) {
+    if (active(j) > 0.0 && dv(j) < 0.0) {
+      alpha = std::min(alpha, -v(j) / dv(j));
+    }
+  }
+  return alpha;
+}
+
+/**
+ * @brief primal-dual interior point method with Mehrotra's predictor-corrector for
+ * minimize J(u) subject to G * u + s = h, s >= 0 with the dual variable z >= 0.
+ * The newton step is reduced to (H + G' * W * G) * du = -rho with W = diag(z / s), which is
+ * solved by the problem.
+ */
+template <typename Problem>
+bool solveInteriorPoint(Problem & problem, const Constraint & c, VectorXd & u, int64_t & iter)
+{
+  const int n = c.dimU();
+  const int m = c.size();
+  const VectorXd & h = c.h();
+  const VectorXd & active = c.active();
+  const double num_active = std::max(active.sum(), 1.0);
+
+  VectorXd grad(n);
+  VectorXd gu(m);
+  VectorXd w(m);
+  VectorXd w_box(n);
+  VectorXd w_a(m / 2 - n);
+  VectorXd r_d(n);
+  VectorXd r_p(m);
+  VectorXd r_c(m);
+  VectorXd rho(n);
+  VectorXd gt(n);
+  VectorXd du(n);
+  VectorXd ds(m);
+  VectorXd dz(m);
+  VectorXd ds_aff(m);
+  VectorXd dz_aff(m);
+
+  // newton step for the complementarity residual r_c
+  const auto calcStep = [&](
+                            const VectorXd & s, const VectorXd & r_comp, VectorXd & du_step,
+                            VectorXd & ds_step, VectorXd & dz_step) {
+    const VectorXd r_comp_s = r_comp.cwiseQuotient(s);
+    c.multiplyTranspose(w.cwiseProduct(r_p) - r_comp_s, gt);
+    rho = r_d + gt;
+    problem.solve(rho, du_step);
+    c.multiply(du_step, gu);
+    ds_step = (-r_p - gu).cwiseProduct(active);
+    dz_step = (w.cwiseProduct(gu + r_p) - r_comp_s).cwiseProduct(active);
+  };
+
+  // starting point: the minimizer with the unit barrier weight
+  problem.gradient(VectorXd::Zero(n), grad);
+  const double dual_scale = 1.0 + grad.lpNorm<Eigen::Infinity>();
+  c.splitWeight(active, w_box, w_a);
+  if (!problem.factorize(w_box, w_a)) {
+    return false;
+  }
+  problem.solveAffine(u);
+  c.multiply(u, gu);
+  VectorXd s = (h - gu).cwiseMax(1.0).cwiseProduct(active) + (VectorXd::Ones(m) - active);
+  VectorXd z = active;
+
+  for (iter = 1; iter <= max_iteration; ++iter) {
+    c.multiply(u, gu);
+    r_p = (gu + s - h).cwiseProduct(active);
+    problem.gradient(u, grad);
+    c.multiplyTranspose(z, gt);
+    r_d = grad + gt;
+    const double mu = s.dot(z) / num_active;
+    if (
+      r_p.lpNorm<Eigen::Infinity>() < primal_tolerance &&
+      r_d.lpNorm<Eigen::Infinity>() < dual_tolerance * dual_scale && mu < duality_gap_tolerance) {
+      return true;
+    }
+
+    w = z.cwiseQuotient(s).cwiseProduct(active);
+    c.splitWeight(w, w_box, w_a);
+    if (!problem.factorize(w_box, w_a)) {
+      return false;
+    }
+
+    // predictor (affine scaling) step
+    r_c = s.cwiseProduct(z);
+    calcStep(s, r_c, du, ds_aff, dz_aff);
+    const double alpha_aff =
+      std::min(calcMaxStep(s, ds_aff, active), calcMaxStep(z, dz_aff, active));
+    const double mu_aff = (s + alpha_aff * ds_aff).dot(z + alpha_aff * dz_aff) / num_active;
+    const double sigma = std::pow(mu_aff / mu, 3);
+
+    // corrector step
+    r_c += (ds_aff.cwiseProduct(dz_aff) - VectorXd::Constant(m, sigma * mu)).cwiseProduct(active);
+    calcStep(s, r_c, du, ds, dz);
+    const double alpha =
+      std::min(1.0, step_ratio * std::min(calcMaxStep(s, ds, active), calcMaxStep(z, dz, active)));
+
+    u += alpha * du;
+    s += alpha * ds;
+    z += alpha * dz;
+  }
+  iter = max_iteration;
+  return false;
+}
+}  // namespace
+
+QPSolverRiccati::QPSolverRiccati(const rclcpp::Logger & logger) : logger_{logger}
+{
+}
+
+bool QPSolverRiccati::solve(
+  const Eigen::MatrixXd & h_mat, const Eigen::MatrixXd & f_vec, const Eigen::MatrixXd & a,
+  const Eigen::VectorXd & lb, const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a,
+  const Eigen::VectorXd & ub_a, Eigen::VectorXd & u)
+{
+  const auto t_start = std::chrono::steady_clock::now();
+  const Constraint constraint(SparseRowMatrix(a.sparseView()), lb, ub, lb_a, ub_a);
+  CondensedProblem problem(h_mat, f_vec, constraint);
+  const bool solved = solveInteriorPoint(problem, constraint, u, iter_);
+  obj_val_ = problem.objective(u);
+  run_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+  if (!solved) {
+    RCLCPP_WARN(logger_, "optimization failed : interior point method did not converge");
+    return false;
+  }
+  return true;
+}
+
+bool QPSolverRiccati::solveMultiStage(
+  const Eigen::MatrixXd & a_ex, const Eigen::MatrixXd & b_ex, const Eigen::MatrixXd & w_ex,
+  const Eigen::MatrixXd & q_ex, const Eigen::VectorXd & x0, const SparseRowMatrix & r_mat,
+  const Eigen::MatrixXd & r_vec, const SparseRowMatrix & a, const Eigen::VectorXd & lb,
+  const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a, const Eigen::VectorXd & ub_a,
+  Eigen::VectorXd & u)
+{
+  const auto t_start = std::chrono::steady_clock::now();
+  const Constraint constraint(a, lb, ub, lb_a, ub_a);
+  const int dim_x = static_cast<int>(a_ex.cols());
+  const int dim_u = static_cast<int>(b_ex.cols());
+  const int band = std::max(calcBandWidth(r_mat, dim_u), constraint.calcBandWidth(dim_u));
+  bool solved = false;
+  dispatchDimension(dim_x + band * dim_u, dim_u, [&](auto ds, auto du) {
+    MultiStageProblem<decltype(ds)::value, decltype(du)::value> problem(
+      a_ex, b_ex, w_ex, q_ex, x0, r_mat, r_vec, band, constraint, ws_);
+    solved = solveInteriorPoint(problem, constraint, u, iter_);
+    obj_val_ = problem.objective(u);
+  });
+  run_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+  if (!solved) {
+    RCLCPP_WARN(logger_, "optimization failed : interior point method did not converge");
+    return false;
+  }
+  return true;
+}
+}  // namespace autoware::motion::control::mpc_lateral_controller
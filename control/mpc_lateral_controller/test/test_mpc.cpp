@@ -15,6 +15,7 @@
 #include "gtest/gtest.h"
 #include "mpc_lateral_controller/mpc.hpp"
 #include "mpc_lateral_controller/qp_solver/qp_solver_osqp.hpp"
+#include "mpc_lateral_controller/qp_solver/qp_solver_riccati.hpp"
 #include "mpc_lateral_controller/qp_solver/qp_solver_unconstraint_fast.hpp"
 #include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_dynamics.hpp"
 #include "mpc_lateral_controller/vehicle_model/vehicle_model_bicycle_kinematics.hpp"
@@ -302,6 +303,62 @@ TEST_F(MPCTest, OsqpCalculateRightTurn)
   EXPECT_LT(ctrl_cmd.steering_tire_rotation_rate, 0.0f);
 }
 
+TEST_F(MPCTest, RiccatiCalculate)
+{
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  auto mpc = std::make_unique<MPC>(node);
+  initializeMPC(*mpc);
+  const auto current_kinematics = makeOdometry(dummy_straight_trajectory.points.front().pose, 0.0);
+  mpc->setReferenceTrajectory(dummy_straight_trajectory, trajectory_param, current_kinematics);
+
+  std::shared_ptr<VehicleModelInterface> vehicle_model_ptr =
+    std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau);
+  mpc->setVehicleModel(vehicle_model_ptr);
+  ASSERT_TRUE(mpc->hasVehicleModel());
+
+  std::shared_ptr<QPSolverInterface> qpsolver_ptr = std::make_shared<QPSolverRiccati>(logger);
+  mpc->setQPSolver(qpsolver_ptr);
+  ASSERT_TRUE(mpc->hasQPSolver());
+
+  // Calculate MPC
+  AckermannLateralCommand ctrl_cmd;
+  Trajectory pred_traj;
+  Float32MultiArrayStamped diag;
+  const auto odom = makeOdometry(pose_zero, default_velocity);
+  EXPECT_TRUE(mpc->calculateMPC(neutral_steer, odom, ctrl_cmd, pred_traj, diag));
+  // the interior point method converges to the optimum within the tolerance
+  EXPECT_NEAR(ctrl_cmd.steering_tire_angle, 0.0f, 1.0e-5);
+  EXPECT_NEAR(ctrl_cmd.steering_tire_rotation_rate, 0.0f, 1.0e-4);
+}
+
+TEST_F(MPCTest, RiccatiCalculateRightTurn)
+{
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  auto mpc = std::make_unique<MPC>(node);
+  initializeMPC(*mpc);
+  const auto current_kinematics =
+    makeOdometry(dummy_right_turn_trajectory.points.front().pose, 0.0);
+  mpc->setReferenceTrajectory(dummy_right_turn_trajectory, trajectory_param, current_kinematics);
+
+  std::shared_ptr<VehicleModelInterface> vehicle_model_ptr =
+    std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau);
+  mpc->setVehicleModel(vehicle_model_ptr);
+  ASSERT_TRUE(mpc->hasVehicleModel());
+
+  std::shared_ptr<QPSolverInterface> qpsolver_ptr = std::make_shared<QPSolverRiccati>(logger);
+  mpc->setQPSolver(qpsolver_ptr);
+  ASSERT_TRUE(mpc->hasQPSolver());
+
+  // Calculate MPC
+  AckermannLateralCommand ctrl_cmd;
+  Trajectory pred_traj;
+  Float32MultiArrayStamped diag;
+  const auto odom = makeOdometry(pose_zero, default_velocity);
+  ASSERT_TRUE(mpc->calculateMPC(neutral_steer, odom, ctrl_cmd, pred_traj, diag));
+  EXPECT_LT(ctrl_cmd.steering_tire_angle, 0.0f);
+  EXPECT_LT(ctrl_cmd.steering_tire_rotation_rate, 0.0f);
+}
+
 TEST_F(MPCTest, KinematicsNoDelayCalculate)
 {
   auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
@@ -0,0 +1,108 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "mpc_lateral_controller/mpc_condensing.hpp"
+
+#include <Eigen/Core>
+
+#include <cstdlib>
+
+namespace
+{
+namespace MPCCondensing = autoware::motion::control::mpc_lateral_controller::MPCCondensing;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// compare the condensing with the dense products for the given dimensions
+void checkCondensing(const int dim_x, const int dim_u, const int dim_y, const int N)
+{
+  std::srand(0);
+  MatrixXd Ad_ex = MatrixXd::Random(dim_x * N, dim_x) * 0.5;
+  MatrixXd Bd_ex = MatrixXd::Random(dim_x * N, dim_u);
+  MatrixXd Wd_ex = MatrixXd::Random(dim_x * N, 1);
+  MatrixXd Cex = MatrixXd::Zero(dim_y * N, dim_x * N);
+  MatrixXd Qex = MatrixXd::Zero(dim_y * N, dim_y * N);
+  for (int i = 0; i < N; ++i) {
+    Cex.block(i * dim_y, i * dim_x, dim_y, dim_x) = MatrixXd::Random(dim_y, dim_x);
+    const MatrixXd Q = MatrixXd::Random(dim_y, dim_y);
+    Qex.block(i * dim_y, i * dim_y, dim_y, dim_y) = Q * Q.transpose();
+  }
+  const VectorXd x0 = VectorXd::Random(dim_x);
+
+  // reference: the dense prediction matrices and products
+  MatrixXd Aex_ref = MatrixXd::Zero(dim_x * N, dim_x);
+  MatrixXd Bex_ref = MatrixXd::Zero(dim_x * N, dim_u * N);
+  MatrixXd Wex_ref = MatrixXd::Zero(dim_x * N, 1);
+  for (int i = 0; i < N; ++i) {
+    const MatrixXd Ad = Ad_ex.block(i * dim_x, 0, dim_x, dim_x);
+    if (i == 0) {
+      Aex_ref.block(0, 0, dim_x, dim_x) = Ad;
+      Wex_ref.block(0, 0, dim_x, 1) = Wd_ex.block(0, 0, dim_x, 1);
+    } else {
+      Aex_ref.block(i * dim_x, 0, dim_x, dim_x) =
+        Ad * Aex_ref.block((i - 1) * dim_x, 0, dim_x, dim_x);
+      for (int j = 0; j < i; ++j) {
+        Bex_ref.block(i * dim_x, j * dim_u, dim_x, dim_u) =
+          Ad * Bex_ref.block((i - 1) * dim_x, j * dim_u, dim_x, dim_u);
+      }
+      Wex_ref.block(i * dim_x, 0, dim_x, 1) =
+        Ad * Wex_ref.block((i - 1) * dim_x, 0, dim_x, 1) + Wd_ex.block(i * dim_x, 0, dim_x, 1);
+    }
+    Bex_ref.block(i * dim_x, i * dim_u, dim_x, dim_u) = Bd_ex.block(i * dim_x, 0, dim_x, dim_u);
+  }
+  const MatrixXd CB = Cex * Bex_ref;
+  const MatrixXd H_ref = CB.transpose() * Qex * CB;
+  const MatrixXd f_ref = (Cex * (Aex_ref * x0 + Wex_ref)).transpose() * Qex * CB;
+
+  // condensing
+  MatrixXd Aex = MatrixXd::Zero(dim_x * N, dim_x);
+  MatrixXd Bex = MatrixXd::Zero(dim_x * N, dim_u * N);
+  MatrixXd Wex = Wd_ex;
+  for (int i = 0; i < N; ++i) {
+    Bex.block(i * dim_x, i * dim_u, dim_x, dim_u) = Bd_ex.block(i * dim_x, 0, dim_x, dim_u);
+  }
+  MPCCondensing::calcPredictionMatrix(dim_x, dim_u, Ad_ex, Aex, Bex, Wex);
+  EXPECT_TRUE(Aex.isApprox(Aex_ref, 1.0e-10));
+  EXPECT_TRUE(Bex.isApprox(Bex_ref, 1.0e-10));
+  EXPECT_TRUE(Wex.isApprox(Wex_ref, 1.0e-10));
+
+  MPCCondensing::CondensingWorkspace workspace;
+  MPCCondensing::calcCondensedCost(
+    dim_x, dim_u, dim_y, Ad_ex, Aex, Bex, Wex, Cex, Qex, x0, workspace);
+  EXPECT_TRUE(workspace.H.isApprox(H_ref, 1.0e-10));
+  EXPECT_TRUE(workspace.f.isApprox(f_ref, 1.0e-10));
+  EXPECT_TRUE(workspace.H.isApprox(workspace.H.transpose()));
+
+  // the workspace is reused
+  const double * H_data = workspace.H.data();
+  MPCCondensing::calcCondensedCost(
+    dim_x, dim_u, dim_y, Ad_ex, Aex, Bex, Wex, Cex, Qex, x0, workspace);
+  EXPECT_EQ(workspace.H.data(), H_data);
+  EXPECT_TRUE(workspace.H.isApprox(H_ref, 1.0e-10));
+}
+}  // namespace
+
+TEST(TestMPCCondensing, VehicleModelDimensions)
+{
+  checkCondensing(2, 1, 2, 30);  // kinematics_no_delay
+  checkCondensing(3, 1, 2, 30);  // kinematics
+  checkCondensing(4, 1, 2, 30);  // dynamics
+}
+
+TEST(TestMPCCondensing, DynamicDimensions)
+{
+  checkCondensing(5, 2, 3, 20);
+  checkCondensing(3, 1, 2, 1);
+}
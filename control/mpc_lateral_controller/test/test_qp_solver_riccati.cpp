@@ -0,0 +1,198 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "mpc_lateral_controller/qp_solver/qp_solver_riccati.hpp"
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <cmath>
+
+namespace
+{
+using autoware::motion::control::mpc_lateral_controller::QPSolverRiccati;
+using Eigen::MatrixXd;
+using Eigen::VectorXd;
+
+// lateral error, yaw error and steering with the first order delay along a sine curve
+struct Problem
+{
+  MatrixXd Ad_ex;
+  MatrixXd Bd_ex;
+  MatrixXd Wd_ex;
+  MatrixXd Qbar_ex;
+  VectorXd x0;
+  MatrixXd R;
+  MatrixXd r;
+  MatrixXd H;
+  MatrixXd f;
+  MatrixXd A;
+  VectorXd lb;
+  VectorXd ub;
+  VectorXd lbA;
+  VectorXd ubA;
+};
+
+Problem generateProblem(
+  const int N, const double velocity, const double steer_rate_lim, const double prev_steer)
+{
+  constexpr int DIM_X = 3;
+  constexpr double dt = 0.1;
+  constexpr double wheelbase = 2.7;
+  constexpr double steer_tau = 0.3;
+
+  Problem p;
+  p.Ad_ex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  p.Bd_ex = MatrixXd::Zero(DIM_X * N, 1);
+  p.Wd_ex = MatrixXd::Zero(DIM_X * N, 1);
+  p.Qbar_ex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  p.R = MatrixXd::Zero(N, N);
+  VectorXd u_ref(N);
+  for (int i = 0; i < N; ++i) {
+    const double k = 0.05 * std::sin(0.2 * i);
+    Eigen::Matrix3d A;
+    A << 0.0, velocity, 0.0, 0.0, 0.0, velocity / wheelbase, 0.0, 0.0, -1.0 / steer_tau;
+    p.Ad_ex.block(i * DIM_X, 0, DIM_X, DIM_X) = Eigen::Matrix3d::Identity() + A * dt;
+    p.Bd_ex(i * DIM_X + 2, 0) = dt / steer_tau;
+    p.Wd_ex(i * DIM_X + 1, 0) = -velocity * k * dt;
+    p.Qbar_ex(i * DIM_X, 0) = i == N - 1 ? 1.0 : 0.1;
+    p.Qbar_ex(i * DIM_X + 1, 1) = 0.3 * velocity * velocity;
+    p.R(i, i) = 1.0 + 0.25 * velocity * velocity;
+    u_ref(i) = std::atan(wheelbase * k);
+  }
+  p.r = -(u_ref.transpose() * p.R).transpose();
+
+  // steering rate and acceleration weight
+  const double steer_rate_r = 0.5 / (dt * dt);
+  const double steer_acc_r = 1.0e-4 / std::pow(dt, 4);
+  for (int i = 0; i < N - 1; ++i) {
+    p.R.block(i, i, 2, 2) += steer_rate_r * (Eigen::Matrix2d() << 1, -1, -1, 1).finished();
+  }
+  for (int i = 1; i < N - 1; ++i) {
+    p.R.block(i - 1, i - 1, 3, 3) +=
+      steer_acc_r * (Eigen::Matrix3d() << 1, -2, 1, -2, 4, -2, 1, -2, 1).finished();
+  }
+  p.x0 = Eigen::Vector3d(1.0, 0.1, prev_steer);
+
+  // condensed problem with the dense prediction matrices
+  MatrixXd Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
+  MatrixXd Bex = MatrixXd::Zero(DIM_X * N, N);
+  MatrixXd Wex = MatrixXd::Zero(DIM_X * N, 1);
+  MatrixXd Qex = MatrixXd::Zero(DIM_X * N, DIM_X * N);
+  for (int i = 0; i < N; ++i) {
+    const MatrixXd Ad = p.Ad_ex.block(i * DIM_X, 0, DIM_X, DIM_X);
+    Aex.block(i * DIM_X, 0, DIM_X, DIM_X) =
+      i == 0 ? Ad : MatrixXd(Ad * Aex.block((i - 1) * DIM_X, 0, DIM_X, DIM_X));
+    Wex.block(i * DIM_X, 0, DIM_X, 1) = p.Wd_ex.block(i * DIM_X, 0, DIM_X, 1);
+    if (i > 0) {
+      Wex.block(i * DIM_X, 0, DIM_X, 1) += Ad * Wex.block((i - 1) * DIM_X, 0, DIM_X, 1);
+      for (int j = 0; j < i; ++j) {
+        Bex.block(i * DIM_X, j, DIM_X, 1) = Ad * Bex.block((i - 1) * DIM_X, j, DIM_X, 1);
+      }
+    }
+    Bex.block(i * DIM_X, i, DIM_X, 1) = p.Bd_ex.block(i * DIM_X, 0, DIM_X, 1);
+    Qex.block(i * DIM_X, i * DIM_X, DIM_X, DIM_X) = p.Qbar_ex.block(i * DIM_X, 0, DIM_X, DIM_X);
+  }
+  p.H = Bex.transpose() * Qex * Bex + p.R;
+  p.f = Bex.transpose() * Qex * (Aex * p.x0 + Wex) + p.r;
+
+  p.A = MatrixXd::Identity(N, N);
+  for (int i = 1; i < N; ++i) {
+    p.A(i, i - 1) = -1.0;
+  }
+  p.lb = VectorXd::Constant(N, -0.7);
+  p.ub = VectorXd::Constant(N, 0.7);
+  p.ubA = VectorXd::Constant(N, steer_rate_lim * dt);
+  p.lbA = -p.ubA;
+  p.ubA(0) = prev_steer + steer_rate_lim * 0.03;
+  p.lbA(0) = prev_steer - steer_rate_lim * 0.03;
+  return p;
+}
+
+bool solveMultiStage(QPSolverRiccati & solver, const Problem & p, VectorXd & u)
+{
+  using SparseMatrix = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+  const SparseMatrix R = p.R.sparseView();
+  const SparseMatrix A = p.A.sparseView();
+  return solver.solveMultiStage(
+    p.Ad_ex, p.Bd_ex, p.Wd_ex, p.Qbar_ex, p.x0, R, p.r, A, p.lb, p.ub, p.lbA, p.ubA, u);
+}
+
+void expectFeasible(const Problem & p, const VectorXd & u)
+{
+  constexpr double eps = 1.0e-6;
+  const VectorXd Au = p.A * u;
+  EXPECT_TRUE(((u - p.lb).array() > -eps).all());
+  EXPECT_TRUE(((p.ub - u).array() > -eps).all());
+  EXPECT_TRUE(((Au - p.lbA).array() > -eps).all());
+  EXPECT_TRUE(((p.ubA - Au).array() > -eps).all());
+}
+}  // namespace
+
+TEST(TestQPSolverRiccati, Unconstrained)
+{
+  // the constraints are not active with the loose steering rate limit
+  const auto p = generateProblem(50, 10.0, 10.0, 0.0);
+  QPSolverRiccati solver(rclcpp::get_logger("test_qp_solver_riccati"));
+  const VectorXd u_expected = -p.H.llt().solve(p.f);
+
+  VectorXd u;
+  ASSERT_TRUE(solver.solve(p.H, p.f, p.A, p.lb, p.ub, p.lbA, p.ubA, u));
+  EXPECT_TRUE(u.isApprox(u_expected, 1.0e-6));
+
+  ASSERT_TRUE(solveMultiStage(solver, p, u));
+  EXPECT_TRUE(u.isApprox(u_expected, 1.0e-6));
+  EXPECT_GT(solver.getTakenIter(), 0);
+}
+
+TEST(TestQPSolverRiccati, MultiStageMatchesCondensed)
+{
+  QPSolverRiccati solver(rclcpp::get_logger("test_qp_solver_riccati"));
+  for (const int N : {1, 2, 10, 50, 200}) {
+    // the steering rate limit is active
+    const auto p = generateProblem(N, 3.0, 0.1, 0.1);
+    VectorXd u_condensed;
+    ASSERT_TRUE(solver.solve(p.H, p.f, p.A, p.lb, p.ub, p.lbA, p.ubA, u_condensed));
+    const double obj_condensed = solver.getObjVal();
+    expectFeasible(p, u_condensed);
+
+    VectorXd u;
+    ASSERT_TRUE(solveMultiStage(solver, p, u));
+    expectFeasible(p, u);
+    EXPECT_LT((u - u_condensed).lpNorm<Eigen::Infinity>(), 1.0e-6);
+
+    const double obj = 0.5 * u_condensed.dot(p.H * u_condensed) + p.f.col(0).dot(u_condensed);
+    EXPECT_NEAR(obj_condensed, obj, 1.0e-6 * std::abs(obj));
+  }
+}
+
+TEST(TestQPSolverRiccati, EqualityConstraint)
+{
+  // the steering rate limit is zero when the vehicle is stopped
+  const auto p = generateProblem(50, 0.0, 0.0, 0.05);
+  QPSolverRiccati solver(rclcpp::get_logger("test_qp_solver_riccati"));
+  VectorXd u;
+  ASSERT_TRUE(solveMultiStage(solver, p, u));
+  EXPECT_LT((u - VectorXd::Constant(50, 0.05)).lpNorm<Eigen::Infinity>(), 1.0e-6);
+}
+
+TEST(TestQPSolverRiccati, Infeasible)
+{
+  auto p = generateProblem(10, 10.0, 0.1, 0.5);
+  p.ub.setConstant(0.1);  // the previous steering is out of the steering limit
+  QPSolverRiccati solver(rclcpp::get_logger("test_qp_solver_riccati"));
+  VectorXd u;
+  EXPECT_FALSE(solveMultiStage(solver, p, u));
+}
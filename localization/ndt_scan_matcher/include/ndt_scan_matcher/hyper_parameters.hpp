@@ -44,6 +44,8 @@ struct HyperParameters
   {
     int64_t particles_num;
     int64_t n_startup_trials;
+    int64_t batch_size;
+    int64_t seed;
   } initial_pose_estimation;
 
   struct Validation
@@ -74,6 +76,8 @@ struct HyperParameters
     {
       bool enable;
       std::vector<Eigen::Vector2d> initial_pose_offset_model;
+      int64_t worker_num;
+      double time_budget_ms;
     } covariance_estimation;
   } covariance;
 
@@ -82,6 +86,12 @@ struct HyperParameters
     double update_distance;
     double map_radius;
     double lidar_radius;
+
+    struct Prefetch
+    {
+      bool enable;
+      double lookahead_time;
+    } prefetch;
   } dynamic_map_loading;
 
 public:
@@ -105,6 +115,11 @@ public:
       node->declare_parameter<int64_t>("initial_pose_estimation.particles_num");
     initial_pose_estimation.n_startup_trials =
       node->declare_parameter<int64_t>("initial_pose_estimation.n_startup_trials");
+    initial_pose_estimation.batch_size = std::max(
+      node->declare_parameter<int64_t>("initial_pose_estimation.batch_size"),
+      static_cast<int64_t>(1));
+    initial_pose_estimation.seed =
+      node->declare_parameter<int64_t>("initial_pose_estimation.seed");
 
     validation.lidar_topic_timeout_sec =
       node->declare_parameter<double>("validation.lidar_topic_timeout_sec");
@@ -160,6 +175,11 @@ public:
         covariance.covariance_estimation.enable = false;
       }
     }
+    covariance.covariance_estimation.worker_num = std::max(
+      node->declare_parameter<int64_t>("covariance.covariance_estimation.worker_num"),
+      static_cast<int64_t>(1));
+    covariance.covariance_estimation.time_budget_ms =
+      node->declare_parameter<double>("covariance.covariance_estimation.time_budget_ms");
 
     dynamic_map_loading.update_distance =
       node->declare_parameter<double>("dynamic_map_loading.update_distance");
@@ -167,6 +187,10 @@ public:
       node->declare_parameter<double>("dynamic_map_loading.map_radius");
     dynamic_map_loading.lidar_radius =
       node->declare_parameter<double>("dynamic_map_loading.lidar_radius");
+    dynamic_map_loading.prefetch.enable =
+      node->declare_parameter<bool>("dynamic_map_loading.prefetch.enable");
+    dynamic_map_loading.prefetch.lookahead_time =
+      node->declare_parameter<double>("dynamic_map_loading.prefetch.lookahead_time");
   }
 };
 
@@ -25,6 +25,7 @@
 
 #include <autoware_map_msgs/srv/get_differential_point_cloud_map.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -32,8 +33,12 @@
 #include <multigrid_pclomp/multigrid_ndt_omp.h>
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <thread>
@@ -45,20 +50,59 @@ class MapUpdateModule
   using PointTarget = pcl::PointXYZ;
   using NdtType = pclomp::MultiGridNormalDistributionsTransform<PointSource, PointTarget>;
   using NdtPtrType = std::shared_ptr<NdtType>;
+  using TileCloudConstPtr = pcl::shared_ptr<const pcl::PointCloud<PointTarget>>;
 
 public:
   MapUpdateModule(
     rclcpp::Node * node, std::mutex * ndt_ptr_mutex, NdtPtrType & ndt_ptr,
-    HyperParameters::DynamicMapLoading param);
+    std::vector<NdtPtrType> & worker_ndt_ptr_array, HyperParameters::DynamicMapLoading param);
+  ~MapUpdateModule();
+
+  struct UpdateStatistics
+  {
+    double execution_time_ms{0.0};
+    size_t added_tile_num{0};
+    size_t removed_tile_num{0};
+    size_t loaded_tile_num{0};
+    size_t loaded_point_num{0};
+  };
+
+  UpdateStatistics get_update_statistics() const;
 
 private:
   friend class NDTScanMatcher;
 
+  // Difference between the tiles held by the NDT instances and the tiles around a position
+  struct MapDiff
+  {
+    std::vector<std::string> ids_to_add;
+    std::vector<std::string> ids_to_remove;
+  };
+
+  // Query the pcd loader and decode the new tiles into tile_store_
+  std::optional<MapDiff> request_map_diff(
+    const geometry_msgs::msg::Point & position, const std::vector<std::string> & cached_ids);
+  // Apply a diff to the specified NDT, sharing the decoded tiles from tile_store_
+  void apply_map_diff(const MapDiff & diff, NdtType & ndt) const;
   // Update the specified NDT
   bool update_ndt(const geometry_msgs::msg::Point & position, NdtType & ndt);
   void update_map(const geometry_msgs::msg::Point & position);
-  [[nodiscard]] bool should_update_map(const geometry_msgs::msg::Point & position);
+  // Let the prefetch worker update the map around the position, without waiting for it
+  void request_prefetch(const geometry_msgs::msg::Point & position);
+  void prefetch_loop();
+  // Position around which the map should be loaded. With prefetch enabled, it is moved ahead of
+  // the current position along the velocity.
+  [[nodiscard]] geometry_msgs::msg::Point get_map_loading_position(
+    const geometry_msgs::msg::Point & position, const geometry_msgs::msg::Vector3 & velocity) const;
+  // Return false while an update is in progress, which will move the last update position
+  [[nodiscard]] bool should_update_map(
+    const geometry_msgs::msg::Point & position,
+    const geometry_msgs::msg::Point & map_loading_position);
   void publish_partial_pcd_map();
+  // Copy the specified NDT, whose voxel grid is already built, to the worker NDTs, splitting the
+  // NDT threads between them
+  [[nodiscard]] static std::vector<NdtPtrType> create_worker_ndt_ptr_array(
+    const NdtType & ndt, const size_t worker_num);
 
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr loaded_pcd_pub_;
 
@@ -66,6 +110,9 @@ private:
     pcd_loader_client_;
 
   NdtPtrType & ndt_ptr_;
+  // Copies of ndt_ptr_ used to align in parallel. They are replaced under the same lock as
+  // ndt_ptr_, so they always hold the same map.
+  std::vector<NdtPtrType> & worker_ndt_ptr_array_;
   std::mutex * ndt_ptr_mutex_;
   rclcpp::Logger logger_;
   rclcpp::Clock::SharedPtr clock_;
@@ -74,9 +121,31 @@ private:
 
   HyperParameters::DynamicMapLoading param_;
 
-  // Indicate if there is a prefetch thread waiting for being collected
+  // Decoded map tiles keyed by cell_id. Both NDT instances share these clouds, so keeping the
+  // secondary NDT in sync only replays the last diff instead of deep-copying the whole map.
+  std::map<std::string, TileCloudConstPtr> tile_store_;
+
+  // NDT updated off the lock and swapped with ndt_ptr_. It is the previous ndt_ptr_, lagging behind
+  // it by pending_diff_
   NdtPtrType secondary_ndt_ptr_;
   bool need_rebuild_;
+  // Diff which has been applied to ndt_ptr_ but not yet to the secondary NDTs
+  std::optional<MapDiff> pending_diff_ = std::nullopt;
+
+  // Held during an update, which is done either by the prefetch worker or by the caller of
+  // update_map. It guards the members above except ndt_ptr_ and worker_ndt_ptr_array_.
+  std::mutex update_mutex_;
+
+  // Latest position requested to the prefetch worker, which requests and decodes the tiles and
+  // voxelizes them off the callbacks. Only the pointer swap is done under ndt_ptr_mutex_.
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cv_;
+  std::optional<geometry_msgs::msg::Point> prefetch_position_ = std::nullopt;
+  std::atomic<bool> stop_prefetch_{false};
+  std::thread prefetch_thread_;
+
+  mutable std::mutex statistics_mutex_;
+  UpdateStatistics statistics_;
 };
 
 #endif  // NDT_SCAN_MATCHER__MAP_UPDATE_MODULE_HPP_
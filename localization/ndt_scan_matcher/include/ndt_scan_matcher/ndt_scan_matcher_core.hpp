@@ -23,6 +23,7 @@
 
 #include <rclcpp/rclcpp.hpp>
 #include <tier4_autoware_utils/ros/logger_level_configure.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 
 #include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <geometry_msgs/msg/pose_array.hpp>
@@ -31,6 +32,7 @@
 #include <nav_msgs/msg/odometry.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <std_srvs/srv/set_bool.hpp>
+#include <tier4_debug_msgs/msg/float32_multi_array_stamped.hpp>
 #include <tier4_debug_msgs/msg/float32_stamped.hpp>
 #include <tier4_debug_msgs/msg/int32_stamped.hpp>
 #include <tier4_localization_msgs/srv/pose_with_covariance_stamped.hpp>
@@ -83,6 +85,7 @@ private:
   void service_trigger_node(
     const std_srvs::srv::SetBool::Request::SharedPtr req,
     std_srvs::srv::SetBool::Response::SharedPtr res);
+  void reset_ekf_velocity();
 
   void callback_timer();
   void callback_sensor_points(
@@ -148,6 +151,8 @@ private:
     initial_pose_with_covariance_pub_;
   rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr multi_ndt_pose_pub_;
   rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr multi_initial_pose_pub_;
+  rclcpp::Publisher<tier4_debug_msgs::msg::Float32MultiArrayStamped>::SharedPtr
+    multi_ndt_exe_time_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr exe_time_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr transform_probability_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr
@@ -180,6 +185,11 @@ private:
   rclcpp::CallbackGroup::SharedPtr timer_callback_group_;
 
   std::shared_ptr<NormalDistributionsTransform> ndt_ptr_;
+  // NDT instances holding ndt_ptr_'s map to align the covariance estimation offsets and the initial
+  // pose estimation particles in parallel
+  std::vector<std::shared_ptr<NormalDistributionsTransform>> worker_ndt_ptr_array_;
+  // One thread per worker NDT, kept between the scans
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> worker_pool_;
   std::shared_ptr<std::map<std::string, std::string>> state_ptr_;
 
   Eigen::Matrix4f base_to_sensor_matrix_;
@@ -187,9 +197,13 @@ private:
   std::mutex ndt_ptr_mtx_;
   std::unique_ptr<SmartPoseBuffer> initial_pose_buffer_;
 
-  // Keep latest position for dynamic map loading
+  // Keep latest position and velocity for dynamic map loading
   std::mutex latest_ekf_position_mtx_;
   std::optional<geometry_msgs::msg::Point> latest_ekf_position_ = std::nullopt;
+  // EKF pose from which the velocity is estimated
+  std::optional<geometry_msgs::msg::Point> velocity_reference_position_ = std::nullopt;
+  std::optional<rclcpp::Time> velocity_reference_stamp_ = std::nullopt;
+  geometry_msgs::msg::Vector3 latest_ekf_velocity_;
 
   std::unique_ptr<SmartPoseBuffer> regularization_pose_buffer_;
 
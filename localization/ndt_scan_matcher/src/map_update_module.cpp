@@ -16,8 +16,9 @@
 
 MapUpdateModule::MapUpdateModule(
   rclcpp::Node * node, std::mutex * ndt_ptr_mutex, NdtPtrType & ndt_ptr,
-  HyperParameters::DynamicMapLoading param)
+  std::vector<NdtPtrType> & worker_ndt_ptr_array, HyperParameters::DynamicMapLoading param)
 : ndt_ptr_(ndt_ptr),
+  worker_ndt_ptr_array_(worker_ndt_ptr_array),
   ndt_ptr_mutex_(ndt_ptr_mutex),
   logger_(node->get_logger()),
   clock_(node->get_clock()),
@@ -33,6 +34,7 @@ MapUpdateModule::MapUpdateModule(
 
   if (ndt_ptr_) {
     *secondary_ndt_ptr_ = *ndt_ptr_;
+    worker_ndt_ptr_array_ = create_worker_ndt_ptr_array(*ndt_ptr_, worker_ndt_ptr_array_.size());
   } else {
     RCLCPP_ERROR_STREAM_THROTTLE(logger_, *clock_, 1000, "Attempt to update a null NDT pointer.");
   }
@@ -43,11 +45,82 @@ MapUpdateModule::MapUpdateModule(
   // and ndt_ptr_ is only locked when swapping its pointer with
   // secondary_ndt_ptr_.
   need_rebuild_ = true;
+
+  if (param_.prefetch.enable) {
+    prefetch_thread_ = std::thread(&MapUpdateModule::prefetch_loop, this);
+  }
+}
+
+MapUpdateModule::~MapUpdateModule()
+{
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    stop_prefetch_ = true;
+  }
+  prefetch_cv_.notify_one();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+}
+
+void MapUpdateModule::request_prefetch(const geometry_msgs::msg::Point & position)
+{
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    // Only the latest position matters, so a position the worker has not started yet is replaced
+    prefetch_position_ = position;
+  }
+  prefetch_cv_.notify_one();
+}
+
+void MapUpdateModule::prefetch_loop()
+{
+  while (true) {
+    geometry_msgs::msg::Point position;
+    {
+      std::unique_lock<std::mutex> lock(prefetch_mutex_);
+      prefetch_cv_.wait(lock, [this]() { return stop_prefetch_ || prefetch_position_; });
+      if (stop_prefetch_) {
+        return;
+      }
+      position = prefetch_position_.value();
+      prefetch_position_ = std::nullopt;
+    }
+    update_map(position);
+  }
+}
+
+geometry_msgs::msg::Point MapUpdateModule::get_map_loading_position(
+  const geometry_msgs::msg::Point & position, const geometry_msgs::msg::Vector3 & velocity) const
+{
+  if (!param_.prefetch.enable) {
+    return position;
+  }
+
+  double dx = velocity.x * param_.prefetch.lookahead_time;
+  double dy = velocity.y * param_.prefetch.lookahead_time;
+
+  // The current LiDAR range must stay inside the map loaded around the predicted position
+  const double lookahead_distance = std::hypot(dx, dy);
+  const double max_lookahead_distance = std::max(param_.map_radius - param_.lidar_radius, 0.0);
+  if (lookahead_distance > max_lookahead_distance) {
+    const double scale = max_lookahead_distance / lookahead_distance;
+    dx *= scale;
+    dy *= scale;
+  }
+
+  geometry_msgs::msg::Point map_loading_position = position;
+  map_loading_position.x += dx;
+  map_loading_position.y += dy;
+  return map_loading_position;
 }
 
-bool MapUpdateModule::should_update_map(const geometry_msgs::msg::Point & position)
+bool MapUpdateModule::should_update_map(
+  const geometry_msgs::msg::Point & position,
+  const geometry_msgs::msg::Point & map_loading_position)
 {
-  if (last_update_position_ == std::nullopt) {
+  std::unique_lock<std::mutex> lock(update_mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || last_update_position_ == std::nullopt) {
     return false;
   }
 
@@ -61,11 +134,17 @@ bool MapUpdateModule::should_update_map(const geometry_msgs::msg::Point & positi
     need_rebuild_ = true;
   }
 
-  return distance > param_.update_distance;
+  const double loading_dx = map_loading_position.x - last_update_position_.value().x;
+  const double loading_dy = map_loading_position.y - last_update_position_.value().y;
+  return std::hypot(loading_dx, loading_dy) > param_.update_distance;
 }
 
 void MapUpdateModule::update_map(const geometry_msgs::msg::Point & position)
 {
+  std::lock_guard<std::mutex> update_lock(update_mutex_);
+  const auto exe_start_time = std::chrono::system_clock::now();
+  MapDiff applied_diff;
+
   // If the current position is super far from the previous loading position,
   // lock and rebuild ndt_ptr_
   if (need_rebuild_) {
@@ -78,53 +157,127 @@ void MapUpdateModule::update_map(const geometry_msgs::msg::Point & position)
 
     ndt_ptr_->setParams(param);
 
+    tile_store_.clear();
     update_ndt(position, *ndt_ptr_);
     ndt_ptr_->setInputSource(input_source);
+    // The worker NDTs are replaced in the same critical section, so that no scan sees the new map
+    // on ndt_ptr_ and the old one on the workers
+    std::vector<NdtPtrType> previous_worker_ndt_ptr_array =
+      create_worker_ndt_ptr_array(*ndt_ptr_, worker_ndt_ptr_array_.size());
+    worker_ndt_ptr_array_.swap(previous_worker_ndt_ptr_array);
     ndt_ptr_mutex_->unlock();
     need_rebuild_ = false;
+
+    // A full rebuild is rare, so the secondary NDT is simply copied from the rebuilt one here.
+    secondary_ndt_ptr_.reset(new NdtType);
+    *secondary_ndt_ptr_ = *ndt_ptr_;
+    pending_diff_ = std::nullopt;
+    applied_diff.ids_to_add = ndt_ptr_->getCurrentMapIDs();
   } else {
+    // The secondary NDT is the previous primary one, which lags behind by the last diff.
+    // Replay it before the tiles removed by the next diff are dropped from tile_store_.
+    if (pending_diff_) {
+      apply_map_diff(pending_diff_.value(), *secondary_ndt_ptr_);
+      pending_diff_ = std::nullopt;
+    }
+
     // Load map to the secondary_ndt_ptr, which does not require a mutex lock
     // Since the update of the secondary ndt ptr and the NDT align (done on
     // the main ndt_ptr_) overlap, the latency of updating/alignment reduces partly.
     // If the updating is done the main ndt_ptr_, either the update or the NDT
     // align will be blocked by the other.
-    const bool updated = update_ndt(position, *secondary_ndt_ptr_);
-    if (!updated) {
+    const std::optional<MapDiff> diff =
+      request_map_diff(position, secondary_ndt_ptr_->getCurrentMapIDs());
+    if (!diff) {
       last_update_position_ = position;
       return;
     }
+    apply_map_diff(diff.value(), *secondary_ndt_ptr_);
+    secondary_ndt_ptr_->createVoxelKdtree();
+    // The worker NDTs copy the voxelized map of the secondary NDT, which is voxelized only once
+    std::vector<NdtPtrType> previous_worker_ndt_ptr_array =
+      create_worker_ndt_ptr_array(*secondary_ndt_ptr_, worker_ndt_ptr_array_.size());
 
     ndt_ptr_mutex_->lock();
-    auto dummy_ptr = ndt_ptr_;
+    auto previous_ndt_ptr = ndt_ptr_;
     auto input_source = ndt_ptr_->getInputSource();
     ndt_ptr_ = secondary_ndt_ptr_;
     ndt_ptr_->setInputSource(input_source);
+    worker_ndt_ptr_array_.swap(previous_worker_ndt_ptr_array);
     ndt_ptr_mutex_->unlock();
-
-    dummy_ptr.reset();
+    // The previous worker NDTs are released here, out of the lock
+    previous_worker_ndt_ptr_array.clear();
+
+    // The previous primary NDTs are not referenced by the scan matcher anymore, so they are reused
+    // as the next secondary NDTs instead of deep-copying the whole map and its kd-tree.
+    secondary_ndt_ptr_ = previous_ndt_ptr;
+    pending_diff_ = diff;
+    applied_diff = diff.value();
   }
 
-  secondary_ndt_ptr_.reset(new NdtType);
-  *secondary_ndt_ptr_ = *ndt_ptr_;
-
   // Memorize the position of the last update
   last_update_position_ = position;
 
+  const auto exe_end_time = std::chrono::system_clock::now();
+  const auto duration_micro_sec =
+    std::chrono::duration_cast<std::chrono::microseconds>(exe_end_time - exe_start_time).count();
+  {
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    statistics_.execution_time_ms = static_cast<double>(duration_micro_sec) / 1000.0;
+    statistics_.added_tile_num = applied_diff.ids_to_add.size();
+    statistics_.removed_tile_num = applied_diff.ids_to_remove.size();
+    statistics_.loaded_tile_num = tile_store_.size();
+    statistics_.loaded_point_num = 0;
+    for (const auto & tile : tile_store_) {
+      statistics_.loaded_point_num += tile.second->size();
+    }
+  }
+
   // Publish the new ndt maps
   publish_partial_pcd_map();
 }
 
+MapUpdateModule::UpdateStatistics MapUpdateModule::get_update_statistics() const
+{
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  return statistics_;
+}
+
 bool MapUpdateModule::update_ndt(const geometry_msgs::msg::Point & position, NdtType & ndt)
+{
+  const std::optional<MapDiff> diff = request_map_diff(position, ndt.getCurrentMapIDs());
+  if (!diff) {
+    return false;  // No update
+  }
+
+  const auto exe_start_time = std::chrono::system_clock::now();
+
+  apply_map_diff(diff.value(), ndt);
+  ndt.createVoxelKdtree();
+
+  const auto exe_end_time = std::chrono::system_clock::now();
+  const auto duration_micro_sec =
+    std::chrono::duration_cast<std::chrono::microseconds>(exe_end_time - exe_start_time).count();
+  const auto exe_time = static_cast<double>(duration_micro_sec) / 1000.0;
+  RCLCPP_INFO(logger_, "Time duration for creating new ndt_ptr: %lf [ms]", exe_time);
+  return true;  // Updated
+}
+
+std::optional<MapUpdateModule::MapDiff> MapUpdateModule::request_map_diff(
+  const geometry_msgs::msg::Point & position, const std::vector<std::string> & cached_ids)
 {
   auto request = std::make_shared<autoware_map_msgs::srv::GetDifferentialPointCloudMap::Request>();
 
   request->area.center_x = static_cast<float>(position.x);
   request->area.center_y = static_cast<float>(position.y);
   request->area.radius = static_cast<float>(param_.map_radius);
-  request->cached_ids = ndt.getCurrentMapIDs();
+  request->cached_ids = cached_ids;
 
   while (!pcd_loader_client_->wait_for_service(std::chrono::seconds(1)) && rclcpp::ok()) {
     RCLCPP_INFO(logger_, "Waiting for pcd loader service. Check the pointcloud_map_loader.");
+    if (stop_prefetch_) {
+      return std::nullopt;  // No update
+    }
   }
 
   // send a request to map_loader
@@ -135,8 +288,8 @@ bool MapUpdateModule::update_ndt(const geometry_msgs::msg::Point & position, Ndt
   std::future_status status = result.wait_for(std::chrono::seconds(0));
   while (status != std::future_status::ready) {
     RCLCPP_INFO(logger_, "waiting response");
-    if (!rclcpp::ok()) {
-      return false;  // No update
+    if (!rclcpp::ok() || stop_prefetch_) {
+      return std::nullopt;  // No update
     }
     status = result.wait_for(std::chrono::seconds(1));
   }
@@ -148,37 +301,65 @@ bool MapUpdateModule::update_ndt(const geometry_msgs::msg::Point & position, Ndt
     logger_, "Update map (Add: %lu, Remove: %lu)", maps_to_add.size(), map_ids_to_remove.size());
   if (maps_to_add.empty() && map_ids_to_remove.empty()) {
     RCLCPP_INFO(logger_, "Skip map update");
-    return false;  // No update
+    return std::nullopt;  // No update
   }
 
-  const auto exe_start_time = std::chrono::system_clock::now();
-  const size_t add_size = maps_to_add.size();
   // Perform heavy processing outside of the lock scope
-  std::vector<pcl::shared_ptr<pcl::PointCloud<PointTarget>>> points_pcl(add_size);
+  MapDiff diff;
+  diff.ids_to_add.reserve(maps_to_add.size());
+  for (const auto & map_to_add : maps_to_add) {
+    auto points_pcl = pcl::make_shared<pcl::PointCloud<PointTarget>>();
+    pcl::fromROSMsg(map_to_add.pointcloud, *points_pcl);
+    tile_store_[map_to_add.cell_id] = points_pcl;
+    diff.ids_to_add.push_back(map_to_add.cell_id);
+  }
 
-  for (size_t i = 0; i < add_size; i++) {
-    points_pcl[i] = pcl::make_shared<pcl::PointCloud<PointTarget>>();
-    pcl::fromROSMsg(maps_to_add[i].pointcloud, *points_pcl[i]);
+  diff.ids_to_remove = map_ids_to_remove;
+  for (const std::string & map_id_to_remove : map_ids_to_remove) {
+    tile_store_.erase(map_id_to_remove);
   }
 
+  return diff;
+}
+
+void MapUpdateModule::apply_map_diff(const MapDiff & diff, NdtType & ndt) const
+{
   // Add pcd
-  for (size_t i = 0; i < add_size; i++) {
-    ndt.addTarget(points_pcl[i], maps_to_add[i].cell_id);
+  for (const std::string & map_id_to_add : diff.ids_to_add) {
+    const auto tile_itr = tile_store_.find(map_id_to_add);
+    if (tile_itr == tile_store_.end()) {
+      RCLCPP_WARN_STREAM(logger_, "Map tile " << map_id_to_add << " is not in the tile store.");
+      continue;
+    }
+    ndt.addTarget(tile_itr->second, map_id_to_add);
   }
 
   // Remove pcd
-  for (const std::string & map_id_to_remove : map_ids_to_remove) {
+  for (const std::string & map_id_to_remove : diff.ids_to_remove) {
     ndt.removeTarget(map_id_to_remove);
   }
+}
 
-  ndt.createVoxelKdtree();
+std::vector<MapUpdateModule::NdtPtrType> MapUpdateModule::create_worker_ndt_ptr_array(
+  const NdtType & ndt, const size_t worker_num)
+{
+  std::vector<NdtPtrType> worker_ndt_ptr_array;
+  if (worker_num == 0) {
+    return worker_ndt_ptr_array;
+  }
 
-  const auto exe_end_time = std::chrono::system_clock::now();
-  const auto duration_micro_sec =
-    std::chrono::duration_cast<std::chrono::microseconds>(exe_end_time - exe_start_time).count();
-  const auto exe_time = static_cast<double>(duration_micro_sec) / 1000.0;
-  RCLCPP_INFO(logger_, "Time duration for creating new ndt_ptr: %lf [ms]", exe_time);
-  return true;  // Updated
+  pclomp::NdtParams worker_param = ndt.getParams();
+  worker_param.num_threads = std::max(worker_param.num_threads / static_cast<int>(worker_num), 1);
+
+  // The NDT library keeps its voxel grid and kd-tree by value, so the workers copy the ones
+  // already built on ndt instead of voxelizing the tiles again
+  worker_ndt_ptr_array.reserve(worker_num);
+  for (size_t i = 0; i < worker_num; i++) {
+    auto worker_ndt_ptr = std::make_shared<NdtType>(ndt);
+    worker_ndt_ptr->setParams(worker_param);
+    worker_ndt_ptr_array.push_back(worker_ndt_ptr);
+  }
+  return worker_ndt_ptr_array;
 }
 
 void MapUpdateModule::publish_partial_pcd_map()
@@ -33,10 +33,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <functional>
 #include <iomanip>
-#include <thread>
+#include <random>
 
 tier4_debug_msgs::msg::Float32Stamped make_float32_stamped(
   const builtin_interfaces::msg::Time & stamp, const float data)
@@ -133,6 +134,8 @@ NDTScanMatcher::NDTScanMatcher()
   multi_ndt_pose_pub_ = this->create_publisher<geometry_msgs::msg::PoseArray>("multi_ndt_pose", 10);
   multi_initial_pose_pub_ =
     this->create_publisher<geometry_msgs::msg::PoseArray>("multi_initial_pose", 10);
+  multi_ndt_exe_time_pub_ = this->create_publisher<tier4_debug_msgs::msg::Float32MultiArrayStamped>(
+    "multi_ndt_exe_time_ms", 10);
   exe_time_pub_ = this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>("exe_time_ms", 10);
   transform_probability_pub_ =
     this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>("transform_probability", 10);
@@ -181,8 +184,22 @@ NDTScanMatcher::NDTScanMatcher()
     this->get_logger(), param_.validation.initial_pose_timeout_sec,
     param_.validation.initial_pose_distance_tolerance_m);
 
-  map_update_module_ =
-    std::make_unique<MapUpdateModule>(this, &ndt_ptr_mtx_, ndt_ptr_, param_.dynamic_map_loading);
+  // The worker NDTs of the covariance estimation follow the map updates. Those of the batch initial
+  // pose estimation are copied from ndt_ptr_ only while it runs, and they share the worker pool.
+  int64_t worker_num = 0;
+  if (
+    param_.covariance.covariance_estimation.enable &&
+    param_.covariance.covariance_estimation.worker_num > 1) {
+    worker_num = param_.covariance.covariance_estimation.worker_num;
+    worker_ndt_ptr_array_.resize(worker_num);
+  }
+  const int64_t thread_num = std::max(worker_num, param_.initial_pose_estimation.batch_size);
+  if (thread_num > 1) {
+    worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(thread_num);
+  }
+
+  map_update_module_ = std::make_unique<MapUpdateModule>(
+    this, &ndt_ptr_mtx_, ndt_ptr_, worker_ndt_ptr_array_, param_.dynamic_map_loading);
 
   logger_configure_ = std::make_unique<tier4_autoware_utils::LoggerLevelConfigure>(this);
 }
@@ -260,18 +277,36 @@ void NDTScanMatcher::callback_timer()
   if (!is_activated_) {
     return;
   }
-  std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
-  if (latest_ekf_position_ == std::nullopt) {
+  // Copy the latest position and velocity, so that loading the map on this timer's own callback
+  // group does not block callback_initial_pose
+  std::optional<geometry_msgs::msg::Point> latest_ekf_position = std::nullopt;
+  geometry_msgs::msg::Vector3 latest_ekf_velocity;
+  {
+    std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
+    latest_ekf_position = latest_ekf_position_;
+    latest_ekf_velocity = latest_ekf_velocity_;
+  }
+  if (latest_ekf_position == std::nullopt) {
     RCLCPP_ERROR_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), 1000,
       "Cannot find the reference position for map update. Please check if the EKF odometry is "
       "provided to NDT.");
     return;
   }
+  const geometry_msgs::msg::Point map_loading_position =
+    map_update_module_->get_map_loading_position(latest_ekf_position.value(), latest_ekf_velocity);
   // continue only if we should update the map
-  if (map_update_module_->should_update_map(latest_ekf_position_.value())) {
+  if (!map_update_module_->should_update_map(latest_ekf_position.value(), map_loading_position)) {
+    return;
+  }
+  if (param_.dynamic_map_loading.prefetch.enable) {
+    // The tiles are requested, decoded and voxelized on the prefetch worker, so that this timer
+    // does not wait for the pcd loader
+    RCLCPP_INFO(this->get_logger(), "Request prefetching NDT map (timer_callback)");
+    map_update_module_->request_prefetch(map_loading_position);
+  } else {
     RCLCPP_INFO(this->get_logger(), "Start updating NDT map (timer_callback)");
-    map_update_module_->update_map(latest_ekf_position_.value());
+    map_update_module_->update_map(map_loading_position);
   }
 }
 
@@ -293,7 +328,30 @@ void NDTScanMatcher::callback_initial_pose(
   {
     // latest_ekf_position_ is also used by callback_timer, so it is necessary to acquire the lock
     std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
-    latest_ekf_position_ = initial_pose_msg_ptr->pose.pose.position;
+    const rclcpp::Time stamp = initial_pose_msg_ptr->header.stamp;
+    const geometry_msgs::msg::Point & position = initial_pose_msg_ptr->pose.pose.position;
+    // The velocity is averaged over velocity_estimation_period, since the difference between two
+    // consecutive EKF poses is dominated by their noise
+    constexpr double velocity_estimation_period = 0.5;
+    if (velocity_reference_position_ == std::nullopt || velocity_reference_stamp_ == std::nullopt) {
+      velocity_reference_position_ = position;
+      velocity_reference_stamp_ = stamp;
+    } else {
+      const double dt = (stamp - velocity_reference_stamp_.value()).seconds();
+      if (dt <= 0.0) {
+        // e.g. a rosbag replayed from the beginning
+        latest_ekf_velocity_ = geometry_msgs::msg::Vector3{};
+        velocity_reference_position_ = position;
+        velocity_reference_stamp_ = stamp;
+      } else if (dt >= velocity_estimation_period) {
+        latest_ekf_velocity_.x = (position.x - velocity_reference_position_.value().x) / dt;
+        latest_ekf_velocity_.y = (position.y - velocity_reference_position_.value().y) / dt;
+        latest_ekf_velocity_.z = (position.z - velocity_reference_position_.value().z) / dt;
+        velocity_reference_position_ = position;
+        velocity_reference_stamp_ = stamp;
+      }
+    }
+    latest_ekf_position_ = position;
   }
 }
 
@@ -488,6 +546,18 @@ void NDTScanMatcher::callback_sensor_points(
     std::to_string(is_local_optimal_solution_oscillation);
   (*state_ptr_)["execution_time"] = std::to_string(exe_time);
 
+  const MapUpdateModule::UpdateStatistics map_update_statistics =
+    map_update_module_->get_update_statistics();
+  (*state_ptr_)["map_update_execution_time"] =
+    std::to_string(map_update_statistics.execution_time_ms);
+  (*state_ptr_)["map_update_added_tile_num"] = std::to_string(map_update_statistics.added_tile_num);
+  (*state_ptr_)["map_update_removed_tile_num"] =
+    std::to_string(map_update_statistics.removed_tile_num);
+  (*state_ptr_)["map_update_loaded_tile_num"] =
+    std::to_string(map_update_statistics.loaded_tile_num);
+  (*state_ptr_)["map_update_loaded_point_num"] =
+    std::to_string(map_update_statistics.loaded_point_num);
+
   publish_diagnostic();
 }
 
@@ -734,12 +804,11 @@ std::array<double, 36> NDTScanMatcher::estimate_covariance(
   }
 
   // first result is added to mean
-  const int n =
-    static_cast<int>(param_.covariance.covariance_estimation.initial_pose_offset_model.size()) + 1;
   const Eigen::Vector2d ndt_pose_2d(ndt_result.pose(0, 3), ndt_result.pose(1, 3));
   Eigen::Vector2d mean = ndt_pose_2d;
   std::vector<Eigen::Vector2d> ndt_pose_2d_vec;
-  ndt_pose_2d_vec.reserve(n);
+  ndt_pose_2d_vec.reserve(
+    param_.covariance.covariance_estimation.initial_pose_offset_model.size() + 1);
   ndt_pose_2d_vec.emplace_back(ndt_pose_2d);
 
   geometry_msgs::msg::PoseArray multi_ndt_result_msg;
@@ -752,26 +821,105 @@ std::array<double, 36> NDTScanMatcher::estimate_covariance(
   multi_initial_pose_msg.poses.push_back(matrix4f_to_pose(initial_pose_matrix));
 
   // multiple searches
-  for (const auto & pose_offset :
-       param_.covariance.covariance_estimation.initial_pose_offset_model) {
-    const Eigen::Vector2d rotated_pose_offset_2d = rot * pose_offset;
+  const std::vector<Eigen::Vector2d> & initial_pose_offset_model =
+    param_.covariance.covariance_estimation.initial_pose_offset_model;
+  const size_t offset_num = initial_pose_offset_model.size();
+  std::vector<Eigen::Matrix4f> sub_initial_pose_matrix_array(offset_num);
+  for (size_t i = 0; i < offset_num; i++) {
+    const Eigen::Vector2d rotated_pose_offset_2d = rot * initial_pose_offset_model[i];
 
     Eigen::Matrix4f sub_initial_pose_matrix(Eigen::Matrix4f::Identity());
     sub_initial_pose_matrix = ndt_result.pose;
     sub_initial_pose_matrix(0, 3) += static_cast<float>(rotated_pose_offset_2d.x());
     sub_initial_pose_matrix(1, 3) += static_cast<float>(rotated_pose_offset_2d.y());
+    sub_initial_pose_matrix_array[i] = sub_initial_pose_matrix;
+  }
 
-    auto sub_output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
-    ndt_ptr_->align(*sub_output_cloud, sub_initial_pose_matrix);
-    const Eigen::Matrix4f sub_ndt_result = ndt_ptr_->getResult().pose;
+  // The worker NDTs hold the same map as ndt_ptr_ and only need the current input source.
+  const size_t worker_num = std::min(
+    static_cast<size_t>(param_.covariance.covariance_estimation.worker_num),
+    worker_ndt_ptr_array_.size());
+  std::vector<std::shared_ptr<NormalDistributionsTransform>> ndt_ptr_array;
+  if (worker_num > 1) {
+    ndt_ptr_array.assign(worker_ndt_ptr_array_.begin(), worker_ndt_ptr_array_.begin() + worker_num);
+    for (const auto & worker_ndt_ptr : ndt_ptr_array) {
+      worker_ndt_ptr->setInputSource(ndt_ptr_->getInputSource());
+    }
+  } else {
+    ndt_ptr_array.push_back(ndt_ptr_);
+  }
 
-    const Eigen::Vector2d sub_ndt_pose_2d = sub_ndt_result.topRightCorner<2, 1>().cast<double>();
+  std::vector<Eigen::Matrix4f> sub_ndt_result_array(offset_num);
+  std::vector<double> sub_exe_time_ms_array(offset_num, 0.0);
+  // std::vector<bool> is avoided, as its elements cannot be written concurrently
+  std::vector<uint8_t> is_aligned_array(offset_num, 0);
+  std::atomic<size_t> next_offset_index{0};
+  const auto start_time = std::chrono::system_clock::now();
+  auto align_offsets = [&](const size_t worker_index) {
+    if (worker_index >= ndt_ptr_array.size()) {
+      return;
+    }
+    for (size_t i = next_offset_index++; i < offset_num; i = next_offset_index++) {
+      const auto sub_start_time = std::chrono::system_clock::now();
+      const double elapsed_time_ms =
+        static_cast<double>(
+          std::chrono::duration_cast<std::chrono::microseconds>(sub_start_time - start_time)
+            .count()) /
+        1000.0;
+      if (elapsed_time_ms > param_.covariance.covariance_estimation.time_budget_ms) {
+        return;
+      }
+
+      auto sub_output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+      ndt_ptr_array[worker_index]->align(*sub_output_cloud, sub_initial_pose_matrix_array[i]);
+      sub_ndt_result_array[i] = ndt_ptr_array[worker_index]->getResult().pose;
+      const auto sub_end_time = std::chrono::system_clock::now();
+      sub_exe_time_ms_array[i] =
+        static_cast<double>(
+          std::chrono::duration_cast<std::chrono::microseconds>(sub_end_time - sub_start_time)
+            .count()) /
+        1000.0;
+      is_aligned_array[i] = 1;
+    }
+  };
+
+  // The offsets are taken one by one by the workers of the pool, which are kept between scans
+  if (ndt_ptr_array.size() > 1) {
+    worker_pool_->run(align_offsets);
+  } else {
+    align_offsets(0);
+  }
+
+  const size_t aligned_num =
+    static_cast<size_t>(std::count(is_aligned_array.begin(), is_aligned_array.end(), 1));
+  if (aligned_num < offset_num) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      this->get_logger(), *this->get_clock(), 1000,
+      "Covariance estimation exceeded its time budget. Aligned " << aligned_num << " of "
+                                                                 << offset_num << " offsets.");
+  }
+  if (aligned_num == 0) {
+    return param_.covariance.output_pose_covariance;
+  }
+
+  tier4_debug_msgs::msg::Float32MultiArrayStamped multi_ndt_exe_time_msg;
+  multi_ndt_exe_time_msg.stamp = sensor_ros_time;
+  for (size_t i = 0; i < offset_num; i++) {
+    if (!is_aligned_array[i]) {
+      continue;
+    }
+    const Eigen::Vector2d sub_ndt_pose_2d =
+      sub_ndt_result_array[i].topRightCorner<2, 1>().cast<double>();
     mean += sub_ndt_pose_2d;
     ndt_pose_2d_vec.emplace_back(sub_ndt_pose_2d);
 
-    multi_ndt_result_msg.poses.push_back(matrix4f_to_pose(sub_ndt_result));
-    multi_initial_pose_msg.poses.push_back(matrix4f_to_pose(sub_initial_pose_matrix));
+    multi_ndt_result_msg.poses.push_back(matrix4f_to_pose(sub_ndt_result_array[i]));
+    multi_initial_pose_msg.poses.push_back(matrix4f_to_pose(sub_initial_pose_matrix_array[i]));
+    multi_ndt_exe_time_msg.data.push_back(static_cast<float>(sub_exe_time_ms_array[i]));
   }
+  // first result is added to mean
+  const int n = static_cast<int>(aligned_num) + 1;
+  (*state_ptr_)["covariance_estimation_aligned_num"] = std::to_string(aligned_num);
 
   // calculate the covariance matrix
   mean /= n;
@@ -790,6 +938,7 @@ std::array<double, 36> NDTScanMatcher::estimate_covariance(
 
   multi_ndt_pose_pub_->publish(multi_ndt_result_msg);
   multi_initial_pose_pub_->publish(multi_initial_pose_msg);
+  multi_ndt_exe_time_pub_->publish(multi_ndt_exe_time_msg);
 
   return ndt_covariance;
 }
@@ -797,6 +946,9 @@ std::array<double, 36> NDTScanMatcher::estimate_covariance(
 void NDTScanMatcher::add_regularization_pose(const rclcpp::Time & sensor_ros_time)
 {
   ndt_ptr_->unsetRegularizationPose();
+  for (const auto & worker_ndt_ptr : worker_ndt_ptr_array_) {
+    worker_ndt_ptr->unsetRegularizationPose();
+  }
   std::optional<SmartPoseBuffer::InterpolateResult> interpolation_result_opt =
     regularization_pose_buffer_->interpolate(sensor_ros_time);
   if (!interpolation_result_opt) {
@@ -807,6 +959,9 @@ void NDTScanMatcher::add_regularization_pose(const rclcpp::Time & sensor_ros_tim
     interpolation_result_opt.value();
   const Eigen::Matrix4f pose = pose_to_matrix4f(interpolation_result.interpolated_pose.pose.pose);
   ndt_ptr_->setRegularizationPose(pose);
+  for (const auto & worker_ndt_ptr : worker_ndt_ptr_array_) {
+    worker_ndt_ptr->setRegularizationPose(pose);
+  }
   RCLCPP_DEBUG_STREAM(get_logger(), "Regularization pose is set to NDT");
 }
 
@@ -817,10 +972,21 @@ void NDTScanMatcher::service_trigger_node(
   is_activated_ = req->data;
   if (is_activated_) {
     initial_pose_buffer_->clear();
+    reset_ekf_velocity();
   }
   res->success = true;
 }
 
+void NDTScanMatcher::reset_ekf_velocity()
+{
+  // The pose is reinitialized, so the velocity from the poses before it must not move the map
+  // loading position
+  std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
+  velocity_reference_position_ = std::nullopt;
+  velocity_reference_stamp_ = std::nullopt;
+  latest_ekf_velocity_ = geometry_msgs::msg::Vector3{};
+}
+
 void NDTScanMatcher::service_ndt_align(
   const tier4_localization_msgs::srv::PoseWithCovarianceStamped::Request::SharedPtr req,
   tier4_localization_msgs::srv::PoseWithCovarianceStamped::Response::SharedPtr res)
@@ -847,6 +1013,7 @@ void NDTScanMatcher::service_ndt_align(
 
   // transform pose_frame to map_frame
   const auto initial_pose_msg_in_map_frame = transform(req->pose_with_covariance, transform_s2t);
+  reset_ekf_velocity();
   map_update_module_->update_map(initial_pose_msg_in_map_frame.pose.pose.position);
 
   // mutex Map
@@ -909,77 +1076,124 @@ geometry_msgs::msg::PoseWithCovarianceStamped NDTScanMatcher::align_pose(
   // a normal distribution with a small standard deviation. This assumes that the initial pose of
   // the ego vehicle is aligned with the ground to some extent about roll and pitch.
   const std::vector<bool> is_loop_variable = {false, false, false, false, false, true};
+  // With a fixed seed, the particles and so the result are the same for the same input
+  const uint64_t seed = param_.initial_pose_estimation.seed >= 0
+                          ? static_cast<uint64_t>(param_.initial_pose_estimation.seed)
+                          : std::random_device{}();
   TreeStructuredParzenEstimator tpe(
     TreeStructuredParzenEstimator::Direction::MAXIMIZE,
-    param_.initial_pose_estimation.n_startup_trials, is_loop_variable);
+    param_.initial_pose_estimation.n_startup_trials, is_loop_variable, seed);
 
   std::vector<Particle> particle_array;
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
 
   // publish the estimated poses in 20 times to see the progress and to avoid dropping data
   visualization_msgs::msg::MarkerArray marker_array;
   constexpr int64_t publish_num = 20;
   const int64_t publish_interval = param_.initial_pose_estimation.particles_num / publish_num;
 
-  for (int64_t i = 0; i < param_.initial_pose_estimation.particles_num; i++) {
-    const TreeStructuredParzenEstimator::Input input = tpe.get_next_input();
-
-    geometry_msgs::msg::Pose initial_pose;
-    initial_pose.position.x =
-      initial_pose_with_cov.pose.pose.position.x + uniform_to_normal(input[0]) * stddev_x;
-    initial_pose.position.y =
-      initial_pose_with_cov.pose.pose.position.y + uniform_to_normal(input[1]) * stddev_y;
-    initial_pose.position.z =
-      initial_pose_with_cov.pose.pose.position.z + uniform_to_normal(input[2]) * stddev_z;
-    geometry_msgs::msg::Vector3 init_rpy;
-    init_rpy.x = base_rpy.x + uniform_to_normal(input[3]) * stddev_roll;
-    init_rpy.y = base_rpy.y + uniform_to_normal(input[4]) * stddev_pitch;
-    init_rpy.z = base_rpy.z + input[5] * M_PI;
-    tf2::Quaternion tf_quaternion;
-    tf_quaternion.setRPY(init_rpy.x, init_rpy.y, init_rpy.z);
-    initial_pose.orientation = tf2::toMsg(tf_quaternion);
-
-    const Eigen::Matrix4f initial_pose_matrix = pose_to_matrix4f(initial_pose);
-    ndt_ptr_->align(*output_cloud, initial_pose_matrix);
-    const pclomp::NdtResult ndt_result = ndt_ptr_->getResult();
-
-    Particle particle(
-      initial_pose, matrix4f_to_pose(ndt_result.pose), ndt_result.transform_probability,
-      ndt_result.iteration_num);
-    particle_array.push_back(particle);
-    push_debug_markers(marker_array, get_clock()->now(), param_.frame.map_frame, particle, i);
-    if (
-      (i + 1) % publish_interval == 0 || (i + 1) == param_.initial_pose_estimation.particles_num) {
-      ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
-      marker_array.markers.clear();
+  // In batch mode, the particles of a batch are aligned on copies of ndt_ptr_, which are made here
+  // and released after the estimation, so they do not follow every map update. Each of them uses
+  // a share of the NDT threads.
+  const int64_t batch_size = param_.initial_pose_estimation.batch_size;
+  std::vector<std::shared_ptr<NormalDistributionsTransform>> ndt_ptr_array;
+  if (batch_size > 1) {
+    ndt_ptr_array =
+      MapUpdateModule::create_worker_ndt_ptr_array(*ndt_ptr_, static_cast<size_t>(batch_size));
+  } else {
+    ndt_ptr_array.push_back(ndt_ptr_);
+  }
+
+  const int64_t particles_num = param_.initial_pose_estimation.particles_num;
+  for (int64_t batch_begin = 0; batch_begin < particles_num;
+       batch_begin += static_cast<int64_t>(ndt_ptr_array.size())) {
+    const int64_t current_batch_size =
+      std::min(static_cast<int64_t>(ndt_ptr_array.size()), particles_num - batch_begin);
+
+    // The inputs are suggested and the trials are added in the particle order, so the result
+    // does not depend on the order in which the alignments finish.
+    const std::vector<TreeStructuredParzenEstimator::Input> inputs =
+      tpe.get_next_inputs(current_batch_size);
+
+    std::vector<geometry_msgs::msg::Pose> initial_pose_array(current_batch_size);
+    for (int64_t k = 0; k < current_batch_size; k++) {
+      const TreeStructuredParzenEstimator::Input & input = inputs[k];
+      geometry_msgs::msg::Pose & initial_pose = initial_pose_array[k];
+      initial_pose.position.x =
+        initial_pose_with_cov.pose.pose.position.x + uniform_to_normal(input[0]) * stddev_x;
+      initial_pose.position.y =
+        initial_pose_with_cov.pose.pose.position.y + uniform_to_normal(input[1]) * stddev_y;
+      initial_pose.position.z =
+        initial_pose_with_cov.pose.pose.position.z + uniform_to_normal(input[2]) * stddev_z;
+      geometry_msgs::msg::Vector3 init_rpy;
+      init_rpy.x = base_rpy.x + uniform_to_normal(input[3]) * stddev_roll;
+      init_rpy.y = base_rpy.y + uniform_to_normal(input[4]) * stddev_pitch;
+      init_rpy.z = base_rpy.z + input[5] * M_PI;
+      tf2::Quaternion tf_quaternion;
+      tf_quaternion.setRPY(init_rpy.x, init_rpy.y, init_rpy.z);
+      initial_pose.orientation = tf2::toMsg(tf_quaternion);
     }
 
-    const geometry_msgs::msg::Pose pose = matrix4f_to_pose(ndt_result.pose);
-    const geometry_msgs::msg::Vector3 rpy = get_rpy(pose);
-
-    const double diff_x = pose.position.x - initial_pose_with_cov.pose.pose.position.x;
-    const double diff_y = pose.position.y - initial_pose_with_cov.pose.pose.position.y;
-    const double diff_z = pose.position.z - initial_pose_with_cov.pose.pose.position.z;
-    const double diff_roll = rpy.x - base_rpy.x;
-    const double diff_pitch = rpy.y - base_rpy.y;
-    const double diff_yaw = rpy.z - base_rpy.z;
-
-    // Only yaw is a loop_variable, so only simple normalization is performed.
-    // All other variables are converted from normal distribution to uniform distribution.
-    TreeStructuredParzenEstimator::Input result(is_loop_variable.size());
-    result[0] = normal_to_uniform(diff_x / stddev_x);
-    result[1] = normal_to_uniform(diff_y / stddev_y);
-    result[2] = normal_to_uniform(diff_z / stddev_z);
-    result[3] = normal_to_uniform(diff_roll / stddev_roll);
-    result[4] = normal_to_uniform(diff_pitch / stddev_pitch);
-    result[5] = diff_yaw / M_PI;
-    tpe.add_trial(TreeStructuredParzenEstimator::Trial{result, ndt_result.transform_probability});
-
-    auto sensor_points_in_map_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-    tier4_autoware_utils::transformPointCloud(
-      *ndt_ptr_->getInputSource(), *sensor_points_in_map_ptr, ndt_result.pose);
-    publish_point_cloud(
-      initial_pose_with_cov.header.stamp, param_.frame.map_frame, sensor_points_in_map_ptr);
+    std::vector<pclomp::NdtResult> ndt_result_array(current_batch_size);
+    std::atomic<int64_t> next_particle_index{0};
+    auto align_particles = [&](const size_t worker_index) {
+      if (worker_index >= ndt_ptr_array.size()) {
+        return;
+      }
+      for (int64_t k = next_particle_index++; k < current_batch_size; k = next_particle_index++) {
+        auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+        const Eigen::Matrix4f initial_pose_matrix = pose_to_matrix4f(initial_pose_array[k]);
+        ndt_ptr_array[worker_index]->align(*output_cloud, initial_pose_matrix);
+        ndt_result_array[k] = ndt_ptr_array[worker_index]->getResult();
+      }
+    };
+    if (current_batch_size > 1) {
+      worker_pool_->run(align_particles);
+    } else {
+      align_particles(0);
+    }
+
+    for (int64_t k = 0; k < current_batch_size; k++) {
+      const int64_t i = batch_begin + k;
+      const pclomp::NdtResult & ndt_result = ndt_result_array[k];
+
+      Particle particle(
+        initial_pose_array[k], matrix4f_to_pose(ndt_result.pose), ndt_result.transform_probability,
+        ndt_result.iteration_num);
+      particle_array.push_back(particle);
+      push_debug_markers(marker_array, get_clock()->now(), param_.frame.map_frame, particle, i);
+      if ((i + 1) % publish_interval == 0 || (i + 1) == particles_num) {
+        ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+        marker_array.markers.clear();
+      }
+
+      const geometry_msgs::msg::Pose pose = matrix4f_to_pose(ndt_result.pose);
+      const geometry_msgs::msg::Vector3 rpy = get_rpy(pose);
+
+      const double diff_x = pose.position.x - initial_pose_with_cov.pose.pose.position.x;
+      const double diff_y = pose.position.y - initial_pose_with_cov.pose.pose.position.y;
+      const double diff_z = pose.position.z - initial_pose_with_cov.pose.pose.position.z;
+      const double diff_roll = rpy.x - base_rpy.x;
+      const double diff_pitch = rpy.y - base_rpy.y;
+      const double diff_yaw = rpy.z - base_rpy.z;
+
+      // Only yaw is a loop_variable, so only simple normalization is performed.
+      // All other variables are converted from normal distribution to uniform distribution.
+      TreeStructuredParzenEstimator::Input result(is_loop_variable.size());
+      result[0] = normal_to_uniform(diff_x / stddev_x);
+      result[1] = normal_to_uniform(diff_y / stddev_y);
+      result[2] = normal_to_uniform(diff_z / stddev_z);
+      result[3] = normal_to_uniform(diff_roll / stddev_roll);
+      result[4] = normal_to_uniform(diff_pitch / stddev_pitch);
+      result[5] = diff_yaw / M_PI;
+      tpe.add_trial(
+        TreeStructuredParzenEstimator::Trial{result, ndt_result.transform_probability});
+
+      auto sensor_points_in_map_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
+      tier4_autoware_utils::transformPointCloud(
+        *ndt_ptr_->getInputSource(), *sensor_points_in_map_ptr, ndt_result.pose);
+      publish_point_cloud(
+        initial_pose_with_cov.header.stamp, param_.frame.map_frame, sensor_points_in_map_ptr);
+    }
   }
 
   auto best_particle_ptr = std::max_element(
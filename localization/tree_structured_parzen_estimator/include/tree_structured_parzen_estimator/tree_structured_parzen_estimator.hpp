@@ -45,10 +45,15 @@ public:
   };
 
   TreeStructuredParzenEstimator() = delete;
+  // The inputs are reproducible for a fixed seed
   TreeStructuredParzenEstimator(
-    const Direction direction, const int64_t n_startup_trials, std::vector<bool> is_loop_variable);
+    const Direction direction, const int64_t n_startup_trials, std::vector<bool> is_loop_variable,
+    const uint64_t seed = std::random_device{}());
   void add_trial(const Trial & trial);
   Input get_next_input() const;
+  // Suggest several inputs from the same set of trials so that they can be evaluated in parallel.
+  // The inputs are drawn in order, so the result is the same as calling get_next_input() n times.
+  std::vector<Input> get_next_inputs(const int64_t n) const;
 
 private:
   static constexpr double BASE_STDDEV_COEFF = 0.2;
@@ -59,10 +64,6 @@ private:
   static constexpr int64_t N_EI_CANDIDATES = 100;
   static constexpr double PRIOR_WEIGHT = 0.0;
 
-  static std::mt19937_64 engine;
-  static std::uniform_real_distribution<double> dist_uniform;
-  static std::normal_distribution<double> dist_normal;
-
   double compute_log_likelihood_ratio(const Input & input) const;
   double log_gaussian_pdf(const Input & input, const Input & mu, const Input & sigma) const;
   static std::vector<double> get_weights(const int64_t n);
@@ -75,6 +76,11 @@ private:
   const int64_t input_dimension_;
   const std::vector<bool> is_loop_variable_;
   const Input base_stddev_;
+
+  // random number generator
+  mutable std::mt19937_64 engine_;
+  mutable std::uniform_real_distribution<double> dist_uniform_;
+  mutable std::normal_distribution<double> dist_normal_;
 };
 
 #endif  // TREE_STRUCTURED_PARZEN_ESTIMATOR__TREE_STRUCTURED_PARZEN_ESTIMATOR_HPP_
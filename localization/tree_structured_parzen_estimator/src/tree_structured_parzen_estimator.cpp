@@ -19,20 +19,18 @@
 #include <iostream>
 #include <numeric>
 
-// random number generator
-std::mt19937_64 TreeStructuredParzenEstimator::engine(std::random_device{}());
-std::uniform_real_distribution<double> TreeStructuredParzenEstimator::dist_uniform(
-  TreeStructuredParzenEstimator::MIN_VALUE, TreeStructuredParzenEstimator::MAX_VALUE);
-std::normal_distribution<double> TreeStructuredParzenEstimator::dist_normal(0.0, 1.0);
-
 TreeStructuredParzenEstimator::TreeStructuredParzenEstimator(
-  const Direction direction, const int64_t n_startup_trials, std::vector<bool> is_loop_variable)
+  const Direction direction, const int64_t n_startup_trials, std::vector<bool> is_loop_variable,
+  const uint64_t seed)
 : above_num_(0),
   direction_(direction),
   n_startup_trials_(n_startup_trials),
   input_dimension_(is_loop_variable.size()),
   is_loop_variable_(is_loop_variable),
-  base_stddev_(input_dimension_, VALUE_WIDTH)
+  base_stddev_(input_dimension_, VALUE_WIDTH),
+  engine_(seed),
+  dist_uniform_(MIN_VALUE, MAX_VALUE),
+  dist_normal_(0.0, 1.0)
 {
 }
 
@@ -52,7 +50,7 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
     // Random sampling based on prior until the number of trials reaches `n_startup_trials_`.
     Input input(input_dimension_);
     for (int64_t j = 0; j < input_dimension_; j++) {
-      input[j] = dist_uniform(engine);
+      input[j] = dist_uniform_(engine_);
     }
     return input;
   }
@@ -65,7 +63,7 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
   std::discrete_distribution<int64_t> dist(weights.begin(), weights.end());
   for (int64_t i = 0; i < N_EI_CANDIDATES; i++) {
     Input mu, sigma;
-    const int64_t index = dist(engine);
+    const int64_t index = dist(engine_);
     if (index == above_num_) {
       mu = Input(input_dimension_, 0.0);
       sigma = base_stddev_;
@@ -79,7 +77,7 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
     // sample from the normal distribution
     Input input(input_dimension_);
     for (int64_t j = 0; j < input_dimension_; j++) {
-      input[j] = mu[j] + dist_normal(engine) * sigma[j];
+      input[j] = mu[j] + dist_normal_(engine_) * sigma[j];
       input[j] =
         (is_loop_variable_[j] ? normalize_loop_variable(input[j])
                               : std::clamp(input[j], MIN_VALUE, MAX_VALUE));
@@ -93,6 +91,17 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
   return best_input;
 }
 
+std::vector<TreeStructuredParzenEstimator::Input> TreeStructuredParzenEstimator::get_next_inputs(
+  const int64_t n) const
+{
+  std::vector<Input> inputs;
+  inputs.reserve(std::max(n, static_cast<int64_t>(0)));
+  for (int64_t i = 0; i < n; i++) {
+    inputs.push_back(get_next_input());
+  }
+  return inputs;
+}
+
 double TreeStructuredParzenEstimator::compute_log_likelihood_ratio(const Input & input) const
 {
   const int64_t n = trials_.size();
@@ -63,3 +63,54 @@ TEST(TreeStructuredParzenEstimatorTest, TPE_is_better_than_random_search_on_sphe
   }
   ASSERT_LT(mean_scores[0], mean_scores[1]);
 }
+
+TEST(TreeStructuredParzenEstimatorTest, get_next_inputs_returns_valid_batch)
+{
+  const std::vector<bool> is_loop_variable = {false, false, true};
+  TreeStructuredParzenEstimator estimator(
+    TreeStructuredParzenEstimator::Direction::MAXIMIZE, 4, is_loop_variable);
+
+  constexpr int64_t kBatchSize = 4;
+  for (int64_t batch = 0; batch < 5; batch++) {
+    const std::vector<TreeStructuredParzenEstimator::Input> inputs =
+      estimator.get_next_inputs(kBatchSize);
+    ASSERT_EQ(static_cast<int64_t>(inputs.size()), kBatchSize);
+    for (const auto & input : inputs) {
+      ASSERT_EQ(input.size(), is_loop_variable.size());
+      for (const double value : input) {
+        EXPECT_GE(value, -1.0);
+        EXPECT_LE(value, 1.0);
+      }
+      estimator.add_trial({input, -input[0] * input[0]});
+    }
+  }
+
+  EXPECT_TRUE(estimator.get_next_inputs(0).empty());
+}
+
+TEST(TreeStructuredParzenEstimatorTest, same_seed_gives_same_inputs)
+{
+  const std::vector<bool> is_loop_variable = {false, false, true};
+  constexpr uint64_t kSeed = 42;
+  constexpr int64_t kBatchSize = 4;
+
+  auto run = [&]() {
+    TreeStructuredParzenEstimator estimator(
+      TreeStructuredParzenEstimator::Direction::MAXIMIZE, 8, is_loop_variable, kSeed);
+    std::vector<TreeStructuredParzenEstimator::Input> history;
+    for (int64_t batch = 0; batch < 10; batch++) {
+      for (const auto & input : estimator.get_next_inputs(kBatchSize)) {
+        estimator.add_trial({input, -input[0] * input[0] - input[1] * input[1]});
+        history.push_back(input);
+      }
+    }
+    return history;
+  };
+
+  const auto first = run();
+  const auto second = run();
+  ASSERT_EQ(first.size(), second.size());
+  for (size_t i = 0; i < first.size(); i++) {
+    EXPECT_EQ(first[i], second[i]);
+  }
+}
@@ -0,0 +1,91 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+#include <vector>
+
+using euclidean_cluster::VoxelGridBasedEuclideanCluster;
+using Clusters = std::vector<pcl::PointCloud<pcl::PointXYZ>>;
+
+// clusters as sorted point lists, to compare the backends regardless of the order
+std::vector<std::vector<std::tuple<float, float, float>>> toComparable(const Clusters & clusters)
+{
+  std::vector<std::vector<std::tuple<float, float, float>>> comparable;
+  for (const auto & cluster : clusters) {
+    std::vector<std::tuple<float, float, float>> points;
+    for (const auto & point : cluster.points) {
+      points.emplace_back(point.x, point.y, point.z);
+    }
+    std::sort(points.begin(), points.end());
+    comparable.push_back(points);
+  }
+  std::sort(comparable.begin(), comparable.end());
+  return comparable;
+}
+
+// usage: voxel_grid_based_euclidean_cluster_benchmark <pcd files of recorded pointclouds>...
+int main(int argc, char ** argv)
+{
+  // same as config/voxel_grid_based_euclidean_cluster.param.yaml
+  VoxelGridBasedEuclideanCluster cluster(false, 10, 3000, 0.7, 0.3, 1);
+  constexpr int iteration_num = 20;
+
+  std::printf("file, points, kd_tree clusters, grid clusters, equal, kd_tree [ms], grid [ms]\n");
+  for (int i = 1; i < argc; ++i) {
+    pcl::PCLPointCloud2 pcl_pointcloud;
+    if (pcl::io::loadPCDFile(argv[i], pcl_pointcloud) != 0) {
+      std::printf("%s, failed to load\n", argv[i]);
+      continue;
+    }
+    sensor_msgs::msg::PointCloud2 ros_pointcloud;
+    pcl_conversions::fromPCL(pcl_pointcloud, ros_pointcloud);
+
+    Clusters kd_tree_clusters;
+    Clusters grid_clusters;
+    std::chrono::nanoseconds kd_tree_time{0};
+    std::chrono::nanoseconds grid_time{0};
+    for (int iteration = 0; iteration < iteration_num; ++iteration) {
+      // the conversion is included since the grid backend reads the message directly
+      kd_tree_clusters.clear();
+      const auto kd_tree_start = std::chrono::system_clock::now();
+      pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
+      pcl::fromROSMsg(ros_pointcloud, *pointcloud_ptr);
+      cluster.cluster(pointcloud_ptr, kd_tree_clusters);
+      const auto kd_tree_end = std::chrono::system_clock::now();
+      kd_tree_time += kd_tree_end - kd_tree_start;
+
+      grid_clusters.clear();
+      const auto grid_start = std::chrono::system_clock::now();
+      cluster.clusterWithGrid(ros_pointcloud, grid_clusters);
+      const auto grid_end = std::chrono::system_clock::now();
+      grid_time += grid_end - grid_start;
+    }
+
+    const bool is_equal = toComparable(kd_tree_clusters) == toComparable(grid_clusters);
+    std::printf(
+      "%s, %u, %lu, %lu, %s, %.3f, %.3f\n", argv[i], ros_pointcloud.width * ros_pointcloud.height,
+      kd_tree_clusters.size(), grid_clusters.size(), is_equal ? "true" : "false",
+      std::chrono::duration<double, std::milli>(kd_tree_time).count() / iteration_num,
+      std::chrono::duration<double, std::milli>(grid_time).count() / iteration_num);
+  }
+  return 0;
+}
@@ -17,6 +17,8 @@
 #include "euclidean_cluster/euclidean_cluster_interface.hpp"
 #include "euclidean_cluster/utils.hpp"
 
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/point_types.h>
 
@@ -35,6 +37,15 @@ public:
   bool cluster(
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
     std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) override;
+  /**
+   * @brief Same clustering as cluster(), but reads the PointCloud2 directly and connects the
+   * voxels with a 2D grid of tolerance sized cells and union-find instead of a kd-tree.
+   * @return false if the pointcloud does not have float x, y and z fields or its row_step,
+   * point_step and data size are inconsistent, in which case cluster() is to be used
+   */
+  bool clusterWithGrid(
+    const sensor_msgs::msg::PointCloud2 & pointcloud,
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) const;
   void setVoxelLeafSize(float voxel_leaf_size) { voxel_leaf_size_ = voxel_leaf_size; }
   void setTolerance(float tolerance) { tolerance_ = tolerance; }
   void setMinPointsNumberPerVoxel(int min_points_number_per_voxel)
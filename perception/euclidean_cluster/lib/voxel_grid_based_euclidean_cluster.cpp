@@ -17,10 +17,87 @@
 #include <pcl/kdtree/kdtree.h>
 #include <pcl/segmentation/extract_clusters.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <string>
 #include <unordered_map>
 
 namespace euclidean_cluster
 {
+namespace
+{
+// same voxel height as the pcl::VoxelGrid in cluster()
+constexpr float voxel_leaf_size_z = 100000.0;
+
+struct GridKey
+{
+  int x;
+  int y;
+  int z;
+  bool operator==(const GridKey & other) const
+  {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+struct GridKeyHash
+{
+  size_t operator()(const GridKey & key) const
+  {
+    size_t seed = std::hash<int>()(key.x);
+    seed ^= std::hash<int>()(key.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int>()(key.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+bool findFloatFieldOffset(
+  const sensor_msgs::msg::PointCloud2 & pointcloud, const std::string & name, size_t & offset)
+{
+  for (const auto & field : pointcloud.fields) {
+    if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+      offset = field.offset;
+      return true;
+    }
+  }
+  return false;
+}
+
+float readFloat(const uint8_t * data)
+{
+  float value;
+  std::memcpy(&value, data, sizeof(float));
+  return value;
+}
+
+int findRoot(std::vector<int> & parents, int index)
+{
+  while (parents.at(index) != index) {
+    parents.at(index) = parents.at(parents.at(index));  // path halving
+    index = parents.at(index);
+  }
+  return index;
+}
+
+void unite(std::vector<int> & parents, const int a, const int b)
+{
+  const int root_a = findRoot(parents, a);
+  const int root_b = findRoot(parents, b);
+  if (root_a == root_b) {
+    return;
+  }
+  // the smaller index becomes the root to keep the labels independent of the visiting order
+  if (root_a < root_b) {
+    parents.at(root_b) = root_a;
+  } else {
+    parents.at(root_a) = root_b;
+  }
+}
+}  // namespace
+
 VoxelGridBasedEuclideanCluster::VoxelGridBasedEuclideanCluster()
 {
 }
@@ -116,4 +193,198 @@ bool VoxelGridBasedEuclideanCluster::cluster(
   return true;
 }
 
+bool VoxelGridBasedEuclideanCluster::clusterWithGrid(
+  const sensor_msgs::msg::PointCloud2 & pointcloud,
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) const
+{
+  size_t x_offset{};
+  size_t y_offset{};
+  size_t z_offset{};
+  if (
+    !findFloatFieldOffset(pointcloud, "x", x_offset) ||
+    !findFloatFieldOffset(pointcloud, "y", y_offset) ||
+    !findFloatFieldOffset(pointcloud, "z", z_offset)) {
+    return false;
+  }
+
+  // the points are read from the raw data, so the layout has to be consistent with its size
+  const size_t point_step = pointcloud.point_step;
+  const size_t row_step = pointcloud.row_step;
+  if (
+    std::max({x_offset, y_offset, z_offset}) + sizeof(float) > point_step ||
+    row_step < static_cast<size_t>(pointcloud.width) * point_step ||
+    pointcloud.data.size() < row_step * pointcloud.height) {
+    return false;
+  }
+
+  // read points and hash them into voxels, which are numbered in order of appearance
+  const size_t point_num = static_cast<size_t>(pointcloud.width) * pointcloud.height;
+  const float inverse_leaf_size = 1.0f / voxel_leaf_size_;
+  const float inverse_leaf_size_z = 1.0f / voxel_leaf_size_z;
+  std::vector<pcl::PointXYZ> points;
+  std::vector<int> point_voxel_indices;
+  points.reserve(point_num);
+  point_voxel_indices.reserve(point_num);
+  std::unordered_map<GridKey, int, GridKeyHash> voxel_map;
+  std::vector<int> voxel_point_nums;
+  std::vector<pcl::PointXYZ> voxel_sums;
+  for (size_t row = 0; row < pointcloud.height; ++row) {
+    const uint8_t * row_data = pointcloud.data.data() + row * row_step;
+    for (size_t col = 0; col < pointcloud.width; ++col) {
+      const uint8_t * point_data = row_data + col * point_step;
+      pcl::PointXYZ point(
+        readFloat(point_data + x_offset), readFloat(point_data + y_offset),
+        readFloat(point_data + z_offset));
+      if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+        continue;
+      }
+      const GridKey key{
+        static_cast<int>(std::floor(point.x * inverse_leaf_size)),
+        static_cast<int>(std::floor(point.y * inverse_leaf_size)),
+        static_cast<int>(std::floor(point.z * inverse_leaf_size_z))};
+      const auto voxel_itr =
+        voxel_map.emplace(key, static_cast<int>(voxel_point_nums.size())).first;
+      const int voxel_index = voxel_itr->second;
+      if (voxel_index == static_cast<int>(voxel_point_nums.size())) {
+        voxel_point_nums.push_back(0);
+        voxel_sums.emplace_back(0.0f, 0.0f, 0.0f);
+      }
+      voxel_point_nums.at(voxel_index) += 1;
+      voxel_sums.at(voxel_index).x += point.x;
+      voxel_sums.at(voxel_index).y += point.y;
+      voxel_sums.at(voxel_index).z += point.z;
+      points.push_back(point);
+      point_voxel_indices.push_back(voxel_index);
+    }
+  }
+
+  // voxel centroids pressed to 2d and hashed into cells as large as the tolerance, so that
+  // every neighbor within the tolerance is in the same or an adjacent cell
+  const size_t voxel_num = voxel_point_nums.size();
+  const float inverse_tolerance = 1.0f / tolerance_;
+  std::vector<pcl::PointXYZ> centroids(voxel_num);
+  std::vector<int> voxel_cell_indices(voxel_num, -1);
+  std::unordered_map<GridKey, int, GridKeyHash> cell_map;
+  std::vector<GridKey> cell_keys;
+  std::vector<int> cell_offsets;
+  for (size_t i = 0; i < voxel_num; ++i) {
+    if (voxel_point_nums.at(i) < min_points_number_per_voxel_) {
+      continue;
+    }
+    const float point_num_in_voxel = static_cast<float>(voxel_point_nums.at(i));
+    auto & centroid = centroids.at(i);
+    centroid.x = voxel_sums.at(i).x / point_num_in_voxel;
+    centroid.y = voxel_sums.at(i).y / point_num_in_voxel;
+    centroid.z = 0.0;
+    const GridKey cell_key{
+      static_cast<int>(std::floor(centroid.x * inverse_tolerance)),
+      static_cast<int>(std::floor(centroid.y * inverse_tolerance)), 0};
+    const auto cell_itr = cell_map.emplace(cell_key, static_cast<int>(cell_keys.size())).first;
+    if (cell_itr->second == static_cast<int>(cell_keys.size())) {
+      cell_keys.push_back(cell_key);
+      cell_offsets.push_back(0);
+    }
+    voxel_cell_indices.at(i) = cell_itr->second;
+    cell_offsets.at(cell_itr->second) += 1;
+  }
+
+  // counting sort of the voxels by cell
+  cell_offsets.push_back(0);
+  std::exclusive_scan(cell_offsets.begin(), cell_offsets.end(), cell_offsets.begin(), 0);
+  std::vector<int> cell_voxels(cell_offsets.back());
+  {
+    std::vector<int> cell_fill(cell_offsets.begin(), cell_offsets.end() - 1);
+    for (size_t i = 0; i < voxel_num; ++i) {
+      if (voxel_cell_indices.at(i) >= 0) {
+        cell_voxels.at(cell_fill.at(voxel_cell_indices.at(i))++) = static_cast<int>(i);
+      }
+    }
+  }
+
+  // connect the voxels closer than the tolerance, same condition as the kd-tree radius search
+  const float squared_tolerance = tolerance_ * tolerance_;
+  std::vector<int> parents(voxel_num);
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto connect_cells = [&](const int cell_a, const int cell_b) {
+    for (int a = cell_offsets.at(cell_a); a < cell_offsets.at(cell_a + 1); ++a) {
+      const auto & centroid_a = centroids.at(cell_voxels.at(a));
+      // in the same cell, only the following voxels need to be checked
+      const int b_begin = cell_a == cell_b ? a + 1 : cell_offsets.at(cell_b);
+      for (int b = b_begin; b < cell_offsets.at(cell_b + 1); ++b) {
+        const auto & centroid_b = centroids.at(cell_voxels.at(b));
+        const float dx = centroid_a.x - centroid_b.x;
+        const float dy = centroid_a.y - centroid_b.y;
+        if (dx * dx + dy * dy < squared_tolerance) {
+          unite(parents, cell_voxels.at(a), cell_voxels.at(b));
+        }
+      }
+    }
+  };
+  // each pair of adjacent cells is visited once
+  constexpr std::array<std::array<int, 2>, 4> forward_neighbors{
+    {{{1, -1}}, {{1, 0}}, {{1, 1}}, {{0, 1}}}};
+  for (size_t cell = 0; cell < cell_keys.size(); ++cell) {
+    connect_cells(static_cast<int>(cell), static_cast<int>(cell));
+    for (const auto & neighbor : forward_neighbors) {
+      const auto neighbor_itr = cell_map.find(
+        GridKey{cell_keys.at(cell).x + neighbor.at(0), cell_keys.at(cell).y + neighbor.at(1), 0});
+      if (neighbor_itr != cell_map.end()) {
+        connect_cells(static_cast<int>(cell), neighbor_itr->second);
+      }
+    }
+  }
+
+  // label the components like pcl::EuclideanClusterExtraction, which drops the ones with too many
+  // voxels and sorts the rest by the number of voxels in descending order
+  std::vector<int> root_voxel_nums(voxel_num, 0);
+  std::vector<int> roots;
+  for (size_t i = 0; i < voxel_num; ++i) {
+    if (voxel_cell_indices.at(i) < 0) {
+      continue;
+    }
+    const int root = findRoot(parents, static_cast<int>(i));
+    if (root_voxel_nums.at(root)++ == 0) {
+      roots.push_back(root);
+    }
+  }
+  std::stable_sort(roots.begin(), roots.end(), [&](const int a, const int b) {
+    return root_voxel_nums.at(a) > root_voxel_nums.at(b);
+  });
+  std::vector<int> root_cluster_indices(voxel_num, -1);
+  int cluster_num = 0;
+  for (const int root : roots) {
+    if (root_voxel_nums.at(root) <= max_cluster_size_) {
+      root_cluster_indices.at(root) = cluster_num++;
+    }
+  }
+
+  // create vector of point cloud cluster. vector index is cluster index.
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> temporary_clusters;  // no check about cluster size
+  temporary_clusters.resize(cluster_num);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const int voxel_index = point_voxel_indices.at(i);
+    if (voxel_cell_indices.at(voxel_index) < 0) {
+      continue;
+    }
+    const int cluster_index = root_cluster_indices.at(findRoot(parents, voxel_index));
+    if (cluster_index >= 0) {
+      temporary_clusters.at(cluster_index).points.push_back(points.at(i));
+    }
+  }
+
+  // build output and check cluster size
+  for (const auto & cluster : temporary_clusters) {
+    if (!(min_cluster_size_ <= static_cast<int>(cluster.points.size()) &&
+          static_cast<int>(cluster.points.size()) <= max_cluster_size_)) {
+      continue;
+    }
+    clusters.push_back(cluster);
+    clusters.back().width = cluster.points.size();
+    clusters.back().height = 1;
+    clusters.back().is_dense = false;
+  }
+
+  return true;
+}
+
 }  // namespace euclidean_cluster
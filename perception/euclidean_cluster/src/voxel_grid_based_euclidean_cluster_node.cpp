@@ -16,6 +16,7 @@
 
 #include "euclidean_cluster/utils.hpp"
 
+#include <string>
 #include <vector>
 
 namespace euclidean_cluster
@@ -30,6 +31,18 @@ VoxelGridBasedEuclideanClusterNode::VoxelGridBasedEuclideanClusterNode(
   const float tolerance = this->declare_parameter("tolerance", 1.0);
   const float voxel_leaf_size = this->declare_parameter("voxel_leaf_size", 0.5);
   const int min_points_number_per_voxel = this->declare_parameter("min_points_number_per_voxel", 3);
+  const std::string clustering_backend =
+    this->declare_parameter<std::string>("clustering_backend", "kd_tree");
+  if (clustering_backend == "grid") {
+    use_grid_clustering_ = true;
+  } else if (clustering_backend == "kd_tree") {
+    use_grid_clustering_ = false;
+  } else {
+    RCLCPP_WARN(
+      this->get_logger(), "specified clustering backend [%s] is not found, use kd_tree",
+      clustering_backend.c_str());
+    use_grid_clustering_ = false;
+  }
   cluster_ = std::make_shared<VoxelGridBasedEuclideanCluster>(
     use_height, min_cluster_size, max_cluster_size, tolerance, voxel_leaf_size,
     min_points_number_per_voxel);
@@ -54,20 +67,19 @@ void VoxelGridBasedEuclideanClusterNode::onPointCloud(
 {
   stop_watch_ptr_->toc("processing_time", true);
 
-  // convert ros to pcl
-  pcl::PointCloud<pcl::PointXYZ>::Ptr raw_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
+  // clustering
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
   if (input_msg->data.empty()) {
     // NOTE: prevent pcl log spam
     RCLCPP_WARN_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), 1000, "Empty sensor points!");
-  } else {
+  } else if (!use_grid_clustering_ || !cluster_->clusterWithGrid(*input_msg, clusters)) {
+    // convert ros to pcl
+    pcl::PointCloud<pcl::PointXYZ>::Ptr raw_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
     pcl::fromROSMsg(*input_msg, *raw_pointcloud_ptr);
-  }
-
-  // clustering
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
-  if (!raw_pointcloud_ptr->empty()) {
-    cluster_->cluster(raw_pointcloud_ptr, clusters);
+    if (!raw_pointcloud_ptr->empty()) {
+      cluster_->cluster(raw_pointcloud_ptr, clusters);
+    }
   }
 
   // build output msg
@@ -0,0 +1,156 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using euclidean_cluster::VoxelGridBasedEuclideanCluster;
+using Clusters = std::vector<pcl::PointCloud<pcl::PointXYZ>>;
+
+namespace
+{
+// clusters as sorted point lists, to compare the backends regardless of the order
+std::vector<std::vector<std::tuple<float, float, float>>> toComparable(const Clusters & clusters)
+{
+  std::vector<std::vector<std::tuple<float, float, float>>> comparable;
+  for (const auto & cluster : clusters) {
+    std::vector<std::tuple<float, float, float>> points;
+    for (const auto & point : cluster.points) {
+      points.emplace_back(point.x, point.y, point.z);
+    }
+    std::sort(points.begin(), points.end());
+    comparable.push_back(points);
+  }
+  std::sort(comparable.begin(), comparable.end());
+  return comparable;
+}
+
+// objects of various sizes separated by more than the tolerance, and sparse points around them
+pcl::PointCloud<pcl::PointXYZ> createPointCloud()
+{
+  std::mt19937 engine(0);
+  pcl::PointCloud<pcl::PointXYZ> pointcloud;
+  const std::vector<std::tuple<float, float, float, int>> objects{
+    {0.0f, 0.0f, 2.0f, 2000}, {10.0f, 0.0f, 1.0f, 500}, {0.0f, 10.0f, 0.5f, 100},
+    {-10.0f, -5.0f, 3.0f, 4000}, {20.0f, 20.0f, 0.2f, 5}};
+  for (const auto & [center_x, center_y, radius, point_num] : objects) {
+    std::uniform_real_distribution<float> xy(-radius, radius);
+    std::uniform_real_distribution<float> z(0.0f, 2.0f);
+    for (int i = 0; i < point_num; ++i) {
+      pointcloud.push_back(pcl::PointXYZ(center_x + xy(engine), center_y + xy(engine), z(engine)));
+    }
+  }
+  std::uniform_real_distribution<float> far_xy(30.0f, 80.0f);
+  for (int i = 0; i < 45; ++i) {
+    pointcloud.push_back(pcl::PointXYZ(far_xy(engine), far_xy(engine), 0.0f));
+  }
+  return pointcloud;
+}
+
+Clusters clusterWithKdTree(
+  VoxelGridBasedEuclideanCluster & cluster, const pcl::PointCloud<pcl::PointXYZ> & pointcloud)
+{
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr pointcloud_ptr(
+    new pcl::PointCloud<pcl::PointXYZ>(pointcloud));
+  Clusters clusters;
+  cluster.cluster(pointcloud_ptr, clusters);
+  return clusters;
+}
+}  // namespace
+
+TEST(VoxelGridBasedEuclideanCluster, GridMatchesKdTree)
+{
+  const auto pointcloud = createPointCloud();
+  sensor_msgs::msg::PointCloud2 ros_pointcloud;
+  pcl::toROSMsg(pointcloud, ros_pointcloud);
+
+  // the parameters of config/voxel_grid_based_euclidean_cluster.param.yaml, and the ones dropping
+  // the sparse voxels and the large clusters
+  for (const auto & [min_cluster_size, max_cluster_size, min_points_number_per_voxel] :
+       std::vector<std::tuple<int, int, int>>{{10, 3000, 1}, {1, 3000, 3}, {10, 100, 1}}) {
+    VoxelGridBasedEuclideanCluster cluster(
+      false, min_cluster_size, max_cluster_size, 0.7, 0.3, min_points_number_per_voxel);
+    const auto kd_tree_clusters = clusterWithKdTree(cluster, pointcloud);
+    Clusters grid_clusters;
+    ASSERT_TRUE(cluster.clusterWithGrid(ros_pointcloud, grid_clusters));
+    EXPECT_FALSE(kd_tree_clusters.empty());
+    EXPECT_EQ(toComparable(grid_clusters), toComparable(kd_tree_clusters));
+  }
+}
+
+TEST(VoxelGridBasedEuclideanCluster, GridReadsPaddedRows)
+{
+  // two rows whose row_step is larger than width * point_step
+  const auto pointcloud = createPointCloud();
+  sensor_msgs::msg::PointCloud2 dense_pointcloud;
+  pcl::toROSMsg(pointcloud, dense_pointcloud);
+  ASSERT_EQ(pointcloud.size() % 2, 0u);
+
+  sensor_msgs::msg::PointCloud2 padded_pointcloud = dense_pointcloud;
+  padded_pointcloud.width = dense_pointcloud.width / 2;
+  padded_pointcloud.height = 2;
+  const size_t row_size = padded_pointcloud.width * padded_pointcloud.point_step;
+  padded_pointcloud.row_step = row_size + 16;
+  padded_pointcloud.data.assign(padded_pointcloud.row_step * 2, 0);
+  for (size_t row = 0; row < 2; ++row) {
+    std::memcpy(
+      padded_pointcloud.data.data() + row * padded_pointcloud.row_step,
+      dense_pointcloud.data.data() + row * row_size, row_size);
+  }
+
+  VoxelGridBasedEuclideanCluster cluster(false, 10, 3000, 0.7, 0.3, 1);
+  Clusters grid_clusters;
+  ASSERT_TRUE(cluster.clusterWithGrid(padded_pointcloud, grid_clusters));
+  EXPECT_EQ(toComparable(grid_clusters), toComparable(clusterWithKdTree(cluster, pointcloud)));
+}
+
+TEST(VoxelGridBasedEuclideanCluster, GridRejectsInconsistentLayout)
+{
+  sensor_msgs::msg::PointCloud2 pointcloud;
+  pcl::toROSMsg(createPointCloud(), pointcloud);
+  VoxelGridBasedEuclideanCluster cluster(false, 10, 3000, 0.7, 0.3, 1);
+  Clusters clusters;
+
+  {
+    auto invalid_pointcloud = pointcloud;
+    invalid_pointcloud.data.resize(pointcloud.data.size() - 1);
+    EXPECT_FALSE(cluster.clusterWithGrid(invalid_pointcloud, clusters));
+  }
+  {
+    auto invalid_pointcloud = pointcloud;
+    invalid_pointcloud.row_step = pointcloud.row_step - 1;
+    EXPECT_FALSE(cluster.clusterWithGrid(invalid_pointcloud, clusters));
+  }
+  {
+    auto invalid_pointcloud = pointcloud;
+    invalid_pointcloud.point_step = sizeof(float) * 2;
+    invalid_pointcloud.row_step = invalid_pointcloud.width * invalid_pointcloud.point_step;
+    EXPECT_FALSE(cluster.clusterWithGrid(invalid_pointcloud, clusters));
+  }
+  {
+    auto invalid_pointcloud = pointcloud;
+    invalid_pointcloud.fields.at(2).datatype = sensor_msgs::msg::PointField::FLOAT64;
+    EXPECT_FALSE(cluster.clusterWithGrid(invalid_pointcloud, clusters));
+  }
+  EXPECT_TRUE(clusters.empty());
+}
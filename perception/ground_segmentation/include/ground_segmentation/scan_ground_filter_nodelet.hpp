@@ -17,6 +17,7 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 #include <vehicle_info_util/vehicle_info.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -173,9 +174,22 @@ private:
     split_height_distance_;                 // useful for close points
   bool use_virtual_ground_point_;
   bool use_recheck_ground_cluster_;  // to enable recheck ground cluster
+  bool use_flat_ray_buffers_;        // to read PointCloud2 directly into the reused ray buffers
+  int classification_thread_num_;   // number of threads to classify the rays in the flat mode
+  // threads to classify the rays in the flat mode, kept between the frames
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> classification_worker_pool_;
   size_t radial_dividers_num_;
   VehicleInfo vehicle_info_;
 
+  // buffers of the flat ray mode reused among the frames
+  pcl::PointCloud<pcl::PointXYZ>::Ptr flat_cloud_ptr_{new pcl::PointCloud<pcl::PointXYZ>};
+  std::vector<float> flat_x_buffer_;
+  std::vector<float> flat_y_buffer_;
+  std::vector<float> flat_theta_buffer_;
+  std::vector<size_t> flat_radial_div_buffer_;
+  std::vector<size_t> flat_ray_offsets_;    // begin of each ray in flat_ray_points_
+  std::vector<PointRef> flat_ray_points_;  // points grouped by ray
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -197,6 +211,15 @@ private:
   void convertPointcloudGridScan(
     const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
     std::vector<PointCloudRefVector> & out_radial_ordered_points_manager);
+  size_t calcRadialDivision(const double theta) const;
+  void calcGridOfPoint(PointRef & point) const;
+  /*!
+   * Read PointCloud2 into the flat buffers and group the points by ray with a counting sort
+   * @param[in] input Input Point Cloud
+   * @retval true the points are stored in flat_ray_points_
+   * @retval false the input does not have float x, y and z fields
+   */
+  bool convertPointcloudToFlatRays(const PointCloud2 & input);
   /*!
    * Output ground center of front wheels as the virtual ground point
    * @param[out] point Virtual ground origin point
@@ -223,6 +246,21 @@ private:
   void classifyPointCloudGridScan(
     std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
     pcl::PointIndices & out_no_ground_indices);
+  void classifyRay(
+    PointRef * ray, const size_t ray_size, pcl::PointIndices & out_no_ground_indices);
+  void classifyRayGridScan(
+    PointRef * ray, const size_t ray_size, pcl::PointIndices & out_no_ground_indices);
+  /*!
+   * Sort the rays in flat_ray_points_ by radius and classify them in parallel chunks. The result
+   * is identical to classifyPointCloud() and classifyPointCloudGridScan().
+   * @param out_no_ground_indices Returns the indices of the points
+   *     classified as not ground in the original PointCloud
+   */
+  void classifyFlatRays(pcl::PointIndices & out_no_ground_indices);
+  /*!
+   * Recreate the pool of the threads of classifyFlatRays() from classification_thread_num_
+   */
+  void resetClassificationWorkerPool();
   /*!
    * Re-classifies point of ground cluster based on their height
    * @param gnd_cluster Input ground cluster for re-checking
@@ -19,6 +19,11 @@
 #include <tier4_autoware_utils/math/unit_conversion.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,6 +37,34 @@ using tier4_autoware_utils::normalizeDegree;
 using tier4_autoware_utils::normalizeRadian;
 using vehicle_info_util::VehicleInfoUtil;
 
+namespace
+{
+/**
+ * @brief polynomial approximation of atan2 (Abramowitz and Stegun 4.4.49)
+ * @details written without branches so that the loop over the points is vectorized. The maximum
+ * error is about 1.2e-5 rad.
+ */
+inline float fastAtan2(const float y, const float x)
+{
+  const float abs_x = std::fabs(x);
+  const float abs_y = std::fabs(y);
+  const float a = std::min(abs_x, abs_y) /
+                  std::max(std::max(abs_x, abs_y), std::numeric_limits<float>::min());
+  const float s = a * a;
+  float r =
+    ((((0.0208351f * s - 0.0851330f) * s + 0.1801410f) * s - 0.3302995f) * s + 0.9998660f) * a;
+  r = abs_y > abs_x ? 1.57079637f - r : r;
+  r = x < 0.0f ? 3.14159274f - r : r;
+  return y < 0.0f ? -r : r;
+}
+
+// angle margin around the radial divider boundaries in which the exact atan2 is used instead
+constexpr double fast_atan_margin_rad = 1e-4;
+
+// number of rays classified in a chunk of the flat ray mode
+constexpr size_t ray_chunk_size = 8;
+}  // namespace
+
 ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions & options)
 : Filter("ScanGroundFilter", options)
 {
@@ -53,6 +86,9 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
     split_height_distance_ = declare_parameter<float>("split_height_distance");
     use_virtual_ground_point_ = declare_parameter<bool>("use_virtual_ground_point");
     use_recheck_ground_cluster_ = declare_parameter<bool>("use_recheck_ground_cluster");
+    use_flat_ray_buffers_ = declare_parameter<bool>("use_flat_ray_buffers");
+    classification_thread_num_ = declare_parameter<int>("classification_thread_num");
+    resetClassificationWorkerPool();
     radial_dividers_num_ = std::ceil(2.0 * M_PI / radial_divider_angle_rad_);
     vehicle_info_ = VehicleInfoUtil(*this).getVehicleInfo();
 
@@ -83,45 +119,30 @@ void ScanGroundFilterComponent::convertPointcloudGridScan(
 {
   out_radial_ordered_points.resize(radial_dividers_num_);
   PointRef current_point;
-  uint16_t back_steps_num = 1;
 
   grid_size_rad_ =
     normalizeRadian(std::atan2(grid_mode_switch_radius_ + grid_size_m_, virtual_lidar_z_)) -
     normalizeRadian(std::atan2(grid_mode_switch_radius_, virtual_lidar_z_));
   for (size_t i = 0; i < in_cloud->points.size(); ++i) {
+    // points without a valid ray (e.g. NaN) are not classified
+    if (!std::isfinite(in_cloud->points[i].x) || !std::isfinite(in_cloud->points[i].y)) {
+      continue;
+    }
     auto x{
       in_cloud->points[i].x - vehicle_info_.wheel_base_m / 2.0f -
       center_pcl_shift_};  // base on front wheel center
     // auto y{in_cloud->points[i].y};
     auto radius{static_cast<float>(std::hypot(x, in_cloud->points[i].y))};
     auto theta{normalizeRadian(std::atan2(x, in_cloud->points[i].y), 0.0)};
+    auto radial_div{calcRadialDivision(theta)};
 
-    // divide by vertical angle
-    auto gamma{normalizeRadian(std::atan2(radius, virtual_lidar_z_), 0.0f)};
-    auto radial_div{
-      static_cast<size_t>(std::floor(normalizeDegree(theta / radial_divider_angle_rad_, 0.0)))};
-    uint16_t grid_id = 0;
-    float curr_grid_size = 0.0f;
-    if (radius <= grid_mode_switch_radius_) {
-      grid_id = static_cast<uint16_t>(radius / grid_size_m_);
-      curr_grid_size = grid_size_m_;
-    } else {
-      grid_id = grid_mode_switch_grid_id_ + (gamma - grid_mode_switch_angle_rad_) / grid_size_rad_;
-      if (grid_id <= grid_mode_switch_grid_id_ + back_steps_num) {
-        curr_grid_size = grid_size_m_;
-      } else {
-        curr_grid_size = std::tan(gamma) - std::tan(gamma - grid_size_rad_);
-        curr_grid_size *= virtual_lidar_z_;
-      }
-    }
-    current_point.grid_id = grid_id;
-    current_point.grid_size = curr_grid_size;
     current_point.radius = radius;
     current_point.theta = theta;
     current_point.radial_div = radial_div;
     current_point.point_state = PointLabel::INIT;
     current_point.orig_index = i;
     current_point.orig_point = &in_cloud->points[i];
+    calcGridOfPoint(current_point);
 
     // radial divisions
     out_radial_ordered_points[radial_div].emplace_back(current_point);
@@ -142,10 +163,13 @@ void ScanGroundFilterComponent::convertPointcloud(
   PointRef current_point;
 
   for (size_t i = 0; i < in_cloud->points.size(); ++i) {
+    // points without a valid ray (e.g. NaN) are not classified
+    if (!std::isfinite(in_cloud->points[i].x) || !std::isfinite(in_cloud->points[i].y)) {
+      continue;
+    }
     auto radius{static_cast<float>(std::hypot(in_cloud->points[i].x, in_cloud->points[i].y))};
     auto theta{normalizeRadian(std::atan2(in_cloud->points[i].x, in_cloud->points[i].y), 0.0)};
-    auto radial_div{
-      static_cast<size_t>(std::floor(normalizeDegree(theta / radial_divider_angle_rad_, 0.0)))};
+    auto radial_div{calcRadialDivision(theta)};
 
     current_point.radius = radius;
     current_point.theta = theta;
@@ -166,6 +190,148 @@ void ScanGroundFilterComponent::convertPointcloud(
   }
 }
 
+size_t ScanGroundFilterComponent::calcRadialDivision(const double theta) const
+{
+  return static_cast<size_t>(std::floor(normalizeDegree(theta / radial_divider_angle_rad_, 0.0)));
+}
+
+void ScanGroundFilterComponent::calcGridOfPoint(PointRef & point) const
+{
+  const uint16_t back_steps_num = 1;
+
+  // divide by vertical angle
+  auto gamma{normalizeRadian(std::atan2(point.radius, virtual_lidar_z_), 0.0f)};
+  uint16_t grid_id = 0;
+  float curr_grid_size = 0.0f;
+  if (point.radius <= grid_mode_switch_radius_) {
+    grid_id = static_cast<uint16_t>(point.radius / grid_size_m_);
+    curr_grid_size = grid_size_m_;
+  } else {
+    grid_id = grid_mode_switch_grid_id_ + (gamma - grid_mode_switch_angle_rad_) / grid_size_rad_;
+    if (grid_id <= grid_mode_switch_grid_id_ + back_steps_num) {
+      curr_grid_size = grid_size_m_;
+    } else {
+      curr_grid_size = std::tan(gamma) - std::tan(gamma - grid_size_rad_);
+      curr_grid_size *= virtual_lidar_z_;
+    }
+  }
+  point.grid_id = grid_id;
+  point.grid_size = curr_grid_size;
+}
+
+bool ScanGroundFilterComponent::convertPointcloudToFlatRays(const PointCloud2 & input)
+{
+  const auto find_offset = [&input](const std::string & name) -> int {
+    for (const auto & field : input.fields) {
+      if (field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32) {
+        return static_cast<int>(field.offset);
+      }
+    }
+    return -1;
+  };
+  const int x_offset = find_offset("x");
+  const int y_offset = find_offset("y");
+  const int z_offset = find_offset("z");
+  if (
+    x_offset < 0 || y_offset < 0 || z_offset < 0 ||
+    input.data.size() < static_cast<size_t>(input.row_step) * input.height) {
+    return false;
+  }
+
+  // read the points from PointCloud2 directly
+  const size_t point_num = static_cast<size_t>(input.width) * input.height;
+  auto & points = flat_cloud_ptr_->points;
+  points.resize(point_num);
+  for (uint32_t row = 0, i = 0; row < input.height; ++row) {
+    const uint8_t * point_ptr = input.data.data() + static_cast<size_t>(row) * input.row_step;
+    for (uint32_t col = 0; col < input.width; ++col, ++i, point_ptr += input.point_step) {
+      std::memcpy(&points[i].x, point_ptr + x_offset, sizeof(float));
+      std::memcpy(&points[i].y, point_ptr + y_offset, sizeof(float));
+      std::memcpy(&points[i].z, point_ptr + z_offset, sizeof(float));
+    }
+  }
+
+  // calculate the azimuth with the approximated atan2 in a vectorizable loop
+  if (elevation_grid_mode_) {
+    grid_size_rad_ =
+      normalizeRadian(std::atan2(grid_mode_switch_radius_ + grid_size_m_, virtual_lidar_z_)) -
+      normalizeRadian(std::atan2(grid_mode_switch_radius_, virtual_lidar_z_));
+  }
+  const float x_shift =
+    elevation_grid_mode_ ? vehicle_info_.wheel_base_m / 2.0f + center_pcl_shift_ : 0.0f;
+  flat_x_buffer_.resize(point_num);
+  flat_y_buffer_.resize(point_num);
+  flat_theta_buffer_.resize(point_num);
+  for (size_t i = 0; i < point_num; ++i) {
+    flat_x_buffer_[i] = points[i].x - x_shift;
+    flat_y_buffer_[i] = points[i].y;
+  }
+  for (size_t i = 0; i < point_num; ++i) {
+    flat_theta_buffer_[i] = fastAtan2(flat_x_buffer_[i], flat_y_buffer_[i]);
+  }
+
+  // count the points of each ray. The exact atan2 is used for the points close to the boundary of
+  // the radial dividers so that the rays are identical to the ones of convertPointcloud().
+  const double margin = fast_atan_margin_rad / radial_divider_angle_rad_;
+  flat_radial_div_buffer_.resize(point_num);
+  flat_ray_offsets_.assign(radial_dividers_num_ + 1, 0);
+  for (size_t i = 0; i < point_num; ++i) {
+    // points without a valid ray (e.g. NaN) are not classified
+    if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y)) {
+      flat_radial_div_buffer_[i] = radial_dividers_num_;
+      continue;
+    }
+    const double theta = normalizeRadian(flat_theta_buffer_[i], 0.0);
+    const double theta_div = theta / radial_divider_angle_rad_;
+    const double theta_div_frac = theta_div - std::floor(theta_div);
+    const bool is_close_to_boundary = theta < fast_atan_margin_rad ||
+                                      theta > 2.0 * M_PI - fast_atan_margin_rad ||
+                                      theta_div_frac < margin || theta_div_frac > 1.0 - margin;
+    size_t radial_div = 0;
+    if (!is_close_to_boundary) {
+      radial_div = calcRadialDivision(theta);
+    } else if (elevation_grid_mode_) {
+      const auto x{points[i].x - vehicle_info_.wheel_base_m / 2.0f - center_pcl_shift_};
+      radial_div = calcRadialDivision(normalizeRadian(std::atan2(x, points[i].y), 0.0));
+    } else {
+      radial_div = calcRadialDivision(normalizeRadian(std::atan2(points[i].x, points[i].y), 0.0));
+    }
+    flat_radial_div_buffer_[i] = radial_div;
+    if (radial_div < radial_dividers_num_) {
+      ++flat_ray_offsets_[radial_div + 1];
+    }
+  }
+  for (size_t i = 0; i < radial_dividers_num_; ++i) {
+    flat_ray_offsets_[i + 1] += flat_ray_offsets_[i];
+  }
+
+  // scatter the points to the rays in the input order
+  flat_ray_points_.resize(flat_ray_offsets_.back());
+  std::vector<size_t> ray_ends(flat_ray_offsets_.begin(), flat_ray_offsets_.end() - 1);
+  for (size_t i = 0; i < point_num; ++i) {
+    const size_t radial_div = flat_radial_div_buffer_[i];
+    if (radial_div >= radial_dividers_num_) {
+      continue;
+    }
+    PointRef & current_point = flat_ray_points_[ray_ends[radial_div]++];
+    if (elevation_grid_mode_) {
+      const auto x{points[i].x - vehicle_info_.wheel_base_m / 2.0f - center_pcl_shift_};
+      current_point.radius = static_cast<float>(std::hypot(x, points[i].y));
+    } else {
+      current_point.radius = static_cast<float>(std::hypot(points[i].x, points[i].y));
+    }
+    current_point.theta = flat_theta_buffer_[i];
+    current_point.radial_div = radial_div;
+    current_point.point_state = PointLabel::INIT;
+    current_point.orig_index = i;
+    current_point.orig_point = &points[i];
+    if (elevation_grid_mode_) {
+      calcGridOfPoint(current_point);
+    }
+  }
+  return true;
+}
+
 void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point)
 {
   point.x = vehicle_info_.wheel_base_m;
@@ -287,127 +453,135 @@ void ScanGroundFilterComponent::classifyPointCloudGridScan(
 {
   out_no_ground_indices.indices.clear();
   for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
-    PointsCentroid ground_cluster;
-    ground_cluster.initialize();
-    std::vector<GridCenter> gnd_grids;
-    GridCenter curr_gnd_grid;
-
-    // check empty ray
-    if (in_radial_ordered_clouds[i].size() == 0) {
-      continue;
-    }
+    classifyRayGridScan(
+      in_radial_ordered_clouds[i].data(), in_radial_ordered_clouds[i].size(),
+      out_no_ground_indices);
+  }
+}
 
-    // check the first point in ray
-    auto * p = &in_radial_ordered_clouds[i][0];
-    PointRef * prev_p;
-    prev_p = &in_radial_ordered_clouds[i][0];  // for checking the distance to prev point
+void ScanGroundFilterComponent::classifyRayGridScan(
+  PointRef * ray, const size_t ray_size, pcl::PointIndices & out_no_ground_indices)
+{
+  PointsCentroid ground_cluster;
+  ground_cluster.initialize();
+  std::vector<GridCenter> gnd_grids;
+  GridCenter curr_gnd_grid;
 
-    bool initialized_first_gnd_grid = false;
-    bool prev_list_init = false;
+  // check empty ray
+  if (ray_size == 0) {
+    return;
+  }
 
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); ++j) {
-      p = &in_radial_ordered_clouds[i][j];
-      float global_slope_p = std::atan(p->orig_point->z / p->radius);
-      float non_ground_height_threshold_local = non_ground_height_threshold_;
-      if (p->orig_point->x < low_priority_region_x_) {
-        non_ground_height_threshold_local =
-          non_ground_height_threshold_ * abs(p->orig_point->x / low_priority_region_x_);
-      }
-      // classify first grid's point cloud
-      if (
-        !initialized_first_gnd_grid && global_slope_p >= global_slope_max_angle_rad_ &&
-        p->orig_point->z > non_ground_height_threshold_local) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        p->point_state = PointLabel::NON_GROUND;
-        prev_p = p;
-        continue;
-      }
+  // check the first point in ray
+  auto * p = &ray[0];
+  PointRef * prev_p;
+  prev_p = &ray[0];  // for checking the distance to prev point
+
+  bool initialized_first_gnd_grid = false;
+  bool prev_list_init = false;
+
+  for (size_t j = 0; j < ray_size; ++j) {
+    p = &ray[j];
+    float global_slope_p = std::atan(p->orig_point->z / p->radius);
+    float non_ground_height_threshold_local = non_ground_height_threshold_;
+    if (p->orig_point->x < low_priority_region_x_) {
+      non_ground_height_threshold_local =
+        non_ground_height_threshold_ * abs(p->orig_point->x / low_priority_region_x_);
+    }
+    // classify first grid's point cloud
+    if (
+      !initialized_first_gnd_grid && global_slope_p >= global_slope_max_angle_rad_ &&
+      p->orig_point->z > non_ground_height_threshold_local) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+      p->point_state = PointLabel::NON_GROUND;
+      prev_p = p;
+      continue;
+    }
 
-      if (
-        !initialized_first_gnd_grid && abs(global_slope_p) < global_slope_max_angle_rad_ &&
-        abs(p->orig_point->z) < non_ground_height_threshold_local) {
-        ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
-        p->point_state = PointLabel::GROUND;
-        initialized_first_gnd_grid = static_cast<bool>(p->grid_id - prev_p->grid_id);
-        prev_p = p;
-        continue;
-      }
+    if (
+      !initialized_first_gnd_grid && abs(global_slope_p) < global_slope_max_angle_rad_ &&
+      abs(p->orig_point->z) < non_ground_height_threshold_local) {
+      ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
+      p->point_state = PointLabel::GROUND;
+      initialized_first_gnd_grid = static_cast<bool>(p->grid_id - prev_p->grid_id);
+      prev_p = p;
+      continue;
+    }
 
-      if (!initialized_first_gnd_grid) {
-        prev_p = p;
-        continue;
-      }
+    if (!initialized_first_gnd_grid) {
+      prev_p = p;
+      continue;
+    }
 
-      // initialize lists of previous gnd grids
-      if (prev_list_init == false && initialized_first_gnd_grid == true) {
-        float h = ground_cluster.getAverageHeight();
-        float r = ground_cluster.getAverageRadius();
-        initializeFirstGndGrids(h, r, p->grid_id, gnd_grids);
-        prev_list_init = true;
-      }
+    // initialize lists of previous gnd grids
+    if (prev_list_init == false && initialized_first_gnd_grid == true) {
+      float h = ground_cluster.getAverageHeight();
+      float r = ground_cluster.getAverageRadius();
+      initializeFirstGndGrids(h, r, p->grid_id, gnd_grids);
+      prev_list_init = true;
+    }
 
-      if (prev_list_init == false && initialized_first_gnd_grid == false) {
-        // assume first gnd grid is zero
-        initializeFirstGndGrids(0.0f, p->radius, p->grid_id, gnd_grids);
-        prev_list_init = true;
-      }
+    if (prev_list_init == false && initialized_first_gnd_grid == false) {
+      // assume first gnd grid is zero
+      initializeFirstGndGrids(0.0f, p->radius, p->grid_id, gnd_grids);
+      prev_list_init = true;
+    }
 
-      // move to new grid
-      if (p->grid_id > prev_p->grid_id && ground_cluster.getAverageRadius() > 0.0) {
-        // check if the prev grid have ground point cloud
-        if (use_recheck_ground_cluster_) {
-          recheckGroundCluster(ground_cluster, non_ground_height_threshold_, out_no_ground_indices);
-        }
-        curr_gnd_grid.radius = ground_cluster.getAverageRadius();
-        curr_gnd_grid.avg_height = ground_cluster.getAverageHeight();
-        curr_gnd_grid.max_height = ground_cluster.getMaxHeight();
-        curr_gnd_grid.grid_id = prev_p->grid_id;
-        gnd_grids.push_back(curr_gnd_grid);
-        ground_cluster.initialize();
-      }
-      // classify
-      if (p->orig_point->z - gnd_grids.back().avg_height > detection_range_z_max_) {
-        p->point_state = PointLabel::OUT_OF_RANGE;
-        prev_p = p;
-        continue;
-      }
-      float points_xy_distance = std::hypot(
-        p->orig_point->x - prev_p->orig_point->x, p->orig_point->y - prev_p->orig_point->y);
-      if (
-        prev_p->point_state == PointLabel::NON_GROUND &&
-        points_xy_distance < split_points_distance_tolerance_ &&
-        p->orig_point->z > prev_p->orig_point->z) {
-        p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        prev_p = p;
-        continue;
+    // move to new grid
+    if (p->grid_id > prev_p->grid_id && ground_cluster.getAverageRadius() > 0.0) {
+      // check if the prev grid have ground point cloud
+      if (use_recheck_ground_cluster_) {
+        recheckGroundCluster(ground_cluster, non_ground_height_threshold_, out_no_ground_indices);
       }
+      curr_gnd_grid.radius = ground_cluster.getAverageRadius();
+      curr_gnd_grid.avg_height = ground_cluster.getAverageHeight();
+      curr_gnd_grid.max_height = ground_cluster.getMaxHeight();
+      curr_gnd_grid.grid_id = prev_p->grid_id;
+      gnd_grids.push_back(curr_gnd_grid);
+      ground_cluster.initialize();
+    }
+    // classify
+    if (p->orig_point->z - gnd_grids.back().avg_height > detection_range_z_max_) {
+      p->point_state = PointLabel::OUT_OF_RANGE;
+      prev_p = p;
+      continue;
+    }
+    float points_xy_distance = std::hypot(
+      p->orig_point->x - prev_p->orig_point->x, p->orig_point->y - prev_p->orig_point->y);
+    if (
+      prev_p->point_state == PointLabel::NON_GROUND &&
+      points_xy_distance < split_points_distance_tolerance_ &&
+      p->orig_point->z > prev_p->orig_point->z) {
+      p->point_state = PointLabel::NON_GROUND;
+      out_no_ground_indices.indices.push_back(p->orig_index);
+      prev_p = p;
+      continue;
+    }
 
-      if (global_slope_p > global_slope_max_angle_rad_) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        prev_p = p;
-        continue;
-      }
-      // gnd grid is continuous, the last gnd grid is close
-      uint16_t next_gnd_grid_id_thresh = (gnd_grids.end() - gnd_grid_buffer_size_)->grid_id +
-                                         gnd_grid_buffer_size_ + gnd_grid_continual_thresh_;
-      if (
-        p->grid_id < next_gnd_grid_id_thresh &&
-        p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
-        checkContinuousGndGrid(*p, gnd_grids);
-
-      } else if (p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
-        checkDiscontinuousGndGrid(*p, gnd_grids);
-      } else {
-        checkBreakGndGrid(*p, gnd_grids);
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
-      }
+    if (global_slope_p > global_slope_max_angle_rad_) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
       prev_p = p;
+      continue;
+    }
+    // gnd grid is continuous, the last gnd grid is close
+    uint16_t next_gnd_grid_id_thresh = (gnd_grids.end() - gnd_grid_buffer_size_)->grid_id +
+                                       gnd_grid_buffer_size_ + gnd_grid_continual_thresh_;
+    if (
+      p->grid_id < next_gnd_grid_id_thresh &&
+      p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
+      checkContinuousGndGrid(*p, gnd_grids);
+
+    } else if (p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
+      checkDiscontinuousGndGrid(*p, gnd_grids);
+    } else {
+      checkBreakGndGrid(*p, gnd_grids);
+    }
+    if (p->point_state == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
     }
+    prev_p = p;
   }
 }
 
@@ -417,112 +591,170 @@ void ScanGroundFilterComponent::classifyPointCloud(
 {
   out_no_ground_indices.indices.clear();
 
+  // point classification algorithm
+  // sweep through each radial division
+  for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
+    classifyRay(
+      in_radial_ordered_clouds[i].data(), in_radial_ordered_clouds[i].size(),
+      out_no_ground_indices);
+  }
+}
+
+void ScanGroundFilterComponent::classifyRay(
+  PointRef * ray, const size_t ray_size, pcl::PointIndices & out_no_ground_indices)
+{
   const pcl::PointXYZ init_ground_point(0, 0, 0);
   pcl::PointXYZ virtual_ground_point(0, 0, 0);
   calcVirtualGroundOrigin(virtual_ground_point);
 
-  // point classification algorithm
-  // sweep through each radial division
-  for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
-    float prev_gnd_radius = 0.0f;
-    float prev_gnd_slope = 0.0f;
-    float points_distance = 0.0f;
-    PointsCentroid ground_cluster, non_ground_cluster;
-    float local_slope = 0.0f;
-    PointLabel prev_point_label = PointLabel::INIT;
-    pcl::PointXYZ prev_gnd_point(0, 0, 0);
-    // loop through each point in the radial div
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); ++j) {
-      const float global_slope_max_angle = global_slope_max_angle_rad_;
-      const float local_slope_max_angle = local_slope_max_angle_rad_;
-      auto * p = &in_radial_ordered_clouds[i][j];
-      auto * p_prev = &in_radial_ordered_clouds[i][j - 1];
-
-      if (j == 0) {
-        bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
-        if (use_virtual_ground_point_ && is_front_side) {
-          prev_gnd_point = virtual_ground_point;
-        } else {
-          prev_gnd_point = init_ground_point;
-        }
-        prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
-        prev_gnd_slope = 0.0f;
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-        points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  float points_distance = 0.0f;
+  PointsCentroid ground_cluster, non_ground_cluster;
+  float local_slope = 0.0f;
+  PointLabel prev_point_label = PointLabel::INIT;
+  pcl::PointXYZ prev_gnd_point(0, 0, 0);
+  // loop through each point in the radial div
+  for (size_t j = 0; j < ray_size; ++j) {
+    const float global_slope_max_angle = global_slope_max_angle_rad_;
+    const float local_slope_max_angle = local_slope_max_angle_rad_;
+    auto * p = &ray[j];
+    auto * p_prev = j > 0 ? &ray[j - 1] : nullptr;
+
+    if (j == 0) {
+      bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
+      if (use_virtual_ground_point_ && is_front_side) {
+        prev_gnd_point = virtual_ground_point;
       } else {
-        points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+        prev_gnd_point = init_ground_point;
       }
+      prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
+      prev_gnd_slope = 0.0f;
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+      points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+    } else {
+      points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+    }
 
-      float radius_distance_from_gnd = p->radius - prev_gnd_radius;
-      float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
-      float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
-      bool calculate_slope = false;
-      bool is_point_close_to_prev =
-        (points_distance <
-         (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
-
-      float global_slope = std::atan2(p->orig_point->z, p->radius);
-      // check points which is far enough from previous point
-      if (global_slope > global_slope_max_angle) {
+    float radius_distance_from_gnd = p->radius - prev_gnd_radius;
+    float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
+    float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
+    bool calculate_slope = false;
+    bool is_point_close_to_prev =
+      (points_distance <
+       (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
+
+    float global_slope = std::atan2(p->orig_point->z, p->radius);
+    // check points which is far enough from previous point
+    if (global_slope > global_slope_max_angle) {
+      p->point_state = PointLabel::NON_GROUND;
+      calculate_slope = false;
+    } else if (
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (std::abs(height_from_obj) >= split_height_distance_)) {
+      calculate_slope = true;
+    } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
+      // close to the previous point, set point follow label
+      p->point_state = PointLabel::POINT_FOLLOW;
+      calculate_slope = false;
+    } else {
+      calculate_slope = true;
+    }
+    if (is_point_close_to_prev) {
+      height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
+      radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
+    }
+    if (calculate_slope) {
+      // far from the previous point
+      local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
+      if (local_slope - prev_gnd_slope > local_slope_max_angle) {
+        // the point is outside of the local slope threshold
         p->point_state = PointLabel::NON_GROUND;
-        calculate_slope = false;
-      } else if (
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (std::abs(height_from_obj) >= split_height_distance_)) {
-        calculate_slope = true;
-      } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
-        // close to the previous point, set point follow label
-        p->point_state = PointLabel::POINT_FOLLOW;
-        calculate_slope = false;
       } else {
-        calculate_slope = true;
-      }
-      if (is_point_close_to_prev) {
-        height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
-        radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
+        p->point_state = PointLabel::GROUND;
       }
-      if (calculate_slope) {
-        // far from the previous point
-        local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
-        if (local_slope - prev_gnd_slope > local_slope_max_angle) {
-          // the point is outside of the local slope threshold
-          p->point_state = PointLabel::NON_GROUND;
+    }
+
+    if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+    }
+    if (p->point_state == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::NON_GROUND;
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::GROUND;
+    } else {
+    }
+
+    // update the ground state
+    prev_point_label = p->point_state;
+    if (p->point_state == PointLabel::GROUND) {
+      prev_gnd_radius = p->radius;
+      prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
+      ground_cluster.addPoint(p->radius, p->orig_point->z);
+      prev_gnd_slope = ground_cluster.getAverageSlope();
+    }
+    // update the non ground state
+    if (p->point_state == PointLabel::NON_GROUND) {
+      non_ground_cluster.addPoint(p->radius, p->orig_point->z);
+    }
+  }
+}
+
+void ScanGroundFilterComponent::classifyFlatRays(pcl::PointIndices & out_no_ground_indices)
+{
+  out_no_ground_indices.indices.clear();
+
+  // The rays are independent of each other. Each chunk of rays is sorted and classified into its
+  // own indices, which are merged in the ray order afterwards.
+  const size_t chunk_num = (radial_dividers_num_ + ray_chunk_size - 1) / ray_chunk_size;
+  std::vector<pcl::PointIndices> chunk_no_ground_indices(chunk_num);
+  std::atomic<size_t> next_chunk{0};
+  const auto classify_chunks = [&]() {
+    for (size_t chunk = next_chunk++; chunk < chunk_num; chunk = next_chunk++) {
+      const size_t ray_end = std::min((chunk + 1) * ray_chunk_size, radial_dividers_num_);
+      for (size_t i = chunk * ray_chunk_size; i < ray_end; ++i) {
+        PointRef * ray = flat_ray_points_.data() + flat_ray_offsets_[i];
+        const size_t ray_size = flat_ray_offsets_[i + 1] - flat_ray_offsets_[i];
+
+        // sort by distance
+        std::sort(ray, ray + ray_size, [](const PointRef & a, const PointRef & b) {
+          return a.radius < b.radius;
+        });
+        if (elevation_grid_mode_) {
+          classifyRayGridScan(ray, ray_size, chunk_no_ground_indices[chunk]);
         } else {
-          p->point_state = PointLabel::GROUND;
+          classifyRay(ray, ray_size, chunk_no_ground_indices[chunk]);
         }
       }
+    }
+  };
 
-      if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (p->point_state == PointLabel::POINT_FOLLOW)) {
-        p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
-        p->point_state = PointLabel::GROUND;
-      } else {
-      }
+  if (classification_worker_pool_ && chunk_num > 1) {
+    classification_worker_pool_->run([&](const size_t /*worker_index*/) { classify_chunks(); });
+  } else {
+    classify_chunks();
+  }
 
-      // update the ground state
-      prev_point_label = p->point_state;
-      if (p->point_state == PointLabel::GROUND) {
-        prev_gnd_radius = p->radius;
-        prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
-        ground_cluster.addPoint(p->radius, p->orig_point->z);
-        prev_gnd_slope = ground_cluster.getAverageSlope();
-      }
-      // update the non ground state
-      if (p->point_state == PointLabel::NON_GROUND) {
-        non_ground_cluster.addPoint(p->radius, p->orig_point->z);
-      }
-    }
+  for (const auto & indices : chunk_no_ground_indices) {
+    out_no_ground_indices.indices.insert(
+      out_no_ground_indices.indices.end(), indices.indices.begin(), indices.indices.end());
+  }
+}
+
+void ScanGroundFilterComponent::resetClassificationWorkerPool()
+{
+  classification_worker_pool_.reset();
+  if (classification_thread_num_ > 1) {
+    classification_worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(
+      static_cast<size_t>(classification_thread_num_));
   }
 }
 
@@ -541,24 +773,31 @@ void ScanGroundFilterComponent::filter(
 {
   std::scoped_lock lock(mutex_);
   stop_watch_ptr_->toc("processing_time", true);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
-
-  std::vector<PointCloudRefVector> radial_ordered_points;
 
   pcl::PointIndices no_ground_indices;
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  no_ground_cloud_ptr->points.reserve(current_sensor_cloud_ptr->points.size());
+  no_ground_cloud_ptr->points.reserve(static_cast<size_t>(input->width) * input->height);
 
-  if (elevation_grid_mode_) {
-    convertPointcloudGridScan(current_sensor_cloud_ptr, radial_ordered_points);
-    classifyPointCloudGridScan(radial_ordered_points, no_ground_indices);
+  if (use_flat_ray_buffers_ && convertPointcloudToFlatRays(*input)) {
+    classifyFlatRays(no_ground_indices);
+    extractObjectPoints(flat_cloud_ptr_, no_ground_indices, no_ground_cloud_ptr);
   } else {
-    convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points);
-    classifyPointCloud(radial_ordered_points, no_ground_indices);
-  }
+    pcl::PointCloud<pcl::PointXYZ>::Ptr current_sensor_cloud_ptr(
+      new pcl::PointCloud<pcl::PointXYZ>);
+    pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
 
-  extractObjectPoints(current_sensor_cloud_ptr, no_ground_indices, no_ground_cloud_ptr);
+    std::vector<PointCloudRefVector> radial_ordered_points;
+
+    if (elevation_grid_mode_) {
+      convertPointcloudGridScan(current_sensor_cloud_ptr, radial_ordered_points);
+      classifyPointCloudGridScan(radial_ordered_points, no_ground_indices);
+    } else {
+      convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points);
+      classifyPointCloud(radial_ordered_points, no_ground_indices);
+    }
+
+    extractObjectPoints(current_sensor_cloud_ptr, no_ground_indices, no_ground_cloud_ptr);
+  }
 
   auto no_ground_cloud_msg_ptr = std::make_shared<PointCloud2>();
   pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
@@ -579,6 +818,7 @@ void ScanGroundFilterComponent::filter(
 rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
   const std::vector<rclcpp::Parameter> & p)
 {
+  std::scoped_lock lock(mutex_);
   double global_slope_max_angle_deg{get_parameter("global_slope_max_angle_deg").as_double()};
   if (get_param(p, "global_slope_max_angle_deg", global_slope_max_angle_deg)) {
     global_slope_max_angle_rad_ = deg2rad(global_slope_max_angle_deg);
@@ -617,6 +857,15 @@ rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
       get_logger(),
       "Setting use_recheck_ground_cluster to: " << std::boolalpha << use_recheck_ground_cluster_);
   }
+  if (get_param(p, "use_flat_ray_buffers", use_flat_ray_buffers_)) {
+    RCLCPP_DEBUG_STREAM(
+      get_logger(), "Setting use_flat_ray_buffers to: " << std::boolalpha << use_flat_ray_buffers_);
+  }
+  if (get_param(p, "classification_thread_num", classification_thread_num_)) {
+    resetClassificationWorkerPool();
+    RCLCPP_DEBUG(
+      get_logger(), "Setting classification_thread_num to: %d.", classification_thread_num_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
@@ -31,6 +31,9 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <limits>
+#include <vector>
+
 class ScanGroundFilterTest : public ::testing::Test
 {
 protected:
@@ -83,6 +86,9 @@ protected:
       rclcpp::Parameter("radial_divider_angle_deg", radial_divider_angle_deg_));
     parameters.emplace_back(
       rclcpp::Parameter("use_recheck_ground_cluster", use_recheck_ground_cluster_));
+    parameters.emplace_back(rclcpp::Parameter("use_flat_ray_buffers", use_flat_ray_buffers_));
+    parameters.emplace_back(
+      rclcpp::Parameter("classification_thread_num", classification_thread_num_));
 
     options.parameter_overrides(parameters);
 
@@ -134,6 +140,18 @@ public:
     scan_ground_filter_->filter(input_msg_ptr_, nullptr, out_cloud);
   }
 
+  // wrapper function to switch the private flat ray buffer option
+  void setFlatRayBufferMode(const bool use_flat_ray_buffers)
+  {
+    scan_ground_filter_->use_flat_ray_buffers_ = use_flat_ray_buffers;
+  }
+
+  // wrapper function to switch the private elevation grid mode
+  void setElevationGridMode(const bool elevation_grid_mode)
+  {
+    scan_ground_filter_->elevation_grid_mode_ = elevation_grid_mode;
+  }
+
   void parse_yaml()
   {
     const auto share_dir = ament_index_cpp::get_package_share_directory("ground_segmentation");
@@ -156,6 +174,8 @@ public:
     center_pcl_shift_ = params["center_pcl_shift"].as<float>();
     radial_divider_angle_deg_ = params["radial_divider_angle_deg"].as<float>();
     use_recheck_ground_cluster_ = params["use_recheck_ground_cluster"].as<bool>();
+    use_flat_ray_buffers_ = params["use_flat_ray_buffers"].as<bool>();
+    classification_thread_num_ = params["classification_thread_num"].as<int>();
   }
 
   float global_slope_max_angle_deg_ = 0.0;
@@ -173,6 +193,8 @@ public:
   float center_pcl_shift_;
   float radial_divider_angle_deg_;
   bool use_recheck_ground_cluster_;
+  bool use_flat_ray_buffers_;
+  int classification_thread_num_;
 };
 
 TEST_F(ScanGroundFilterTest, TestCase1)
@@ -201,3 +223,92 @@ TEST_F(ScanGroundFilterTest, TestCase1)
   //           << ",percentage:" << percent << std::endl;
   EXPECT_GE(percent, 0.9);
 }
+
+TEST_F(ScanGroundFilterTest, FlatRayBuffersMatchLegacy)
+{
+  sensor_msgs::msg::PointCloud2 legacy_out_cloud;
+  setFlatRayBufferMode(false);
+  filter(legacy_out_cloud);
+
+  sensor_msgs::msg::PointCloud2 flat_out_cloud;
+  setFlatRayBufferMode(true);
+  filter(flat_out_cloud);
+
+  // both modes must classify exactly the same points in the same order
+  EXPECT_EQ(flat_out_cloud.width, legacy_out_cloud.width);
+  EXPECT_EQ(flat_out_cloud.point_step, legacy_out_cloud.point_step);
+  ASSERT_EQ(flat_out_cloud.fields.size(), legacy_out_cloud.fields.size());
+  for (size_t i = 0; i < flat_out_cloud.fields.size(); ++i) {
+    EXPECT_EQ(flat_out_cloud.fields.at(i).name, legacy_out_cloud.fields.at(i).name);
+    EXPECT_EQ(flat_out_cloud.fields.at(i).offset, legacy_out_cloud.fields.at(i).offset);
+  }
+  EXPECT_EQ(flat_out_cloud.data, legacy_out_cloud.data);
+}
+
+TEST_F(ScanGroundFilterTest, NonFinitePointsAreSkipped)
+{
+  sensor_msgs::msg::PointCloud2 expected_out_cloud;
+  filter(expected_out_cloud);
+
+  // append the points without a valid ray
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  pcl::fromROSMsg(*input_msg_ptr_, cloud);
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  cloud.push_back(pcl::PointXYZ(nan, nan, nan));
+  cloud.push_back(pcl::PointXYZ(nan, 1.0f, 1.0f));
+  cloud.push_back(pcl::PointXYZ(1.0f, inf, 1.0f));
+  const auto header = input_msg_ptr_->header;
+  pcl::toROSMsg(cloud, *input_msg_ptr_);
+  input_msg_ptr_->header = header;
+
+  for (const bool use_flat_ray_buffers : {false, true}) {
+    setFlatRayBufferMode(use_flat_ray_buffers);
+    sensor_msgs::msg::PointCloud2 out_cloud;
+    filter(out_cloud);
+    EXPECT_EQ(out_cloud.width, expected_out_cloud.width);
+    EXPECT_EQ(out_cloud.data, expected_out_cloud.data);
+  }
+}
+
+TEST_F(ScanGroundFilterTest, FlatRayBuffersMatchLegacyWithoutElevationGrid)
+{
+  setElevationGridMode(false);
+
+  sensor_msgs::msg::PointCloud2 legacy_out_cloud;
+  setFlatRayBufferMode(false);
+  filter(legacy_out_cloud);
+
+  sensor_msgs::msg::PointCloud2 flat_out_cloud;
+  setFlatRayBufferMode(true);
+  filter(flat_out_cloud);
+
+  EXPECT_GT(legacy_out_cloud.width, 0u);
+  EXPECT_EQ(flat_out_cloud.width, legacy_out_cloud.width);
+  EXPECT_EQ(flat_out_cloud.data, legacy_out_cloud.data);
+}
+
+TEST_F(ScanGroundFilterTest, ClassificationThreadNumIsUpdated)
+{
+  setFlatRayBufferMode(true);
+  for (const bool elevation_grid_mode : {true, false}) {
+    setElevationGridMode(elevation_grid_mode);
+
+    // the number of threads is changed through the parameter callback
+    std::vector<sensor_msgs::msg::PointCloud2> out_clouds;
+    for (const int classification_thread_num : {1, 4, 2}) {
+      const auto result = scan_ground_filter_->set_parameter(
+        rclcpp::Parameter("classification_thread_num", classification_thread_num));
+      ASSERT_TRUE(result.successful);
+      EXPECT_EQ(scan_ground_filter_->classification_thread_num_, classification_thread_num);
+
+      sensor_msgs::msg::PointCloud2 out_cloud;
+      filter(out_cloud);
+      out_clouds.push_back(out_cloud);
+    }
+    for (const auto & out_cloud : out_clouds) {
+      EXPECT_EQ(out_cloud.width, out_clouds.front().width) << elevation_grid_mode;
+      EXPECT_EQ(out_cloud.data, out_clouds.front().data) << elevation_grid_mode;
+    }
+  }
+}
@@ -16,7 +16,9 @@
 #define MAP_BASED_PREDICTION__MAP_BASED_PREDICTION_NODE_HPP_
 
 #include "map_based_prediction/path_generator.hpp"
+#include "map_based_prediction/reference_paths_cache.hpp"
 #include "tf2/LinearMath/Quaternion.h"
+#include "tier4_autoware_utils/geometry/boost_geometry.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 #include "tier4_autoware_utils/ros/update_param.hpp"
 
@@ -24,6 +26,7 @@
 #include <tier4_autoware_utils/ros/transform_listener.hpp>
 #include <tier4_autoware_utils/ros/uuid_helper.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
@@ -36,6 +39,8 @@
 #include <tier4_debug_msgs/msg/string_stamped.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <lanelet2_core/Forward.h>
 #include <lanelet2_routing/Forward.h>
 #include <lanelet2_traffic_rules/TrafficRules.h>
@@ -44,6 +49,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -98,6 +104,11 @@ struct PredictedRefPath
   Maneuver maneuver;
 };
 
+// bounding box of a fence segment and its index in the fence segment array
+using FenceSegmentRtreeValue = std::pair<tier4_autoware_utils::Box2d, size_t>;
+using FenceSegmentRtree =
+  boost::geometry::index::rtree<FenceSegmentRtreeValue, boost::geometry::index::rstar<16>>;
+
 using LaneletsData = std::vector<LaneletData>;
 using ManeuverProbability = std::unordered_map<Maneuver, float>;
 using autoware_auto_mapping_msgs::msg::HADMapBin;
@@ -133,6 +144,26 @@ private:
   // Object History
   std::unordered_map<std::string, std::deque<ObjectData>> objects_history_;
   std::map<std::pair<std::string, lanelet::Id>, rclcpp::Time> stopped_times_against_green_;
+  std::mutex stopped_times_against_green_mutex_;
+
+  // Reference paths keyed by the lanelet id and the search distance, cleared on a new map
+  std::unique_ptr<ReferencePathsCache> reference_paths_cache_;
+
+  // Threads predicting the objects, kept between the callbacks
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> worker_pool_;
+
+  // Fence segments indexed at map loading, and the fence crossing results keyed by the hash of the
+  // path. The results which are not used in a cycle are removed at the end of the cycle.
+  std::vector<tier4_autoware_utils::Segment2d> fence_segments_;
+  FenceSegmentRtree fence_segment_rtree_;
+  struct FenceCrossingCacheEntry
+  {
+    std::vector<tier4_autoware_utils::Point2d> path;
+    bool does_cross;
+    bool is_used;
+  };
+  std::unordered_map<size_t, FenceCrossingCacheEntry> fence_crossing_cache_;
+  std::mutex fence_crossing_cache_mutex_;
 
   // Lanelet Map Pointers
   std::shared_ptr<lanelet::LaneletMap> lanelet_map_ptr_;
@@ -204,13 +235,19 @@ private:
   void trafficSignalsCallback(const TrafficSignalArray::ConstSharedPtr msg);
   void objectsCallback(const TrackedObjects::ConstSharedPtr in_objects);
 
+  std::optional<PredictedObject> predictObject(
+    const TrackedObject & transformed_object, const std::uint8_t label,
+    const LaneletsData & current_lanelets, const double objects_detected_time,
+    std::optional<Maneuver> & debug_maneuver);
+
   bool doesPathCrossAnyFence(const PredictedPath & predicted_path);
-  bool doesPathCrossFence(
-    const PredictedPath & predicted_path, const lanelet::ConstLineString3d & fence_line);
+  bool doesPathCrossFence(const std::vector<tier4_autoware_utils::Point2d> & path) const;
+  void removeUnusedFenceCrossingCache();
   lanelet::BasicLineString2d convertToFenceLine(const lanelet::ConstLineString3d & fence);
   bool isIntersecting(
-    const geometry_msgs::msg::Point & point1, const geometry_msgs::msg::Point & point2,
-    const lanelet::ConstPoint3d & point3, const lanelet::ConstPoint3d & point4);
+    const tier4_autoware_utils::Point2d & point1, const tier4_autoware_utils::Point2d & point2,
+    const tier4_autoware_utils::Point2d & point3,
+    const tier4_autoware_utils::Point2d & point4) const;
 
   PredictedObjectKinematics convertToPredictedKinematics(
     const TrackedObjectKinematics & tracked_object);
@@ -236,6 +273,8 @@ private:
   std::vector<PredictedRefPath> getPredictedReferencePath(
     const TrackedObject & object, const LaneletsData & current_lanelets_data,
     const double object_detected_time);
+  ReferencePathsConstPtr calcReferencePaths(
+    const lanelet::ConstLanelet & lanelet, const double search_dist);
   Maneuver predictObjectManeuver(
     const TrackedObject & object, const LaneletData & current_lanelet_data,
     const double object_detected_time);
@@ -252,7 +291,7 @@ private:
     const lanelet::routing::LaneletPaths & center_paths);
 
   void addReferencePaths(
-    const TrackedObject & object, const lanelet::routing::LaneletPaths & candidate_paths,
+    const TrackedObject & object, const ReferencePaths & candidate_paths,
     const float path_probability, const ManeuverProbability & maneuver_probability,
     const Maneuver & maneuver, std::vector<PredictedRefPath> & reference_paths,
     const double speed_limit = 0.0);
@@ -0,0 +1,89 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_BASED_PREDICTION__REFERENCE_PATHS_CACHE_HPP_
+#define MAP_BASED_PREDICTION__REFERENCE_PATHS_CACHE_HPP_
+
+#include "map_based_prediction/path_generator.hpp"
+
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_routing/LaneletPath.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace map_based_prediction
+{
+struct ReferencePaths
+{
+  lanelet::routing::LaneletPaths lanelet_paths;
+  std::vector<PosePath> converted_paths;  // resampled centerline of each lanelet path
+};
+using ReferencePathsConstPtr = std::shared_ptr<const ReferencePaths>;
+
+/**
+ * @brief reference paths of the lanelets shared among the objects and the cycles.
+ * The search distance is rounded up to a multiple of the resolution whether the cache is enabled
+ * or not, so that the objects with similar speeds share the paths and enabling the cache does not
+ * change the paths. The entries which are not used in a cycle are removed at the end of the cycle.
+ */
+class ReferencePathsCache
+{
+public:
+  using CalcReferencePaths =
+    std::function<ReferencePathsConstPtr(const lanelet::ConstLanelet &, const double)>;
+
+  /**
+   * @param enable flag to keep the paths, which are calculated on every call if false
+   * @param search_distance_resolution resolution of the search distance, which is not rounded if 0
+   * @param calc_reference_paths function to calculate the paths from the lanelet within the
+   * search distance
+   */
+  ReferencePathsCache(
+    const bool enable, const double search_distance_resolution,
+    CalcReferencePaths calc_reference_paths);
+
+  // search distance rounded up to a multiple of the resolution
+  double roundSearchDistance(const double search_dist) const;
+
+  // get the paths from the lanelet within the rounded search distance. This is thread safe.
+  ReferencePathsConstPtr get(const lanelet::ConstLanelet & lanelet, const double search_dist);
+
+  // remove the entries which are not used since the last call
+  void removeUnused();
+
+  void clear();
+
+  size_t size() const;
+
+private:
+  struct Entry
+  {
+    ReferencePathsConstPtr paths;
+    bool is_used;
+  };
+
+  bool enable_;
+  double search_distance_resolution_;
+  CalcReferencePaths calc_reference_paths_;
+  std::map<std::pair<lanelet::Id, double>, Entry> entries_;
+  mutable std::mutex mutex_;
+};
+}  // namespace map_based_prediction
+
+#endif  // MAP_BASED_PREDICTION__REFERENCE_PATHS_CACHE_HPP_
@@ -27,6 +27,7 @@
 
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
 
@@ -45,6 +46,7 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <functional>
@@ -778,6 +780,19 @@ MapBasedPredictionNode::MapBasedPredictionNode(const rclcpp::NodeOptions & node_
       declare_parameter<bool>("lane_change_detection.consider_only_routable_neighbours");
   }
   reference_path_resolution_ = declare_parameter<double>("reference_path_resolution");
+  const int prediction_thread_num = declare_parameter<int>("prediction_thread_num");
+  if (prediction_thread_num > 1) {
+    worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(
+      static_cast<size_t>(prediction_thread_num));
+  }
+  const bool use_reference_path_cache = declare_parameter<bool>("reference_path_cache.enable");
+  const double reference_path_search_distance_resolution =
+    declare_parameter<double>("reference_path_cache.search_distance_resolution");
+  reference_paths_cache_ = std::make_unique<ReferencePathsCache>(
+    use_reference_path_cache, reference_path_search_distance_resolution,
+    [this](const lanelet::ConstLanelet & lanelet, const double search_dist) {
+      return calcReferencePaths(lanelet, search_dist);
+    });
   /* prediction path will disabled when the estimated path length exceeds lanelet length. This
    * parameter control the estimated path length = vx * th * (rate)  */
   prediction_time_horizon_rate_for_validate_lane_length_ =
@@ -881,6 +896,31 @@ void MapBasedPredictionNode::mapCallback(const HADMapBin::ConstSharedPtr msg)
   const auto walkways = lanelet::utils::query::walkwayLanelets(all_lanelets);
   crosswalks_.insert(crosswalks_.end(), crosswalks.begin(), crosswalks.end());
   crosswalks_.insert(crosswalks_.end(), walkways.begin(), walkways.end());
+
+  reference_paths_cache_->clear();
+
+  // Index the fence segments for the fence crossing check of the crosswalk users
+  fence_segments_.clear();
+  fence_crossing_cache_.clear();
+  std::vector<FenceSegmentRtreeValue> fence_segment_rtree_values;
+  for (const auto & fence_line : lanelet::utils::query::getAllFences(lanelet_map_ptr_)) {
+    for (size_t i = 0; i + 1 < fence_line.size(); ++i) {
+      const tier4_autoware_utils::Point2d p1(fence_line[i].x(), fence_line[i].y());
+      const tier4_autoware_utils::Point2d p2(fence_line[i + 1].x(), fence_line[i + 1].y());
+      tier4_autoware_utils::Box2d box;
+      boost::geometry::envelope(tier4_autoware_utils::Segment2d(p1, p2), box);
+      fence_segment_rtree_values.emplace_back(box, fence_segments_.size());
+      fence_segments_.emplace_back(p1, p2);
+    }
+  }
+  fence_segment_rtree_ =
+    FenceSegmentRtree(fence_segment_rtree_values.begin(), fence_segment_rtree_values.end());
+
+  // The centerline of a lanelet is computed lazily and cached in the shared lanelet data, which is
+  // not thread safe. Compute them here since the objects are predicted in parallel.
+  for (const auto & lanelet : all_lanelets) {
+    static_cast<void>(lanelet.centerline());
+  }
 }
 
 void MapBasedPredictionNode::trafficSignalsCallback(const TrafficSignalArray::ConstSharedPtr msg)
@@ -928,9 +968,16 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
   // result debug
   visualization_msgs::msg::MarkerArray debug_markers;
 
-  for (const auto & object : in_objects->objects) {
-    std::string object_id = tier4_autoware_utils::toHexString(object.object_id);
-    TrackedObject transformed_object = object;
+  // Transform the objects and update their histories. The histories are shared among the objects,
+  // so this is done sequentially before the prediction.
+  const size_t object_num = in_objects->objects.size();
+  std::vector<TrackedObject> transformed_objects(object_num);
+  std::vector<std::uint8_t> labels(object_num);
+  std::vector<LaneletsData> current_lanelets_array(object_num);
+  for (size_t i = 0; i < object_num; ++i) {
+    const auto & object = in_objects->objects.at(i);
+    TrackedObject & transformed_object = transformed_objects.at(i);
+    transformed_object = object;
 
     // transform object frame if it's based on map frame
     if (in_objects->header.frame_id != "map") {
@@ -943,16 +990,9 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
 
     // get tracking label and update it for the prediction
     const auto & label_ = transformed_object.classification.front().label;
-    const auto label = changeLabelForPrediction(label_, object, lanelet_map_ptr_);
-
-    switch (label) {
-      case ObjectClassification::PEDESTRIAN:
-      case ObjectClassification::BICYCLE: {
-        const auto predicted_object_crosswalk =
-          getPredictedObjectAsCrosswalkUser(transformed_object);
-        output.objects.push_back(predicted_object_crosswalk);
-        break;
-      }
+    labels.at(i) = changeLabelForPrediction(label_, object, lanelet_map_ptr_);
+
+    switch (labels.at(i)) {
       case ObjectClassification::CAR:
       case ObjectClassification::BUS:
       case ObjectClassification::TRAILER:
@@ -962,185 +1002,251 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
         updateObjectData(transformed_object);
 
         // Get Closest Lanelet
-        const auto current_lanelets = getCurrentLanelets(transformed_object);
+        current_lanelets_array.at(i) = getCurrentLanelets(transformed_object);
 
         // Update Objects History
-        updateObjectsHistory(output.header, transformed_object, current_lanelets);
-
-        // For off lane obstacles
-        if (current_lanelets.empty()) {
-          PredictedPath predicted_path =
-            path_generator_->generatePathForOffLaneVehicle(transformed_object);
-          predicted_path.confidence = 1.0;
-          if (predicted_path.path.empty()) break;
-
-          auto predicted_object_vehicle = convertToPredictedObject(transformed_object);
-          predicted_object_vehicle.kinematics.predicted_paths.push_back(predicted_path);
-          output.objects.push_back(predicted_object_vehicle);
-          break;
-        }
+        updateObjectsHistory(output.header, transformed_object, current_lanelets_array.at(i));
+        break;
+      }
+      default:
+        break;
+    }
+  }
 
-        // For too-slow vehicle
-        const double abs_obj_speed = std::hypot(
-          transformed_object.kinematics.twist_with_covariance.twist.linear.x,
-          transformed_object.kinematics.twist_with_covariance.twist.linear.y);
-        if (std::fabs(abs_obj_speed) < min_velocity_for_map_based_prediction_) {
-          PredictedPath predicted_path =
-            path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-          predicted_path.confidence = 1.0;
-          if (predicted_path.path.empty()) break;
-
-          auto predicted_slow_object = convertToPredictedObject(transformed_object);
-          predicted_slow_object.kinematics.predicted_paths.push_back(predicted_path);
-          output.objects.push_back(predicted_slow_object);
-          break;
-        }
+  // Predict the objects in parallel. Each object only modifies its own history.
+  std::vector<std::optional<PredictedObject>> predicted_objects(object_num);
+  std::vector<std::optional<Maneuver>> debug_maneuvers(object_num);
+  std::atomic<size_t> next_object_idx{0};
+  const auto predict_objects = [&]() {
+    for (size_t i = next_object_idx++; i < object_num; i = next_object_idx++) {
+      predicted_objects.at(i) = predictObject(
+        transformed_objects.at(i), labels.at(i), current_lanelets_array.at(i),
+        objects_detected_time, debug_maneuvers.at(i));
+    }
+  };
+  if (worker_pool_ && object_num > 1) {
+    worker_pool_->run([&](const size_t /*worker_index*/) { predict_objects(); });
+  } else {
+    predict_objects();
+  }
 
-        // Get Predicted Reference Path for Each Maneuver and current lanelets
-        // return: <probability, paths>
-        const auto ref_paths =
-          getPredictedReferencePath(transformed_object, current_lanelets, objects_detected_time);
-
-        // If predicted reference path is empty, assume this object is out of the lane
-        if (ref_paths.empty()) {
-          PredictedPath predicted_path =
-            path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-          predicted_path.confidence = 1.0;
-          if (predicted_path.path.empty()) break;
-
-          auto predicted_object_out_of_lane = convertToPredictedObject(transformed_object);
-          predicted_object_out_of_lane.kinematics.predicted_paths.push_back(predicted_path);
-          output.objects.push_back(predicted_object_out_of_lane);
-          break;
-        }
+  // Merge the results in the input order so that the output does not depend on the scheduling
+  for (size_t i = 0; i < object_num; ++i) {
+    if (debug_maneuvers.at(i)) {
+      debug_markers.markers.push_back(getDebugMarker(
+        in_objects->objects.at(i), *debug_maneuvers.at(i), debug_markers.markers.size()));
+    }
+    if (predicted_objects.at(i)) {
+      output.objects.push_back(std::move(*predicted_objects.at(i)));
+    }
+  }
+  reference_paths_cache_->removeUnused();
+  removeUnusedFenceCrossingCache();
 
-        // Get Debug Marker for On Lane Vehicles
-        const auto max_prob_path = std::max_element(
-          ref_paths.begin(), ref_paths.end(),
-          [](const PredictedRefPath & a, const PredictedRefPath & b) {
-            return a.probability < b.probability;
-          });
-        const auto debug_marker =
-          getDebugMarker(object, max_prob_path->maneuver, debug_markers.markers.size());
-        debug_markers.markers.push_back(debug_marker);
-
-        // Fix object angle if its orientation unreliable (e.g. far object by radar sensor)
-        // This prevent bending predicted path
-        TrackedObject yaw_fixed_transformed_object = transformed_object;
-        if (
-          transformed_object.kinematics.orientation_availability ==
-          autoware_auto_perception_msgs::msg::TrackedObjectKinematics::UNAVAILABLE) {
-          replaceObjectYawWithLaneletsYaw(current_lanelets, yaw_fixed_transformed_object);
-        }
-        // Generate Predicted Path
-        std::vector<PredictedPath> predicted_paths;
-        double min_avg_curvature = std::numeric_limits<double>::max();
-        PredictedPath path_with_smallest_avg_curvature;
-
-        for (const auto & ref_path : ref_paths) {
-          PredictedPath predicted_path = path_generator_->generatePathForOnLaneVehicle(
-            yaw_fixed_transformed_object, ref_path.path, ref_path.speed_limit);
-          if (predicted_path.path.empty()) continue;
-
-          if (!check_lateral_acceleration_constraints_) {
-            predicted_path.confidence = ref_path.probability;
-            predicted_paths.push_back(predicted_path);
-            continue;
-          }
+  // Publish Results
+  pub_objects_->publish(output);
+  pub_debug_markers_->publish(debug_markers);
+  const auto calculation_time_msg = createStringStamped(now(), stop_watch_.toc());
+  pub_calculation_time_->publish(calculation_time_msg);
+}
 
-          // Check lat. acceleration constraints
-          const auto trajectory_with_const_velocity =
-            toTrajectoryPoints(predicted_path, abs_obj_speed);
+std::optional<PredictedObject> MapBasedPredictionNode::predictObject(
+  const TrackedObject & transformed_object, const std::uint8_t label,
+  const LaneletsData & current_lanelets, const double objects_detected_time,
+  std::optional<Maneuver> & debug_maneuver)
+{
+  switch (label) {
+    case ObjectClassification::PEDESTRIAN:
+    case ObjectClassification::BICYCLE: {
+      return getPredictedObjectAsCrosswalkUser(transformed_object);
+    }
+    case ObjectClassification::CAR:
+    case ObjectClassification::BUS:
+    case ObjectClassification::TRAILER:
+    case ObjectClassification::MOTORCYCLE:
+    case ObjectClassification::TRUCK: {
+      // For off lane obstacles
+      if (current_lanelets.empty()) {
+        PredictedPath predicted_path =
+          path_generator_->generatePathForOffLaneVehicle(transformed_object);
+        predicted_path.confidence = 1.0;
+        if (predicted_path.path.empty()) return std::nullopt;
 
-          if (isLateralAccelerationConstraintSatisfied(
-                trajectory_with_const_velocity, prediction_sampling_time_interval_)) {
-            predicted_path.confidence = ref_path.probability;
-            predicted_paths.push_back(predicted_path);
-            continue;
-          }
+        auto predicted_object_vehicle = convertToPredictedObject(transformed_object);
+        predicted_object_vehicle.kinematics.predicted_paths.push_back(predicted_path);
+        return predicted_object_vehicle;
+      }
 
-          // Calculate curvature assuming the trajectory points interval is constant
-          // In case all paths are deleted, a copy of the straightest path is kept
+      // For too-slow vehicle
+      const double abs_obj_speed = std::hypot(
+        transformed_object.kinematics.twist_with_covariance.twist.linear.x,
+        transformed_object.kinematics.twist_with_covariance.twist.linear.y);
+      if (std::fabs(abs_obj_speed) < min_velocity_for_map_based_prediction_) {
+        PredictedPath predicted_path =
+          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
+        predicted_path.confidence = 1.0;
+        if (predicted_path.path.empty()) return std::nullopt;
 
-          constexpr double curvature_calculation_distance = 2.0;
-          constexpr double points_interval = 1.0;
-          const size_t idx_dist = static_cast<size_t>(
-            std::max(static_cast<int>((curvature_calculation_distance) / points_interval), 1));
-          const auto curvature_v =
-            calcTrajectoryCurvatureFrom3Points(trajectory_with_const_velocity, idx_dist);
-          if (curvature_v.empty()) {
-            continue;
-          }
-          const auto curvature_avg =
-            std::accumulate(curvature_v.begin(), curvature_v.end(), 0.0) / curvature_v.size();
-          if (curvature_avg < min_avg_curvature) {
-            min_avg_curvature = curvature_avg;
-            path_with_smallest_avg_curvature = predicted_path;
-            path_with_smallest_avg_curvature.confidence = ref_path.probability;
-          }
+        auto predicted_slow_object = convertToPredictedObject(transformed_object);
+        predicted_slow_object.kinematics.predicted_paths.push_back(predicted_path);
+        return predicted_slow_object;
+      }
+
+      // Get Predicted Reference Path for Each Maneuver and current lanelets
+      // return: <probability, paths>
+      const auto ref_paths =
+        getPredictedReferencePath(transformed_object, current_lanelets, objects_detected_time);
+
+      // If predicted reference path is empty, assume this object is out of the lane
+      if (ref_paths.empty()) {
+        PredictedPath predicted_path =
+          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
+        predicted_path.confidence = 1.0;
+        if (predicted_path.path.empty()) return std::nullopt;
+
+        auto predicted_object_out_of_lane = convertToPredictedObject(transformed_object);
+        predicted_object_out_of_lane.kinematics.predicted_paths.push_back(predicted_path);
+        return predicted_object_out_of_lane;
+      }
+
+      // Get Debug Marker for On Lane Vehicles
+      const auto max_prob_path = std::max_element(
+        ref_paths.begin(), ref_paths.end(),
+        [](const PredictedRefPath & a, const PredictedRefPath & b) {
+          return a.probability < b.probability;
+        });
+      debug_maneuver = max_prob_path->maneuver;
+
+      // Fix object angle if its orientation unreliable (e.g. far object by radar sensor)
+      // This prevent bending predicted path
+      TrackedObject yaw_fixed_transformed_object = transformed_object;
+      if (
+        transformed_object.kinematics.orientation_availability ==
+        autoware_auto_perception_msgs::msg::TrackedObjectKinematics::UNAVAILABLE) {
+        replaceObjectYawWithLaneletsYaw(current_lanelets, yaw_fixed_transformed_object);
+      }
+      // Generate Predicted Path
+      std::vector<PredictedPath> predicted_paths;
+      double min_avg_curvature = std::numeric_limits<double>::max();
+      PredictedPath path_with_smallest_avg_curvature;
+
+      for (const auto & ref_path : ref_paths) {
+        PredictedPath predicted_path = path_generator_->generatePathForOnLaneVehicle(
+          yaw_fixed_transformed_object, ref_path.path, ref_path.speed_limit);
+        if (predicted_path.path.empty()) continue;
+
+        if (!check_lateral_acceleration_constraints_) {
+          predicted_path.confidence = ref_path.probability;
+          predicted_paths.push_back(predicted_path);
+          continue;
         }
 
-        if (predicted_paths.empty()) predicted_paths.push_back(path_with_smallest_avg_curvature);
-        // Normalize Path Confidence and output the predicted object
+        // Check lat. acceleration constraints
+        const auto trajectory_with_const_velocity =
+          toTrajectoryPoints(predicted_path, abs_obj_speed);
 
-        float sum_confidence = 0.0;
-        for (const auto & predicted_path : predicted_paths) {
-          sum_confidence += predicted_path.confidence;
+        if (isLateralAccelerationConstraintSatisfied(
+              trajectory_with_const_velocity, prediction_sampling_time_interval_)) {
+          predicted_path.confidence = ref_path.probability;
+          predicted_paths.push_back(predicted_path);
+          continue;
         }
-        const float min_sum_confidence_value = 1e-3;
-        sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
 
-        auto predicted_object = convertToPredictedObject(transformed_object);
+        // Calculate curvature assuming the trajectory points interval is constant
+        // In case all paths are deleted, a copy of the straightest path is kept
 
-        for (auto & predicted_path : predicted_paths) {
-          predicted_path.confidence = predicted_path.confidence / sum_confidence;
-          if (predicted_object.kinematics.predicted_paths.size() >= 100) break;
-          predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+        constexpr double curvature_calculation_distance = 2.0;
+        constexpr double points_interval = 1.0;
+        const size_t idx_dist = static_cast<size_t>(
+          std::max(static_cast<int>((curvature_calculation_distance) / points_interval), 1));
+        const auto curvature_v =
+          calcTrajectoryCurvatureFrom3Points(trajectory_with_const_velocity, idx_dist);
+        if (curvature_v.empty()) {
+          continue;
+        }
+        const auto curvature_avg =
+          std::accumulate(curvature_v.begin(), curvature_v.end(), 0.0) / curvature_v.size();
+        if (curvature_avg < min_avg_curvature) {
+          min_avg_curvature = curvature_avg;
+          path_with_smallest_avg_curvature = predicted_path;
+          path_with_smallest_avg_curvature.confidence = ref_path.probability;
         }
-        output.objects.push_back(predicted_object);
-        break;
       }
-      default: {
-        auto predicted_unknown_object = convertToPredictedObject(transformed_object);
-        PredictedPath predicted_path =
-          path_generator_->generatePathForNonVehicleObject(transformed_object);
-        predicted_path.confidence = 1.0;
 
-        predicted_unknown_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_unknown_object);
-        break;
+      if (predicted_paths.empty()) predicted_paths.push_back(path_with_smallest_avg_curvature);
+      // Normalize Path Confidence and output the predicted object
+
+      float sum_confidence = 0.0;
+      for (const auto & predicted_path : predicted_paths) {
+        sum_confidence += predicted_path.confidence;
       }
+      const float min_sum_confidence_value = 1e-3;
+      sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
+
+      auto predicted_object = convertToPredictedObject(transformed_object);
+
+      for (auto & predicted_path : predicted_paths) {
+        predicted_path.confidence = predicted_path.confidence / sum_confidence;
+        if (predicted_object.kinematics.predicted_paths.size() >= 100) break;
+        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+      }
+      return predicted_object;
     }
-  }
+    default: {
+      auto predicted_unknown_object = convertToPredictedObject(transformed_object);
+      PredictedPath predicted_path =
+        path_generator_->generatePathForNonVehicleObject(transformed_object);
+      predicted_path.confidence = 1.0;
 
-  // Publish Results
-  pub_objects_->publish(output);
-  pub_debug_markers_->publish(debug_markers);
-  const auto calculation_time_msg = createStringStamped(now(), stop_watch_.toc());
-  pub_calculation_time_->publish(calculation_time_msg);
+      predicted_unknown_object.kinematics.predicted_paths.push_back(predicted_path);
+      return predicted_unknown_object;
+    }
+  }
 }
 
 bool MapBasedPredictionNode::doesPathCrossAnyFence(const PredictedPath & predicted_path)
 {
-  const lanelet::ConstLineStrings3d & all_fences =
-    lanelet::utils::query::getAllFences(lanelet_map_ptr_);
-  for (const auto & fence_line : all_fences) {
-    if (doesPathCrossFence(predicted_path, fence_line)) {
-      return true;
+  std::vector<tier4_autoware_utils::Point2d> path;
+  path.reserve(predicted_path.path.size());
+  size_t path_hash = 0;
+  for (const auto & pose : predicted_path.path) {
+    path.emplace_back(pose.position.x, pose.position.y);
+    boost::hash_combine(path_hash, pose.position.x);
+    boost::hash_combine(path_hash, pose.position.y);
+  }
+
+  // The paths to the crosswalk are often identical to the ones in the previous cycle, e.g. for
+  // stopping pedestrians, so reuse the results if the path is exactly the same.
+  {
+    std::lock_guard<std::mutex> lock(fence_crossing_cache_mutex_);
+    const auto itr = fence_crossing_cache_.find(path_hash);
+    if (itr != fence_crossing_cache_.end() && itr->second.path == path) {
+      itr->second.is_used = true;
+      return itr->second.does_cross;
     }
   }
-  return false;
+
+  const bool does_cross = doesPathCrossFence(path);
+
+  std::lock_guard<std::mutex> lock(fence_crossing_cache_mutex_);
+  fence_crossing_cache_[path_hash] = FenceCrossingCacheEntry{path, does_cross, true};
+  return does_cross;
 }
 
 bool MapBasedPredictionNode::doesPathCrossFence(
-  const PredictedPath & predicted_path, const lanelet::ConstLineString3d & fence_line)
+  const std::vector<tier4_autoware_utils::Point2d> & path) const
 {
   // check whether the predicted path cross with fence
-  for (size_t i = 0; i < predicted_path.path.size(); ++i) {
-    for (size_t j = 0; j < fence_line.size() - 1; ++j) {
-      if (isIntersecting(
-            predicted_path.path[i].position, predicted_path.path[i + 1].position, fence_line[j],
-            fence_line[j + 1])) {
+  std::vector<FenceSegmentRtreeValue> candidate_fence_segments;
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    tier4_autoware_utils::Box2d box;
+    boost::geometry::envelope(tier4_autoware_utils::Segment2d(path[i], path[i + 1]), box);
+    candidate_fence_segments.clear();
+    fence_segment_rtree_.query(
+      boost::geometry::index::intersects(box), std::back_inserter(candidate_fence_segments));
+    for (const auto & candidate : candidate_fence_segments) {
+      const auto & fence_segment = fence_segments_.at(candidate.second);
+      if (isIntersecting(path[i], path[i + 1], fence_segment.first, fence_segment.second)) {
         return true;
       }
     }
@@ -1148,12 +1254,24 @@ bool MapBasedPredictionNode::doesPathCrossFence(
   return false;
 }
 
+void MapBasedPredictionNode::removeUnusedFenceCrossingCache()
+{
+  for (auto itr = fence_crossing_cache_.begin(); itr != fence_crossing_cache_.end();) {
+    if (!itr->second.is_used) {
+      itr = fence_crossing_cache_.erase(itr);
+      continue;
+    }
+    itr->second.is_used = false;
+    ++itr;
+  }
+}
+
 bool MapBasedPredictionNode::isIntersecting(
-  const geometry_msgs::msg::Point & point1, const geometry_msgs::msg::Point & point2,
-  const lanelet::ConstPoint3d & point3, const lanelet::ConstPoint3d & point4)
+  const tier4_autoware_utils::Point2d & point1, const tier4_autoware_utils::Point2d & point2,
+  const tier4_autoware_utils::Point2d & point3, const tier4_autoware_utils::Point2d & point4) const
 {
-  const auto p1 = tier4_autoware_utils::createPoint(point1.x, point1.y, 0.0);
-  const auto p2 = tier4_autoware_utils::createPoint(point2.x, point2.y, 0.0);
+  const auto p1 = tier4_autoware_utils::createPoint(point1.x(), point1.y(), 0.0);
+  const auto p2 = tier4_autoware_utils::createPoint(point2.x(), point2.y(), 0.0);
   const auto p3 = tier4_autoware_utils::createPoint(point3.x(), point3.y(), 0.0);
   const auto p4 = tier4_autoware_utils::createPoint(point4.x(), point4.y(), 0.0);
   const auto intersection = tier4_autoware_utils::intersect(p1, p2, p3, p4);
@@ -1650,6 +1768,7 @@ std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
   };
 
   std::vector<PredictedRefPath> all_ref_paths;
+  const auto empty_paths = std::make_shared<const ReferencePaths>();
 
   for (const auto & current_lanelet_data : current_lanelets_data) {
     const lanelet::traffic_rules::SpeedLimitInformation limit =
@@ -1668,23 +1787,25 @@ std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
                            : get_search_distance_with_decaying_acc();
     search_dist += lanelet::utils::getLaneletLength3d(current_lanelet_data.lanelet);
 
-    lanelet::routing::PossiblePathsParams possible_params{search_dist, {}, 0, false, true};
     const double validate_time_horizon =
       t_h * prediction_time_horizon_rate_for_validate_lane_length_;
 
     // lambda function to get possible paths for isolated lanelet
     // isolated is often caused by lanelet with no connection e.g. shoulder-lane
-    auto getPathsForNormalOrIsolatedLanelet = [&](const lanelet::ConstLanelet & lanelet) {
+    auto getPathsForNormalOrIsolatedLanelet =
+      [&](const lanelet::ConstLanelet & lanelet) -> ReferencePathsConstPtr {
       // if lanelet is not isolated, return normal possible paths
       if (!isIsolatedLanelet(lanelet, routing_graph_ptr_)) {
-        return routing_graph_ptr_->possiblePaths(lanelet, possible_params);
+        return reference_paths_cache_->get(lanelet, search_dist);
       }
       // if lanelet is isolated, check if it has enough length
       if (!validateIsolatedLaneletLength(lanelet, object, validate_time_horizon)) {
-        return lanelet::routing::LaneletPaths{};
+        return empty_paths;
       } else {
         // if lanelet has enough length, return possible paths
-        return getPossiblePathsForIsolatedLanelet(lanelet);
+        const auto paths = getPossiblePathsForIsolatedLanelet(lanelet);
+        return std::make_shared<const ReferencePaths>(
+          ReferencePaths{paths, convertPathType(paths)});
       }
     };
 
@@ -1719,25 +1840,27 @@ std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
 
     // Step1. Get the path
     // Step1.1 Get the left lanelet
-    lanelet::routing::LaneletPaths left_paths;
+    ReferencePathsConstPtr left_paths = empty_paths;
     const auto left_lanelet = getLeftOrRightLanelets(current_lanelet_data.lanelet, true);
     if (!!left_lanelet) {
       left_paths = getPathsForNormalOrIsolatedLanelet(left_lanelet.value());
     }
 
     // Step1.2 Get the right lanelet
-    lanelet::routing::LaneletPaths right_paths;
+    ReferencePathsConstPtr right_paths = empty_paths;
     const auto right_lanelet = getLeftOrRightLanelets(current_lanelet_data.lanelet, false);
     if (!!right_lanelet) {
       right_paths = getPathsForNormalOrIsolatedLanelet(right_lanelet.value());
     }
 
     // Step1.3 Get the centerline
-    lanelet::routing::LaneletPaths center_paths =
+    const ReferencePathsConstPtr center_paths =
       getPathsForNormalOrIsolatedLanelet(current_lanelet_data.lanelet);
 
     // Skip calculations if all paths are empty
-    if (left_paths.empty() && right_paths.empty() && center_paths.empty()) {
+    if (
+      left_paths->lanelet_paths.empty() && right_paths->lanelet_paths.empty() &&
+      center_paths->lanelet_paths.empty()) {
       continue;
     }
 
@@ -1746,8 +1869,9 @@ std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
       predictObjectManeuver(object, current_lanelet_data, object_detected_time);
 
     // Step3. Allocate probability for each predicted maneuver
-    const auto maneuver_prob =
-      calculateManeuverProbability(predicted_maneuver, left_paths, right_paths, center_paths);
+    const auto maneuver_prob = calculateManeuverProbability(
+      predicted_maneuver, left_paths->lanelet_paths, right_paths->lanelet_paths,
+      center_paths->lanelet_paths);
 
     // Step4. add candidate reference paths to the all_ref_paths
     const float path_prob = current_lanelet_data.probability;
@@ -1755,14 +1879,22 @@ std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
       addReferencePaths(
         object, paths, path_prob, maneuver_prob, maneuver, all_ref_paths, final_speed_limit);
     };
-    addReferencePathsLocal(left_paths, Maneuver::LEFT_LANE_CHANGE);
-    addReferencePathsLocal(right_paths, Maneuver::RIGHT_LANE_CHANGE);
-    addReferencePathsLocal(center_paths, Maneuver::LANE_FOLLOW);
+    addReferencePathsLocal(*left_paths, Maneuver::LEFT_LANE_CHANGE);
+    addReferencePathsLocal(*right_paths, Maneuver::RIGHT_LANE_CHANGE);
+    addReferencePathsLocal(*center_paths, Maneuver::LANE_FOLLOW);
   }
 
   return all_ref_paths;
 }
 
+ReferencePathsConstPtr MapBasedPredictionNode::calcReferencePaths(
+  const lanelet::ConstLanelet & lanelet, const double search_dist)
+{
+  const lanelet::routing::PossiblePathsParams possible_params{search_dist, {}, 0, false, true};
+  const auto paths = routing_graph_ptr_->possiblePaths(lanelet, possible_params);
+  return std::make_shared<const ReferencePaths>(ReferencePaths{paths, convertPathType(paths)});
+}
+
 /**
  * @brief Do lane change prediction
  * @return predicted manuever (lane follow, left/right lane change)
@@ -2073,15 +2205,14 @@ void MapBasedPredictionNode::updateFuturePossibleLanelets(
 }
 
 void MapBasedPredictionNode::addReferencePaths(
-  const TrackedObject & object, const lanelet::routing::LaneletPaths & candidate_paths,
+  const TrackedObject & object, const ReferencePaths & candidate_paths,
   const float path_probability, const ManeuverProbability & maneuver_probability,
   const Maneuver & maneuver, std::vector<PredictedRefPath> & reference_paths,
   const double speed_limit)
 {
-  if (!candidate_paths.empty()) {
-    updateFuturePossibleLanelets(object, candidate_paths);
-    const auto converted_paths = convertPathType(candidate_paths);
-    for (const auto & converted_path : converted_paths) {
+  if (!candidate_paths.lanelet_paths.empty()) {
+    updateFuturePossibleLanelets(object, candidate_paths.lanelet_paths);
+    for (const auto & converted_path : candidate_paths.converted_paths) {
       PredictedRefPath predicted_path;
       predicted_path.probability = maneuver_probability.at(maneuver) * path_probability;
       predicted_path.path = converted_path;
@@ -2306,7 +2437,11 @@ bool MapBasedPredictionNode::calcIntentionToCrossWithTrafficSignal(
     signal_color == TrafficSignalElement::GREEN &&
     tier4_autoware_utils::calcNorm(object.kinematics.twist_with_covariance.twist.linear) <
       threshold_velocity_assumed_as_stopping_) {
-    stopped_times_against_green_.try_emplace(key, this->get_clock()->now());
+    const auto stopped_time = [&]() {
+      std::lock_guard<std::mutex> lock(stopped_times_against_green_mutex_);
+      return stopped_times_against_green_.try_emplace(key, this->get_clock()->now())
+        .first->second;
+    }();
 
     const auto timeout_no_intention_to_walk = [&]() {
       auto InterpolateMap = [](
@@ -2338,12 +2473,12 @@ bool MapBasedPredictionNode::calcIntentionToCrossWithTrafficSignal(
     }();
 
     if (
-      (this->get_clock()->now() - stopped_times_against_green_.at(key)).seconds() >
-      timeout_no_intention_to_walk) {
+      (this->get_clock()->now() - stopped_time).seconds() > timeout_no_intention_to_walk) {
       return false;
     }
 
   } else {
+    std::lock_guard<std::mutex> lock(stopped_times_against_green_mutex_);
     stopped_times_against_green_.erase(key);
     // If the pedestrian disappears, another function erases the old data.
   }
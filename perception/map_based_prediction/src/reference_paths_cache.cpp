@@ -0,0 +1,90 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_based_prediction/reference_paths_cache.hpp"
+
+#include <cmath>
+#include <utility>
+
+namespace map_based_prediction
+{
+ReferencePathsCache::ReferencePathsCache(
+  const bool enable, const double search_distance_resolution,
+  CalcReferencePaths calc_reference_paths)
+: enable_(enable),
+  search_distance_resolution_(search_distance_resolution),
+  calc_reference_paths_(std::move(calc_reference_paths))
+{
+}
+
+double ReferencePathsCache::roundSearchDistance(const double search_dist) const
+{
+  if (search_distance_resolution_ <= 0.0) {
+    return search_dist;
+  }
+  return std::ceil(search_dist / search_distance_resolution_) * search_distance_resolution_;
+}
+
+ReferencePathsConstPtr ReferencePathsCache::get(
+  const lanelet::ConstLanelet & lanelet, const double search_dist)
+{
+  const double rounded_search_dist = roundSearchDistance(search_dist);
+  if (!enable_) {
+    return calc_reference_paths_(lanelet, rounded_search_dist);
+  }
+
+  const auto key = std::make_pair(lanelet.id(), rounded_search_dist);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto itr = entries_.find(key);
+    if (itr != entries_.end()) {
+      itr->second.is_used = true;
+      return itr->second.paths;
+    }
+  }
+
+  // The paths are calculated without the lock. If another thread has stored the same paths in the
+  // meantime, the stored ones are returned.
+  const auto paths = calc_reference_paths_(lanelet, rounded_search_dist);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto itr = entries_.try_emplace(key, Entry{paths, true});
+  itr.first->second.is_used = true;
+  return itr.first->second.paths;
+}
+
+void ReferencePathsCache::removeUnused()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto itr = entries_.begin(); itr != entries_.end();) {
+    if (!itr->second.is_used) {
+      itr = entries_.erase(itr);
+      continue;
+    }
+    itr->second.is_used = false;
+    ++itr;
+  }
+}
+
+void ReferencePathsCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
+
+size_t ReferencePathsCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+}  // namespace map_based_prediction
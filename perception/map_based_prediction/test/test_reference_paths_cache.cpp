@@ -0,0 +1,202 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_based_prediction/reference_paths_cache.hpp"
+
+#include <lanelet2_extension/utility/utilities.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+
+using map_based_prediction::ReferencePaths;
+using map_based_prediction::ReferencePathsCache;
+using map_based_prediction::ReferencePathsConstPtr;
+
+namespace
+{
+// lanelets of 30 m along the x axis: 0 -> 1 -> 2 -> 4, and 1 -> 3 which branches to the left
+class ReferencePathsCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const auto point = [](const double x, const double y) {
+      return lanelet::Point3d(lanelet::utils::getId(), x, y, 0.0);
+    };
+    const auto create_lanelet = [](
+                                  const lanelet::Point3d & left_front,
+                                  const lanelet::Point3d & left_back,
+                                  const lanelet::Point3d & right_front,
+                                  const lanelet::Point3d & right_back) {
+      lanelet::Lanelet ll(
+        lanelet::utils::getId(),
+        lanelet::LineString3d(lanelet::utils::getId(), {left_front, left_back}),
+        lanelet::LineString3d(lanelet::utils::getId(), {right_front, right_back}));
+      ll.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+      return ll;
+    };
+
+    std::vector<lanelet::Point3d> left;
+    std::vector<lanelet::Point3d> right;
+    for (int i = 0; i <= 4; ++i) {
+      left.push_back(point(30.0 * i, 1.5));
+      right.push_back(point(30.0 * i, -1.5));
+    }
+    const auto branch_left = point(90.0, 11.5);
+    const auto branch_right = point(90.0, 8.5);
+
+    const lanelet::Lanelets lanelets{
+      create_lanelet(left[0], left[1], right[0], right[1]),
+      create_lanelet(left[1], left[2], right[1], right[2]),
+      create_lanelet(left[2], left[3], right[2], right[3]),
+      create_lanelet(left[2], branch_left, right[2], branch_right),
+      create_lanelet(left[3], left[4], right[3], right[4])};
+    lanelets_.assign(lanelets.begin(), lanelets.end());
+    map_ = lanelet::utils::createMap(lanelets);
+    traffic_rules_ = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+    routing_graph_ = lanelet::routing::RoutingGraph::build(*map_, *traffic_rules_);
+  }
+
+  // the paths as the node searches them, counting the calls
+  ReferencePathsCache::CalcReferencePaths createCalc(std::atomic<size_t> & calc_num) const
+  {
+    return [this, &calc_num](const lanelet::ConstLanelet & lanelet, const double search_dist) {
+      ++calc_num;
+      const lanelet::routing::PossiblePathsParams possible_params{search_dist, {}, 0, false, true};
+      const auto paths = routing_graph_->possiblePaths(lanelet, possible_params);
+      return std::make_shared<const ReferencePaths>(ReferencePaths{paths, {}});
+    };
+  }
+
+  static std::vector<std::vector<lanelet::Id>> toIds(const ReferencePathsConstPtr & paths)
+  {
+    std::vector<std::vector<lanelet::Id>> ids;
+    for (const auto & path : paths->lanelet_paths) {
+      ids.emplace_back();
+      for (const auto & lanelet : path) {
+        ids.back().push_back(lanelet.id());
+      }
+    }
+    return ids;
+  }
+
+  lanelet::ConstLanelets lanelets_;
+  lanelet::LaneletMapPtr map_;
+  lanelet::traffic_rules::TrafficRulesPtr traffic_rules_;
+  lanelet::routing::RoutingGraphPtr routing_graph_;
+};
+}  // namespace
+
+TEST_F(ReferencePathsCacheTest, CachedPathsMatchUncachedPaths)
+{
+  std::atomic<size_t> cached_calc_num{0};
+  std::atomic<size_t> uncached_calc_num{0};
+  ReferencePathsCache cached(true, 5.0, createCalc(cached_calc_num));
+  ReferencePathsCache uncached(false, 5.0, createCalc(uncached_calc_num));
+
+  // several cycles with the search distances of the objects of various speeds
+  std::set<double> rounded_search_dists;
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    for (double search_dist = 10.0; search_dist < 150.0; search_dist += 0.7) {
+      rounded_search_dists.insert(cached.roundSearchDistance(search_dist));
+      for (const size_t i : {0, 1, 2}) {
+        const auto & lanelet = lanelets_.at(i);
+        EXPECT_EQ(
+          toIds(cached.get(lanelet, search_dist)), toIds(uncached.get(lanelet, search_dist)));
+      }
+    }
+    cached.removeUnused();
+  }
+
+  // the rounded search distances are shared among the objects and the cycles
+  EXPECT_EQ(cached.size(), 3u * rounded_search_dists.size());
+  EXPECT_EQ(cached_calc_num.load(), cached.size());
+  EXPECT_GT(uncached_calc_num.load(), 10 * cached_calc_num.load());
+
+  // the paths are longer with the longer search distance
+  const auto & lanelet = lanelets_.front();
+  EXPECT_EQ(toIds(cached.get(lanelet, 20.0)).size(), 1u);
+  EXPECT_EQ(toIds(cached.get(lanelet, 100.0)).size(), 2u);
+}
+
+TEST_F(ReferencePathsCacheTest, NotRoundedWithZeroResolution)
+{
+  std::atomic<size_t> calc_num{0};
+  ReferencePathsCache cached(true, 0.0, createCalc(calc_num));
+  const auto calc = createCalc(calc_num);
+  for (const double search_dist : {29.0, 31.0, 59.5, 60.5, 119.0}) {
+    EXPECT_DOUBLE_EQ(cached.roundSearchDistance(search_dist), search_dist);
+    const auto & lanelet = lanelets_.front();
+    EXPECT_EQ(toIds(cached.get(lanelet, search_dist)), toIds(calc(lanelet, search_dist)));
+  }
+}
+
+TEST_F(ReferencePathsCacheTest, RemoveUnused)
+{
+  std::atomic<size_t> calc_num{0};
+  ReferencePathsCache cached(true, 5.0, createCalc(calc_num));
+  const auto & lanelet = lanelets_.front();
+  EXPECT_DOUBLE_EQ(cached.roundSearchDistance(41.0), 45.0);
+
+  cached.get(lanelet, 41.0);
+  cached.get(lanelet, 44.0);
+  cached.get(lanelet, 51.0);
+  EXPECT_EQ(cached.size(), 2u);
+  EXPECT_EQ(calc_num.load(), 2u);
+
+  // the entries used in the cycle are kept for the next cycle
+  cached.removeUnused();
+  EXPECT_EQ(cached.size(), 2u);
+  cached.get(lanelet, 43.0);
+  cached.removeUnused();
+  EXPECT_EQ(cached.size(), 1u);
+  EXPECT_EQ(calc_num.load(), 2u);
+
+  cached.clear();
+  EXPECT_EQ(cached.size(), 0u);
+}
+
+TEST_F(ReferencePathsCacheTest, SharedAmongWorkers)
+{
+  std::atomic<size_t> cached_calc_num{0};
+  std::atomic<size_t> uncached_calc_num{0};
+  ReferencePathsCache cached(true, 5.0, createCalc(cached_calc_num));
+  ReferencePathsCache uncached(false, 5.0, createCalc(uncached_calc_num));
+
+  tier4_autoware_utils::WorkerPool pool(4);
+  constexpr size_t object_num = 200;
+  std::vector<std::vector<std::vector<lanelet::Id>>> results(object_num);
+  std::atomic<size_t> next_object_idx{0};
+  pool.run([&](const size_t /*worker_index*/) {
+    for (size_t i = next_object_idx++; i < object_num; i = next_object_idx++) {
+      const auto & lanelet = lanelets_.at(i % 3);
+      results.at(i) = toIds(cached.get(lanelet, 10.0 + 0.5 * static_cast<double>(i)));
+    }
+  });
+
+  for (size_t i = 0; i < object_num; ++i) {
+    const auto & lanelet = lanelets_.at(i % 3);
+    EXPECT_EQ(results.at(i), toIds(uncached.get(lanelet, 10.0 + 0.5 * static_cast<double>(i))));
+  }
+}
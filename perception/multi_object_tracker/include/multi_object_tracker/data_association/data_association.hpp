@@ -19,7 +19,6 @@
 #ifndef MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 #define MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -42,9 +41,17 @@ private:
   Eigen::MatrixXd min_area_matrix_;
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
+  // maximum of max_dist_matrix_ over the assignable tracker labels, for each measurement label
+  std::vector<double> max_search_dist_vector_;
   const double score_threshold_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
 
+  double calcScore(
+    const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object,
+    const std::uint8_t measurement_label,
+    const autoware_auto_perception_msgs::msg::TrackedObject & tracked_object,
+    const std::uint8_t tracker_label) const;
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   DataAssociation(
@@ -52,11 +59,11 @@ public:
     std::vector<double> max_area_vector, std::vector<double> min_area_vector,
     std::vector<double> max_rad_vector, std::vector<double> min_iou_vector);
   void assign(
-    const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+    const gnn_solver::SparseScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
     std::unordered_map<int, int> & reverse_assignment);
-  Eigen::MatrixXd calcScoreMatrix(
+  gnn_solver::SparseScoreMatrix calcScoreMatrix(
     const autoware_auto_perception_msgs::msg::DetectedObjects & measurements,
-    const std::list<std::shared_ptr<Tracker>> & trackers);
+    const std::vector<std::shared_ptr<Tracker>> & trackers);
   virtual ~DataAssociation() {}
 };
 
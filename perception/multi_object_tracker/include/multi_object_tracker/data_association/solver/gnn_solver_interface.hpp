@@ -16,10 +16,45 @@
 #define MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__SOLVER__GNN_SOLVER_INTERFACE_HPP_
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace gnn_solver
 {
+/**
+ * @brief score matrix holding only the non-zero scores. entries.at(row) holds the pairs of column
+ * and score of the row in ascending order of the column.
+ */
+struct SparseScoreMatrix
+{
+  SparseScoreMatrix(const int rows, const int cols) : rows(rows), cols(cols), entries(rows) {}
+
+  double coeff(const int row, const int col) const
+  {
+    for (const auto & entry : entries.at(row)) {
+      if (entry.first == col) {
+        return entry.second;
+      }
+    }
+    return 0.0;
+  }
+
+  std::vector<std::vector<double>> toDense() const
+  {
+    std::vector<std::vector<double>> dense(rows, std::vector<double>(cols, 0.0));
+    for (int row = 0; row < rows; ++row) {
+      for (const auto & entry : entries.at(row)) {
+        dense.at(row).at(entry.first) = entry.second;
+      }
+    }
+    return dense;
+  }
+
+  int rows;
+  int cols;
+  std::vector<std::vector<std::pair<int, double>>> entries;
+};
+
 class GnnSolverInterface
 {
 public:
@@ -29,6 +64,14 @@ public:
   virtual void maximizeLinearAssignment(
     const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
     std::unordered_map<int, int> * reverse_assignment) = 0;
+
+  // solvers which can not use the sparsity solve the dense matrix
+  virtual void maximizeLinearAssignment(
+    const SparseScoreMatrix & score, std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment)
+  {
+    maximizeLinearAssignment(score.toDense(), direct_assignment, reverse_assignment);
+  }
 };
 }  // namespace gnn_solver
 
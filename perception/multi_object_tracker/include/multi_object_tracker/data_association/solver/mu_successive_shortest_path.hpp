@@ -31,6 +31,12 @@ public:
   void maximizeLinearAssignment(
     const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
     std::unordered_map<int, int> * reverse_assignment) override;
+
+  // solve each connected component of the non-zero scores separately, as no assignment with a
+  // positive score connects two components
+  void maximizeLinearAssignment(
+    const SparseScoreMatrix & score, std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment) override;
 };
 }  // namespace gnn_solver
 
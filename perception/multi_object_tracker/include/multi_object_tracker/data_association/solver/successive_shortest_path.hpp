@@ -31,6 +31,10 @@ public:
   void maximizeLinearAssignment(
     const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
     std::unordered_map<int, int> * reverse_assignment) override;
+
+  void maximizeLinearAssignment(
+    const SparseScoreMatrix & score, std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment) override;
 };
 }  // namespace gnn_solver
 
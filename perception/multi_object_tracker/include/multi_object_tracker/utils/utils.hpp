@@ -21,6 +21,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
 
 #include <autoware_auto_perception_msgs/msg/detected_object.hpp>
 #include <autoware_auto_perception_msgs/msg/shape.hpp>
@@ -29,11 +30,15 @@
 #include <geometry_msgs/msg/transform.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <tf2/utils.h>
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace utils
@@ -343,6 +348,56 @@ inline void convertConvexHullToBoundingBox(
   output_object.shape.dimensions.z = height;
 }
 
+// spatial index of the tracked object positions, used as the broad phase of the data association
+// and the tracker sanitization. the value holds the index of the tracker.
+using TrackerRtreeValue = std::pair<tier4_autoware_utils::Point2d, size_t>;
+using TrackerRtree =
+  boost::geometry::index::rtree<TrackerRtreeValue, boost::geometry::index::rstar<16>>;
+
+/**
+ * @brief create the spatial index of the tracked objects
+ * @param objects: tracked objects, which are indexed by their position in this vector
+ * @return rtree of the object positions
+ */
+inline TrackerRtree createTrackerRtree(
+  const std::vector<autoware_auto_perception_msgs::msg::TrackedObject> & objects)
+{
+  std::vector<TrackerRtreeValue> values;
+  values.reserve(objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & position = objects.at(i).kinematics.pose_with_covariance.pose.position;
+    values.emplace_back(tier4_autoware_utils::Point2d(position.x, position.y), i);
+  }
+  return TrackerRtree(values.begin(), values.end());
+}
+
+/**
+ * @brief get the trackers within the distance from the position
+ * @param rtree: spatial index of the tracked objects
+ * @param position: query position
+ * @param distance: maximum distance
+ * @return indices of the trackers in ascending order
+ */
+inline std::vector<size_t> getTrackersWithinDistance(
+  const TrackerRtree & rtree, const geometry_msgs::msg::Point & position, const double distance)
+{
+  const tier4_autoware_utils::Box2d query_box(
+    tier4_autoware_utils::Point2d(position.x - distance, position.y - distance),
+    tier4_autoware_utils::Point2d(position.x + distance, position.y + distance));
+  std::vector<TrackerRtreeValue> values;
+  rtree.query(boost::geometry::index::intersects(query_box), std::back_inserter(values));
+
+  std::vector<size_t> indices;
+  indices.reserve(values.size());
+  for (const auto & value : values) {
+    if (std::hypot(value.first.x() - position.x, value.first.y() - position.y) <= distance) {
+      indices.push_back(value.second);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
 }  // namespace utils
 
 #endif  // MULTI_OBJECT_TRACKER__UTILS__UTILS_HPP_
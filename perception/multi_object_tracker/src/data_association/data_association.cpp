@@ -19,7 +19,6 @@
 #include "object_recognition_utils/object_recognition_utils.hpp"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -111,25 +110,30 @@ DataAssociation::DataAssociation(
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
 
+  max_search_dist_vector_.assign(max_dist_matrix_.cols(), 0.0);
+  for (int measurement_label = 0; measurement_label < max_dist_matrix_.cols();
+       ++measurement_label) {
+    for (int tracker_label = 0; tracker_label < max_dist_matrix_.rows(); ++tracker_label) {
+      if (can_assign_matrix_(tracker_label, measurement_label)) {
+        max_search_dist_vector_.at(measurement_label) = std::max(
+          max_search_dist_vector_.at(measurement_label),
+          max_dist_matrix_(tracker_label, measurement_label));
+      }
+    }
+  }
+
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
 void DataAssociation::assign(
-  const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
+  const gnn_solver::SparseScoreMatrix & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
-  for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
-    for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
-    }
-  }
   // Solve
-  gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
+  gnn_solver_ptr_->maximizeLinearAssignment(src, &direct_assignment, &reverse_assignment);
 
   for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
+    if (src.coeff(itr->first, itr->second) < score_threshold_) {
       itr = direct_assignment.erase(itr);
       continue;
     } else {
@@ -137,7 +141,7 @@ void DataAssociation::assign(
     }
   }
   for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
+    if (src.coeff(itr->second, itr->first) < score_threshold_) {
       itr = reverse_assignment.erase(itr);
       continue;
     } else {
@@ -146,81 +150,110 @@ void DataAssociation::assign(
   }
 }
 
-Eigen::MatrixXd DataAssociation::calcScoreMatrix(
+gnn_solver::SparseScoreMatrix DataAssociation::calcScoreMatrix(
   const autoware_auto_perception_msgs::msg::DetectedObjects & measurements,
-  const std::list<std::shared_ptr<Tracker>> & trackers)
+  const std::vector<std::shared_ptr<Tracker>> & trackers)
 {
-  Eigen::MatrixXd score_matrix =
-    Eigen::MatrixXd::Zero(trackers.size(), measurements.objects.size());
-  size_t tracker_idx = 0;
-  for (auto tracker_itr = trackers.begin(); tracker_itr != trackers.end();
-       ++tracker_itr, ++tracker_idx) {
-    const std::uint8_t tracker_label = (*tracker_itr)->getHighestProbLabel();
-
-    for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
-         ++measurement_idx) {
-      const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object =
-        measurements.objects.at(measurement_idx);
-      const std::uint8_t measurement_label =
-        object_recognition_utils::getHighestProbLabel(measurement_object.classification);
-
-      double score = 0.0;
-      if (can_assign_matrix_(tracker_label, measurement_label)) {
-        autoware_auto_perception_msgs::msg::TrackedObject tracked_object;
-        (*tracker_itr)->getTrackedObject(measurements.header.stamp, tracked_object);
-
-        const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
-        const double dist = tier4_autoware_utils::calcDistance2d(
-          measurement_object.kinematics.pose_with_covariance.pose.position,
-          tracked_object.kinematics.pose_with_covariance.pose.position);
-
-        bool passed_gate = true;
-        // dist gate
-        if (passed_gate) {
-          if (max_dist < dist) passed_gate = false;
-        }
-        // area gate
-        if (passed_gate) {
-          const double max_area = max_area_matrix_(tracker_label, measurement_label);
-          const double min_area = min_area_matrix_(tracker_label, measurement_label);
-          const double area = tier4_autoware_utils::getArea(measurement_object.shape);
-          if (area < min_area || max_area < area) passed_gate = false;
-        }
-        // angle gate
-        if (passed_gate) {
-          const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
-          const double angle = getFormedYawAngle(
-            measurement_object.kinematics.pose_with_covariance.pose.orientation,
-            tracked_object.kinematics.pose_with_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle))
-            passed_gate = false;
-        }
-        // mahalanobis dist gate
-        if (passed_gate) {
-          const double mahalanobis_dist = getMahalanobisDistance(
-            measurement_object.kinematics.pose_with_covariance.pose.position,
-            tracked_object.kinematics.pose_with_covariance.pose.position,
-            getXYCovariance(tracked_object.kinematics.pose_with_covariance));
-          if (3.035 /*99%*/ <= mahalanobis_dist) passed_gate = false;
-        }
-        // 2d iou gate
-        if (passed_gate) {
-          const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
-          const double min_union_iou_area = 1e-2;
-          const double iou = object_recognition_utils::get2dIoU(
-            measurement_object, tracked_object, min_union_iou_area);
-          if (iou < min_iou) passed_gate = false;
-        }
-
-        // all gate is passed
-        if (passed_gate) {
-          score = (max_dist - std::min(dist, max_dist)) / max_dist;
-          if (score < score_threshold_) score = 0.0;
-        }
+  gnn_solver::SparseScoreMatrix score_matrix(trackers.size(), measurements.objects.size());
+  if (trackers.empty() || measurements.objects.empty()) {
+    return score_matrix;
+  }
+
+  // get the tracked objects once and index their positions, so that each measurement is only
+  // compared with the trackers within the maximum distance of the gate
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> tracked_objects(trackers.size());
+  std::vector<std::uint8_t> tracker_labels(trackers.size());
+  for (size_t tracker_idx = 0; tracker_idx < trackers.size(); ++tracker_idx) {
+    trackers.at(tracker_idx)
+      ->getTrackedObject(measurements.header.stamp, tracked_objects.at(tracker_idx));
+    tracker_labels.at(tracker_idx) = trackers.at(tracker_idx)->getHighestProbLabel();
+  }
+  const auto rtree = utils::createTrackerRtree(tracked_objects);
+
+  // the columns of each row are appended in ascending order
+  for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
+       ++measurement_idx) {
+    const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object =
+      measurements.objects.at(measurement_idx);
+    const std::uint8_t measurement_label =
+      object_recognition_utils::getHighestProbLabel(measurement_object.classification);
+
+    const auto tracker_indices = utils::getTrackersWithinDistance(
+      rtree, measurement_object.kinematics.pose_with_covariance.pose.position,
+      max_search_dist_vector_.at(measurement_label));
+    for (const auto tracker_idx : tracker_indices) {
+      const double score = calcScore(
+        measurement_object, measurement_label, tracked_objects.at(tracker_idx),
+        tracker_labels.at(tracker_idx));
+      if (0.0 < score) {
+        score_matrix.entries.at(tracker_idx).emplace_back(measurement_idx, score);
       }
-      score_matrix(tracker_idx, measurement_idx) = score;
     }
   }
 
   return score_matrix;
 }
+
+double DataAssociation::calcScore(
+  const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object,
+  const std::uint8_t measurement_label,
+  const autoware_auto_perception_msgs::msg::TrackedObject & tracked_object,
+  const std::uint8_t tracker_label) const
+{
+  if (!can_assign_matrix_(tracker_label, measurement_label)) {
+    return 0.0;
+  }
+
+  const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
+  const double dist = tier4_autoware_utils::calcDistance2d(
+    measurement_object.kinematics.pose_with_covariance.pose.position,
+    tracked_object.kinematics.pose_with_covariance.pose.position);
+
+  // dist gate
+  if (max_dist < dist) {
+    return 0.0;
+  }
+  // area gate
+  {
+    const double max_area = max_area_matrix_(tracker_label, measurement_label);
+    const double min_area = min_area_matrix_(tracker_label, measurement_label);
+    const double area = tier4_autoware_utils::getArea(measurement_object.shape);
+    if (area < min_area || max_area < area) {
+      return 0.0;
+    }
+  }
+  // angle gate
+  {
+    const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
+    const double angle = getFormedYawAngle(
+      measurement_object.kinematics.pose_with_covariance.pose.orientation,
+      tracked_object.kinematics.pose_with_covariance.pose.orientation, false);
+    if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle)) {
+      return 0.0;
+    }
+  }
+  // mahalanobis dist gate
+  {
+    const double mahalanobis_dist = getMahalanobisDistance(
+      measurement_object.kinematics.pose_with_covariance.pose.position,
+      tracked_object.kinematics.pose_with_covariance.pose.position,
+      getXYCovariance(tracked_object.kinematics.pose_with_covariance));
+    if (3.035 /*99%*/ <= mahalanobis_dist) {
+      return 0.0;
+    }
+  }
+  // 2d iou gate
+  {
+    const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
+    const double min_union_iou_area = 1e-2;
+    const double iou =
+      object_recognition_utils::get2dIoU(measurement_object, tracked_object, min_union_iou_area);
+    if (iou < min_iou) {
+      return 0.0;
+    }
+  }
+
+  // all gate is passed
+  const double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+  return score < score_threshold_ ? 0.0 : score;
+}
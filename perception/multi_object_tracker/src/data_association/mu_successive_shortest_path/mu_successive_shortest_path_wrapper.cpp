@@ -20,6 +20,7 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -38,4 +39,77 @@ void MuSSP::maximizeLinearAssignment(
   // Solve DA by muSSP
   solve_muSSP(cost, direct_assignment, reverse_assignment);
 }
+
+void MuSSP::maximizeLinearAssignment(
+  const SparseScoreMatrix & score, std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
+  // Terminate if the graph is empty
+  if (score.rows == 0 || score.cols == 0) {
+    return;
+  }
+
+  // Union-find over the rows {0, ..., rows - 1} and the columns {rows, ..., rows + cols - 1}
+  std::vector<int> parents(score.rows + score.cols);
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto find_root = [&parents](int node) {
+    while (parents.at(node) != node) {
+      parents.at(node) = parents.at(parents.at(node));
+      node = parents.at(node);
+    }
+    return node;
+  };
+  for (int row = 0; row < score.rows; ++row) {
+    for (const auto & entry : score.entries.at(row)) {
+      parents.at(find_root(row)) = find_root(score.rows + entry.first);
+    }
+  }
+
+  // Rows and columns of each component in ascending order. The rows and the columns without any
+  // score are left unassigned.
+  std::unordered_map<int, std::pair<std::vector<int>, std::vector<int>>> components;
+  for (int row = 0; row < score.rows; ++row) {
+    if (!score.entries.at(row).empty()) {
+      components[find_root(row)].first.push_back(row);
+    }
+  }
+  for (int col = 0; col < score.cols; ++col) {
+    const int root = find_root(score.rows + col);
+    if (components.count(root) != 0) {
+      components.at(root).second.push_back(col);
+    }
+  }
+
+  for (const auto & [root, component] : components) {
+    const auto & [rows, cols] = component;
+
+    // a single pair needs no solver
+    if (rows.size() == 1 && cols.size() == 1) {
+      direct_assignment->emplace(rows.front(), cols.front());
+      reverse_assignment->emplace(cols.front(), rows.front());
+      continue;
+    }
+
+    std::unordered_map<int, int> local_cols;
+    for (size_t i = 0; i < cols.size(); ++i) {
+      local_cols.emplace(cols.at(i), static_cast<int>(i));
+    }
+    std::vector<std::vector<double>> cost(rows.size(), std::vector<double>(cols.size(), 0.0));
+    for (size_t i = 0; i < rows.size(); ++i) {
+      for (const auto & entry : score.entries.at(rows.at(i))) {
+        cost.at(i).at(local_cols.at(entry.first)) = entry.second;
+      }
+    }
+
+    std::unordered_map<int, int> local_direct_assignment;
+    std::unordered_map<int, int> local_reverse_assignment;
+    solve_muSSP(cost, &local_direct_assignment, &local_reverse_assignment);
+    for (const auto & [local_row, local_col] : local_direct_assignment) {
+      direct_assignment->emplace(rows.at(local_row), cols.at(local_col));
+    }
+    for (const auto & [local_col, local_row] : local_reverse_assignment) {
+      reverse_assignment->emplace(cols.at(local_col), rows.at(local_row));
+    }
+  }
+}
 }  // namespace gnn_solver
@@ -46,6 +46,24 @@ struct ResidualEdge
 void SSP::maximizeLinearAssignment(
   const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
   std::unordered_map<int, int> * reverse_assignment)
+{
+  // When there is no agents or no tasks, terminate
+  if (cost.size() == 0 || cost.at(0).size() == 0) {
+    return;
+  }
+
+  SparseScoreMatrix score(cost.size(), cost.at(0).size());
+  for (int agent = 0; agent < score.rows; ++agent) {
+    for (int task = 0; task < score.cols; ++task) {
+      score.entries.at(agent).emplace_back(task, cost.at(agent).at(task));
+    }
+  }
+  maximizeLinearAssignment(score, direct_assignment, reverse_assignment);
+}
+
+void SSP::maximizeLinearAssignment(
+  const SparseScoreMatrix & score, std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
 {
   // NOTE: Need to set as default arguments
   bool sparse_cost = true;
@@ -58,13 +76,13 @@ void SSP::maximizeLinearAssignment(
   const double EPS = 1e-5;
 
   // When there is no agents or no tasks, terminate
-  if (cost.size() == 0 || cost.at(0).size() == 0) {
+  if (score.rows == 0 || score.cols == 0) {
     return;
   }
 
   // Construct a bipartite graph from the cost matrix
-  int n_agents = cost.size();
-  int n_tasks = cost.at(0).size();
+  int n_agents = score.rows;
+  int n_tasks = score.cols;
 
   int n_dummies;
   if (sparse_cost) {
@@ -131,18 +149,16 @@ void SSP::maximizeLinearAssignment(
 
   // Add edges from agents
   for (int agent = 0; agent < n_agents; ++agent) {
-    for (int task = 0; task < n_tasks; ++task) {
-      if (!sparse_cost || cost.at(agent).at(task) > EPS) {
+    for (const auto & [task, cost] : score.entries.at(agent)) {
+      if (!sparse_cost || cost > EPS) {
         // From agent to task
         adjacency_list.at(agent + 1).emplace_back(
-          task + n_agents + 1, 1, MAX_COST - cost.at(agent).at(task), 0,
+          task + n_agents + 1, 1, MAX_COST - cost, 0,
           adjacency_list.at(task + n_agents + 1).size());
 
         // From task to agent
         adjacency_list.at(task + n_agents + 1)
-          .emplace_back(
-            agent + 1, 0, cost.at(agent).at(task) - MAX_COST, 0,
-            adjacency_list.at(agent + 1).size() - 1);
+          .emplace_back(agent + 1, 0, cost - MAX_COST, 0, adjacency_list.at(agent + 1).size() - 1);
       }
     }
   }
@@ -20,8 +20,8 @@
 #include <tf2_ros/create_timer_interface.h>
 #include <tf2_ros/create_timer_ros.h>
 
+#include <algorithm>
 #include <iterator>
-#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -263,7 +263,7 @@ void MultiObjectTracker::onMeasurement(
 
   /* global nearest neighbor */
   std::unordered_map<int, int> direct_assignment, reverse_assignment;
-  Eigen::MatrixXd score_matrix = data_association_->calcScoreMatrix(
+  const auto score_matrix = data_association_->calcScoreMatrix(
     transformed_objects, list_tracker_);  // row : tracker, col : measurement
   data_association_->assign(score_matrix, direct_assignment, reverse_assignment);
 
@@ -347,49 +347,56 @@ void MultiObjectTracker::onTimer()
 }
 
 void MultiObjectTracker::checkTrackerLifeCycle(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
   [[maybe_unused]] const geometry_msgs::msg::Transform & self_transform)
 {
   /* params */
   constexpr float max_elapsed_time = 1.0;
 
   /* delete tracker */
-  for (auto itr = list_tracker.begin(); itr != list_tracker.end(); ++itr) {
-    const bool is_old = max_elapsed_time < (*itr)->getElapsedTimeFromLastUpdate(time);
-    if (is_old) {
-      auto erase_itr = itr;
-      --itr;
-      list_tracker.erase(erase_itr);
-    }
-  }
+  list_tracker.erase(
+    std::remove_if(
+      list_tracker.begin(), list_tracker.end(),
+      [&](const auto & tracker) {
+        return max_elapsed_time < tracker->getElapsedTimeFromLastUpdate(time);
+      }),
+    list_tracker.end());
 }
 
 void MultiObjectTracker::sanitizeTracker(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
 {
   constexpr float min_iou = 0.1;
   constexpr float min_iou_for_unknown_object = 0.001;
   constexpr double distance_threshold = 5.0;
   /* delete collision tracker */
-  for (auto itr1 = list_tracker.begin(); itr1 != list_tracker.end(); ++itr1) {
-    autoware_auto_perception_msgs::msg::TrackedObject object1;
-    (*itr1)->getTrackedObject(time, object1);
-    for (auto itr2 = std::next(itr1); itr2 != list_tracker.end(); ++itr2) {
-      autoware_auto_perception_msgs::msg::TrackedObject object2;
-      (*itr2)->getTrackedObject(time, object2);
-      const double distance = std::hypot(
-        object1.kinematics.pose_with_covariance.pose.position.x -
-          object2.kinematics.pose_with_covariance.pose.position.x,
-        object1.kinematics.pose_with_covariance.pose.position.y -
-          object2.kinematics.pose_with_covariance.pose.position.y);
-      if (distance_threshold < distance) {
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> objects(list_tracker.size());
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    list_tracker.at(i)->getTrackedObject(time, objects.at(i));
+  }
+  // only the trackers within distance_threshold can collide
+  const auto rtree = utils::createTrackerRtree(objects);
+
+  std::vector<bool> is_deleted(list_tracker.size(), false);
+  for (size_t idx1 = 0; idx1 < list_tracker.size(); ++idx1) {
+    if (is_deleted.at(idx1)) {
+      continue;
+    }
+    const auto & object1 = objects.at(idx1);
+    const auto neighbor_indices = utils::getTrackersWithinDistance(
+      rtree, object1.kinematics.pose_with_covariance.pose.position, distance_threshold);
+    for (const auto idx2 : neighbor_indices) {
+      if (idx2 <= idx1 || is_deleted.at(idx2)) {
         continue;
       }
+      const auto & object2 = objects.at(idx2);
+      const auto & tracker1 = list_tracker.at(idx1);
+      const auto & tracker2 = list_tracker.at(idx2);
 
       const double min_union_iou_area = 1e-2;
       const auto iou = object_recognition_utils::get2dIoU(object1, object2, min_union_iou_area);
-      const auto & label1 = (*itr1)->getHighestProbLabel();
-      const auto & label2 = (*itr2)->getHighestProbLabel();
+      const auto & label1 = tracker1->getHighestProbLabel();
+      const auto & label2 = tracker2->getHighestProbLabel();
       bool should_delete_tracker1 = false;
       bool should_delete_tracker2 = false;
 
@@ -398,7 +405,7 @@ void MultiObjectTracker::sanitizeTracker(
       if (label1 == Label::UNKNOWN || label2 == Label::UNKNOWN) {
         if (min_iou_for_unknown_object < iou) {
           if (label1 == Label::UNKNOWN && label2 == Label::UNKNOWN) {
-            if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+            if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
               should_delete_tracker1 = true;
             } else {
               should_delete_tracker2 = true;
@@ -411,7 +418,7 @@ void MultiObjectTracker::sanitizeTracker(
         }
       } else {  // If neither is UNKNOWN, delete the one with lower IOU.
         if (min_iou < iou) {
-          if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+          if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
             should_delete_tracker1 = true;
           } else {
             should_delete_tracker2 = true;
@@ -420,15 +427,21 @@ void MultiObjectTracker::sanitizeTracker(
       }
 
       if (should_delete_tracker1) {
-        itr1 = list_tracker.erase(itr1);
-        --itr1;
+        is_deleted.at(idx1) = true;
         break;
       } else if (should_delete_tracker2) {
-        itr2 = list_tracker.erase(itr2);
-        --itr2;
+        is_deleted.at(idx2) = true;
       }
     }
   }
+
+  size_t remaining_num = 0;
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    if (!is_deleted.at(i)) {
+      list_tracker.at(remaining_num++) = std::move(list_tracker.at(i));
+    }
+  }
+  list_tracker.resize(remaining_num);
 }
 
 inline bool MultiObjectTracker::shouldTrackerPublish(
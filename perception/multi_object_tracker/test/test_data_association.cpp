@@ -0,0 +1,134 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "multi_object_tracker/data_association/solver/mu_successive_shortest_path.hpp"
+#include "multi_object_tracker/data_association/solver/successive_shortest_path.hpp"
+#include "multi_object_tracker/utils/utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+// sparse score matrix with the scores of the gated pairs, and zero for the other pairs
+gnn_solver::SparseScoreMatrix createRandomScoreMatrix(
+  std::mt19937 & engine, const int rows, const int cols, const double density)
+{
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::uniform_real_distribution<double> score(0.01, 1.0);
+  gnn_solver::SparseScoreMatrix matrix(rows, cols);
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      if (uniform(engine) < density) {
+        matrix.entries.at(row).emplace_back(col, score(engine));
+      }
+    }
+  }
+  return matrix;
+}
+
+// remove the assignments with zero score, as DataAssociation::assign does
+void removeZeroScoreAssignments(
+  const gnn_solver::SparseScoreMatrix & score, std::unordered_map<int, int> & direct_assignment,
+  std::unordered_map<int, int> & reverse_assignment)
+{
+  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
+    itr = score.coeff(itr->first, itr->second) <= 0.0 ? direct_assignment.erase(itr) : ++itr;
+  }
+  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
+    itr = score.coeff(itr->second, itr->first) <= 0.0 ? reverse_assignment.erase(itr) : ++itr;
+  }
+}
+
+void expectSameAssignment(gnn_solver::GnnSolverInterface & solver, const int seed)
+{
+  std::mt19937 engine(seed);
+  for (const double density : {0.02, 0.1, 0.5, 1.0}) {
+    for (int trial = 0; trial < 20; ++trial) {
+      std::uniform_int_distribution<int> size(1, 40);
+      const auto score = createRandomScoreMatrix(engine, size(engine), size(engine), density);
+
+      std::unordered_map<int, int> dense_direct_assignment;
+      std::unordered_map<int, int> dense_reverse_assignment;
+      solver.maximizeLinearAssignment(
+        score.toDense(), &dense_direct_assignment, &dense_reverse_assignment);
+      removeZeroScoreAssignments(score, dense_direct_assignment, dense_reverse_assignment);
+
+      std::unordered_map<int, int> sparse_direct_assignment;
+      std::unordered_map<int, int> sparse_reverse_assignment;
+      solver.maximizeLinearAssignment(
+        score, &sparse_direct_assignment, &sparse_reverse_assignment);
+      removeZeroScoreAssignments(score, sparse_direct_assignment, sparse_reverse_assignment);
+
+      EXPECT_EQ(dense_direct_assignment, sparse_direct_assignment);
+      EXPECT_EQ(dense_reverse_assignment, sparse_reverse_assignment);
+    }
+  }
+}
+}  // namespace
+
+TEST(GnnSolver, MuSSPSparseMatchesDense)
+{
+  gnn_solver::MuSSP solver;
+  expectSameAssignment(solver, 0);
+}
+
+TEST(GnnSolver, SSPSparseMatchesDense)
+{
+  gnn_solver::SSP solver;
+  expectSameAssignment(solver, 1);
+}
+
+// the association gating and the tracker sanitization used to compare every pair and skip the ones
+// farther than the distance, in ascending order of the tracker index
+TEST(TrackerRtree, TrackersWithinDistanceMatchesBruteForce)
+{
+  std::mt19937 engine(2);
+  std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+  std::uniform_real_distribution<double> distance(0.0, 30.0);
+
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> objects(500);
+  for (auto & object : objects) {
+    object.kinematics.pose_with_covariance.pose.position.x = coordinate(engine);
+    object.kinematics.pose_with_covariance.pose.position.y = coordinate(engine);
+  }
+  // objects on the same position and exactly on the border of the query
+  objects.at(1).kinematics.pose_with_covariance.pose.position =
+    objects.at(0).kinematics.pose_with_covariance.pose.position;
+  objects.at(2).kinematics.pose_with_covariance.pose.position.x =
+    objects.at(0).kinematics.pose_with_covariance.pose.position.x + 5.0;
+  objects.at(2).kinematics.pose_with_covariance.pose.position.y =
+    objects.at(0).kinematics.pose_with_covariance.pose.position.y;
+  const auto rtree = utils::createTrackerRtree(objects);
+
+  const auto checkQuery = [&](const geometry_msgs::msg::Point & position, const double dist) {
+    std::vector<size_t> expected_indices;
+    for (size_t i = 0; i < objects.size(); ++i) {
+      const auto & object_position = objects.at(i).kinematics.pose_with_covariance.pose.position;
+      if (std::hypot(object_position.x - position.x, object_position.y - position.y) <= dist) {
+        expected_indices.push_back(i);
+      }
+    }
+    EXPECT_EQ(utils::getTrackersWithinDistance(rtree, position, dist), expected_indices);
+  };
+
+  checkQuery(objects.at(0).kinematics.pose_with_covariance.pose.position, 5.0);
+  for (const auto & object : objects) {
+    checkQuery(object.kinematics.pose_with_covariance.pose.position, distance(engine));
+  }
+}
@@ -54,16 +54,43 @@
 
 #include <nav2_costmap_2d/costmap_2d.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <sensor_msgs/msg/laser_scan.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 namespace costmap_2d
 {
 using geometry_msgs::msg::Pose;
 using sensor_msgs::msg::PointCloud2;
 
+// cost to be written to a cell of the costmap
+struct CellUpdate
+{
+  unsigned int index;
+  unsigned char cost;
+};
+
+// cell updates of a chunk of angle bins, one list for each step in the order they are applied
+struct AngleBinCellUpdates
+{
+  std::vector<CellUpdate> free_space;      // 1st step: free space up to the farthest point
+  std::vector<CellUpdate> no_information;  // 2nd step: unknown cells behind the obstacles
+  std::vector<CellUpdate> occupied;        // 3rd step: obstacle cells
+
+  void clear()
+  {
+    free_space.clear();
+    no_information.clear();
+    occupied.clear();
+  }
+};
+
 class OccupancyGridMapInterface : public nav2_costmap_2d::Costmap2D
 {
 public:
@@ -83,9 +110,41 @@ public:
 
   virtual void initRosParam(rclcpp::Node & node) = 0;
 
+protected:
+  // same as raytrace() and setCellValue(), but the cells are appended to updates
+  void addRaytraceUpdates(
+    const double source_x, const double source_y, const double target_x, const double target_y,
+    const unsigned char cost, std::vector<CellUpdate> & updates);
+  void addCellValueUpdate(
+    const double wx, const double wy, const unsigned char cost,
+    std::vector<CellUpdate> & updates) const;
+
+  /**
+   * @brief Run update_bin for every angle bin on raytrace_thread_num_ threads. The bins are split
+   * into chunks and each chunk collects its own cell updates, so nothing is written to the
+   * costmap here. Call applyAngleBinCellUpdates() afterwards for each step.
+   */
+  void collectAngleBinCellUpdates(
+    const size_t angle_bin_size,
+    const std::function<void(const size_t, AngleBinCellUpdates &)> & update_bin);
+  // write one step of the collected updates in ascending bin order, same as a sequential update
+  void applyAngleBinCellUpdates(std::vector<CellUpdate> AngleBinCellUpdates::*step);
+  // set raytrace_thread_num_ and create the threads, which are kept between the updates
+  void setRaytraceThreadNum(const int raytrace_thread_num);
+
+  int raytrace_thread_num_{1};
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> raytrace_worker_pool_;
+
 private:
   bool worldToMap(double wx, double wy, unsigned int & mx, unsigned int & my) const;
 
+  template <class ActionType>
+  void raytraceWithAction(
+    const double source_x, const double source_y, const double target_x, const double target_y,
+    ActionType action);
+
+  std::vector<AngleBinCellUpdates> angle_bin_chunk_updates_;
+
   rclcpp::Logger logger_{rclcpp::get_logger("pointcloud_based_occupancy_grid_map")};
   rclcpp::Clock clock_{RCL_ROS_TIME};
 };
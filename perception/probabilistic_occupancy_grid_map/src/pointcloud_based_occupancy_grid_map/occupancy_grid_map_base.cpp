@@ -69,10 +69,32 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 namespace costmap_2d
 {
 using sensor_msgs::PointCloud2ConstIterator;
 
+namespace
+{
+// number of angle bins handled by a worker at once
+constexpr size_t angle_bin_chunk_size = 32;
+
+// raytraceLine() action which records the cells instead of writing to the costmap
+class CellUpdateCollector
+{
+public:
+  CellUpdateCollector(std::vector<CellUpdate> & updates, const unsigned char cost)
+  : updates_(updates), cost_(cost)
+  {
+  }
+  inline void operator()(unsigned int offset) { updates_.push_back(CellUpdate{offset, cost_}); }
+
+private:
+  std::vector<CellUpdate> & updates_;
+  unsigned char cost_;
+};
+}  // namespace
+
 OccupancyGridMapInterface::OccupancyGridMapInterface(
   const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
 : Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION)
@@ -161,9 +183,37 @@ void OccupancyGridMapInterface::setCellValue(
   marker(index);
 }
 
+void OccupancyGridMapInterface::addCellValueUpdate(
+  const double wx, const double wy, const unsigned char cost,
+  std::vector<CellUpdate> & updates) const
+{
+  unsigned int mx{};
+  unsigned int my{};
+  if (!worldToMap(wx, wy, mx, my)) {
+    RCLCPP_DEBUG(logger_, "Computing map coords failed");
+    return;
+  }
+  updates.push_back(CellUpdate{getIndex(mx, my), cost});
+}
+
 void OccupancyGridMapInterface::raytrace(
   const double source_x, const double source_y, const double target_x, const double target_y,
   const unsigned char cost)
+{
+  raytraceWithAction(source_x, source_y, target_x, target_y, MarkCell(costmap_, cost));
+}
+
+void OccupancyGridMapInterface::addRaytraceUpdates(
+  const double source_x, const double source_y, const double target_x, const double target_y,
+  const unsigned char cost, std::vector<CellUpdate> & updates)
+{
+  raytraceWithAction(source_x, source_y, target_x, target_y, CellUpdateCollector(updates, cost));
+}
+
+template <class ActionType>
+void OccupancyGridMapInterface::raytraceWithAction(
+  const double source_x, const double source_y, const double target_x, const double target_y,
+  ActionType action)
 {
   unsigned int x0{};
   unsigned int y0{};
@@ -225,8 +275,60 @@ void OccupancyGridMapInterface::raytrace(
   }
 
   constexpr unsigned int cell_raytrace_range = 10000;  // large number to ignore range threshold
-  MarkCell marker(costmap_, cost);
-  raytraceLine(marker, x0, y0, x1, y1, cell_raytrace_range);
+  raytraceLine(action, x0, y0, x1, y1, cell_raytrace_range);
+}
+
+void OccupancyGridMapInterface::collectAngleBinCellUpdates(
+  const size_t angle_bin_size,
+  const std::function<void(const size_t, AngleBinCellUpdates &)> & update_bin)
+{
+  const size_t chunk_num = (angle_bin_size + angle_bin_chunk_size - 1) / angle_bin_chunk_size;
+  if (angle_bin_chunk_updates_.size() < chunk_num) {
+    angle_bin_chunk_updates_.resize(chunk_num);
+  }
+  for (auto & chunk_updates : angle_bin_chunk_updates_) {
+    chunk_updates.clear();
+  }
+
+  // each chunk is written by only one worker, the costmap itself is only read
+  std::atomic<size_t> next_chunk_index{0};
+  const auto worker = [&]() {
+    for (size_t chunk_index = next_chunk_index++; chunk_index < chunk_num;
+         chunk_index = next_chunk_index++) {
+      auto & chunk_updates = angle_bin_chunk_updates_.at(chunk_index);
+      const size_t bin_end = std::min((chunk_index + 1) * angle_bin_chunk_size, angle_bin_size);
+      for (size_t bin_index = chunk_index * angle_bin_chunk_size; bin_index < bin_end;
+           ++bin_index) {
+        update_bin(bin_index, chunk_updates);
+      }
+    }
+  };
+
+  if (raytrace_worker_pool_ && chunk_num > 1) {
+    raytrace_worker_pool_->run([&](const size_t /*worker_index*/) { worker(); });
+  } else {
+    worker();
+  }
+}
+
+void OccupancyGridMapInterface::setRaytraceThreadNum(const int raytrace_thread_num)
+{
+  raytrace_thread_num_ = raytrace_thread_num;
+  raytrace_worker_pool_.reset();
+  if (raytrace_thread_num_ > 1) {
+    raytrace_worker_pool_ =
+      std::make_unique<tier4_autoware_utils::WorkerPool>(static_cast<size_t>(raytrace_thread_num_));
+  }
+}
+
+void OccupancyGridMapInterface::applyAngleBinCellUpdates(
+  std::vector<CellUpdate> AngleBinCellUpdates::*step)
+{
+  for (const auto & chunk_updates : angle_bin_chunk_updates_) {
+    for (const auto & update : chunk_updates.*step) {
+      costmap_[update.index] = update.cost;
+    }
+  }
 }
 
 }  // namespace costmap_2d
@@ -106,128 +106,139 @@ void OccupancyGridMapFixedBlindSpot::updateWithPointCloud(
       .push_back(BinInfo(std::hypot(*iter_y, *iter_x), *iter_wx, *iter_wy));
   }
 
-  // Sort by distance
-  for (auto & obstacle_pointcloud_angle_bin : obstacle_pointcloud_angle_bins) {
-    std::sort(
-      obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
-      [](auto a, auto b) { return a.range < b.range; });
-  }
-  for (auto & raw_pointcloud_angle_bin : raw_pointcloud_angle_bins) {
-    std::sort(raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(), [](auto a, auto b) {
-      return a.range < b.range;
-    });
-  }
+  // Raytrace each angle bin in parallel. The three steps below are applied in this order and
+  // each one overwrites the previous ones, so the bins only collect their cell updates here.
+  collectAngleBinCellUpdates(
+    angle_bin_size, [&](const size_t bin_index, AngleBinCellUpdates & updates) {
+      auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
+      auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
+
+      // Sort by distance
+      std::sort(
+        obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
+        [](const auto & a, const auto & b) { return a.range < b.range; });
+      std::sort(
+        raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(),
+        [](const auto & a, const auto & b) { return a.range < b.range; });
+
+      // First step: Initialize cells to the final point with freespace
+      if (!raw_pointcloud_angle_bin.empty() || !obstacle_pointcloud_angle_bin.empty()) {
+        BinInfo end_distance;
+        if (raw_pointcloud_angle_bin.empty()) {
+          end_distance = obstacle_pointcloud_angle_bin.back();
+        } else if (obstacle_pointcloud_angle_bin.empty()) {
+          end_distance = raw_pointcloud_angle_bin.back();
+        } else {
+          end_distance = obstacle_pointcloud_angle_bin.back().range + distance_margin_ <
+                             raw_pointcloud_angle_bin.back().range
+                           ? raw_pointcloud_angle_bin.back()
+                           : obstacle_pointcloud_angle_bin.back();
+        }
+        addRaytraceUpdates(
+          scan_origin.position.x, scan_origin.position.y, end_distance.wx, end_distance.wy,
+          occupancy_cost_value::FREE_SPACE, updates.free_space);
+      }
 
-  // First step: Initialize cells to the final point with freespace
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-
-    BinInfo end_distance;
-    if (raw_pointcloud_angle_bin.empty() && obstacle_pointcloud_angle_bin.empty()) {
-      continue;
-    } else if (raw_pointcloud_angle_bin.empty()) {
-      end_distance = obstacle_pointcloud_angle_bin.back();
-    } else if (obstacle_pointcloud_angle_bin.empty()) {
-      end_distance = raw_pointcloud_angle_bin.back();
-    } else {
-      end_distance = obstacle_pointcloud_angle_bin.back().range + distance_margin_ <
-                         raw_pointcloud_angle_bin.back().range
-                       ? raw_pointcloud_angle_bin.back()
-                       : obstacle_pointcloud_angle_bin.back();
-    }
-    raytrace(
-      scan_origin.position.x, scan_origin.position.y, end_distance.wx, end_distance.wy,
-      occupancy_cost_value::FREE_SPACE);
-  }
+      // Second step: Add unknown cell
+      auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
+      for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size();
+           ++dist_index) {
+        // Calculate next raw point from obstacle point
+        while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
+          if (
+            raw_distance_iter->range <
+            obstacle_pointcloud_angle_bin.at(dist_index).range + distance_margin_)
+            raw_distance_iter++;
+          else
+            break;
+        }
 
-  // Second step: Add unknown cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-    auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      // Calculate next raw point from obstacle point
-      while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
-        if (
-          raw_distance_iter->range <
-          obstacle_pointcloud_angle_bin.at(dist_index).range + distance_margin_)
-          raw_distance_iter++;
-        else
-          break;
-      }
+        // There is no point far than the obstacle point.
+        const bool no_freespace_point = (raw_distance_iter == raw_pointcloud_angle_bin.end());
+
+        if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          if (!no_freespace_point) {
+            const auto & target = *raw_distance_iter;
+            addRaytraceUpdates(
+              source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+              updates.no_information);
+            addCellValueUpdate(
+              target.wx, target.wy, occupancy_cost_value::FREE_SPACE, updates.no_information);
+          }
+          continue;
+        }
 
-      // There is no point far than the obstacle point.
-      const bool no_freespace_point = (raw_distance_iter == raw_pointcloud_angle_bin.end());
+        auto next_obstacle_point_distance = std::abs(
+          obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
+          obstacle_pointcloud_angle_bin.at(dist_index).range);
+        if (next_obstacle_point_distance <= distance_margin_) {
+          continue;
+        } else if (no_freespace_point) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          continue;
+        }
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        if (!no_freespace_point) {
+        auto next_raw_distance =
+          std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
+        if (next_raw_distance < next_obstacle_point_distance) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
           const auto & target = *raw_distance_iter;
-          raytrace(
-            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-          setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          addCellValueUpdate(
+            target.wx, target.wy, occupancy_cost_value::FREE_SPACE, updates.no_information);
+          continue;
+        } else {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          continue;
         }
-        continue;
-      }
-
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
-      if (next_obstacle_point_distance <= distance_margin_) {
-        continue;
-      } else if (no_freespace_point) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        continue;
       }
 
-      auto next_raw_distance =
-        std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
-      if (next_raw_distance < next_obstacle_point_distance) {
+      // Third step: Overwrite occupied cell
+      for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size();
+           ++dist_index) {
         const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = *raw_distance_iter;
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
-        continue;
-      } else {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        continue;
-      }
-    }
-  }
+        addCellValueUpdate(
+          source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE, updates.occupied);
 
-  // Third step: Overwrite occupied cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-      setCellValue(source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE);
+        if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+          continue;
+        }
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        continue;
+        auto next_obstacle_point_distance = std::abs(
+          obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
+          obstacle_pointcloud_angle_bin.at(dist_index).range);
+        if (next_obstacle_point_distance <= distance_margin_) {
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE,
+            updates.occupied);
+          continue;
+        }
       }
+    });
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
-      if (next_obstacle_point_distance <= distance_margin_) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE);
-        continue;
-      }
-    }
-  }
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::free_space);
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::no_information);
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::occupied);
 }
 
 void OccupancyGridMapFixedBlindSpot::initRosParam(rclcpp::Node & node)
 {
   distance_margin_ =
     node.declare_parameter<double>("OccupancyGridMapFixedBlindSpot.distance_margin");
+  setRaytraceThreadNum(
+    node.declare_parameter<int>("OccupancyGridMapFixedBlindSpot.raytrace_thread_num"));
 }
 
 }  // namespace costmap_2d
@@ -137,18 +137,6 @@ void OccupancyGridMapProjectiveBlindSpot::updateWithPointCloud(
     }
   }
 
-  // Sort by distance
-  for (auto & obstacle_pointcloud_angle_bin : obstacle_pointcloud_angle_bins) {
-    std::sort(
-      obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
-      [](auto a, auto b) { return a.range < b.range; });
-  }
-  for (auto & raw_pointcloud_angle_bin : raw_pointcloud_angle_bins) {
-    std::sort(raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(), [](auto a, auto b) {
-      return a.range < b.range;
-    });
-  }
-
   grid_map::Costmap2DConverter<grid_map::GridMap> converter;
   if (pub_debug_grid_) {
     debug_grid_.clearAll();
@@ -175,122 +163,140 @@ void OccupancyGridMapProjectiveBlindSpot::updateWithPointCloud(
     return raw.wz > (a * raw.range + b);
   };
 
-  // First step: Initialize cells to the final point with freespace
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    const auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    const auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-
-    BinInfo3D ray_end;
-    if (raw_pointcloud_angle_bin.empty() && obstacle_pointcloud_angle_bin.empty()) {
-      continue;
-    } else if (raw_pointcloud_angle_bin.empty()) {
-      ray_end = obstacle_pointcloud_angle_bin.back();
-    } else if (obstacle_pointcloud_angle_bin.empty()) {
-      ray_end = raw_pointcloud_angle_bin.back();
-    } else {
-      const auto & farthest_obstacle_this_bin = obstacle_pointcloud_angle_bin.back();
-      const auto & farthest_raw_this_bin = raw_pointcloud_angle_bin.back();
-      ray_end = is_visible_beyond_obstacle(farthest_obstacle_this_bin, farthest_raw_this_bin)
-                  ? farthest_raw_this_bin
-                  : farthest_obstacle_this_bin;
-    }
-    raytrace(
-      scan_origin.position.x, scan_origin.position.y, ray_end.wx, ray_end.wy,
-      occupancy_cost_value::FREE_SPACE);
-  }
+  // Raytrace each angle bin in parallel. The three steps below are applied in this order and
+  // each one overwrites the previous ones, so the bins only collect their cell updates here.
+  collectAngleBinCellUpdates(
+    angle_bin_size, [&](const size_t bin_index, AngleBinCellUpdates & updates) {
+      auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
+      auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
+
+      // Sort by distance
+      std::sort(
+        obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
+        [](const auto & a, const auto & b) { return a.range < b.range; });
+      std::sort(
+        raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(),
+        [](const auto & a, const auto & b) { return a.range < b.range; });
+
+      // First step: Initialize cells to the final point with freespace
+      if (!raw_pointcloud_angle_bin.empty() || !obstacle_pointcloud_angle_bin.empty()) {
+        BinInfo3D ray_end;
+        if (raw_pointcloud_angle_bin.empty()) {
+          ray_end = obstacle_pointcloud_angle_bin.back();
+        } else if (obstacle_pointcloud_angle_bin.empty()) {
+          ray_end = raw_pointcloud_angle_bin.back();
+        } else {
+          const auto & farthest_obstacle_this_bin = obstacle_pointcloud_angle_bin.back();
+          const auto & farthest_raw_this_bin = raw_pointcloud_angle_bin.back();
+          ray_end = is_visible_beyond_obstacle(farthest_obstacle_this_bin, farthest_raw_this_bin)
+                      ? farthest_raw_this_bin
+                      : farthest_obstacle_this_bin;
+        }
+        addRaytraceUpdates(
+          scan_origin.position.x, scan_origin.position.y, ray_end.wx, ray_end.wy,
+          occupancy_cost_value::FREE_SPACE, updates.free_space);
+      }
 
-  if (pub_debug_grid_)
-    converter.addLayerFromCostmap2D(*this, "filled_free_to_farthest", debug_grid_);
+      // Second step: Add unknown cell
+      auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
+      for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size();
+           ++dist_index) {
+        // Calculate next raw point from obstacle point
+        const auto & obstacle_bin = obstacle_pointcloud_angle_bin.at(dist_index);
+        while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
+          if (!is_visible_beyond_obstacle(obstacle_bin, *raw_distance_iter))
+            raw_distance_iter++;
+          else
+            break;
+        }
 
-  // Second step: Add unknown cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    const auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    const auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-    auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      // Calculate next raw point from obstacle point
-      const auto & obstacle_bin = obstacle_pointcloud_angle_bin.at(dist_index);
-      while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
-        if (!is_visible_beyond_obstacle(obstacle_bin, *raw_distance_iter))
-          raw_distance_iter++;
-        else
+        // There is no point farther than the obstacle point.
+        const bool no_visible_point_beyond = (raw_distance_iter == raw_pointcloud_angle_bin.end());
+        if (no_visible_point_beyond) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          addRaytraceUpdates(
+            source.wx, source.wy, source.projected_wx, source.projected_wy,
+            occupancy_cost_value::NO_INFORMATION, updates.no_information);
           break;
-      }
+        }
 
-      // There is no point farther than the obstacle point.
-      const bool no_visible_point_beyond = (raw_distance_iter == raw_pointcloud_angle_bin.end());
-      if (no_visible_point_beyond) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        raytrace(
-          source.wx, source.wy, source.projected_wx, source.projected_wy,
-          occupancy_cost_value::NO_INFORMATION);
-        break;
-      }
+        if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          if (!no_visible_point_beyond) {
+            addRaytraceUpdates(
+              source.wx, source.wy, source.projected_wx, source.projected_wy,
+              occupancy_cost_value::NO_INFORMATION, updates.no_information);
+          }
+          continue;
+        }
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        if (!no_visible_point_beyond) {
-          raytrace(
-            source.wx, source.wy, source.projected_wx, source.projected_wy,
-            occupancy_cost_value::NO_INFORMATION);
+        auto next_obstacle_point_distance = std::abs(
+          obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
+          obstacle_pointcloud_angle_bin.at(dist_index).range);
+        if (next_obstacle_point_distance <= obstacle_separation_threshold_) {
+          continue;
+        } else if (no_visible_point_beyond) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          continue;
         }
-        continue;
-      }
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
-      if (next_obstacle_point_distance <= obstacle_separation_threshold_) {
-        continue;
-      } else if (no_visible_point_beyond) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        continue;
+        auto next_raw_distance =
+          std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
+        if (next_raw_distance < next_obstacle_point_distance) {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          const auto & target = *raw_distance_iter;
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          addCellValueUpdate(
+            target.wx, target.wy, occupancy_cost_value::FREE_SPACE, updates.no_information);
+          continue;
+        } else {
+          const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION,
+            updates.no_information);
+          continue;
+        }
       }
 
-      auto next_raw_distance =
-        std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
-      if (next_raw_distance < next_obstacle_point_distance) {
+      // Third step: Overwrite occupied cell
+      for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size();
+           ++dist_index) {
         const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = *raw_distance_iter;
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
-        continue;
-      } else {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
-        continue;
-      }
-    }
-  }
+        addCellValueUpdate(
+          source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE, updates.occupied);
 
-  if (pub_debug_grid_) converter.addLayerFromCostmap2D(*this, "added_unknown", debug_grid_);
-
-  // Third step: Overwrite occupied cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-      setCellValue(source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE);
+        if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+          continue;
+        }
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        continue;
+        auto next_obstacle_point_distance = std::abs(
+          obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
+          obstacle_pointcloud_angle_bin.at(dist_index).range);
+        if (next_obstacle_point_distance <= obstacle_separation_threshold_) {
+          const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+          addRaytraceUpdates(
+            source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE,
+            updates.occupied);
+          continue;
+        }
       }
+    });
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
-      if (next_obstacle_point_distance <= obstacle_separation_threshold_) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
-        raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE);
-        continue;
-      }
-    }
-  }
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::free_space);
+  if (pub_debug_grid_)
+    converter.addLayerFromCostmap2D(*this, "filled_free_to_farthest", debug_grid_);
+
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::no_information);
+  if (pub_debug_grid_) converter.addLayerFromCostmap2D(*this, "added_unknown", debug_grid_);
 
+  applyAngleBinCellUpdates(&AngleBinCellUpdates::occupied);
   if (pub_debug_grid_) converter.addLayerFromCostmap2D(*this, "added_obstacle", debug_grid_);
   if (pub_debug_grid_) {
     debug_grid_map_publisher_ptr_->publish(grid_map::GridMapRosConverter::toMessage(debug_grid_));
@@ -303,6 +309,8 @@ void OccupancyGridMapProjectiveBlindSpot::initRosParam(rclcpp::Node & node)
     node.declare_parameter<double>("OccupancyGridMapProjectiveBlindSpot.projection_dz_threshold");
   obstacle_separation_threshold_ = node.declare_parameter<double>(
     "OccupancyGridMapProjectiveBlindSpot.obstacle_separation_threshold");
+  setRaytraceThreadNum(
+    node.declare_parameter<int>("OccupancyGridMapProjectiveBlindSpot.raytrace_thread_num"));
   pub_debug_grid_ =
     node.declare_parameter<bool>("OccupancyGridMapProjectiveBlindSpot.pub_debug_grid");
   debug_grid_map_publisher_ptr_ = node.create_publisher<grid_map_msgs::msg::GridMap>(
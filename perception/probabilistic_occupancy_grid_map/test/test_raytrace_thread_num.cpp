@@ -0,0 +1,111 @@
+// Copyright 2024 TIER IV, INC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// autoware
+#include "probabilistic_occupancy_grid_map/pointcloud_based_occupancy_grid_map/occupancy_grid_map_fixed.hpp"
+#include "probabilistic_occupancy_grid_map/pointcloud_based_occupancy_grid_map/occupancy_grid_map_projective.hpp"
+
+#include <gtest/gtest.h>
+
+// pcl
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using costmap_2d::OccupancyGridMapFixedBlindSpot;
+using costmap_2d::OccupancyGridMapProjectiveBlindSpot;
+
+namespace
+{
+// obstacles around the vehicle and the ground points between them
+void createPointClouds(
+  sensor_msgs::msg::PointCloud2 & raw_pointcloud,
+  sensor_msgs::msg::PointCloud2 & obstacle_pointcloud)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> xy(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> z(0.0f, 2.0f);
+  pcl::PointCloud<pcl::PointXYZ> raw_cloud;
+  pcl::PointCloud<pcl::PointXYZ> obstacle_cloud;
+  for (int i = 0; i < 20000; ++i) {
+    const pcl::PointXYZ point(xy(engine), xy(engine), z(engine));
+    raw_cloud.push_back(point);
+    if (point.z > 0.5f) {
+      obstacle_cloud.push_back(point);
+    }
+  }
+  pcl::toROSMsg(raw_cloud, raw_pointcloud);
+  pcl::toROSMsg(obstacle_cloud, obstacle_pointcloud);
+}
+
+std::vector<unsigned char> createGridMap(
+  costmap_2d::OccupancyGridMapInterface & grid_map, const int raytrace_thread_num,
+  const std::string & grid_map_type)
+{
+  rclcpp::NodeOptions node_options;
+  node_options.parameter_overrides(
+    {rclcpp::Parameter(grid_map_type + ".distance_margin", 1.0),
+     rclcpp::Parameter(grid_map_type + ".projection_dz_threshold", 0.01),
+     rclcpp::Parameter(grid_map_type + ".obstacle_separation_threshold", 1.0),
+     rclcpp::Parameter(grid_map_type + ".pub_debug_grid", false),
+     rclcpp::Parameter(grid_map_type + ".raytrace_thread_num", raytrace_thread_num)});
+  auto node = std::make_shared<rclcpp::Node>(
+    "raytrace_thread_num_" + std::to_string(raytrace_thread_num), node_options);
+  grid_map.initRosParam(*node);
+
+  sensor_msgs::msg::PointCloud2 raw_pointcloud;
+  sensor_msgs::msg::PointCloud2 obstacle_pointcloud;
+  createPointClouds(raw_pointcloud, obstacle_pointcloud);
+  geometry_msgs::msg::Pose robot_pose;
+  robot_pose.orientation.w = 1.0;
+  geometry_msgs::msg::Pose scan_origin = robot_pose;
+  scan_origin.position.z = 2.0;
+
+  // several updates, so that the threads are reused
+  for (int i = 0; i < 3; ++i) {
+    grid_map.resetMaps();
+    grid_map.updateOrigin(-grid_map.getSizeInMetersX() / 2, -grid_map.getSizeInMetersY() / 2);
+    grid_map.updateWithPointCloud(raw_pointcloud, obstacle_pointcloud, robot_pose, scan_origin);
+  }
+  const unsigned char * char_map = grid_map.getCharMap();
+  return std::vector<unsigned char>(
+    char_map, char_map + grid_map.getSizeInCellsX() * grid_map.getSizeInCellsY());
+}
+
+template <class GridMap>
+void testRaytraceThreadNum(const std::string & grid_map_type)
+{
+  GridMap single_thread_grid_map(300, 300, 0.5);
+  const auto expected = createGridMap(single_thread_grid_map, 1, grid_map_type);
+  for (const int raytrace_thread_num : {2, 4, 7}) {
+    GridMap grid_map(300, 300, 0.5);
+    EXPECT_EQ(createGridMap(grid_map, raytrace_thread_num, grid_map_type), expected)
+      << grid_map_type << ", raytrace_thread_num = " << raytrace_thread_num;
+  }
+}
+}  // namespace
+
+// the grid map must not depend on the number of the raytrace threads
+TEST(TestRaytraceThreadNum, SameGridMapWithAnyThreadNum)
+{
+  rclcpp::init(0, nullptr);
+  testRaytraceThreadNum<OccupancyGridMapFixedBlindSpot>("OccupancyGridMapFixedBlindSpot");
+  testRaytraceThreadNum<OccupancyGridMapProjectiveBlindSpot>(
+    "OccupancyGridMapProjectiveBlindSpot");
+  rclcpp::shutdown();
+}
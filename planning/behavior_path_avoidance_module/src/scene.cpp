@@ -772,6 +772,12 @@ bool AvoidanceModule::isSafePath(
     ego_predicted_path_params, shifted_path.path.points, getEgoPose(), getEgoSpeed(), ego_seg_idx,
     false, limit_to_max_velocity);
 
+  // the ego footprints are interpolated once and shared by all the objects and their paths
+  utils::path_safety_checker::EgoPredictedFootprints ego_footprints_for_front_object(
+    ego_predicted_path_for_front_object, p.vehicle_info);
+  utils::path_safety_checker::EgoPredictedFootprints ego_footprints_for_rear_object(
+    ego_predicted_path_for_rear_object, p.vehicle_info);
+
   for (const auto & object : safety_check_target_objects) {
     auto current_debug_data = utils::path_safety_checker::createObjectDebug(object);
 
@@ -794,13 +800,13 @@ bool AvoidanceModule::isSafePath(
     const auto obj_predicted_paths = utils::path_safety_checker::getPredictedPathFromObj(
       object, parameters_->check_all_predicted_path);
 
-    const auto & ego_predicted_path = is_object_front && !is_object_oncoming
-                                        ? ego_predicted_path_for_front_object
-                                        : ego_predicted_path_for_rear_object;
+    auto & ego_footprints = is_object_front && !is_object_oncoming
+                              ? ego_footprints_for_front_object
+                              : ego_footprints_for_rear_object;
 
     for (const auto & obj_path : obj_predicted_paths) {
       if (!utils::path_safety_checker::checkCollision(
-            shifted_path.path, ego_predicted_path, object, obj_path, p, parameters_->rss_params,
+            shifted_path.path, ego_footprints, object, obj_path, p, parameters_->rss_params,
             hysteresis_factor, current_debug_data.second)) {
         utils::path_safety_checker::updateCollisionCheckDebugMap(
           debug.collision_check, current_debug_data, false);
@@ -0,0 +1,68 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_GOAL_PLANNER_MODULE__FOOTPRINT_DISTANCE_FIELD_HPP_
+#define BEHAVIOR_PATH_GOAL_PLANNER_MODULE__FOOTPRINT_DISTANCE_FIELD_HPP_
+
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace behavior_path_planner
+{
+using tier4_autoware_utils::Box2d;
+using tier4_autoware_utils::LinearRing2d;
+using tier4_autoware_utils::Polygon2d;
+
+/**
+ * @brief Grid over an area with the distance from each cell to the nearest cell touched by the
+ *        polygons. Sampling it over a footprint gives a lower bound of the distance between the
+ *        footprint and the polygons, so that the exact check is needed only for the footprints
+ *        close to them.
+ */
+class FootprintDistanceField
+{
+public:
+  FootprintDistanceField(const Box2d & area, const double resolution);
+
+  /**
+   * @brief Rasterize the polygons and calculate the distance of all the cells.
+   */
+  void setPolygons(const std::vector<Polygon2d> & polygons);
+
+  /**
+   * @brief Lower bound of the distance between the footprint and the polygons.
+   * @return nullopt if the footprint is out of the area.
+   */
+  std::optional<double> calcDistanceLowerBound(const LinearRing2d & footprint) const;
+
+  const Box2d & getArea() const { return area_; }
+  double getResolution() const { return resolution_; }
+
+private:
+  std::optional<size_t> getIndex(const double x, const double y) const;
+  void rasterizePolygon(const Polygon2d & polygon);
+
+  Box2d area_{};
+  double resolution_{1.0};
+  size_t width_{0};
+  size_t height_{0};
+  // distance from the cell center to the nearest touched cell center [m]
+  std::vector<double> distances_{};
+  bool has_polygon_out_of_area_{false};
+};
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_GOAL_PLANNER_MODULE__FOOTPRINT_DISTANCE_FIELD_HPP_
@@ -33,6 +33,7 @@
 #include <lane_departure_checker/lane_departure_checker.hpp>
 #include <motion_utils/distance/distance.hpp>
 #include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <autoware_auto_vehicle_msgs/msg/hazard_lights_command.hpp>
@@ -217,9 +218,17 @@ struct FreespacePlannerDebugData
   size_t num_goal_candidates{0};
 };
 
+struct LaneParkingPlannerDebugData
+{
+  size_t num_evaluated_candidates{0};  // pairs of goal candidate and planner evaluated last cycle
+  size_t num_candidates{0};
+  double processing_time_ms{0.0};
+};
+
 struct GoalPlannerDebugData
 {
   FreespacePlannerDebugData freespace_planner{};
+  LaneParkingPlannerDebugData lane_parking_planner{};
   std::vector<Polygon2d> ego_polygons_expanded{};
   lanelet::ConstLanelet expanded_pull_over_lane_between_ego{};
 };
@@ -412,6 +421,11 @@ private:
 
   // planner
   std::vector<std::shared_ptr<PullOverPlannerBase>> pull_over_planners_;
+  // the planners keep the state of the planning, so each additional worker thread of onTimer()
+  // uses its own instances
+  std::vector<std::vector<std::shared_ptr<PullOverPlannerBase>>> worker_pull_over_planners_;
+  // the worker i of the pool uses worker_pull_over_planners_[i - 1], and the worker 0 is onTimer()
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> pull_over_worker_pool_;
   std::unique_ptr<PullOverPlannerBase> freespace_planner_;
   std::unique_ptr<FixedGoalPlannerBase> fixed_goal_planner_;
 
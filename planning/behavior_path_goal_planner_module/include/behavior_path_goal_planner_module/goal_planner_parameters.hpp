@@ -60,6 +60,7 @@ struct GoalPlannerParameters
   double lateral_offset_interval{0.0};
   double ignore_distance_from_lane_start{0.0};
   double margin_from_boundary{0.0};
+  double distance_field_resolution{0.0};
 
   // occupancy grid map
   bool use_occupancy_grid_for_goal_search{false};
@@ -88,6 +89,8 @@ struct GoalPlannerParameters
   double maximum_jerk{0.0};
   std::string path_priority;  // "efficient_path" or "close_goal"
   std::vector<std::string> efficient_path_order{};
+  int candidate_path_thread_num{1};
+  double candidate_path_time_budget{0.0};
 
   // shift path
   bool enable_shift_parking{false};
@@ -15,10 +15,15 @@
 #ifndef BEHAVIOR_PATH_GOAL_PLANNER_MODULE__GOAL_SEARCHER_HPP_
 #define BEHAVIOR_PATH_GOAL_PLANNER_MODULE__GOAL_SEARCHER_HPP_
 
+#include "behavior_path_goal_planner_module/footprint_distance_field.hpp"
 #include "behavior_path_goal_planner_module/goal_searcher_base.hpp"
 #include "behavior_path_planner_common/utils/occupancy_grid_based_collision_detector/occupancy_grid_based_collision_detector.hpp"
 
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -26,6 +31,14 @@ namespace behavior_path_planner
 using tier4_autoware_utils::LinearRing2d;
 using BasicPolygons2d = std::vector<lanelet::BasicPolygon2d>;
 
+// distance field of the objects with the upper bound of their displacement from the polygons it
+// was built from, which is subtracted from the distance of the field
+struct ObjectDistanceField
+{
+  std::shared_ptr<const FootprintDistanceField> field{};
+  double displacement{0.0};
+};
+
 class GoalSearcher : public GoalSearcherBase
 {
 public:
@@ -47,16 +60,33 @@ private:
   void countObjectsToAvoid(
     GoalCandidates & goal_candidates, const PredictedObjects & objects) const;
   void createAreaPolygons(std::vector<Pose> original_search_poses);
-  bool checkCollision(const Pose & pose, const PredictedObjects & objects) const;
+  bool checkCollision(
+    const Pose & pose, const PredictedObjects & objects,
+    const ObjectDistanceField & object_distance_field) const;
+  bool checkObjectsCollision(
+    const Pose & pose, const PredictedObjects & objects, const double margin,
+    const ObjectDistanceField & object_distance_field) const;
+  ObjectDistanceField getObjectDistanceField(const PredictedObjects & objects) const;
   bool checkCollisionWithLongitudinalDistance(
     const Pose & ego_pose, const PredictedObjects & objects) const;
   BasicPolygons2d getNoParkingAreaPolygons(const lanelet::ConstLanelets & lanes) const;
   BasicPolygons2d getNoStoppingAreaPolygons(const lanelet::ConstLanelets & lanes) const;
   bool isInAreas(const LinearRing2d & footprint, const BasicPolygons2d & areas) const;
+  std::optional<Box2d> calcSearchArea(const lanelet::ConstLanelets & pull_over_lanes) const;
 
   LinearRing2d vehicle_footprint_{};
   std::shared_ptr<OccupancyGridBasedCollisionDetector> occupancy_grid_map_{};
   bool left_side_parking_{true};
+
+  // the distance field of the objects is shared by the checks of all the goal candidates. it is
+  // rebuilt only when the search area changes, or an object appears, disappears or moves farther
+  // than the resolution from the polygons it was built from. update() is also called from the
+  // freespace parking thread, so it is guarded by the mutex.
+  mutable std::mutex object_distance_field_mutex_;
+  std::optional<Box2d> search_area_{};
+  mutable std::shared_ptr<const FootprintDistanceField> object_distance_field_{};
+  // object id and polygon the field was built from
+  mutable std::vector<std::pair<std::string, Polygon2d>> object_polygons_{};
 };
 }  // namespace behavior_path_planner
 
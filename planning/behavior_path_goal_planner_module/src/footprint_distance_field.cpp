@@ -0,0 +1,216 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_goal_planner_module/footprint_distance_field.hpp"
+
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace behavior_path_planner
+{
+namespace
+{
+constexpr double squared_distance_inf = 1e20;
+
+// squared euclidean distance transform of one line (Felzenszwalb and Huttenlocher, 2012)
+void transformLine(std::vector<double> & f, std::vector<int> & v, std::vector<double> & z)
+{
+  const int n = static_cast<int>(f.size());
+  const auto intersection = [&](const int q, const int p) {
+    return ((f.at(q) + q * q) - (f.at(p) + p * p)) / (2.0 * q - 2.0 * p);
+  };
+
+  int k = 0;
+  v.at(0) = 0;
+  z.at(0) = -std::numeric_limits<double>::max();
+  z.at(1) = std::numeric_limits<double>::max();
+  for (int q = 1; q < n; ++q) {
+    double s = intersection(q, v.at(k));
+    while (s <= z.at(k)) {
+      --k;
+      s = intersection(q, v.at(k));
+    }
+    ++k;
+    v.at(k) = q;
+    z.at(k) = s;
+    z.at(k + 1) = std::numeric_limits<double>::max();
+  }
+
+  const auto f_copy = f;
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z.at(k + 1) < q) {
+      ++k;
+    }
+    f.at(q) = (q - v.at(k)) * (q - v.at(k)) + f_copy.at(v.at(k));
+  }
+}
+}  // namespace
+
+FootprintDistanceField::FootprintDistanceField(const Box2d & area, const double resolution)
+: area_{area}, resolution_{resolution}
+{
+  const double area_width = area_.max_corner().x() - area_.min_corner().x();
+  const double area_height = area_.max_corner().y() - area_.min_corner().y();
+  width_ = static_cast<size_t>(std::max(std::ceil(area_width / resolution_), 1.0));
+  height_ = static_cast<size_t>(std::max(std::ceil(area_height / resolution_), 1.0));
+  distances_.assign(width_ * height_, std::numeric_limits<double>::max());
+}
+
+std::optional<size_t> FootprintDistanceField::getIndex(const double x, const double y) const
+{
+  const double dx = (x - area_.min_corner().x()) / resolution_;
+  const double dy = (y - area_.min_corner().y()) / resolution_;
+  if (dx < 0.0 || dy < 0.0 || dx >= width_ || dy >= height_) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(dy) * width_ + static_cast<size_t>(dx);
+}
+
+void FootprintDistanceField::rasterizePolygon(const Polygon2d & polygon)
+{
+  if (polygon.outer().empty()) {
+    return;
+  }
+
+  const auto box = boost::geometry::return_envelope<Box2d>(polygon.outer());
+  const auto & min = area_.min_corner();
+  const auto & max = area_.max_corner();
+  if (
+    box.min_corner().x() < min.x() || box.min_corner().y() < min.y() ||
+    box.max_corner().x() > max.x() || box.max_corner().y() > max.y()) {
+    has_polygon_out_of_area_ = true;
+  }
+
+  // the cells whose center is within the half diagonal from the polygon contain its points
+  const double half_diagonal = resolution_ * M_SQRT1_2;
+  const auto toCellRange = [&](const double lower, const double upper, const double origin,
+                               const size_t size) {
+    const double begin = std::floor((lower - origin) / resolution_) - 1.0;
+    const double end = std::floor((upper - origin) / resolution_) + 1.0;
+    return std::make_pair(
+      static_cast<size_t>(std::clamp(begin, 0.0, static_cast<double>(size))),
+      static_cast<size_t>(std::clamp(end + 1.0, 0.0, static_cast<double>(size))));
+  };
+  const auto [x_begin, x_end] =
+    toCellRange(box.min_corner().x(), box.max_corner().x(), min.x(), width_);
+  const auto [y_begin, y_end] =
+    toCellRange(box.min_corner().y(), box.max_corner().y(), min.y(), height_);
+  for (size_t iy = y_begin; iy < y_end; ++iy) {
+    for (size_t ix = x_begin; ix < x_end; ++ix) {
+      const tier4_autoware_utils::Point2d center{
+        min.x() + (ix + 0.5) * resolution_, min.y() + (iy + 0.5) * resolution_};
+      if (boost::geometry::distance(center, polygon) <= half_diagonal) {
+        distances_.at(iy * width_ + ix) = 0.0;
+      }
+    }
+  }
+}
+
+void FootprintDistanceField::setPolygons(const std::vector<Polygon2d> & polygons)
+{
+  has_polygon_out_of_area_ = false;
+  distances_.assign(width_ * height_, squared_distance_inf);
+  for (const auto & polygon : polygons) {
+    rasterizePolygon(polygon);
+  }
+
+  // squared distance in cells along the rows and then along the columns
+  const size_t max_size = std::max(width_, height_);
+  std::vector<double> f(max_size);
+  std::vector<int> v(max_size);
+  std::vector<double> z(max_size + 1);
+  f.resize(width_);
+  for (size_t iy = 0; iy < height_; ++iy) {
+    std::copy_n(distances_.begin() + iy * width_, width_, f.begin());
+    transformLine(f, v, z);
+    std::copy(f.begin(), f.end(), distances_.begin() + iy * width_);
+  }
+  f.resize(height_);
+  for (size_t ix = 0; ix < width_; ++ix) {
+    for (size_t iy = 0; iy < height_; ++iy) {
+      f.at(iy) = distances_.at(iy * width_ + ix);
+    }
+    transformLine(f, v, z);
+    for (size_t iy = 0; iy < height_; ++iy) {
+      distances_.at(iy * width_ + ix) = std::sqrt(f.at(iy)) * resolution_;
+    }
+  }
+}
+
+std::optional<double> FootprintDistanceField::calcDistanceLowerBound(
+  const LinearRing2d & footprint) const
+{
+  if (footprint.size() < 2) {
+    return std::nullopt;
+  }
+
+  // sample the bounding box of the footprint aligned with its first edge
+  const auto & origin = footprint.front();
+  const double edge_length =
+    std::hypot(footprint.at(1).x() - origin.x(), footprint.at(1).y() - origin.y());
+  const double ux = edge_length > 1e-6 ? (footprint.at(1).x() - origin.x()) / edge_length : 1.0;
+  const double uy = edge_length > 1e-6 ? (footprint.at(1).y() - origin.y()) / edge_length : 0.0;
+  double u_min = std::numeric_limits<double>::max();
+  double u_max = std::numeric_limits<double>::lowest();
+  double v_min = std::numeric_limits<double>::max();
+  double v_max = std::numeric_limits<double>::lowest();
+  for (const auto & p : footprint) {
+    const double u = ux * (p.x() - origin.x()) + uy * (p.y() - origin.y());
+    const double v = -uy * (p.x() - origin.x()) + ux * (p.y() - origin.y());
+    u_min = std::min(u_min, u);
+    u_max = std::max(u_max, u);
+    v_min = std::min(v_min, v);
+    v_max = std::max(v_max, v);
+  }
+  const int u_num = static_cast<int>(std::max(std::ceil((u_max - u_min) / resolution_), 1.0));
+  const int v_num = static_cast<int>(std::max(std::ceil((v_max - v_min) / resolution_), 1.0));
+  const double u_step = (u_max - u_min) / u_num;
+  const double v_step = (v_max - v_min) / v_num;
+
+  const auto & min = area_.min_corner();
+  const auto & max = area_.max_corner();
+  double min_distance = std::numeric_limits<double>::max();
+  for (int i = 0; i <= u_num; ++i) {
+    for (int j = 0; j <= v_num; ++j) {
+      const double u = u_min + i * u_step;
+      const double v = v_min + j * v_step;
+      const double x = origin.x() + ux * u - uy * v;
+      const double y = origin.y() + uy * u + ux * v;
+      const auto index = getIndex(x, y);
+      if (!index) {
+        return std::nullopt;
+      }
+      min_distance = std::min(min_distance, distances_.at(*index));
+      if (has_polygon_out_of_area_) {
+        // the points of the polygons out of the area are at least as far as the boundary
+        const double cx = min.x() + (*index % width_ + 0.5) * resolution_;
+        const double cy = min.y() + (*index / width_ + 0.5) * resolution_;
+        min_distance = std::min(
+          {min_distance, cx - min.x(), max.x() - cx, cy - min.y(), max.y() - cy});
+      }
+    }
+  }
+
+  // every point of the footprint is within the half diagonal of the sampling from a sample, which
+  // is within the half diagonal of a cell from its cell center, and so are the polygon points
+  const double sampling_error = 0.5 * std::hypot(u_step, v_step) + resolution_ * M_SQRT2;
+  return min_distance - sampling_error;
+}
+}  // namespace behavior_path_planner
@@ -32,10 +32,16 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -76,17 +82,32 @@ GoalPlannerModule::GoalPlannerModule(
   // planner when goal modification is not allowed
   fixed_goal_planner_ = std::make_unique<DefaultFixedGoalPlanner>();
 
-  for (const std::string & planner_type : parameters_->efficient_path_order) {
-    if (planner_type == "SHIFT" && parameters_->enable_shift_parking) {
-      pull_over_planners_.push_back(std::make_shared<ShiftPullOver>(
-        node, *parameters, lane_departure_checker, occupancy_grid_map_));
-    } else if (planner_type == "ARC_FORWARD" && parameters_->enable_arc_forward_parking) {
-      pull_over_planners_.push_back(std::make_shared<GeometricPullOver>(
-        node, *parameters, lane_departure_checker, occupancy_grid_map_, /*is_forward*/ true));
-    } else if (planner_type == "ARC_BACKWARD" && parameters_->enable_arc_backward_parking) {
-      pull_over_planners_.push_back(std::make_shared<GeometricPullOver>(
-        node, *parameters, lane_departure_checker, occupancy_grid_map_, /*is_forward*/ false));
+  const auto createPullOverPlanners = [&]() {
+    std::vector<std::shared_ptr<PullOverPlannerBase>> planners{};
+    for (const std::string & planner_type : parameters_->efficient_path_order) {
+      if (planner_type == "SHIFT" && parameters_->enable_shift_parking) {
+        planners.push_back(std::make_shared<ShiftPullOver>(
+          node, *parameters, lane_departure_checker, occupancy_grid_map_));
+      } else if (planner_type == "ARC_FORWARD" && parameters_->enable_arc_forward_parking) {
+        planners.push_back(std::make_shared<GeometricPullOver>(
+          node, *parameters, lane_departure_checker, occupancy_grid_map_, /*is_forward*/ true));
+      } else if (planner_type == "ARC_BACKWARD" && parameters_->enable_arc_backward_parking) {
+        planners.push_back(std::make_shared<GeometricPullOver>(
+          node, *parameters, lane_departure_checker, occupancy_grid_map_, /*is_forward*/ false));
+      }
     }
+    return planners;
+  };
+  pull_over_planners_ = createPullOverPlanners();
+  // the threads are kept between the cycles, and bounded by the number of the cores
+  const auto thread_num = std::min(
+    static_cast<size_t>(std::max(parameters_->candidate_path_thread_num, 1)),
+    static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)));
+  for (size_t i = 1; i < thread_num; ++i) {
+    worker_pull_over_planners_.push_back(createPullOverPlanners());
+  }
+  if (thread_num > 1) {
+    pull_over_worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(thread_num);
   }
 
   if (pull_over_planners_.empty()) {
@@ -211,6 +232,7 @@ void GoalPlannerModule::onTimer()
     return;
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
   const auto previous_module_output = getPreviousModuleOutput();
   const auto goal_candidates = thread_safe_data_.get_goal_candidates();
 
@@ -219,29 +241,6 @@ void GoalPlannerModule::onTimer()
     planner_data_, parameters_->backward_goal_search_length,
     parameters_->forward_goal_search_length,
     /*forward_only_in_route*/ false);
-  std::vector<PullOverPath> path_candidates{};
-  std::optional<Pose> closest_start_pose{};
-  double min_start_arc_length = std::numeric_limits<double>::max();
-  const auto planCandidatePaths = [&](
-                                    const std::shared_ptr<PullOverPlannerBase> & planner,
-                                    const GoalCandidate & goal_candidate) {
-    planner->setPlannerData(planner_data_);
-    planner->setPreviousModuleOutput(previous_module_output);
-    auto pull_over_path = planner->plan(goal_candidate.goal_pose);
-    if (pull_over_path) {
-      pull_over_path->goal_id = goal_candidate.id;
-      pull_over_path->id = path_candidates.size();
-      path_candidates.push_back(*pull_over_path);
-      // calculate closest pull over start pose for stop path
-      const double start_arc_length =
-        lanelet::utils::getArcCoordinates(current_lanes, pull_over_path->start_pose).length;
-      if (start_arc_length < min_start_arc_length) {
-        min_start_arc_length = start_arc_length;
-        // closest start pose is stop point when not finding safe path
-        closest_start_pose = pull_over_path->start_pose;
-      }
-    }
-  };
 
   // todo: currently non centerline input path is supported only by shift pull over
   const bool is_center_line_input_path = goal_planner_utils::isReferencePath(
@@ -250,25 +249,28 @@ void GoalPlannerModule::onTimer()
     getLogger(), "the input path of pull over planner is center line: %d",
     is_center_line_input_path);
 
-  // plan candidate paths and set them to the member variable
+  // pairs of the planner index and the goal candidate in the priority order
+  std::vector<std::pair<size_t, const GoalCandidate *>> tasks{};
+  const auto isPlannerSkipped = [&](const std::shared_ptr<PullOverPlannerBase> & planner) {
+    // todo: temporary skip NON SHIFT planner when input path is not center line
+    return !is_center_line_input_path && planner->getPlannerType() != PullOverPlannerType::SHIFT;
+  };
   if (parameters_->path_priority == "efficient_path") {
-    for (const auto & planner : pull_over_planners_) {
-      // todo: temporary skip NON SHIFT planner when input path is not center line
-      if (!is_center_line_input_path && planner->getPlannerType() != PullOverPlannerType::SHIFT) {
+    for (size_t i = 0; i < pull_over_planners_.size(); ++i) {
+      if (isPlannerSkipped(pull_over_planners_.at(i))) {
         continue;
       }
       for (const auto & goal_candidate : goal_candidates) {
-        planCandidatePaths(planner, goal_candidate);
+        tasks.emplace_back(i, &goal_candidate);
       }
     }
   } else if (parameters_->path_priority == "close_goal") {
     for (const auto & goal_candidate : goal_candidates) {
-      for (const auto & planner : pull_over_planners_) {
-        // todo: temporary skip NON SHIFT planner when input path is not center line
-        if (!is_center_line_input_path && planner->getPlannerType() != PullOverPlannerType::SHIFT) {
+      for (size_t i = 0; i < pull_over_planners_.size(); ++i) {
+        if (isPlannerSkipped(pull_over_planners_.at(i))) {
           continue;
         }
-        planCandidatePaths(planner, goal_candidate);
+        tasks.emplace_back(i, &goal_candidate);
       }
     }
   } else {
@@ -278,12 +280,104 @@ void GoalPlannerModule::onTimer()
     throw std::domain_error("[pull_over] invalid path_priority");
   }
 
+  // the candidates are merged in the priority order as the tasks before them finish. when there
+  // are no candidates yet, the merged ones are set to the member variables at once so that the
+  // first feasible path is available early. otherwise the previous candidates are kept until all
+  // the tasks finish.
+  const bool stream_candidates = thread_safe_data_.get_pull_over_path_candidates().empty();
+  std::vector<std::optional<PullOverPath>> results(tasks.size());
+  std::vector<std::exception_ptr> exceptions(tasks.size());
+  std::vector<bool> is_finished(tasks.size(), false);
+  size_t num_merged = 0;
+  std::mutex merge_mutex;
+  std::vector<PullOverPath> path_candidates{};
+  std::optional<Pose> closest_start_pose{};
+  double min_start_arc_length = std::numeric_limits<double>::max();
+  const auto mergeFinishedTasks = [&](const size_t task_idx) {
+    const std::lock_guard<std::mutex> merge_lock(merge_mutex);
+    is_finished.at(task_idx) = true;
+    const size_t num_candidates = path_candidates.size();
+    for (; num_merged < tasks.size() && is_finished.at(num_merged); ++num_merged) {
+      auto & pull_over_path = results.at(num_merged);
+      if (!pull_over_path) {
+        continue;
+      }
+      pull_over_path->goal_id = tasks.at(num_merged).second->id;
+      pull_over_path->id = path_candidates.size();
+      path_candidates.push_back(*pull_over_path);
+      // calculate closest pull over start pose for stop path
+      const double start_arc_length =
+        lanelet::utils::getArcCoordinates(current_lanes, pull_over_path->start_pose).length;
+      if (start_arc_length < min_start_arc_length) {
+        min_start_arc_length = start_arc_length;
+        // closest start pose is stop point when not finding safe path
+        closest_start_pose = pull_over_path->start_pose;
+      }
+    }
+    if (stream_candidates && num_candidates < path_candidates.size()) {
+      const std::lock_guard<std::recursive_mutex> lock(mutex_);
+      thread_safe_data_.set_pull_over_path_candidates(path_candidates);
+      thread_safe_data_.set_closest_start_pose(closest_start_pose);
+    }
+  };
+
+  // the workers take the tasks in the priority order until the time budget runs out, so the
+  // evaluated tasks are always the ones with the highest priority.
+  const double time_budget = parameters_->candidate_path_time_budget;
+  std::atomic<size_t> next_task_idx{0};
+  std::atomic<bool> has_exception{false};
+  const auto worker = [&](const size_t worker_index) {
+    const auto & planners =
+      worker_index == 0 ? pull_over_planners_ : worker_pull_over_planners_.at(worker_index - 1);
+    while (!has_exception) {
+      const double elapsed_time =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+      if (time_budget > 0.0 && elapsed_time > time_budget) {
+        return;
+      }
+      const size_t task_idx = next_task_idx++;
+      if (task_idx >= tasks.size()) {
+        return;
+      }
+      const auto & [planner_idx, goal_candidate] = tasks.at(task_idx);
+      try {
+        const auto & planner = planners.at(planner_idx);
+        planner->setPlannerData(planner_data_);
+        planner->setPreviousModuleOutput(previous_module_output);
+        results.at(task_idx) = planner->plan(goal_candidate->goal_pose);
+      } catch (...) {
+        exceptions.at(task_idx) = std::current_exception();
+        has_exception = true;
+      }
+      mergeFinishedTasks(task_idx);
+    }
+  };
+
+  if (pull_over_worker_pool_ && tasks.size() > 1) {
+    pull_over_worker_pool_->run(worker);
+  } else {
+    worker(0);
+  }
+  for (const auto & exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
   // set member variables
   {
     const std::lock_guard<std::recursive_mutex> lock(mutex_);
     thread_safe_data_.set_pull_over_path_candidates(path_candidates);
     thread_safe_data_.set_closest_start_pose(closest_start_pose);
-    RCLCPP_INFO(getLogger(), "generated %lu pull over path candidates", path_candidates.size());
+    debug_data_.lane_parking_planner.num_evaluated_candidates = num_merged;
+    debug_data_.lane_parking_planner.num_candidates = tasks.size();
+    debug_data_.lane_parking_planner.processing_time_ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+        .count();
+    RCLCPP_INFO(
+      getLogger(), "generated %lu pull over path candidates (evaluated %lu/%lu in %.1f ms)",
+      path_candidates.size(), num_merged, tasks.size(),
+      debug_data_.lane_parking_planner.processing_time_ms);
   }
 
   last_previous_module_output_ = previous_module_output;
@@ -2297,6 +2391,12 @@ void GoalPlannerModule::setDebugData()
         std::to_string(debug_data_.freespace_planner.num_goal_candidates);
     }
 
+    if (debug_data_.lane_parking_planner.num_candidates > 0) {
+      marker.text +=
+        " lane: " + std::to_string(debug_data_.lane_parking_planner.num_evaluated_candidates) +
+        "/" + std::to_string(debug_data_.lane_parking_planner.num_candidates);
+    }
+
     planner_type_marker_array.markers.push_back(marker);
     add(planner_type_marker_array);
   }
@@ -22,12 +22,23 @@
 #include "lanelet2_extension/regulatory_elements/no_stopping_area.hpp"
 #include "lanelet2_extension/utility/utilities.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
+#include "tier4_autoware_utils/ros/uuid_helper.hpp"
 
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/is_convex.hpp>
 #include <boost/geometry/algorithms/union.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -130,6 +141,33 @@ GoalCandidates GoalSearcher::search()
     route_handler->getCenterLinePath(pull_over_lanes, s_start, s_end),
     parameters_.goal_search_interval);
 
+  const auto no_parking_area_polygons = getNoParkingAreaPolygons(pull_over_lanes);
+  const auto no_stopping_area_polygons = getNoStoppingAreaPolygons(pull_over_lanes);
+
+  // rasterize the restricted areas once, so that only the footprints close to them are checked
+  // with the polygons
+  const auto search_area = calcSearchArea(pull_over_lanes);
+  {
+    const std::lock_guard<std::mutex> lock(object_distance_field_mutex_);
+    search_area_ = search_area;
+  }
+  std::optional<FootprintDistanceField> area_distance_field{};
+  if (search_area && (!no_parking_area_polygons.empty() || !no_stopping_area_polygons.empty())) {
+    std::vector<Polygon2d> restricted_areas{};
+    for (const auto * areas : {&no_parking_area_polygons, &no_stopping_area_polygons}) {
+      for (const auto & area : *areas) {
+        Polygon2d polygon{};
+        for (const auto & p : area) {
+          polygon.outer().emplace_back(p.x(), p.y());
+        }
+        boost::geometry::correct(polygon);
+        restricted_areas.push_back(polygon);
+      }
+    }
+    area_distance_field.emplace(*search_area, parameters_.distance_field_resolution);
+    area_distance_field->setPolygons(restricted_areas);
+  }
+
   std::vector<Pose> original_search_poses{};  // for search area visualizing
   size_t goal_id = 0;
   for (const auto & p : center_line_path.points) {
@@ -169,12 +207,19 @@ GoalCandidates GoalSearcher::search()
       const auto transformed_vehicle_footprint =
         transformVector(vehicle_footprint_, tier4_autoware_utils::pose2transform(search_pose));
 
-      if (isInAreas(transformed_vehicle_footprint, getNoParkingAreaPolygons(pull_over_lanes))) {
+      const auto distance_to_areas =
+        area_distance_field
+          ? area_distance_field->calcDistanceLowerBound(transformed_vehicle_footprint)
+          : std::nullopt;
+      const bool is_apart_from_areas = distance_to_areas && *distance_to_areas > 0.0;
+      const auto & footprint = transformed_vehicle_footprint;
+
+      if (!is_apart_from_areas && isInAreas(footprint, no_parking_area_polygons)) {
         // break here to exclude goals located laterally in no_parking_areas
         break;
       }
 
-      if (isInAreas(transformed_vehicle_footprint, getNoStoppingAreaPolygons(pull_over_lanes))) {
+      if (!is_apart_from_areas && isInAreas(footprint, no_stopping_area_polygons)) {
         // break here to exclude goals located laterally in no_stopping_areas
         break;
       }
@@ -240,23 +285,34 @@ void GoalSearcher::countObjectsToAvoid(
     goal_candidate.num_objects_to_avoid = 0;
   }
 
+  // the footprints along the center line and the arc lengths of the goals are shared by objects
+  std::vector<LinearRing2d> center_line_footprints{};
+  center_line_footprints.reserve(current_center_line_path.points.size());
+  for (const auto & p : current_center_line_path.points) {
+    center_line_footprints.push_back(
+      transformVector(vehicle_footprint_, tier4_autoware_utils::pose2transform(p.point.pose)));
+  }
+  std::vector<double> goal_arc_lengths{};
+
   // count number of objects to avoid
   for (const auto & object : objects.objects) {
-    for (const auto & p : current_center_line_path.points) {
-      const auto transformed_vehicle_footprint =
-        transformVector(vehicle_footprint_, tier4_autoware_utils::pose2transform(p.point.pose));
-      const auto obj_polygon = tier4_autoware_utils::toPolygon2d(object);
+    const auto obj_polygon = tier4_autoware_utils::toPolygon2d(object);
+    for (const auto & transformed_vehicle_footprint : center_line_footprints) {
       const double distance = boost::geometry::distance(obj_polygon, transformed_vehicle_footprint);
       if (distance > parameters_.object_recognition_collision_check_hard_margins.back()) {
         continue;
       }
+      if (goal_arc_lengths.empty()) {
+        for (const auto & goal_candidate : goal_candidates) {
+          goal_arc_lengths.push_back(
+            lanelet::utils::getArcCoordinates(current_lanes, goal_candidate.goal_pose).length);
+        }
+      }
       const Pose & object_pose = object.kinematics.initial_pose_with_covariance.pose;
       const double s_object = lanelet::utils::getArcCoordinates(current_lanes, object_pose).length;
-      for (auto & goal_candidate : goal_candidates) {
-        const Pose & goal_pose = goal_candidate.goal_pose;
-        const double s_goal = lanelet::utils::getArcCoordinates(current_lanes, goal_pose).length;
-        if (s_object < s_goal) {
-          goal_candidate.num_objects_to_avoid++;
+      for (size_t i = 0; i < goal_candidates.size(); ++i) {
+        if (s_object < goal_arc_lengths.at(i)) {
+          goal_candidates.at(i).num_objects_to_avoid++;
         }
       }
       break;
@@ -289,11 +345,12 @@ void GoalSearcher::update(GoalCandidates & goal_candidates) const
   }
 
   // update is_safe
+  const auto object_distance_field = getObjectDistanceField(pull_over_lane_stop_objects);
   for (auto & goal_candidate : goal_candidates) {
     const Pose goal_pose = goal_candidate.goal_pose;
 
     // check collision with footprint
-    if (checkCollision(goal_pose, pull_over_lane_stop_objects)) {
+    if (checkCollision(goal_pose, pull_over_lane_stop_objects, object_distance_field)) {
       goal_candidate.is_safe = false;
       continue;
     }
@@ -333,8 +390,9 @@ bool GoalSearcher::isSafeGoalWithMarginScaleFactor(
   const double margin =
     parameters_.object_recognition_collision_check_hard_margins.back() * margin_scale_factor;
 
-  if (utils::checkCollisionBetweenFootprintAndObjects(
-        vehicle_footprint_, goal_pose, pull_over_lane_stop_objects, margin)) {
+  if (checkObjectsCollision(
+        goal_pose, pull_over_lane_stop_objects, margin,
+        getObjectDistanceField(pull_over_lane_stop_objects))) {
     return false;
   }
 
@@ -350,7 +408,9 @@ bool GoalSearcher::isSafeGoalWithMarginScaleFactor(
   return true;
 }
 
-bool GoalSearcher::checkCollision(const Pose & pose, const PredictedObjects & objects) const
+bool GoalSearcher::checkCollision(
+  const Pose & pose, const PredictedObjects & objects,
+  const ObjectDistanceField & object_distance_field) const
 {
   if (parameters_.use_occupancy_grid_for_goal_search) {
     const Pose pose_grid_coords = global2local(occupancy_grid_map_->getMap(), pose);
@@ -363,15 +423,116 @@ bool GoalSearcher::checkCollision(const Pose & pose, const PredictedObjects & ob
   }
 
   if (parameters_.use_object_recognition) {
-    if (utils::checkCollisionBetweenFootprintAndObjects(
-          vehicle_footprint_, pose, objects,
-          parameters_.object_recognition_collision_check_hard_margins.back())) {
+    if (checkObjectsCollision(
+          pose, objects, parameters_.object_recognition_collision_check_hard_margins.back(),
+          object_distance_field)) {
       return true;
     }
   }
   return false;
 }
 
+bool GoalSearcher::checkObjectsCollision(
+  const Pose & pose, const PredictedObjects & objects, const double margin,
+  const ObjectDistanceField & object_distance_field) const
+{
+  // skip the exact check when the objects are surely farther than the margin
+  if (object_distance_field.field) {
+    const auto transformed_vehicle_footprint =
+      transformVector(vehicle_footprint_, tier4_autoware_utils::pose2transform(pose));
+    const auto distance =
+      object_distance_field.field->calcDistanceLowerBound(transformed_vehicle_footprint);
+    if (distance && *distance - object_distance_field.displacement >= margin) {
+      return false;
+    }
+  }
+
+  return utils::checkCollisionBetweenFootprintAndObjects(vehicle_footprint_, pose, objects, margin);
+}
+
+namespace
+{
+// upper bound of the distance the objects moved from the polygons of the same ids. a point of a
+// current polygon is at most this far from the previous one, so the distance to the objects
+// decreases at most by this value. it is the maximum over the vertices only when the previous
+// polygon is convex. returns nullopt when the objects are not the same set.
+std::optional<double> calcObjectsDisplacement(
+  const std::vector<std::pair<std::string, Polygon2d>> & prev_object_polygons,
+  const std::vector<std::pair<std::string, Polygon2d>> & object_polygons)
+{
+  if (prev_object_polygons.size() != object_polygons.size()) {
+    return std::nullopt;
+  }
+
+  std::unordered_map<std::string, const Polygon2d *> prev_polygons{};
+  for (const auto & [id, polygon] : prev_object_polygons) {
+    prev_polygons.emplace(id, &polygon);
+  }
+
+  double displacement = 0.0;
+  for (const auto & [id, polygon] : object_polygons) {
+    const auto prev_polygon = prev_polygons.find(id);
+    if (
+      prev_polygon == prev_polygons.end() ||
+      !boost::geometry::is_convex(prev_polygon->second->outer())) {
+      return std::nullopt;
+    }
+    for (const auto & point : polygon.outer()) {
+      displacement =
+        std::max(displacement, boost::geometry::distance(point, *prev_polygon->second));
+    }
+  }
+  return displacement;
+}
+}  // namespace
+
+ObjectDistanceField GoalSearcher::getObjectDistanceField(const PredictedObjects & objects) const
+{
+  if (!parameters_.use_object_recognition) {
+    return {};
+  }
+
+  std::vector<std::pair<std::string, Polygon2d>> object_polygons{};
+  object_polygons.reserve(objects.objects.size());
+  for (const auto & object : objects.objects) {
+    object_polygons.emplace_back(
+      tier4_autoware_utils::toHexString(object.object_id),
+      tier4_autoware_utils::toPolygon2d(object));
+  }
+
+  const std::lock_guard<std::mutex> lock(object_distance_field_mutex_);
+  if (!search_area_) {
+    return {};
+  }
+
+  // reuse the field while the objects only jitter or move slowly (e.g. parked vehicles)
+  const auto isSamePoint = [](const auto & a, const auto & b) {
+    return a.x() == b.x() && a.y() == b.y();
+  };
+  if (
+    object_distance_field_ &&
+    isSamePoint(object_distance_field_->getArea().min_corner(), search_area_->min_corner()) &&
+    isSamePoint(object_distance_field_->getArea().max_corner(), search_area_->max_corner()) &&
+    object_distance_field_->getResolution() == parameters_.distance_field_resolution) {
+    const auto displacement = calcObjectsDisplacement(object_polygons_, object_polygons);
+    if (displacement && *displacement <= parameters_.distance_field_resolution) {
+      return {object_distance_field_, *displacement};
+    }
+  }
+
+  std::vector<Polygon2d> polygons{};
+  polygons.reserve(object_polygons.size());
+  for (const auto & object_polygon : object_polygons) {
+    polygons.push_back(object_polygon.second);
+  }
+  auto object_distance_field =
+    std::make_shared<FootprintDistanceField>(*search_area_, parameters_.distance_field_resolution);
+  object_distance_field->setPolygons(polygons);
+  object_distance_field_ = object_distance_field;
+  object_polygons_ = std::move(object_polygons);
+  return {object_distance_field_, 0.0};
+}
+
 bool GoalSearcher::checkCollisionWithLongitudinalDistance(
   const Pose & ego_pose, const PredictedObjects & objects) const
 {
@@ -505,6 +666,35 @@ bool GoalSearcher::isInAreas(const LinearRing2d & footprint, const BasicPolygons
   return false;
 }
 
+std::optional<Box2d> GoalSearcher::calcSearchArea(
+  const lanelet::ConstLanelets & pull_over_lanes) const
+{
+  if (parameters_.distance_field_resolution <= 0.0 || pull_over_lanes.empty()) {
+    return std::nullopt;
+  }
+
+  // the goals are on the pull over lanes and their footprints stick out at most by the vehicle
+  // length. the polygons out of the area are also handled by the field.
+  const double offset =
+    planner_data_->parameters.base_link2front + planner_data_->parameters.base_link2rear;
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  for (const auto & lane : pull_over_lanes) {
+    for (const auto & p : lane.polygon2d().basicPolygon()) {
+      min_x = std::min(min_x, p.x());
+      min_y = std::min(min_y, p.y());
+      max_x = std::max(max_x, p.x());
+      max_y = std::max(max_y, p.y());
+    }
+  }
+  if (min_x > max_x || min_y > max_y) {
+    return std::nullopt;
+  }
+  return Box2d{{min_x - offset, min_y - offset}, {max_x + offset, max_y + offset}};
+}
+
 GoalCandidate GoalSearcher::getClosetGoalCandidateAlongLanes(
   const GoalCandidates & goal_candidates) const
 {
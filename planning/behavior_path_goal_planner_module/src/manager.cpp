@@ -61,6 +61,8 @@ void GoalPlannerModuleManager::init(rclcpp::Node * node)
     p.ignore_distance_from_lane_start =
       node->declare_parameter<double>(ns + "ignore_distance_from_lane_start");
     p.margin_from_boundary = node->declare_parameter<double>(ns + "margin_from_boundary");
+    p.distance_field_resolution =
+      node->declare_parameter<double>(ns + "distance_field_resolution");
 
     const std::string parking_policy_name =
       node->declare_parameter<std::string>(ns + "parking_policy");
@@ -136,6 +138,9 @@ void GoalPlannerModuleManager::init(rclcpp::Node * node)
     p.path_priority = node->declare_parameter<std::string>(ns + "path_priority");
     p.efficient_path_order =
       node->declare_parameter<std::vector<std::string>>(ns + "efficient_path_order");
+    p.candidate_path_thread_num = node->declare_parameter<int>(ns + "candidate_path_thread_num");
+    p.candidate_path_time_budget =
+      node->declare_parameter<double>(ns + "candidate_path_time_budget");
   }
 
   // shift parking
@@ -245,6 +250,8 @@ void GoalPlannerModuleManager::init(rclcpp::Node * node)
     p.astar_parameters.use_back = node->declare_parameter<bool>(ns + "use_back");
     p.astar_parameters.distance_heuristic_weight =
       node->declare_parameter<double>(ns + "distance_heuristic_weight");
+    p.astar_parameters.use_obstacle_heuristic =
+      node->declare_parameter<bool>(ns + "use_obstacle_heuristic");
   }
 
   //   freespace parking rrtstar
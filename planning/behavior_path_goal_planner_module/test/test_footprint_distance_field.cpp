@@ -0,0 +1,102 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_goal_planner_module/footprint_distance_field.hpp"
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using behavior_path_planner::Box2d;
+using behavior_path_planner::FootprintDistanceField;
+using behavior_path_planner::LinearRing2d;
+using behavior_path_planner::Polygon2d;
+using tier4_autoware_utils::Point2d;
+
+namespace
+{
+LinearRing2d createRectangle(
+  const double x, const double y, const double yaw, const double length, const double width)
+{
+  LinearRing2d ring{};
+  for (const auto & [l, w] : std::vector<std::pair<double, double>>{
+         {0.5, 0.5}, {0.5, -0.5}, {-0.5, -0.5}, {-0.5, 0.5}, {0.5, 0.5}}) {
+    const double lx = l * length;
+    const double ly = w * width;
+    ring.emplace_back(
+      x + lx * std::cos(yaw) - ly * std::sin(yaw), y + lx * std::sin(yaw) + ly * std::cos(yaw));
+  }
+  boost::geometry::correct(ring);
+  return ring;
+}
+
+Polygon2d toPolygon(const LinearRing2d & ring)
+{
+  Polygon2d polygon{};
+  polygon.outer() = ring;
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+}  // namespace
+
+TEST(FootprintDistanceField, LowerBoundNeverExceedsExactDistance)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(0.0, 50.0);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+
+  for (const double resolution : {0.25, 0.5, 1.0}) {
+    FootprintDistanceField field(Box2d(Point2d(-5.0, -5.0), Point2d(55.0, 55.0)), resolution);
+
+    std::vector<Polygon2d> polygons{};
+    for (int i = 0; i < 10; ++i) {
+      polygons.push_back(toPolygon(createRectangle(
+        position(engine), position(engine), yaw(engine), size(engine), size(engine))));
+    }
+    field.setPolygons(polygons);
+
+    for (int i = 0; i < 1000; ++i) {
+      const auto footprint =
+        createRectangle(position(engine), position(engine), yaw(engine), 4.5, 1.8);
+      const auto distance = field.calcDistanceLowerBound(footprint);
+      ASSERT_TRUE(distance);
+
+      double exact_distance = std::numeric_limits<double>::max();
+      for (const auto & polygon : polygons) {
+        exact_distance =
+          std::min(exact_distance, boost::geometry::distance(toPolygon(footprint), polygon));
+      }
+      EXPECT_LE(*distance, exact_distance + 1e-9);
+    }
+  }
+}
+
+TEST(FootprintDistanceField, FootprintOutOfArea)
+{
+  FootprintDistanceField field(Box2d(Point2d(0.0, 0.0), Point2d(10.0, 10.0)), 0.5);
+  field.setPolygons({toPolygon(createRectangle(5.0, 5.0, 0.0, 1.0, 1.0))});
+
+  EXPECT_FALSE(field.calcDistanceLowerBound(createRectangle(20.0, 20.0, 0.0, 4.5, 1.8)));
+  EXPECT_TRUE(field.calcDistanceLowerBound(createRectangle(2.0, 2.0, 0.0, 2.0, 1.0)));
+}
@@ -17,7 +17,14 @@
 #include "behavior_path_lane_change_module/utils/base_class.hpp"
 #include "behavior_path_lane_change_module/utils/data_structs.hpp"
 
+#include <tier4_autoware_utils/system/worker_pool.hpp>
+
+#include <exception>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -141,12 +148,45 @@ protected:
   bool hasEnoughLengthToTrafficLight(
     const LaneChangePath & path, const lanelet::ConstLanelets & current_lanes) const;
 
+  //! @brief Sampled parameters of a candidate path, whose path is built and checked by
+  //! evaluateLaneChangeSamples. The prepare segment is shared by the samples of the same prepare
+  //! length, and its velocity is limited with the limits of the sample when the path is built.
+  struct LaneChangeSample
+  {
+    LaneChangeInfo info;
+    std::shared_ptr<const PathWithLaneId> prepare_segment;
+    double prepare_velocity_limit{std::numeric_limits<double>::max()};
+    double prepare_end_velocity_limit{std::numeric_limits<double>::max()};
+    double shift_length{0.0};
+    double sampled_longitudinal_acc{0.0};
+  };
+
+  struct LaneChangeSampleResult
+  {
+    std::optional<LaneChangePath> path;  // set if the candidate path is valid
+    std::string status;
+    CollisionCheckDebugMap collision_check_objects;
+    double processing_time_ms{0.0};
+    bool is_evaluated{false};
+    bool is_terminal{false};  // the sampling ends at this sample
+    bool is_safe{false};
+    bool is_allowed_in_crosswalk{false};
+    bool is_allowed_in_intersection{false};
+    std::exception_ptr exception;
+  };
+
   bool getLaneChangePaths(
     const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes,
     Direction direction, LaneChangePaths * candidate_paths,
     const utils::path_safety_checker::RSSparams rss_params, const bool is_stuck,
     const bool check_safety = true) const override;
 
+  //! @brief Evaluate the samples in the priority order with candidate_path_thread_num threads.
+  //! The samples after the first terminal one are not evaluated.
+  std::vector<LaneChangeSampleResult> evaluateLaneChangeSamples(
+    const std::vector<LaneChangeSample> & samples,
+    const std::function<LaneChangeSampleResult(const LaneChangeSample &)> & evaluate_sample) const;
+
   std::optional<LaneChangePath> calcTerminalLaneChangePath(
     const lanelet::ConstLanelets & current_lanes,
     const lanelet::ConstLanelets & target_lanes) const;
@@ -188,6 +228,9 @@ protected:
   double getStopTime() const { return stop_time_; }
 
   double stop_time_{0.0};
+
+  // kept between the cycles, and recreated when candidate_path_thread_num is changed
+  mutable std::unique_ptr<tier4_autoware_utils::WorkerPool> candidate_path_worker_pool_;
 };
 }  // namespace behavior_path_planner
 #endif  // BEHAVIOR_PATH_LANE_CHANGE_MODULE__SCENE_HPP_
@@ -89,6 +89,8 @@ struct LaneChangeParameters
   double prediction_time_resolution{0.5};
   int longitudinal_acc_sampling_num{10};
   int lateral_acc_sampling_num{10};
+  int candidate_path_thread_num{1};
+  int max_candidate_path_num{0};  // 0 means no limit
 
   // lane change parameters
   double backward_length_buffer_for_end_of_lane;
@@ -20,16 +20,29 @@
 #include <behavior_path_planner_common/utils/path_safety_checker/path_safety_checker_parameters.hpp>
 
 #include <geometry_msgs/msg/detail/polygon__struct.hpp>
+#include <geometry_msgs/msg/pose.hpp>
 
 #include <string>
+#include <vector>
 
 namespace behavior_path_planner::data::lane_change
 {
 using utils::path_safety_checker::CollisionCheckDebugMap;
+struct CandidatePathSampleDebug
+{
+  double prepare_duration{0.0};
+  double longitudinal_acc{0.0};
+  double lateral_acc{0.0};
+  geometry_msgs::msg::Pose lane_changing_start;
+  std::string status;
+  double processing_time_ms{0.0};
+};
+
 struct Debug
 {
   std::string module_type;
   LaneChangePaths valid_paths;
+  std::vector<CandidatePathSampleDebug> candidate_path_samples;
   CollisionCheckDebugMap collision_check_objects;
   CollisionCheckDebugMap collision_check_objects_after_approval;
   LaneChangeTargetObjects filtered_objects;
@@ -39,6 +52,7 @@ struct Debug
   void reset()
   {
     valid_paths.clear();
+    candidate_path_samples.clear();
     collision_check_objects.clear();
     collision_check_objects_after_approval.clear();
     filtered_objects.current_lane.clear();
@@ -50,6 +50,9 @@ void LaneChangeModuleManager::initParams(rclcpp::Node * node)
     getOrDeclareParameter<int>(*node, parameter("longitudinal_acceleration_sampling_num"));
   p.lateral_acc_sampling_num =
     getOrDeclareParameter<int>(*node, parameter("lateral_acceleration_sampling_num"));
+  p.candidate_path_thread_num =
+    getOrDeclareParameter<int>(*node, parameter("candidate_path_thread_num"));
+  p.max_candidate_path_num = getOrDeclareParameter<int>(*node, parameter("max_candidate_path_num"));
 
   // parked vehicle detection
   p.object_check_min_road_shoulder_width =
@@ -317,6 +320,13 @@ void LaneChangeModuleManager::updateModuleParams(const std::vector<rclcpp::Param
       p->lateral_acc_sampling_num = lateral_acc_sampling_num;
     }
 
+    int candidate_path_thread_num = 0;
+    updateParam<int>(parameters, ns + "candidate_path_thread_num", candidate_path_thread_num);
+    if (candidate_path_thread_num > 0) {
+      p->candidate_path_thread_num = candidate_path_thread_num;
+    }
+    updateParam<int>(parameters, ns + "max_candidate_path_num", p->max_candidate_path_num);
+
     updateParam<double>(
       parameters, ns + "finish_judge_lateral_threshold", p->finish_judge_lateral_threshold);
     updateParam<bool>(parameters, ns + "publish_debug_marker", p->publish_debug_marker);
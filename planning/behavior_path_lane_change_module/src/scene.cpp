@@ -30,6 +30,9 @@
 #include <lanelet2_core/geometry/Polygon.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -1182,6 +1185,7 @@ bool NormalLaneChange::getLaneChangePaths(
   const bool check_safety) const
 {
   lane_change_debug_.collision_check_objects.clear();
+  lane_change_debug_.candidate_path_samples.clear();
   if (current_lanes.empty() || target_lanes.empty()) {
     RCLCPP_WARN(logger_, "target_neighbor_preferred_lane_poly_2d is empty. Not expected.");
     return false;
@@ -1194,6 +1198,8 @@ bool NormalLaneChange::getLaneChangePaths(
   const auto minimum_lane_changing_velocity =
     lane_change_parameters_->minimum_lane_changing_velocity;
   const auto lateral_acc_sampling_num = lane_change_parameters_->lateral_acc_sampling_num;
+  const auto max_candidate_path_num =
+    static_cast<size_t>(std::max(lane_change_parameters_->max_candidate_path_num, 0));
 
   // get velocity
   const auto current_velocity = getEgoVelocity();
@@ -1226,8 +1232,13 @@ bool NormalLaneChange::getLaneChangePaths(
     return false;
   }
 
+  const auto target_lane_polygon =
+    lanelet::utils::getPolygonFromArcLength(target_lanes, 0, std::numeric_limits<double>::max());
+  const auto target_lane_poly_2d = lanelet::utils::to2D(target_lane_polygon).basicPolygon();
+
   const auto target_objects = getTargetObjects(current_lanes, target_lanes);
   lane_change_debug_.filtered_objects = target_objects;
+  const auto filtered_objects = filterObjectsInTargetLane(target_objects, target_lanes);
 
   const auto prepare_durations = calcPrepareDuration(current_lanes, target_lanes);
 
@@ -1238,8 +1249,20 @@ bool NormalLaneChange::getLaneChangePaths(
     logger_, "lane change sampling start. Sampling num for prep_time: %lu, acc: %lu",
     prepare_durations.size(), longitudinal_acc_sampling_values.size());
 
+  // The samples are listed in the priority order, with the rejections which do not need the path.
+  std::vector<LaneChangeSample> samples;
+  const auto is_budget_exhausted = [&]() {
+    return max_candidate_path_num > 0 && samples.size() >= max_candidate_path_num;
+  };
+
   for (const auto & prepare_duration : prepare_durations) {
+    if (is_budget_exhausted()) {
+      break;
+    }
     for (const auto & sampled_longitudinal_acc : longitudinal_acc_sampling_values) {
+      if (is_budget_exhausted()) {
+        break;
+      }
       const auto debug_print = [&](const auto & s) {
         RCLCPP_DEBUG_STREAM(
           logger_, "  -  " << s << " : prep_time = " << prepare_duration
@@ -1260,15 +1283,16 @@ bool NormalLaneChange::getLaneChangePaths(
         current_velocity * prepare_duration +
         0.5 * longitudinal_acc_on_prepare * std::pow(prepare_duration, 2);
 
-      auto prepare_segment = getPrepareSegment(current_lanes, backward_path_length, prepare_length);
+      const auto prepare_segment = std::make_shared<const PathWithLaneId>(
+        getPrepareSegment(current_lanes, backward_path_length, prepare_length));
 
-      if (prepare_segment.points.empty()) {
+      if (prepare_segment->points.empty()) {
         debug_print("prepare segment is empty...? Unexpected.");
         continue;
       }
 
       // lane changing start getEgoPose() is at the end of prepare segment
-      const auto & lane_changing_start_pose = prepare_segment.points.back().point.pose;
+      const auto & lane_changing_start_pose = prepare_segment->points.back().point.pose;
       const auto target_length_from_lane_change_start_pose = utils::getArcLengthToTargetLanelet(
         current_lanes, target_lanes.front(), lane_changing_start_pose);
 
@@ -1282,7 +1306,7 @@ bool NormalLaneChange::getLaneChangePaths(
         lanelet::utils::getLateralDistanceToClosestLanelet(target_lanes, lane_changing_start_pose);
 
       const auto initial_lane_changing_velocity = prepare_velocity;
-      const auto max_path_velocity = prepare_segment.points.back().point.longitudinal_velocity_mps;
+      const auto max_path_velocity = prepare_segment->points.back().point.longitudinal_velocity_mps;
 
       // get lateral acceleration range
       const auto [min_lateral_acc, max_lateral_acc] =
@@ -1297,7 +1321,16 @@ bool NormalLaneChange::getLaneChangePaths(
       }
       RCLCPP_DEBUG(logger_, "  -  sampling num for lat_acc: %lu", sample_lat_acc.size());
 
+      // the prepare velocity is limited by the preceding samples of the same prepare segment, over
+      // the whole segment when accelerating and at its end when decelerating
+      double prepare_velocity_limit = std::numeric_limits<double>::max();
+      double prepare_end_velocity_limit = std::numeric_limits<double>::max();
+
       for (const auto & lateral_acc : sample_lat_acc) {
+        if (is_budget_exhausted()) {
+          RCLCPP_DEBUG(logger_, "  -  candidate path budget is exhausted.");
+          break;
+        }
         const auto debug_print = [&](const auto & s) {
           RCLCPP_DEBUG_STREAM(
             logger_, "    -  " << s << " : prep_time = " << prepare_duration << ", lon_acc = "
@@ -1315,8 +1348,12 @@ bool NormalLaneChange::getLaneChangePaths(
           0.5 * longitudinal_acc_on_lane_changing * lane_changing_time * lane_changing_time;
         const auto terminal_lane_changing_velocity =
           initial_lane_changing_velocity + longitudinal_acc_on_lane_changing * lane_changing_time;
-        utils::lane_change::setPrepareVelocity(
-          prepare_segment, current_velocity, terminal_lane_changing_velocity);
+        if (current_velocity < terminal_lane_changing_velocity) {
+          prepare_velocity_limit =
+            std::min(prepare_velocity_limit, terminal_lane_changing_velocity);
+        }
+        prepare_end_velocity_limit =
+          std::min(prepare_end_velocity_limit, terminal_lane_changing_velocity);
 
         if (lane_changing_length + prepare_length > dist_to_end_of_current_lanes) {
           debug_print("Reject: length of lane changing path is longer than length to goal!!");
@@ -1343,143 +1380,211 @@ bool NormalLaneChange::getLaneChangePaths(
           }
         }
 
-        const auto target_segment = getTargetSegment(
-          target_lanes, lane_changing_start_pose, target_lane_length, lane_changing_length,
-          initial_lane_changing_velocity, next_lane_change_buffer);
+        LaneChangeSample sample;
+        sample.prepare_segment = prepare_segment;
+        sample.prepare_velocity_limit = prepare_velocity_limit;
+        sample.prepare_end_velocity_limit = prepare_end_velocity_limit;
+        sample.shift_length = shift_length;
+        sample.sampled_longitudinal_acc = sampled_longitudinal_acc;
+        sample.info.longitudinal_acceleration =
+          LaneChangePhaseInfo{longitudinal_acc_on_prepare, longitudinal_acc_on_lane_changing};
+        sample.info.duration = LaneChangePhaseInfo{prepare_duration, lane_changing_time};
+        sample.info.velocity =
+          LaneChangePhaseInfo{prepare_velocity, initial_lane_changing_velocity};
+        sample.info.length = LaneChangePhaseInfo{prepare_length, lane_changing_length};
+        sample.info.current_lanes = current_lanes;
+        sample.info.target_lanes = target_lanes;
+        sample.info.lane_changing_start = lane_changing_start_pose;
+        sample.info.lateral_acceleration = lateral_acc;
+        sample.info.terminal_lane_changing_velocity = terminal_lane_changing_velocity;
+        samples.push_back(std::move(sample));
+      }
+    }
+  }
 
-        if (target_segment.points.empty()) {
-          debug_print("Reject: target segment is empty!! something wrong...");
-          continue;
-        }
+  const auto evaluate_sample = [&](const LaneChangeSample & sample) {
+    LaneChangeSampleResult result;
+    // the end limit is above the current velocity only if all the preceding samples accelerate,
+    // and then it equals the limit over the whole segment
+    auto prepare_segment = *sample.prepare_segment;
+    if (sample.prepare_velocity_limit < std::numeric_limits<double>::max()) {
+      utils::lane_change::setPrepareVelocity(
+        prepare_segment, current_velocity, sample.prepare_velocity_limit);
+    }
+    utils::lane_change::setPrepareVelocity(
+      prepare_segment, current_velocity, sample.prepare_end_velocity_limit);
+    const auto & lane_changing_start_pose = sample.info.lane_changing_start;
+    const auto initial_lane_changing_velocity = sample.info.velocity.lane_changing;
+    const auto lane_changing_length = sample.info.length.lane_changing;
+    const auto debug_print = [&](const auto & s) {
+      result.status = s;
+      RCLCPP_DEBUG_STREAM(
+        logger_, "    -  " << s << " : prep_time = " << sample.info.duration.prepare
+                           << ", lon_acc = " << sample.sampled_longitudinal_acc
+                           << ", lat_acc = " << sample.info.lateral_acceleration);
+    };
 
-        const lanelet::BasicPoint2d lc_start_point(
-          prepare_segment.points.back().point.pose.position.x,
-          prepare_segment.points.back().point.pose.position.y);
+    const auto target_segment = getTargetSegment(
+      target_lanes, lane_changing_start_pose, target_lane_length, lane_changing_length,
+      initial_lane_changing_velocity, next_lane_change_buffer);
 
-        const auto target_lane_polygon = lanelet::utils::getPolygonFromArcLength(
-          target_lanes, 0, std::numeric_limits<double>::max());
-        const auto target_lane_poly_2d = lanelet::utils::to2D(target_lane_polygon).basicPolygon();
+    if (target_segment.points.empty()) {
+      debug_print("Reject: target segment is empty!! something wrong...");
+      return result;
+    }
 
-        const auto is_valid_start_point =
-          boost::geometry::covered_by(lc_start_point, target_neighbor_preferred_lane_poly_2d) ||
-          boost::geometry::covered_by(lc_start_point, target_lane_poly_2d);
+    const lanelet::BasicPoint2d lc_start_point(
+      lane_changing_start_pose.position.x, lane_changing_start_pose.position.y);
 
-        LaneChangeInfo lane_change_info;
-        lane_change_info.longitudinal_acceleration =
-          LaneChangePhaseInfo{longitudinal_acc_on_prepare, longitudinal_acc_on_lane_changing};
-        lane_change_info.duration = LaneChangePhaseInfo{prepare_duration, lane_changing_time};
-        lane_change_info.velocity =
-          LaneChangePhaseInfo{prepare_velocity, initial_lane_changing_velocity};
-        lane_change_info.length = LaneChangePhaseInfo{prepare_length, lane_changing_length};
-        lane_change_info.current_lanes = current_lanes;
-        lane_change_info.target_lanes = target_lanes;
-        lane_change_info.lane_changing_start = prepare_segment.points.back().point.pose;
-        lane_change_info.lane_changing_end = target_segment.points.front().point.pose;
-        lane_change_info.lateral_acceleration = lateral_acc;
-        lane_change_info.terminal_lane_changing_velocity = terminal_lane_changing_velocity;
-
-        if (!is_valid_start_point) {
-          debug_print(
-            "Reject: lane changing points are not inside of the target preferred lanes or its "
-            "neighbors");
-          continue;
-        }
+    const auto is_valid_start_point =
+      boost::geometry::covered_by(lc_start_point, target_neighbor_preferred_lane_poly_2d) ||
+      boost::geometry::covered_by(lc_start_point, target_lane_poly_2d);
 
-        const auto resample_interval = utils::lane_change::calcLaneChangeResampleInterval(
-          lane_changing_length, initial_lane_changing_velocity);
-        const auto target_lane_reference_path = utils::lane_change::getReferencePathFromTargetLane(
-          route_handler, target_lanes, lane_changing_start_pose, target_lane_length,
-          lane_changing_length, forward_path_length, resample_interval, is_goal_in_route,
-          next_lane_change_buffer);
+    LaneChangeInfo lane_change_info = sample.info;
+    lane_change_info.lane_changing_end = target_segment.points.front().point.pose;
 
-        if (target_lane_reference_path.points.empty()) {
-          debug_print("Reject: target_lane_reference_path is empty!!");
-          continue;
-        }
+    if (!is_valid_start_point) {
+      debug_print(
+        "Reject: lane changing points are not inside of the target preferred lanes or its "
+        "neighbors");
+      return result;
+    }
 
-        lane_change_info.shift_line = utils::lane_change::getLaneChangingShiftLine(
-          prepare_segment, target_segment, target_lane_reference_path, shift_length);
+    const auto resample_interval = utils::lane_change::calcLaneChangeResampleInterval(
+      lane_changing_length, initial_lane_changing_velocity);
+    const auto target_lane_reference_path = utils::lane_change::getReferencePathFromTargetLane(
+      route_handler, target_lanes, lane_changing_start_pose, target_lane_length,
+      lane_changing_length, forward_path_length, resample_interval, is_goal_in_route,
+      next_lane_change_buffer);
 
-        const auto candidate_path = utils::lane_change::constructCandidatePath(
-          lane_change_info, prepare_segment, target_segment, target_lane_reference_path,
-          sorted_lane_ids);
+    if (target_lane_reference_path.points.empty()) {
+      debug_print("Reject: target_lane_reference_path is empty!!");
+      return result;
+    }
 
-        if (!candidate_path) {
-          debug_print("Reject: failed to generate candidate path!!");
-          continue;
-        }
+    lane_change_info.shift_line = utils::lane_change::getLaneChangingShiftLine(
+      prepare_segment, target_segment, target_lane_reference_path, sample.shift_length);
 
-        if (!hasEnoughLength(*candidate_path, current_lanes, target_lanes, direction)) {
-          debug_print("Reject: invalid candidate path!!");
-          continue;
-        }
+    const auto candidate_path = utils::lane_change::constructCandidatePath(
+      lane_change_info, prepare_segment, target_segment, target_lane_reference_path,
+      sorted_lane_ids);
 
-        if (
-          lane_change_parameters_->regulate_on_crosswalk &&
-          !hasEnoughLengthToCrosswalk(*candidate_path, current_lanes)) {
-          if (getStopTime() < lane_change_parameters_->stop_time_threshold) {
-            debug_print("Reject: including crosswalk!!");
-            continue;
-          }
-          RCLCPP_INFO_THROTTLE(
-            logger_, clock_, 1000, "Stop time is over threshold. Allow lane change in crosswalk.");
-        }
+    if (!candidate_path) {
+      debug_print("Reject: failed to generate candidate path!!");
+      return result;
+    }
 
-        if (
-          lane_change_parameters_->regulate_on_intersection &&
-          !hasEnoughLengthToIntersection(*candidate_path, current_lanes)) {
-          if (getStopTime() < lane_change_parameters_->stop_time_threshold) {
-            debug_print("Reject: including intersection!!");
-            continue;
-          }
-          RCLCPP_WARN_STREAM(
-            logger_, "Stop time is over threshold. Allow lane change in intersection.");
-        }
+    if (!hasEnoughLength(*candidate_path, current_lanes, target_lanes, direction)) {
+      debug_print("Reject: invalid candidate path!!");
+      return result;
+    }
 
-        if (
-          lane_change_parameters_->regulate_on_traffic_light &&
-          !hasEnoughLengthToTrafficLight(*candidate_path, current_lanes)) {
-          debug_print("Reject: regulate on traffic light!!");
-          continue;
-        }
+    if (
+      lane_change_parameters_->regulate_on_crosswalk &&
+      !hasEnoughLengthToCrosswalk(*candidate_path, current_lanes)) {
+      if (getStopTime() < lane_change_parameters_->stop_time_threshold) {
+        debug_print("Reject: including crosswalk!!");
+        return result;
+      }
+      result.is_allowed_in_crosswalk = true;
+    }
 
-        if (utils::traffic_light::isStoppedAtRedTrafficLightWithinDistance(
-              lane_change_info.current_lanes, candidate_path.value().path, planner_data_,
-              lane_change_info.length.sum())) {
-          debug_print("Ego is stopping near traffic light. Do not allow lane change");
-          continue;
-        }
-        candidate_paths->push_back(*candidate_path);
-
-        std::vector<ExtendedPredictedObject> filtered_objects =
-          filterObjectsInTargetLane(target_objects, target_lanes);
-        if (
-          !is_stuck &&
-          utils::lane_change::passParkedObject(
-            route_handler, *candidate_path, filtered_objects, lane_change_buffer, is_goal_in_route,
-            *lane_change_parameters_, lane_change_debug_.collision_check_objects)) {
-          debug_print(
-            "Reject: parking vehicle exists in the target lane, and the ego is not in stuck. Skip "
-            "lane change.");
-          return false;
-        }
+    if (
+      lane_change_parameters_->regulate_on_intersection &&
+      !hasEnoughLengthToIntersection(*candidate_path, current_lanes)) {
+      if (getStopTime() < lane_change_parameters_->stop_time_threshold) {
+        debug_print("Reject: including intersection!!");
+        return result;
+      }
+      result.is_allowed_in_intersection = true;
+    }
 
-        if (!check_safety) {
-          debug_print("ACCEPT!!!: it is valid (and safety check is skipped).");
-          return false;
-        }
+    if (
+      lane_change_parameters_->regulate_on_traffic_light &&
+      !hasEnoughLengthToTrafficLight(*candidate_path, current_lanes)) {
+      debug_print("Reject: regulate on traffic light!!");
+      return result;
+    }
+
+    if (utils::traffic_light::isStoppedAtRedTrafficLightWithinDistance(
+          lane_change_info.current_lanes, candidate_path.value().path, planner_data_,
+          lane_change_info.length.sum())) {
+      debug_print("Ego is stopping near traffic light. Do not allow lane change");
+      return result;
+    }
+    result.path = candidate_path;
 
-        const auto [is_safe, is_object_coming_from_rear] = isLaneChangePathSafe(
-          *candidate_path, target_objects, rss_params, is_stuck,
-          lane_change_debug_.collision_check_objects);
+    if (
+      !is_stuck && utils::lane_change::passParkedObject(
+                     route_handler, *candidate_path, filtered_objects, lane_change_buffer,
+                     is_goal_in_route, *lane_change_parameters_, result.collision_check_objects)) {
+      debug_print(
+        "Reject: parking vehicle exists in the target lane, and the ego is not in stuck. Skip "
+        "lane change.");
+      result.is_terminal = true;
+      return result;
+    }
 
-        if (is_safe) {
-          debug_print("ACCEPT!!!: it is valid and safe!");
-          return true;
-        }
+    if (!check_safety) {
+      debug_print("ACCEPT!!!: it is valid (and safety check is skipped).");
+      result.is_terminal = true;
+      return result;
+    }
 
-        debug_print("Reject: sampled path is not safe.");
-      }
+    const auto [is_safe, is_object_coming_from_rear] = isLaneChangePathSafe(
+      *candidate_path, target_objects, rss_params, is_stuck, result.collision_check_objects);
+
+    if (is_safe) {
+      debug_print("ACCEPT!!!: it is valid and safe!");
+      result.is_safe = true;
+      result.is_terminal = true;
+      return result;
+    }
+
+    debug_print("Reject: sampled path is not safe.");
+    return result;
+  };
+
+  const auto results = evaluateLaneChangeSamples(samples, evaluate_sample);
+
+  // merge the results in the priority order until the first one which ends the sampling, so that
+  // the candidate paths and the debug data are the same as the serial sampling.
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto & result = results.at(i);
+    if (!result.is_evaluated) {
+      break;
+    }
+    if (result.exception) {
+      std::rethrow_exception(result.exception);
+    }
+
+    const auto & info = samples.at(i).info;
+    data::lane_change::CandidatePathSampleDebug sample_debug;
+    sample_debug.prepare_duration = info.duration.prepare;
+    sample_debug.longitudinal_acc = samples.at(i).sampled_longitudinal_acc;
+    sample_debug.lateral_acc = info.lateral_acceleration;
+    sample_debug.lane_changing_start = info.lane_changing_start;
+    sample_debug.status = result.status;
+    sample_debug.processing_time_ms = result.processing_time_ms;
+    lane_change_debug_.candidate_path_samples.push_back(sample_debug);
+
+    for (const auto & [uuid, object_debug] : result.collision_check_objects) {
+      lane_change_debug_.collision_check_objects[uuid] = object_debug;
+    }
+    if (result.is_allowed_in_crosswalk) {
+      RCLCPP_INFO_THROTTLE(
+        logger_, clock_, 1000, "Stop time is over threshold. Allow lane change in crosswalk.");
+    }
+    if (result.is_allowed_in_intersection) {
+      RCLCPP_WARN_STREAM(
+        logger_, "Stop time is over threshold. Allow lane change in intersection.");
+    }
+
+    if (result.path) {
+      candidate_paths->push_back(*result.path);
+    }
+    if (result.is_terminal) {
+      return result.is_safe;
     }
   }
 
@@ -1487,6 +1592,59 @@ bool NormalLaneChange::getLaneChangePaths(
   return false;
 }
 
+std::vector<NormalLaneChange::LaneChangeSampleResult>
+NormalLaneChange::evaluateLaneChangeSamples(
+  const std::vector<LaneChangeSample> & samples,
+  const std::function<LaneChangeSampleResult(const LaneChangeSample &)> & evaluate_sample) const
+{
+  std::vector<LaneChangeSampleResult> results(samples.size());
+  const auto thread_num = std::min(
+    static_cast<size_t>(std::max(lane_change_parameters_->candidate_path_thread_num, 1)),
+    samples.size());
+
+  // the workers take the samples in the priority order and stop taking them once a sample which
+  // ends the sampling is found, so every sample before it is evaluated.
+  std::atomic<size_t> next_index{0};
+  std::atomic<size_t> terminal_index{samples.size()};
+  const auto worker = [&](const size_t /*worker_index*/) {
+    for (size_t i = next_index++; i < samples.size() && i < terminal_index; i = next_index++) {
+      auto & result = results.at(i);
+      const auto start = std::chrono::steady_clock::now();
+      try {
+        result = evaluate_sample(samples.at(i));
+      } catch (...) {
+        result.exception = std::current_exception();
+        result.is_terminal = true;
+      }
+      result.processing_time_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      result.is_evaluated = true;
+
+      if (result.is_terminal) {
+        size_t current = terminal_index;
+        while (i < current && !terminal_index.compare_exchange_weak(current, i)) {
+        }
+      }
+    }
+  };
+
+  if (thread_num <= 1) {
+    worker(0);
+    return results;
+  }
+
+  const auto pool_thread_num =
+    static_cast<size_t>(lane_change_parameters_->candidate_path_thread_num);
+  if (
+    !candidate_path_worker_pool_ ||
+    candidate_path_worker_pool_->getThreadNum() != pool_thread_num) {
+    candidate_path_worker_pool_ =
+      std::make_unique<tier4_autoware_utils::WorkerPool>(pool_thread_num);
+  }
+  candidate_path_worker_pool_->run(worker);
+  return results;
+}
+
 std::optional<LaneChangePath> NormalLaneChange::calcTerminalLaneChangePath(
   const lanelet::ConstLanelets & current_lanes, const lanelet::ConstLanelets & target_lanes) const
 {
@@ -1975,6 +2133,10 @@ PathSafetyStatus NormalLaneChange::isLaneChangePathSafe(
     lane_change_parameters_->lane_expansion_left_offset,
     lane_change_parameters_->lane_expansion_right_offset);
 
+  // the ego footprints are interpolated once and shared by all the objects and their paths
+  utils::path_safety_checker::EgoPredictedFootprints ego_footprints(
+    ego_predicted_path, common_parameters.vehicle_info);
+
   for (const auto & obj : collision_check_objects) {
     auto current_debug_data = utils::path_safety_checker::createObjectDebug(obj);
     const auto obj_predicted_paths = utils::path_safety_checker::getPredictedPathFromObj(
@@ -1982,7 +2144,7 @@ PathSafetyStatus NormalLaneChange::isLaneChangePathSafe(
     auto is_safe = true;
     for (const auto & obj_path : obj_predicted_paths) {
       const auto collided_polygons = utils::path_safety_checker::getCollidedPolygons(
-        path, ego_predicted_path, obj, obj_path, common_parameters, rss_params, 1.0,
+        path, ego_footprints, obj, obj_path, common_parameters, rss_params, 1.0,
         current_debug_data.second);
 
       if (collided_polygons.empty()) {
@@ -17,6 +17,7 @@
 #include "behavior_path_planner_common/utils/path_shifter/path_shifter.hpp"
 
 #include <behavior_path_lane_change_module/utils/markers.hpp>
+#include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/ros/marker_helper.hpp>
 
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -26,6 +27,8 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -122,6 +125,43 @@ MarkerArray showFilteredObjects(
   return marker_array;
 }
 
+MarkerArray showCandidatePathSamples(
+  const std::vector<CandidatePathSampleDebug> & samples, const std::string & ns)
+{
+  if (samples.empty()) {
+    return MarkerArray{};
+  }
+
+  MarkerArray marker_array;
+  marker_array.markers.reserve(samples.size());
+  const auto current_time{rclcpp::Clock{RCL_ROS_TIME}.now()};
+
+  // the samples of the same prepare segment share the start position, so they are stacked
+  int32_t id{0};
+  size_t stack{0};
+  for (size_t idx = 0; idx < samples.size(); ++idx) {
+    const auto & sample = samples.at(idx);
+    const bool is_same_start =
+      idx > 0 && tier4_autoware_utils::calcDistance3d(
+                   samples.at(idx - 1).lane_changing_start, sample.lane_changing_start) < 1e-3;
+    stack = is_same_start ? stack + 1 : 0;
+
+    auto text_marker = createDefaultMarker(
+      "map", current_time, ns, ++id, Marker::TEXT_VIEW_FACING, createMarkerScale(0.0, 0.0, 0.4),
+      colors::white());
+    text_marker.pose = sample.lane_changing_start;
+    text_marker.pose.position.z += 2.0 + 0.5 * static_cast<double>(stack);
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << "prep_time: " << sample.prepare_duration
+       << ", lon_acc: " << sample.longitudinal_acc << ", lat_acc: " << sample.lateral_acc << ", "
+       << sample.status << " (" << sample.processing_time_ms << " [ms])";
+    text_marker.text = ss.str();
+    marker_array.markers.push_back(text_marker);
+  }
+  return marker_array;
+}
+
 MarkerArray createDebugMarkerArray(const Debug & debug_data)
 {
   using marker_utils::showPolygon;
@@ -142,6 +182,7 @@ MarkerArray createDebugMarkerArray(const Debug & debug_data)
   };
 
   add(showAllValidLaneChangePath(debug_valid_paths, "lane_change_valid_paths"));
+  add(showCandidatePathSamples(debug_data.candidate_path_samples, "candidate_path_samples"));
   add(showFilteredObjects(
     debug_filtered_objects.current_lane, debug_filtered_objects.target_lane,
     debug_filtered_objects.other_lane, "object_filtered"));
@@ -20,6 +20,7 @@
 #include "behavior_path_planner_common/interface/scene_module_visitor.hpp"
 #include "tier4_autoware_utils/ros/debug_publisher.hpp"
 #include "tier4_autoware_utils/system/stop_watch.hpp"
+#include "tier4_autoware_utils/system/worker_pool.hpp"
 
 #include <pluginlib/class_loader.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -96,7 +97,9 @@ struct SceneModuleStatus
 class PlannerManager
 {
 public:
-  PlannerManager(rclcpp::Node & node, const size_t max_iteration_num, const bool verbose);
+  PlannerManager(
+    rclcpp::Node & node, const size_t max_iteration_num, const size_t candidate_module_thread_num,
+    const bool verbose);
 
   /**
    * @brief run all candidate and approved modules.
@@ -274,6 +277,24 @@ private:
   {
     stop_watch_.tic(module_ptr->name());
 
+    const auto result = runModule(module_ptr, planner_data, previous_module_output);
+
+    processing_time_.at(module_ptr->name()) += stop_watch_.toc(module_ptr->name(), true);
+
+    return result;
+  }
+
+  /**
+   * @brief run the module and publish RTC status without measuring the processing time. this
+   * function does not touch any member of the manager, so it can be called from worker threads.
+   * @param module.
+   * @param planner data.
+   * @return planning result.
+   */
+  static BehaviorModuleOutput runModule(
+    const SceneModulePtr & module_ptr, const std::shared_ptr<PlannerData> & planner_data,
+    const BehaviorModuleOutput & previous_module_output)
+  {
     module_ptr->setData(planner_data);
     module_ptr->setPreviousModuleOutput(previous_module_output);
 
@@ -291,11 +312,24 @@ private:
 
     module_ptr->publishObjectsOfInterestMarker();
 
-    processing_time_.at(module_ptr->name()) += stop_watch_.toc(module_ptr->name(), true);
-
     return result;
   }
 
+  /**
+   * @brief run the request modules concurrently on candidate_module_thread_num_ threads. every
+   * module gets the same previous module output, and the results are keyed by module name, so the
+   * result is the same as running them one by one. each module is registered to its manager right
+   * before it runs, in the module order.
+   * @param request modules.
+   * @param planner data.
+   * @param previous module output.
+   * @param planning results of each module.
+   */
+  void runRequestModulesInParallel(
+    const std::vector<SceneModulePtr> & modules, const std::shared_ptr<PlannerData> & data,
+    const BehaviorModuleOutput & previous_module_output,
+    std::unordered_map<std::string, BehaviorModuleOutput> & results) const;
+
   void generateCombinedDrivableArea(
     BehaviorModuleOutput & output, const std::shared_ptr<PlannerData> & data) const;
 
@@ -475,6 +509,13 @@ private:
 
   size_t max_iteration_num_{100};
 
+  size_t candidate_module_thread_num_{1};
+
+  // threads running the request modules, kept between the planning cycles
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> worker_pool_;
+
+  mutable double candidate_module_thread_occupancy_{0.0};
+
   bool verbose_{false};
 };
 }  // namespace behavior_path_planner
@@ -128,7 +128,8 @@ BehaviorPathPlannerNode::BehaviorPathPlannerNode(const rclcpp::NodeOptions & nod
     const std::lock_guard<std::mutex> lock(mutex_manager_);  // for planner_manager_
 
     const auto & p = planner_data_->parameters;
-    planner_manager_ = std::make_shared<PlannerManager>(*this, p.max_iteration_num, p.verbose);
+    planner_manager_ = std::make_shared<PlannerManager>(
+      *this, p.max_iteration_num, p.candidate_module_thread_num, p.verbose);
 
     for (const auto & name : declare_parameter<std::vector<std::string>>("launch_modules")) {
       // workaround: Since ROS 2 can't get empty list, launcher set [''] on the parameter.
@@ -204,6 +205,7 @@ BehaviorPathPlannerParameters BehaviorPathPlannerNode::getCommonParam()
 
   p.verbose = declare_parameter<bool>("verbose");
   p.max_iteration_num = declare_parameter<int>("max_iteration_num");
+  p.candidate_module_thread_num = declare_parameter<int>("candidate_module_thread_num");
   p.traffic_light_signal_timeout = declare_parameter<double>("traffic_light_signal_timeout");
 
   // vehicle info
@@ -353,6 +355,11 @@ void BehaviorPathPlannerNode::run()
   // update map
   if (map_ptr) {
     planner_data_->route_handler->setMap(*map_ptr);
+    // the centerline of a lanelet is calculated lazily and cached without a lock, so all of them
+    // are calculated here once for the modules running on several threads.
+    for (const auto & lanelet : planner_data_->route_handler->getLaneletMapPtr()->laneletLayer) {
+      lanelet.centerline();
+    }
   }
 
   std::unique_lock<std::mutex> lk_manager(mutex_manager_);  // for planner_manager_
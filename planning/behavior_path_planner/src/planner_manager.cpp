@@ -25,20 +25,31 @@
 
 #include <boost/format.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace behavior_path_planner
 {
 PlannerManager::PlannerManager(
-  rclcpp::Node & node, const size_t max_iteration_num, const bool verbose)
+  rclcpp::Node & node, const size_t max_iteration_num, const size_t candidate_module_thread_num,
+  const bool verbose)
 : plugin_loader_("behavior_path_planner", "behavior_path_planner::SceneModuleManagerInterface"),
   logger_(node.get_logger().get_child("planner_manager")),
   clock_(*node.get_clock()),
   max_iteration_num_{max_iteration_num},
+  candidate_module_thread_num_{std::max(candidate_module_thread_num, size_t{1})},
   verbose_{verbose}
 {
   processing_time_.emplace("total_time", 0.0);
+  if (candidate_module_thread_num_ > 1) {
+    processing_time_.emplace("parallel_request_modules", 0.0);
+    worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(candidate_module_thread_num_);
+  }
   debug_publisher_ptr_ = std::make_unique<DebugPublisher>(&node, "~/debug");
   state_publisher_ptr_ = std::make_unique<DebugPublisher>(&node, "~/debug");
 }
@@ -540,15 +551,19 @@ std::pair<SceneModulePtr, BehaviorModuleOutput> PlannerManager::runRequestModule
   /**
    * run executable modules.
    */
-  for (const auto & module_ptr : executable_modules) {
-    const auto & manager_ptr = getManager(module_ptr);
+  if (candidate_module_thread_num_ > 1 && executable_modules.size() > 1) {
+    runRequestModulesInParallel(executable_modules, data, previous_module_output, results);
+  } else {
+    for (const auto & module_ptr : executable_modules) {
+      const auto & manager_ptr = getManager(module_ptr);
 
-    if (!manager_ptr->exist(module_ptr)) {
-      manager_ptr->registerNewModule(
-        std::weak_ptr<SceneModuleInterface>(module_ptr), previous_module_output);
-    }
+      if (!manager_ptr->exist(module_ptr)) {
+        manager_ptr->registerNewModule(
+          std::weak_ptr<SceneModuleInterface>(module_ptr), previous_module_output);
+      }
 
-    results.emplace(module_ptr->name(), run(module_ptr, data, previous_module_output));
+      results.emplace(module_ptr->name(), run(module_ptr, data, previous_module_output));
+    }
   }
 
   /**
@@ -619,6 +634,83 @@ std::pair<SceneModulePtr, BehaviorModuleOutput> PlannerManager::runRequestModule
   return std::make_pair(module_ptr, results.at(module_ptr->name()));
 }
 
+void PlannerManager::runRequestModulesInParallel(
+  const std::vector<SceneModulePtr> & modules, const std::shared_ptr<PlannerData> & data,
+  const BehaviorModuleOutput & previous_module_output,
+  std::unordered_map<std::string, BehaviorModuleOutput> & results) const
+{
+  std::vector<BehaviorModuleOutput> outputs(modules.size());
+  std::vector<double> module_processing_times(modules.size(), 0.0);
+  std::vector<std::exception_ptr> exceptions(modules.size(), nullptr);
+  std::atomic<size_t> next_index{0};
+
+  // a module is registered to its manager right before it runs, and the registrations are done one
+  // by one in the module order as in the serial execution.
+  std::mutex registration_mutex;
+  std::condition_variable registration_condition;
+  size_t registered_num{0};
+  const auto register_module = [&](const size_t i) {
+    std::unique_lock<std::mutex> lock(registration_mutex);
+    registration_condition.wait(lock, [&]() { return registered_num == i; });
+    try {
+      const auto & module_ptr = modules.at(i);
+      const auto & manager_ptr = getManager(module_ptr);
+      if (!manager_ptr->exist(module_ptr)) {
+        manager_ptr->registerNewModule(
+          std::weak_ptr<SceneModuleInterface>(module_ptr), previous_module_output);
+      }
+    } catch (...) {
+      exceptions.at(i) = std::current_exception();
+    }
+    registered_num++;
+    lock.unlock();
+    registration_condition.notify_all();
+  };
+
+  const auto worker = [&](const size_t /*worker_index*/) {
+    for (size_t i = next_index++; i < modules.size(); i = next_index++) {
+      register_module(i);
+      if (exceptions.at(i)) {
+        continue;
+      }
+      const auto start = std::chrono::steady_clock::now();
+      try {
+        outputs.at(i) = runModule(modules.at(i), data, previous_module_output);
+      } catch (...) {
+        exceptions.at(i) = std::current_exception();
+      }
+      module_processing_times.at(i) =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+  };
+
+  // the centerlines of the lanelets are calculated in advance when the map is loaded, as they are
+  // calculated lazily and cached without a lock.
+  const size_t thread_num = std::min(candidate_module_thread_num_, modules.size());
+  const auto start = std::chrono::steady_clock::now();
+  worker_pool_->run(worker);
+  const double wall_time =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  // rethrow in priority order, as the serial execution would have stopped at the first exception.
+  for (const auto & exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  double busy_time = 0.0;
+  for (size_t i = 0; i < modules.size(); ++i) {
+    results.emplace(modules.at(i)->name(), outputs.at(i));
+    processing_time_.at(modules.at(i)->name()) += module_processing_times.at(i);
+    busy_time += module_processing_times.at(i);
+  }
+
+  processing_time_.at("parallel_request_modules") += wall_time;
+  candidate_module_thread_occupancy_ =
+    wall_time > 0.0 ? busy_time / (wall_time * static_cast<double>(thread_num)) : 0.0;
+}
+
 BehaviorModuleOutput PlannerManager::runApprovedModules(const std::shared_ptr<PlannerData> & data)
 {
   std::unordered_map<std::string, BehaviorModuleOutput> results;
@@ -997,6 +1089,11 @@ void PlannerManager::publishProcessingTime() const
     std::string name = t.first + std::string("/processing_time_ms");
     debug_publisher_ptr_->publish<DebugDoubleMsg>(name, t.second);
   }
+
+  if (candidate_module_thread_num_ > 1) {
+    debug_publisher_ptr_->publish<DebugDoubleMsg>(
+      "parallel_request_modules/thread_occupancy", candidate_module_thread_occupancy_);
+  }
 }
 
 std::shared_ptr<SceneModuleVisitor> PlannerManager::getDebugMsg()
@@ -32,6 +32,7 @@ struct BehaviorPathPlannerParameters
 {
   bool verbose;
   size_t max_iteration_num{100};
+  size_t candidate_module_thread_num{1};
   double traffic_light_signal_timeout{1.0};
 
   double backward_path_length;
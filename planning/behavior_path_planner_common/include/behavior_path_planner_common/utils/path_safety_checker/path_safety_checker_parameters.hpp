@@ -33,8 +33,22 @@ namespace behavior_path_planner::utils::path_safety_checker
 
 using geometry_msgs::msg::Pose;
 using geometry_msgs::msg::Twist;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::Polygon2d;
 
+/**
+ * @brief Polygon with the axis-aligned bounding box and the convexity used by the broad phase and
+ *        the narrow phase of the collision check.
+ */
+struct PolygonWithBoundingBox
+{
+  Polygon2d polygon{};
+  Box2d box{};
+  bool is_convex{false};
+};
+
+PolygonWithBoundingBox createPolygonWithBoundingBox(const Polygon2d & polygon);
+
 struct PoseWithVelocity
 {
   Pose pose;
@@ -55,11 +69,12 @@ struct PoseWithVelocityStamped : public PoseWithVelocity
 
 struct PoseWithVelocityAndPolygonStamped : public PoseWithVelocityStamped
 {
-  Polygon2d poly;
+  // The bounding box is computed once when the path is built and reused by every collision check
+  PolygonWithBoundingBox poly_with_box;
 
   PoseWithVelocityAndPolygonStamped(
     const double time, const Pose & pose, const double velocity, const Polygon2d & poly)
-  : PoseWithVelocityStamped(time, pose, velocity), poly(poly)
+  : PoseWithVelocityStamped(time, pose, velocity), poly_with_box(createPolygonWithBoundingBox(poly))
   {
   }
 };
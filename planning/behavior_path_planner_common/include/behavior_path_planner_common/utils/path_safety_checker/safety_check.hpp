@@ -26,6 +26,8 @@
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/twist.hpp>
 
+#include <map>
+#include <optional>
 #include <vector>
 
 namespace behavior_path_planner::utils::path_safety_checker
@@ -42,6 +44,37 @@ using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Polygon2d;
 using vehicle_info_util::VehicleInfo;
 
+/**
+ * @brief Ego footprints along the predicted path. The pose and the footprint at each time are
+ *        interpolated on the first query and reused by the following ones, so that the checks of
+ *        all the objects and their predicted paths against the same ego path share them.
+ */
+class EgoPredictedFootprints
+{
+public:
+  struct Footprint
+  {
+    PoseWithVelocityStamped pose_with_velocity;
+    PolygonWithBoundingBox polygon;
+  };
+
+  EgoPredictedFootprints(
+    const std::vector<PoseWithVelocityStamped> & predicted_path, const VehicleInfo & vehicle_info);
+
+  const std::vector<PoseWithVelocityStamped> & getPredictedPath() const { return predicted_path_; }
+
+  /**
+   * @brief Get the footprint at the given time.
+   * @return nullopt if the time is out of the predicted path.
+   */
+  const std::optional<Footprint> & getFootprint(const double time);
+
+private:
+  std::vector<PoseWithVelocityStamped> predicted_path_;
+  VehicleInfo vehicle_info_;
+  std::map<double, std::optional<Footprint>> footprints_;
+};
+
 bool isTargetObjectOncoming(
   const geometry_msgs::msg::Pose & vehicle_pose, const geometry_msgs::msg::Pose & object_pose);
 
@@ -120,6 +153,12 @@ bool checkCollision(
   const PredictedPathWithPolygon & target_object_path,
   const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
   const double hysteresis_factor, CollisionCheckDebug & debug);
+bool checkCollision(
+  const PathWithLaneId & planned_path, EgoPredictedFootprints & ego_footprints,
+  const ExtendedPredictedObject & target_object,
+  const PredictedPathWithPolygon & target_object_path,
+  const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
+  const double hysteresis_factor, CollisionCheckDebug & debug);
 
 /**
  * @brief Iterate the points in the ego and target's predicted path and
@@ -143,6 +182,29 @@ std::vector<Polygon2d> getCollidedPolygons(
   const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
   const double hysteresis_factor, CollisionCheckDebug & debug);
 
+/**
+ * @brief Same as above, but the ego footprints are shared with the other objects and paths checked
+ *        against the same ego predicted path.
+ */
+std::vector<Polygon2d> getCollidedPolygons(
+  const PathWithLaneId & planned_path, EgoPredictedFootprints & ego_footprints,
+  const ExtendedPredictedObject & target_object,
+  const PredictedPathWithPolygon & target_object_path,
+  const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
+  const double hysteresis_factor, CollisionCheckDebug & debug);
+
+/**
+ * @brief Same as boost::geometry::overlaps, but the pairs whose bounding boxes are apart or which
+ *        are separated along an edge normal of the convex polygons are rejected without it.
+ */
+bool checkPolygonsOverlaps(
+  const PolygonWithBoundingBox & poly_1, const PolygonWithBoundingBox & poly_2);
+
+/**
+ * @brief Same as boost::geometry::intersects, with the same rejection as checkPolygonsOverlaps.
+ */
+bool checkPolygonsIntersects(
+  const PolygonWithBoundingBox & poly_1, const PolygonWithBoundingBox & poly_2);
 bool checkPolygonsIntersects(
   const std::vector<Polygon2d> & polys_1, const std::vector<Polygon2d> & polys_2);
 bool checkSafetyWithIntegralPredictedPolygon(
@@ -21,16 +21,180 @@
 #include "tier4_autoware_utils/ros/uuid_helper.hpp"
 
 #include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
 #include <boost/geometry/algorithms/overlaps.hpp>
 #include <boost/geometry/algorithms/union.hpp>
 #include <boost/geometry/strategies/strategies.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 namespace behavior_path_planner::utils::path_safety_checker
 {
 
 namespace bg = boost::geometry;
 
+namespace
+{
+/**
+ * @brief Offset the points in the frame of the pose as calcOffsetPose does, with the rotation
+ *        calculated once for all the points of the polygon.
+ */
+class PoseOffset
+{
+public:
+  explicit PoseOffset(const Pose & pose) : x_(pose.position.x), y_(pose.position.y)
+  {
+    const auto & q = pose.orientation;
+    const double s = 2.0 / (q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    r00_ = 1.0 - s * (q.y * q.y + q.z * q.z);
+    r01_ = s * (q.x * q.y - q.z * q.w);
+    r10_ = s * (q.x * q.y + q.z * q.w);
+    r11_ = 1.0 - s * (q.x * q.x + q.z * q.z);
+  }
+
+  Point2d operator()(const double lon_offset, const double lat_offset) const
+  {
+    return Point2d{
+      x_ + r00_ * lon_offset + r01_ * lat_offset, y_ + r10_ * lon_offset + r11_ * lat_offset};
+  }
+
+private:
+  double x_;
+  double y_;
+  double r00_{1.0};
+  double r01_{0.0};
+  double r10_{0.0};
+  double r11_{1.0};
+};
+
+bool isConvex(const Polygon2d & polygon)
+{
+  const auto & outer = polygon.outer();
+  if (!polygon.inners().empty() || outer.size() < 3) {
+    return false;
+  }
+
+  // all the turns have the same direction, ignoring the duplicated closing point
+  bool has_left_turn = false;
+  bool has_right_turn = false;
+  for (size_t i = 0; i < outer.size(); ++i) {
+    const auto & p0 = outer.at(i);
+    const auto & p1 = outer.at((i + 1) % outer.size());
+    const auto & p2 = outer.at((i + 2) % outer.size());
+    const double cross =
+      (p1.x() - p0.x()) * (p2.y() - p1.y()) - (p1.y() - p0.y()) * (p2.x() - p1.x());
+    has_left_turn |= cross > 0.0;
+    has_right_turn |= cross < 0.0;
+  }
+  return !(has_left_turn && has_right_turn);
+}
+
+/**
+ * @brief Check if the projections of the polygons on the normal of an edge of poly_1 are apart.
+ */
+bool hasSeparatingEdge(const Polygon2d & poly_1, const Polygon2d & poly_2)
+{
+  constexpr double epsilon = 1e-6;
+  const auto & outer_1 = poly_1.outer();
+  const auto & outer_2 = poly_2.outer();
+  const auto project = [](const auto & outer, const double nx, const double ny) {
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    for (const auto & p : outer) {
+      const double d = nx * p.x() + ny * p.y();
+      min = std::min(min, d);
+      max = std::max(max, d);
+    }
+    return std::make_pair(min, max);
+  };
+
+  for (size_t i = 0; i < outer_1.size(); ++i) {
+    const auto & p0 = outer_1.at(i);
+    const auto & p1 = outer_1.at((i + 1) % outer_1.size());
+    const double length = std::hypot(p1.x() - p0.x(), p1.y() - p0.y());
+    if (length < epsilon) {
+      continue;
+    }
+    const double nx = (p0.y() - p1.y()) / length;
+    const double ny = (p1.x() - p0.x()) / length;
+    const auto [min_1, max_1] = project(outer_1, nx, ny);
+    const auto [min_2, max_2] = project(outer_2, nx, ny);
+    if (max_1 + epsilon < min_2 || max_2 + epsilon < min_1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check if the polygons are apart with the bounding boxes (broad phase) and the separating
+ *        axis of the convex polygons (narrow phase). false does not mean that they intersect.
+ */
+bool isSeparated(const PolygonWithBoundingBox & poly_1, const PolygonWithBoundingBox & poly_2)
+{
+  const auto & min_1 = poly_1.box.min_corner();
+  const auto & max_1 = poly_1.box.max_corner();
+  const auto & min_2 = poly_2.box.min_corner();
+  const auto & max_2 = poly_2.box.max_corner();
+  if (
+    max_1.x() < min_2.x() || max_2.x() < min_1.x() || max_1.y() < min_2.y() ||
+    max_2.y() < min_1.y()) {
+    return true;
+  }
+
+  if (!poly_1.is_convex || !poly_2.is_convex) {
+    return false;
+  }
+  return hasSeparatingEdge(poly_1.polygon, poly_2.polygon) ||
+         hasSeparatingEdge(poly_2.polygon, poly_1.polygon);
+}
+}  // namespace
+
+PolygonWithBoundingBox createPolygonWithBoundingBox(const Polygon2d & polygon)
+{
+  return PolygonWithBoundingBox{
+    polygon, bg::return_envelope<Box2d>(polygon.outer()), isConvex(polygon)};
+}
+
+bool checkPolygonsOverlaps(
+  const PolygonWithBoundingBox & poly_1, const PolygonWithBoundingBox & poly_2)
+{
+  return !isSeparated(poly_1, poly_2) && bg::overlaps(poly_1.polygon, poly_2.polygon);
+}
+
+bool checkPolygonsIntersects(
+  const PolygonWithBoundingBox & poly_1, const PolygonWithBoundingBox & poly_2)
+{
+  return !isSeparated(poly_1, poly_2) && bg::intersects(poly_1.polygon, poly_2.polygon);
+}
+
+EgoPredictedFootprints::EgoPredictedFootprints(
+  const std::vector<PoseWithVelocityStamped> & predicted_path, const VehicleInfo & vehicle_info)
+: predicted_path_(predicted_path), vehicle_info_(vehicle_info)
+{
+}
+
+const std::optional<EgoPredictedFootprints::Footprint> & EgoPredictedFootprints::getFootprint(
+  const double time)
+{
+  if (const auto itr = footprints_.find(time); itr != footprints_.end()) {
+    return itr->second;
+  }
+
+  std::optional<Footprint> footprint{};
+  const auto interpolated_data =
+    getInterpolatedPoseWithVelocityAndPolygonStamped(predicted_path_, time, vehicle_info_);
+  if (interpolated_data) {
+    footprint = Footprint{
+      PoseWithVelocityStamped{time, interpolated_data->pose, interpolated_data->velocity},
+      interpolated_data->poly_with_box};
+  }
+  return footprints_.emplace(time, std::move(footprint)).first->second;
+}
+
 void appendPointToPolygon(Polygon2d & polygon, const geometry_msgs::msg::Point & geom_point)
 {
   Point2d point;
@@ -107,21 +271,15 @@ Polygon2d createExtendedPolygon(
     debug.lat_offset = lat_offset;
   }
 
-  const auto p1 =
-    tier4_autoware_utils::calcOffsetPose(base_link_pose, forward_lon_offset, lat_offset, 0.0);
-  const auto p2 =
-    tier4_autoware_utils::calcOffsetPose(base_link_pose, forward_lon_offset, -lat_offset, 0.0);
-  const auto p3 =
-    tier4_autoware_utils::calcOffsetPose(base_link_pose, backward_lon_offset, -lat_offset, 0.0);
-  const auto p4 =
-    tier4_autoware_utils::calcOffsetPose(base_link_pose, backward_lon_offset, lat_offset, 0.0);
+  const PoseOffset offset(base_link_pose);
+  const auto p1 = offset(forward_lon_offset, lat_offset);
 
   Polygon2d polygon;
-  appendPointToPolygon(polygon, p1.position);
-  appendPointToPolygon(polygon, p2.position);
-  appendPointToPolygon(polygon, p3.position);
-  appendPointToPolygon(polygon, p4.position);
-  appendPointToPolygon(polygon, p1.position);
+  bg::append(polygon.outer(), p1);
+  bg::append(polygon.outer(), offset(forward_lon_offset, -lat_offset));
+  bg::append(polygon.outer(), offset(backward_lon_offset, -lat_offset));
+  bg::append(polygon.outer(), offset(backward_lon_offset, lat_offset));
+  bg::append(polygon.outer(), p1);
   return tier4_autoware_utils::isClockwise(polygon)
            ? polygon
            : tier4_autoware_utils::inverseClockwise(polygon);
@@ -164,21 +322,15 @@ Polygon2d createExtendedPolygon(
     debug.lat_offset = std::max(std::abs(left_lat_offset), std::abs(right_lat_offset));
   }
 
-  const auto p1 =
-    tier4_autoware_utils::calcOffsetPose(obj_pose, forward_lon_offset, left_lat_offset, 0.0);
-  const auto p2 =
-    tier4_autoware_utils::calcOffsetPose(obj_pose, forward_lon_offset, right_lat_offset, 0.0);
-  const auto p3 =
-    tier4_autoware_utils::calcOffsetPose(obj_pose, backward_lon_offset, right_lat_offset, 0.0);
-  const auto p4 =
-    tier4_autoware_utils::calcOffsetPose(obj_pose, backward_lon_offset, left_lat_offset, 0.0);
+  const PoseOffset offset(obj_pose);
+  const auto p1 = offset(forward_lon_offset, left_lat_offset);
 
   Polygon2d polygon;
-  appendPointToPolygon(polygon, p1.position);
-  appendPointToPolygon(polygon, p2.position);
-  appendPointToPolygon(polygon, p3.position);
-  appendPointToPolygon(polygon, p4.position);
-  appendPointToPolygon(polygon, p1.position);
+  bg::append(polygon.outer(), p1);
+  bg::append(polygon.outer(), offset(forward_lon_offset, right_lat_offset));
+  bg::append(polygon.outer(), offset(backward_lon_offset, right_lat_offset));
+  bg::append(polygon.outer(), offset(backward_lon_offset, left_lat_offset));
+  bg::append(polygon.outer(), p1);
   return tier4_autoware_utils::isClockwise(polygon)
            ? polygon
            : tier4_autoware_utils::inverseClockwise(polygon);
@@ -481,6 +633,8 @@ bool checkSafetyWithRSS(
   const BehaviorPathPlannerParameters & parameters, const RSSparams & rss_params,
   const bool check_all_predicted_path, const double hysteresis_factor)
 {
+  EgoPredictedFootprints ego_footprints(ego_predicted_path, parameters.vehicle_info);
+
   // Check for collisions with each predicted path of the object
   const bool is_safe = !std::any_of(objects.begin(), objects.end(), [&](const auto & object) {
     auto current_debug_data = utils::path_safety_checker::createObjectDebug(object);
@@ -491,8 +645,8 @@ bool checkSafetyWithRSS(
     return std::any_of(
       obj_predicted_paths.begin(), obj_predicted_paths.end(), [&](const auto & obj_path) {
         const bool has_collision = !utils::path_safety_checker::checkCollision(
-          planned_path, ego_predicted_path, object, obj_path, parameters, rss_params,
-          hysteresis_factor, current_debug_data.second);
+          planned_path, ego_footprints, object, obj_path, parameters, rss_params, hysteresis_factor,
+          current_debug_data.second);
 
         utils::path_safety_checker::updateCollisionCheckDebugMap(
           debug_map, current_debug_data, !has_collision);
@@ -530,14 +684,15 @@ bool checkSafetyWithIntegralPredictedPolygon(
   }
 
   // check collision
+  const auto ego_integral_polygon_with_box = createPolygonWithBoundingBox(ego_integral_polygon);
   for (const auto & object : filtered_path_objects) {
     CollisionCheckDebugPair debug_pair = createObjectDebug(object);
     for (const auto & path : object.predicted_paths) {
       for (const auto & pose_with_poly : path.path) {
-        if (boost::geometry::overlaps(ego_integral_polygon, pose_with_poly.poly)) {
+        if (checkPolygonsOverlaps(ego_integral_polygon_with_box, pose_with_poly.poly_with_box)) {
           debug_pair.second.ego_predicted_path = ego_predicted_path;  // raw path
           debug_pair.second.obj_predicted_path = path.path;           // raw path
-          debug_pair.second.extended_obj_polygon = pose_with_poly.poly;
+          debug_pair.second.extended_obj_polygon = pose_with_poly.poly_with_box.polygon;
           debug_pair.second.extended_ego_polygon =
             ego_integral_polygon;  // time filtered extended polygon
           updateCollisionCheckDebugMap(debug_map, debug_pair, /*is_safe=*/false);
@@ -564,16 +719,42 @@ bool checkCollision(
   return collided_polygons.empty();
 }
 
+bool checkCollision(
+  const PathWithLaneId & planned_path, EgoPredictedFootprints & ego_footprints,
+  const ExtendedPredictedObject & target_object,
+  const PredictedPathWithPolygon & target_object_path,
+  const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
+  const double hysteresis_factor, CollisionCheckDebug & debug)
+{
+  const auto collided_polygons = getCollidedPolygons(
+    planned_path, ego_footprints, target_object, target_object_path, common_parameters,
+    rss_parameters, hysteresis_factor, debug);
+  return collided_polygons.empty();
+}
+
 std::vector<Polygon2d> getCollidedPolygons(
-  [[maybe_unused]] const PathWithLaneId & planned_path,
+  const PathWithLaneId & planned_path,
   const std::vector<PoseWithVelocityStamped> & predicted_ego_path,
   const ExtendedPredictedObject & target_object,
   const PredictedPathWithPolygon & target_object_path,
   const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
   double hysteresis_factor, CollisionCheckDebug & debug)
+{
+  EgoPredictedFootprints ego_footprints(predicted_ego_path, common_parameters.vehicle_info);
+  return getCollidedPolygons(
+    planned_path, ego_footprints, target_object, target_object_path, common_parameters,
+    rss_parameters, hysteresis_factor, debug);
+}
+
+std::vector<Polygon2d> getCollidedPolygons(
+  [[maybe_unused]] const PathWithLaneId & planned_path, EgoPredictedFootprints & ego_footprints,
+  const ExtendedPredictedObject & target_object,
+  const PredictedPathWithPolygon & target_object_path,
+  const BehaviorPathPlannerParameters & common_parameters, const RSSparams & rss_parameters,
+  double hysteresis_factor, CollisionCheckDebug & debug)
 {
   {
-    debug.ego_predicted_path = predicted_ego_path;
+    debug.ego_predicted_path = ego_footprints.getPredictedPath();
     debug.obj_predicted_path = target_object_path.path;
     debug.current_obj_pose = target_object.initial_pose.pose;
   }
@@ -585,24 +766,22 @@ std::vector<Polygon2d> getCollidedPolygons(
 
     // get object information at current time
     const auto & obj_pose = obj_pose_with_poly.pose;
-    const auto & obj_polygon = obj_pose_with_poly.poly;
+    const auto & obj_polygon_with_box = obj_pose_with_poly.poly_with_box;
+    const auto & obj_polygon = obj_polygon_with_box.polygon;
     const auto & object_velocity = obj_pose_with_poly.velocity;
 
-    // get ego information at current time
-    // Note: we can create these polygons in advance. However, it can decrease the readability and
-    // variability
+    // get ego information at current time, which is shared with the other objects
     const auto & ego_vehicle_info = common_parameters.vehicle_info;
-    const auto interpolated_data = getInterpolatedPoseWithVelocityAndPolygonStamped(
-      predicted_ego_path, current_time, ego_vehicle_info);
-    if (!interpolated_data) {
+    const auto & ego_footprint = ego_footprints.getFootprint(current_time);
+    if (!ego_footprint) {
       continue;
     }
-    const auto & ego_pose = interpolated_data->pose;
-    const auto & ego_polygon = interpolated_data->poly;
-    const auto & ego_velocity = interpolated_data->velocity;
+    const auto & ego_pose = ego_footprint->pose_with_velocity.pose;
+    const auto & ego_polygon = ego_footprint->polygon.polygon;
+    const auto & ego_velocity = ego_footprint->pose_with_velocity.velocity;
 
     // check overlap
-    if (boost::geometry::overlaps(ego_polygon, obj_polygon)) {
+    if (checkPolygonsOverlaps(ego_footprint->polygon, obj_polygon_with_box)) {
       debug.unsafe_reason = "overlap_polygon";
       collided_polygons.push_back(obj_polygon);
 
@@ -656,7 +835,11 @@ std::vector<Polygon2d> getCollidedPolygons(
             obj_pose, target_object.shape, lon_offset, lat_margin, is_stopped_object, debug);
 
     // check overlap with extended polygon
-    if (boost::geometry::overlaps(extended_ego_polygon, extended_obj_polygon)) {
+    const auto extended_ego_polygon_with_box =
+      is_object_front ? createPolygonWithBoundingBox(extended_ego_polygon) : ego_footprint->polygon;
+    const auto extended_obj_polygon_with_box =
+      is_object_front ? obj_polygon_with_box : createPolygonWithBoundingBox(extended_obj_polygon);
+    if (checkPolygonsOverlaps(extended_ego_polygon_with_box, extended_obj_polygon_with_box)) {
       debug.unsafe_reason = "overlap_extended_polygon";
       collided_polygons.push_back(obj_polygon);
 
@@ -674,9 +857,16 @@ std::vector<Polygon2d> getCollidedPolygons(
 bool checkPolygonsIntersects(
   const std::vector<Polygon2d> & polys_1, const std::vector<Polygon2d> & polys_2)
 {
+  std::vector<PolygonWithBoundingBox> polys_with_box_2;
+  polys_with_box_2.reserve(polys_2.size());
+  for (const auto & poly_2 : polys_2) {
+    polys_with_box_2.push_back(createPolygonWithBoundingBox(poly_2));
+  }
+
   for (const auto & poly_1 : polys_1) {
-    for (const auto & poly_2 : polys_2) {
-      if (boost::geometry::intersects(poly_1, poly_2)) {
+    const auto poly_with_box_1 = createPolygonWithBoundingBox(poly_1);
+    for (const auto & poly_with_box_2 : polys_with_box_2) {
+      if (checkPolygonsIntersects(poly_with_box_1, poly_with_box_2)) {
         return true;
       }
     }
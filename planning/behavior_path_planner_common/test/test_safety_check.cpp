@@ -16,6 +16,7 @@
 #include "behavior_path_planner_common/utils/path_safety_checker/path_safety_checker_parameters.hpp"
 #include "behavior_path_planner_common/utils/path_safety_checker/safety_check.hpp"
 
+#include <tier4_autoware_utils/geometry/boost_polygon_utils.hpp>
 #include <tier4_autoware_utils/math/unit_conversion.hpp>
 
 #include <geometry_msgs/msg/pose.hpp>
@@ -25,6 +26,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 constexpr double epsilon = 1e-6;
 
 using autoware_auto_perception_msgs::msg::Shape;
@@ -201,3 +204,83 @@ TEST(BehaviorPathPlanningSafetyUtilsTest, calcRssDistance)
     EXPECT_NEAR(calcRssDistance(front_vel, rear_vel, params), 63.75, epsilon);
   }
 }
+
+TEST(BehaviorPathPlanningSafetyUtilsTest, checkPolygonsOverlapsWithBoundingBox)
+{
+  using behavior_path_planner::utils::path_safety_checker::checkPolygonsIntersects;
+  using behavior_path_planner::utils::path_safety_checker::checkPolygonsOverlaps;
+  using behavior_path_planner::utils::path_safety_checker::createPolygonWithBoundingBox;
+  using tier4_autoware_utils::createPoint;
+  using tier4_autoware_utils::createQuaternionFromYaw;
+
+  Pose ego_pose;
+  ego_pose.position = createPoint(0.0, 0.0, 0.0);
+  ego_pose.orientation = createQuaternionFromYaw(0.3);
+  const auto ego_polygon = tier4_autoware_utils::toFootprint(ego_pose, 4.0, 1.0, 2.0);
+  const auto ego_polygon_with_box = createPolygonWithBoundingBox(ego_polygon);
+  EXPECT_TRUE(ego_polygon_with_box.is_convex);
+
+  // the results are the same as boost for the apart, touching, crossing and contained polygons
+  for (double x = -8.0; x <= 8.0; x += 0.5) {
+    for (double y = -5.0; y <= 5.0; y += 0.5) {
+      for (const double yaw : {0.0, 0.3, 1.2}) {
+        for (const double size : {0.5, 2.0, 20.0}) {
+          Pose obj_pose;
+          obj_pose.position = createPoint(x, y, 0.0);
+          obj_pose.orientation = createQuaternionFromYaw(yaw);
+          const auto obj_polygon =
+            tier4_autoware_utils::toFootprint(obj_pose, size / 2.0, size / 2.0, size);
+          const auto obj_polygon_with_box = createPolygonWithBoundingBox(obj_polygon);
+
+          EXPECT_EQ(
+            checkPolygonsOverlaps(ego_polygon_with_box, obj_polygon_with_box),
+            boost::geometry::overlaps(ego_polygon, obj_polygon));
+          EXPECT_EQ(
+            checkPolygonsIntersects(ego_polygon_with_box, obj_polygon_with_box),
+            boost::geometry::intersects(ego_polygon, obj_polygon));
+        }
+      }
+    }
+  }
+}
+
+TEST(BehaviorPathPlanningSafetyUtilsTest, egoPredictedFootprints)
+{
+  using behavior_path_planner::utils::path_safety_checker::EgoPredictedFootprints;
+  using behavior_path_planner::utils::path_safety_checker::
+    getInterpolatedPoseWithVelocityAndPolygonStamped;
+  using behavior_path_planner::utils::path_safety_checker::PoseWithVelocityStamped;
+  using tier4_autoware_utils::createPoint;
+  using tier4_autoware_utils::createQuaternionFromYaw;
+
+  vehicle_info_util::VehicleInfo vehicle_info;
+  vehicle_info.max_longitudinal_offset_m = 4.0;
+  vehicle_info.vehicle_width_m = 2.0;
+  vehicle_info.rear_overhang_m = 1.0;
+
+  std::vector<PoseWithVelocityStamped> predicted_path;
+  for (size_t i = 0; i < 10; ++i) {
+    Pose pose;
+    pose.position = createPoint(2.0 * i, 0.1 * i * i, 0.0);
+    pose.orientation = createQuaternionFromYaw(0.1 * i);
+    predicted_path.emplace_back(0.5 * i, pose, 4.0 + 0.1 * i);
+  }
+
+  EgoPredictedFootprints ego_footprints(predicted_path, vehicle_info);
+  for (const double time : {0.0, 0.25, 1.3, 0.25, 4.5}) {
+    const auto expected =
+      getInterpolatedPoseWithVelocityAndPolygonStamped(predicted_path, time, vehicle_info);
+    const auto & footprint = ego_footprints.getFootprint(time);
+    ASSERT_TRUE(expected);
+    ASSERT_TRUE(footprint);
+    EXPECT_NEAR(footprint->pose_with_velocity.velocity, expected->velocity, epsilon);
+    EXPECT_NEAR(footprint->pose_with_velocity.pose.position.x, expected->pose.position.x, epsilon);
+    EXPECT_NEAR(footprint->pose_with_velocity.pose.position.y, expected->pose.position.y, epsilon);
+    EXPECT_TRUE(
+      boost::geometry::equals(footprint->polygon.polygon, expected->poly_with_box.polygon));
+  }
+
+  // out of the predicted path
+  EXPECT_FALSE(ego_footprints.getFootprint(-1.0));
+  EXPECT_FALSE(ego_footprints.getFootprint(10.0));
+}
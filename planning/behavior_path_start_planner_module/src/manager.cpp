@@ -150,6 +150,8 @@ void StartPlannerModuleManager::init(rclcpp::Node * node)
     p.astar_parameters.use_back = node->declare_parameter<bool>(ns + "use_back");
     p.astar_parameters.distance_heuristic_weight =
       node->declare_parameter<double>(ns + "distance_heuristic_weight");
+    p.astar_parameters.use_obstacle_heuristic =
+      node->declare_parameter<bool>(ns + "use_obstacle_heuristic");
   }
   //   freespace planner rrtstar
   {
@@ -469,6 +471,8 @@ void StartPlannerModuleManager::updateModuleParams(
       parameters, ns + "only_behind_solutions", p->astar_parameters.only_behind_solutions);
     updateParam<double>(
       parameters, ns + "distance_heuristic_weight", p->astar_parameters.distance_heuristic_weight);
+    updateParam<bool>(
+      parameters, ns + "use_obstacle_heuristic", p->astar_parameters.use_obstacle_heuristic);
   }
   {
     const std::string ns = "start_planner.freespace_planner.rrtstar.";
@@ -149,6 +149,8 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
   // is simulation or not
   planner_data_.is_simulation = declare_parameter<bool>("is_simulation");
 
+  planner_manager_.setSceneModuleThreadNum(declare_parameter<int>("scene_module_thread_num"));
+
   // Initialize PlannerManager
   for (const auto & name : declare_parameter<std::vector<std::string>>("launch_modules")) {
     // workaround: Since ROS 2 can't get empty list, launcher set [''] on the parameter.
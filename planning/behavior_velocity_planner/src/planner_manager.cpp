@@ -16,8 +16,13 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -96,6 +101,13 @@ void BehaviorVelocityPlannerManager::removeScenePlugin(
   }
 }
 
+void BehaviorVelocityPlannerManager::setSceneModuleThreadNum(const int thread_num)
+{
+  scene_module_thread_num_ = thread_num;
+  worker_pool_ =
+    std::make_unique<tier4_autoware_utils::WorkerPool>(static_cast<size_t>(std::max(thread_num, 1)));
+}
+
 autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager::planPathVelocity(
   const std::shared_ptr<const PlannerData> & planner_data,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
@@ -105,9 +117,42 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   int first_stop_path_point_index = static_cast<int>(output_path_msg.points.size() - 1);
   std::string stop_reason_msg("path_end");
 
+  // the plugins supporting the two-phase execution analyze the input path in parallel first, and
+  // their results are applied in the order of the plugins below
+  std::vector<std::shared_ptr<PluginInterface>> two_phase_plugins;
+  if (scene_module_thread_num_ > 1) {
+    for (const auto & plugin : scene_manager_plugins_) {
+      if (plugin->isTwoPhaseSupported()) {
+        plugin->updateSceneModuleInstances(planner_data, input_path_msg);
+        two_phase_plugins.push_back(plugin);
+      }
+    }
+    // centerlines of the lanelets are lazily computed and cached without lock
+    if (two_phase_plugins.size() > 1 && planner_data->route_handler_) {
+      std::set<int64_t> lane_ids;
+      for (const auto & p : input_path_msg.points) {
+        lane_ids.insert(p.lane_ids.begin(), p.lane_ids.end());
+      }
+      const auto & lanelet_layer = planner_data->route_handler_->getLaneletMapPtr()->laneletLayer;
+      for (const auto lane_id : lane_ids) {
+        const auto lanelet = lanelet_layer.find(lane_id);
+        if (lanelet != lanelet_layer.end()) {
+          lanelet->centerline();
+        }
+      }
+    }
+    analyzeScenePlugins(two_phase_plugins, input_path_msg);
+  }
+
   for (const auto & plugin : scene_manager_plugins_) {
-    plugin->updateSceneModuleInstances(planner_data, input_path_msg);
-    plugin->plan(&output_path_msg);
+    if (
+      std::find(two_phase_plugins.begin(), two_phase_plugins.end(), plugin) !=
+      two_phase_plugins.end()) {
+      plugin->apply(&output_path_msg);
+    } else {
+      plugin->updateSceneModuleInstances(planner_data, input_path_msg);
+      plugin->plan(&output_path_msg);
+    }
     const auto firstStopPathPointIndex = plugin->getFirstStopPathPointIndex();
 
     if (firstStopPathPointIndex) {
@@ -124,6 +169,36 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   return output_path_msg;
 }
 
+void BehaviorVelocityPlannerManager::analyzeScenePlugins(
+  const std::vector<std::shared_ptr<PluginInterface>> & plugins,
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
+{
+  std::vector<std::exception_ptr> exceptions(plugins.size());
+  std::atomic<size_t> next_plugin_idx{0};
+  const auto analyze = [&]() {
+    for (size_t i = next_plugin_idx++; i < plugins.size(); i = next_plugin_idx++) {
+      try {
+        plugins.at(i)->analyze(input_path_msg);
+      } catch (...) {
+        exceptions.at(i) = std::current_exception();
+      }
+    }
+  };
+
+  // the threads of the pool are kept between the cycles, and the calling thread is one of them
+  if (worker_pool_ && plugins.size() > 1) {
+    worker_pool_->run([&](const size_t /*worker_index*/) { analyze(); });
+  } else {
+    analyze();
+  }
+
+  for (const auto & exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
 diagnostic_msgs::msg::DiagnosticStatus BehaviorVelocityPlannerManager::getStopReasonDiag() const
 {
   return stop_reason_diag_;
@@ -19,6 +19,7 @@
 #include <behavior_velocity_planner_common/plugin_wrapper.hpp>
 #include <pluginlib/class_loader.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/system/worker_pool.hpp>
 
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -44,6 +45,7 @@ public:
   BehaviorVelocityPlannerManager();
   void launchScenePlugin(rclcpp::Node & node, const std::string & name);
   void removeScenePlugin(rclcpp::Node & node, const std::string & name);
+  void setSceneModuleThreadNum(const int thread_num);
 
   autoware_auto_planning_msgs::msg::PathWithLaneId planPathVelocity(
     const std::shared_ptr<const PlannerData> & planner_data,
@@ -52,6 +54,13 @@ public:
   diagnostic_msgs::msg::DiagnosticStatus getStopReasonDiag() const;
 
 private:
+  void analyzeScenePlugins(
+    const std::vector<std::shared_ptr<PluginInterface>> & plugins,
+    const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg);
+
+  // the plugins supporting the two-phase execution analyze the path in parallel if more than one
+  int scene_module_thread_num_{1};
+  std::unique_ptr<tier4_autoware_utils::WorkerPool> worker_pool_;
   diagnostic_msgs::msg::DiagnosticStatus stop_reason_diag_;
   pluginlib::ClassLoader<PluginInterface> plugin_loader_;
   std::vector<std::shared_ptr<PluginInterface>> scene_manager_plugins_;
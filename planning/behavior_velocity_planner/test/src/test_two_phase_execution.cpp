@@ -0,0 +1,200 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "planner_manager.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <lanelet2_extension/regulatory_elements/speed_bump.hpp>
+#include <lanelet2_extension/utility/message_conversion.hpp>
+#include <lanelet2_extension/utility/utilities.hpp>
+#include <planning_test_utils/planning_interface_test_manager_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/RegulatoryElement.h>
+#include <lanelet2_core/primitives/TrafficSign.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using autoware_auto_planning_msgs::msg::PathWithLaneId;
+using behavior_velocity_planner::BehaviorVelocityPlannerManager;
+using behavior_velocity_planner::PlannerData;
+
+namespace
+{
+constexpr lanelet::Id lane_id = 1000;
+
+// a straight lane along the x axis with a stop sign at x = 40 and a speed bump at x = 60
+lanelet::LaneletMapPtr createMap()
+{
+  const auto create_line = [](const double x0, const double y0, const double x1, const double y1) {
+    return lanelet::LineString3d(
+      lanelet::utils::getId(), {lanelet::Point3d(lanelet::utils::getId(), x0, y0, 0.0),
+                                lanelet::Point3d(lanelet::utils::getId(), x1, y1, 0.0)});
+  };
+
+  lanelet::Lanelet lanelet(
+    lane_id, create_line(0.0, 1.5, 100.0, 1.5), create_line(0.0, -1.5, 100.0, -1.5));
+  lanelet.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+
+  auto stop_line = create_line(40.0, -1.5, 40.0, 1.5);
+  stop_line.attributes()[lanelet::AttributeName::Type] = "stop_line";
+  auto stop_sign = create_line(40.0, 2.0, 40.0, 2.5);
+  stop_sign.attributes()[lanelet::AttributeName::Type] = "traffic_sign";
+  stop_sign.attributes()[lanelet::AttributeName::Subtype] = "stop_sign";
+  lanelet.addRegulatoryElement(lanelet::TrafficSign::make(
+    lanelet::utils::getId(), {}, lanelet::TrafficSignsWithType{{stop_sign}, "stop_sign"}, {},
+    {stop_line}));
+
+  lanelet::Polygon3d speed_bump(
+    lanelet::utils::getId(), {lanelet::Point3d(lanelet::utils::getId(), 60.0, -1.5, 0.0),
+                              lanelet::Point3d(lanelet::utils::getId(), 62.0, -1.5, 0.0),
+                              lanelet::Point3d(lanelet::utils::getId(), 62.0, 1.5, 0.0),
+                              lanelet::Point3d(lanelet::utils::getId(), 60.0, 1.5, 0.0)});
+  speed_bump.attributes()[lanelet::AttributeName::Type] = "speed_bump";
+  speed_bump.attributes()["height"] = 0.15;
+  lanelet.addRegulatoryElement(
+    lanelet::autoware::SpeedBump::make(lanelet::utils::getId(), {}, speed_bump));
+
+  return lanelet::utils::createMap({lanelet});
+}
+
+PathWithLaneId createPath()
+{
+  PathWithLaneId path;
+  path.header.frame_id = "map";
+  for (double x = 0.0; x <= 100.0; x += 1.0) {
+    autoware_auto_planning_msgs::msg::PathPointWithLaneId p;
+    p.point.pose = test_utils::createPose(x, 0.0, 0.0, 0.0, 0.0, 0.0);
+    p.point.longitudinal_velocity_mps = 10.0;
+    p.lane_ids.push_back(lane_id);
+    path.points.push_back(p);
+  }
+  return path;
+}
+
+std::shared_ptr<rclcpp::Node> generateNode(const std::string & name)
+{
+  auto node_options = rclcpp::NodeOptions{};
+
+  const auto planning_test_utils_dir =
+    ament_index_cpp::get_package_share_directory("planning_test_utils");
+  const auto behavior_velocity_planner_dir =
+    ament_index_cpp::get_package_share_directory("behavior_velocity_planner");
+  const auto get_behavior_velocity_module_config = [](const std::string & module) {
+    const auto package_name = "behavior_velocity_" + module + "_module";
+    const auto package_path = ament_index_cpp::get_package_share_directory(package_name);
+    return package_path + "/config/" + module + ".param.yaml";
+  };
+
+  test_utils::updateNodeOptions(
+    node_options, {planning_test_utils_dir + "/config/test_vehicle_info.param.yaml",
+                   behavior_velocity_planner_dir + "/config/behavior_velocity_planner.param.yaml",
+                   get_behavior_velocity_module_config("speed_bump"),
+                   get_behavior_velocity_module_config("stop_line")});
+
+  // the scene module managers declare their parameters, so each planner manager needs its node
+  return std::make_shared<rclcpp::Node>(name, node_options);
+}
+}  // namespace
+
+TEST(BehaviorVelocityPlannerManager, TwoPhaseExecutionMatchesSerialExecution)
+{
+  rclcpp::init(0, nullptr);
+
+  const auto map_ptr = createMap();
+  autoware_auto_mapping_msgs::msg::HADMapBin map_msg;
+  map_msg.header.frame_id = "map";
+  lanelet::utils::conversion::toBinMsg(map_ptr, &map_msg);
+
+  const auto serial_node = generateNode("serial_planner");
+  const auto parallel_node = generateNode("parallel_planner");
+
+  // PlannerData declares its parameters, so it is created once per node and updated every cycle
+  const auto create_planner_data = [&](rclcpp::Node & node) {
+    auto planner_data = std::make_shared<PlannerData>(node);
+    planner_data->route_handler_ = std::make_shared<route_handler::RouteHandler>(map_msg);
+    planner_data->stop_line_extend_length =
+      node.declare_parameter<double>("stop_line_extend_length");
+    planner_data->ego_nearest_dist_threshold = 3.0;
+    planner_data->ego_nearest_yaw_threshold = 1.046;
+    return planner_data;
+  };
+  const auto update_ego_state = [](rclcpp::Node & node, PlannerData & planner_data, double x) {
+    auto odometry = std::make_shared<geometry_msgs::msg::PoseStamped>();
+    odometry->header.frame_id = "map";
+    odometry->header.stamp = node.now();
+    odometry->pose = test_utils::createPose(x, 0.0, 0.0, 0.0, 0.0, 0.0);
+    planner_data.current_odometry = odometry;
+
+    auto velocity = std::make_shared<geometry_msgs::msg::TwistStamped>();
+    velocity->header = odometry->header;
+    velocity->twist.linear.x = 5.0;
+    planner_data.current_velocity = velocity;
+    planner_data.velocity_buffer.push_front(*velocity);
+  };
+  const auto serial_planner_data = create_planner_data(*serial_node);
+  const auto parallel_planner_data = create_planner_data(*parallel_node);
+
+  BehaviorVelocityPlannerManager serial_manager;
+  BehaviorVelocityPlannerManager parallel_manager;
+  parallel_manager.setSceneModuleThreadNum(2);
+  for (const auto & name :
+       {"behavior_velocity_planner::StopLineModulePlugin",
+        "behavior_velocity_planner::SpeedBumpModulePlugin"}) {
+    serial_manager.launchScenePlugin(*serial_node, name);
+    parallel_manager.launchScenePlugin(*parallel_node, name);
+  }
+
+  const auto input_path = createPath();
+
+  // several cycles, so that the worker pool is reused and the scene modules keep their state
+  for (const double ego_x : {5.0, 10.0, 15.0}) {
+    update_ego_state(*serial_node, *serial_planner_data, ego_x);
+    update_ego_state(*parallel_node, *parallel_planner_data, ego_x);
+    const auto serial_path = serial_manager.planPathVelocity(serial_planner_data, input_path);
+    const auto parallel_path = parallel_manager.planPathVelocity(parallel_planner_data, input_path);
+
+    ASSERT_EQ(serial_path.points.size(), parallel_path.points.size());
+    bool has_stop = false;
+    bool has_slow_down = false;
+    for (size_t i = 0; i < serial_path.points.size(); ++i) {
+      const auto & serial_point = serial_path.points.at(i).point;
+      const auto & parallel_point = parallel_path.points.at(i).point;
+      EXPECT_DOUBLE_EQ(serial_point.pose.position.x, parallel_point.pose.position.x);
+      EXPECT_DOUBLE_EQ(serial_point.pose.position.y, parallel_point.pose.position.y);
+      EXPECT_FLOAT_EQ(
+        serial_point.longitudinal_velocity_mps, parallel_point.longitudinal_velocity_mps);
+      const double velocity = serial_point.longitudinal_velocity_mps;
+      has_stop |= velocity == 0.0;
+      has_slow_down |= 0.0 < velocity && velocity < 10.0;
+    }
+    EXPECT_TRUE(has_stop);
+    EXPECT_TRUE(has_slow_down);
+
+    // the first stop index is reported with its module name and pose
+    const auto serial_diag = serial_manager.getStopReasonDiag();
+    const auto parallel_diag = parallel_manager.getStopReasonDiag();
+    EXPECT_EQ(serial_diag.message, parallel_diag.message);
+    EXPECT_EQ(serial_diag.message, "stop_line");
+    ASSERT_EQ(serial_diag.values.size(), parallel_diag.values.size());
+    for (size_t i = 0; i < serial_diag.values.size(); ++i) {
+      EXPECT_EQ(serial_diag.values.at(i).value, parallel_diag.values.at(i).value);
+    }
+  }
+
+  rclcpp::shutdown();
+}
@@ -36,6 +36,11 @@ public:
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path) = 0;
   virtual std::optional<int> getFirstStopPathPointIndex() = 0;
   virtual const char * getModuleName() = 0;
+  // two-phase execution: analyze() can be run in parallel with the other plugins on the input
+  // path, and apply() merges its result to the output path in the order of the plugins
+  virtual bool isTwoPhaseSupported() = 0;
+  virtual void analyze(const autoware_auto_planning_msgs::msg::PathWithLaneId & path) = 0;
+  virtual void apply(autoware_auto_planning_msgs::msg::PathWithLaneId * path) = 0;
 };
 
 }  // namespace behavior_velocity_planner
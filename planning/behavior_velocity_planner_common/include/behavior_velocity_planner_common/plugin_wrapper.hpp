@@ -43,6 +43,15 @@ public:
     return scene_manager_->getFirstStopPathPointIndex();
   }
   const char * getModuleName() override { return scene_manager_->getModuleName(); }
+  bool isTwoPhaseSupported() override { return scene_manager_->isTwoPhaseSupported(); }
+  void analyze(const autoware_auto_planning_msgs::msg::PathWithLaneId & path) override
+  {
+    scene_manager_->analyze(path);
+  }
+  void apply(autoware_auto_planning_msgs::msg::PathWithLaneId * path) override
+  {
+    scene_manager_->apply(path);
+  }
 
 private:
   std::unique_ptr<T> scene_manager_;
@@ -16,6 +16,7 @@
 #define BEHAVIOR_VELOCITY_PLANNER_COMMON__SCENE_MODULE_INTERFACE_HPP_
 
 #include <behavior_velocity_planner_common/planner_data.hpp>
+#include <behavior_velocity_planner_common/utilization/util.hpp>
 #include <behavior_velocity_planner_common/velocity_factor_interface.hpp>
 #include <builtin_interfaces/msg/time.hpp>
 #include <motion_utils/marker/virtual_wall_marker_creator.hpp>
@@ -170,9 +171,42 @@ public:
     modifyPathVelocity(path);
   }
 
+  /**
+   * @brief Whether the manager supports the two-phase execution of analyze() and apply() instead
+   *        of plan(). The scene modules of such a manager must only insert points to the path and
+   *        lower the velocity, and must not depend on the path modified by the other managers.
+   */
+  virtual bool isTwoPhaseSupported() const { return false; }
+
+  /**
+   * @brief Run the scene modules on a copy of the input path and keep the velocity constraints.
+   *        This can be called in parallel with the other managers.
+   */
+  virtual void analyze(const autoware_auto_planning_msgs::msg::PathWithLaneId & path);
+
+  /**
+   * @brief Apply the velocity constraints of analyze() to the path and publish the outputs.
+   */
+  virtual void apply(autoware_auto_planning_msgs::msg::PathWithLaneId * path);
+
 protected:
+  struct SceneModuleOutputs
+  {
+    visualization_msgs::msg::MarkerArray debug_marker_array;
+    tier4_planning_msgs::msg::StopReasonArray stop_reason_array;
+    autoware_adapi_v1_msgs::msg::VelocityFactorArray velocity_factor_array;
+    tier4_v2x_msgs::msg::InfrastructureCommandArray infrastructure_command_array;
+  };
+
   virtual void modifyPathVelocity(autoware_auto_planning_msgs::msg::PathWithLaneId * path);
 
+  void runSceneModules(
+    autoware_auto_planning_msgs::msg::PathWithLaneId * path, SceneModuleOutputs & outputs);
+
+  void publishSceneModuleOutputs(
+    const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
+    const SceneModuleOutputs & outputs);
+
   virtual void launchNewModules(const autoware_auto_planning_msgs::msg::PathWithLaneId & path) = 0;
 
   virtual std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
@@ -199,6 +233,12 @@ protected:
   motion_utils::VirtualWallMarkerCreator virtual_wall_marker_creator_;
 
   std::optional<int> first_stop_path_point_index_;
+
+  // result of analyze() to be applied
+  std::vector<VelocityConstraint> velocity_constraints_;
+  SceneModuleOutputs analyzed_outputs_;
+  double analysis_time_ms_{0.0};
+
   rclcpp::Node & node_;
   rclcpp::Clock::SharedPtr clock_;
   // Debug
@@ -224,6 +264,10 @@ public:
 
   void plan(autoware_auto_planning_msgs::msg::PathWithLaneId * path) override;
 
+  void analyze(const autoware_auto_planning_msgs::msg::PathWithLaneId & path) override;
+
+  void apply(autoware_auto_planning_msgs::msg::PathWithLaneId * path) override;
+
 protected:
   RTCInterface rtc_interface_;
   std::unordered_map<int64_t, UUID> map_uuid_;
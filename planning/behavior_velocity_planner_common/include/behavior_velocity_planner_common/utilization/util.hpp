@@ -56,6 +56,15 @@ struct TrafficSignalStamped
   autoware_perception_msgs::msg::TrafficSignal signal;
 };
 
+// velocity limit on a section of the path, which is from start to end, or to the path end if end
+// is not set
+struct VelocityConstraint
+{
+  geometry_msgs::msg::Point start;
+  std::optional<geometry_msgs::msg::Point> end;
+  double velocity;
+};
+
 using Pose = geometry_msgs::msg::Pose;
 using Point2d = tier4_autoware_utils::Point2d;
 using LineString2d = tier4_autoware_utils::LineString2d;
@@ -219,6 +228,22 @@ std::optional<geometry_msgs::msg::Pose> insertStopPoint(
 std::optional<geometry_msgs::msg::Pose> insertStopPoint(
   const geometry_msgs::msg::Point & stop_point, const size_t stop_seg_idx, PathWithLaneId & output);
 
+/**
+ * @brief calculate the sections of the modified path where the velocity is lower than that of the
+ *        original path. the modified path must be made only by inserting points to the original
+ *        path and by lowering the velocity.
+ */
+std::vector<VelocityConstraint> calcVelocityConstraints(
+  const PathWithLaneId & original_path, const PathWithLaneId & modified_path);
+
+/**
+ * @brief insert the start and end points of the constraints to the path and limit the velocity
+ *        between them.
+ * @return index of the first stop point inserted by the constraints
+ */
+std::optional<size_t> applyVelocityConstraints(
+  const std::vector<VelocityConstraint> & constraints, PathWithLaneId & path);
+
 /*
   @brief return 'associative' lanes in the intersection. 'associative' means that a lane shares same
   or lane-changeable parent lanes with `lane` and has same turn_direction value.
@@ -96,15 +96,54 @@ void SceneModuleManagerInterface::modifyPathVelocity(
 {
   StopWatch<std::chrono::milliseconds> stop_watch;
   stop_watch.tic("Total");
-  visualization_msgs::msg::MarkerArray debug_marker_array;
-  tier4_planning_msgs::msg::StopReasonArray stop_reason_array;
-  autoware_adapi_v1_msgs::msg::VelocityFactorArray velocity_factor_array;
+  SceneModuleOutputs outputs;
+  runSceneModules(path, outputs);
+  publishSceneModuleOutputs(*path, outputs);
+  processing_time_publisher_->publish<Float64Stamped>(
+    std::string(getModuleName()) + "/processing_time_ms", stop_watch.toc("Total"));
+}
+
+void SceneModuleManagerInterface::analyze(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+{
+  StopWatch<std::chrono::milliseconds> stop_watch;
+  stop_watch.tic("Total");
+  auto analyzed_path = path;
+  analyzed_outputs_ = SceneModuleOutputs{};
+  runSceneModules(&analyzed_path, analyzed_outputs_);
+  velocity_constraints_ = planning_utils::calcVelocityConstraints(path, analyzed_path);
+  analysis_time_ms_ = stop_watch.toc("Total");
+}
+
+void SceneModuleManagerInterface::apply(autoware_auto_planning_msgs::msg::PathWithLaneId * path)
+{
+  StopWatch<std::chrono::milliseconds> stop_watch;
+  stop_watch.tic("Total");
+  const auto first_stop_idx =
+    planning_utils::applyVelocityConstraints(velocity_constraints_, *path);
+  first_stop_path_point_index_ = first_stop_idx ? static_cast<int>(*first_stop_idx)
+                                                : static_cast<int>(path->points.size()) - 1;
+  publishSceneModuleOutputs(*path, analyzed_outputs_);
+  const double apply_time_ms = stop_watch.toc("Total");
+  processing_time_publisher_->publish<Float64Stamped>(
+    std::string(getModuleName()) + "/processing_time_ms", analysis_time_ms_ + apply_time_ms);
+  processing_time_publisher_->publish<Float64Stamped>(
+    std::string(getModuleName()) + "/analysis_time_ms", analysis_time_ms_);
+  processing_time_publisher_->publish<Float64Stamped>(
+    std::string(getModuleName()) + "/apply_time_ms", apply_time_ms);
+}
+
+void SceneModuleManagerInterface::runSceneModules(
+  autoware_auto_planning_msgs::msg::PathWithLaneId * path, SceneModuleOutputs & outputs)
+{
+  auto & debug_marker_array = outputs.debug_marker_array;
+  auto & stop_reason_array = outputs.stop_reason_array;
+  auto & velocity_factor_array = outputs.velocity_factor_array;
+  auto & infrastructure_command_array = outputs.infrastructure_command_array;
   stop_reason_array.header.frame_id = "map";
   stop_reason_array.header.stamp = clock_->now();
   velocity_factor_array.header.frame_id = "map";
   velocity_factor_array.header.stamp = clock_->now();
-
-  tier4_v2x_msgs::msg::InfrastructureCommandArray infrastructure_command_array;
   infrastructure_command_array.stamp = clock_->now();
 
   first_stop_path_point_index_ = static_cast<int>(path->points.size()) - 1;
@@ -137,22 +176,25 @@ void SceneModuleManagerInterface::modifyPathVelocity(
 
     virtual_wall_marker_creator_.add_virtual_walls(scene_module->createVirtualWalls());
   }
+}
 
-  if (!stop_reason_array.stop_reasons.empty()) {
-    pub_stop_reason_->publish(stop_reason_array);
+void SceneModuleManagerInterface::publishSceneModuleOutputs(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
+  const SceneModuleOutputs & outputs)
+{
+  if (!outputs.stop_reason_array.stop_reasons.empty()) {
+    pub_stop_reason_->publish(outputs.stop_reason_array);
   }
-  pub_velocity_factor_->publish(velocity_factor_array);
-  pub_infrastructure_commands_->publish(infrastructure_command_array);
-  pub_debug_->publish(debug_marker_array);
+  pub_velocity_factor_->publish(outputs.velocity_factor_array);
+  pub_infrastructure_commands_->publish(outputs.infrastructure_command_array);
+  pub_debug_->publish(outputs.debug_marker_array);
   if (is_publish_debug_path_) {
     autoware_auto_planning_msgs::msg::PathWithLaneId debug_path;
-    debug_path.header = path->header;
-    debug_path.points = path->points;
+    debug_path.header = path.header;
+    debug_path.points = path.points;
     pub_debug_path_->publish(debug_path);
   }
   pub_virtual_wall_->publish(virtual_wall_marker_creator_.create_markers(clock_->now()));
-  processing_time_publisher_->publish<Float64Stamped>(
-    std::string(getModuleName()) + "/processing_time_ms", stop_watch.toc("Total"));
 }
 
 void SceneModuleManagerInterface::deleteExpiredModules(
@@ -207,6 +249,21 @@ void SceneModuleManagerInterfaceWithRTC::plan(
   publishObjectsOfInterestMarker();
 }
 
+void SceneModuleManagerInterfaceWithRTC::analyze(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+{
+  setActivation();
+  SceneModuleManagerInterface::analyze(path);
+}
+
+void SceneModuleManagerInterfaceWithRTC::apply(
+  autoware_auto_planning_msgs::msg::PathWithLaneId * path)
+{
+  SceneModuleManagerInterface::apply(path);
+  sendRTC(path->header.stamp);
+  publishObjectsOfInterestMarker();
+}
+
 void SceneModuleManagerInterfaceWithRTC::sendRTC(const Time & stamp)
 {
   for (const auto & scene_module : scene_modules_) {
@@ -663,6 +663,105 @@ std::optional<geometry_msgs::msg::Pose> insertStopPoint(
   return tier4_autoware_utils::getPose(output.points.at(insert_idx.value()));
 }
 
+std::vector<VelocityConstraint> calcVelocityConstraints(
+  const PathWithLaneId & original_path, const PathWithLaneId & modified_path)
+{
+  constexpr double overlap_threshold = 1e-3;
+
+  std::vector<VelocityConstraint> constraints{};
+  const auto & original_points = original_path.points;
+  const auto & modified_points = modified_path.points;
+  if (original_points.empty()) {
+    return constraints;
+  }
+
+  // the points inserted to the original path are on its segments, so the original velocity of a
+  // point is that of the last original point which is not ahead of it
+  size_t original_idx = 0;
+  double next_original_length = original_points.size() > 1
+                                  ? calcDistance2d(original_points.at(0), original_points.at(1))
+                                  : std::numeric_limits<double>::max();
+  double modified_length = 0.0;
+  for (size_t i = 0; i < modified_points.size(); ++i) {
+    if (i > 0) {
+      modified_length += calcDistance2d(modified_points.at(i - 1), modified_points.at(i));
+    }
+    while (original_idx + 1 < original_points.size() &&
+           next_original_length <= modified_length + overlap_threshold) {
+      ++original_idx;
+      if (original_idx + 1 < original_points.size()) {
+        next_original_length +=
+          calcDistance2d(original_points.at(original_idx), original_points.at(original_idx + 1));
+      }
+    }
+
+    const double original_velocity =
+      original_points.at(original_idx).point.longitudinal_velocity_mps;
+    const double velocity = modified_points.at(i).point.longitudinal_velocity_mps;
+    const bool is_limited = velocity < original_velocity;
+    const auto & point = modified_points.at(i).point.pose.position;
+
+    // extend the last section while the velocity is the same
+    if (!constraints.empty() && !constraints.back().end) {
+      if (is_limited && velocity == constraints.back().velocity) {
+        continue;
+      }
+      constraints.back().end = point;
+    }
+    if (is_limited) {
+      constraints.push_back(VelocityConstraint{point, std::nullopt, velocity});
+    }
+  }
+
+  return constraints;
+}
+
+std::optional<size_t> applyVelocityConstraints(
+  const std::vector<VelocityConstraint> & constraints, PathWithLaneId & path)
+{
+  constexpr double stop_velocity_threshold = 1e-3;
+
+  const auto insertPoint = [&](const geometry_msgs::msg::Point & point) {
+    const size_t seg_idx = motion_utils::findNearestSegmentIndex(path.points, point);
+    return motion_utils::insertTargetPoint(seg_idx, point, path.points);
+  };
+
+  // the constraints are sorted along the path, so the points inserted later are ahead of the
+  // first stop point
+  std::optional<size_t> first_stop_idx{};
+  for (const auto & constraint : constraints) {
+    if (path.points.size() < 2) {
+      break;
+    }
+
+    std::optional<size_t> end_idx{};
+    if (constraint.end) {
+      end_idx = insertPoint(*constraint.end);
+    }
+    const size_t prev_size = path.points.size();
+    const auto start_idx = insertPoint(constraint.start);
+    if (!start_idx) {
+      continue;
+    }
+    if (end_idx && path.points.size() != prev_size && *start_idx <= *end_idx) {
+      ++*end_idx;
+    }
+
+    // limit the velocity until the path end if the end point is not inserted to be on the safe side
+    const size_t last_idx = end_idx ? *end_idx : path.points.size();
+    for (size_t i = *start_idx; i < last_idx; ++i) {
+      auto & velocity = path.points.at(i).point.longitudinal_velocity_mps;
+      velocity = std::min(velocity, static_cast<float>(constraint.velocity));
+    }
+
+    if (!first_stop_idx && constraint.velocity < stop_velocity_threshold) {
+      first_stop_idx = *start_idx;
+    }
+  }
+
+  return first_stop_idx;
+}
+
 std::set<lanelet::Id> getAssociativeIntersectionLanelets(
   lanelet::ConstLanelet lane, const lanelet::LaneletMapPtr lanelet_map,
   const lanelet::routing::RoutingGraphPtr routing_graph)
@@ -174,3 +174,50 @@ TEST(specialInterpolation, specialInterpolation)
     EXPECT_DOUBLE_EQ(calcInterpolatedStopDist(px, vx), expected);
   }
 }
+
+TEST(velocityConstraints, calcAndApplyVelocityConstraints)
+{
+  using behavior_velocity_planner::planning_utils::applyVelocityConstraints;
+  using behavior_velocity_planner::planning_utils::calcVelocityConstraints;
+  using behavior_velocity_planner::planning_utils::insertStopPoint;
+  using tier4_autoware_utils::createPoint;
+
+  auto input_path = test::generatePath(0.0, 0.0, 10.0, 0.0, 11);
+  for (auto & p : input_path.points) {
+    p.point.longitudinal_velocity_mps = 10.0;
+  }
+
+  // a module slows down in [2.5, 4.0) and stops at 7.5
+  auto modified_path = input_path;
+  motion_utils::insertTargetPoint(2, createPoint(2.5, 0.0, 0.0), modified_path.points);
+  modified_path.points.at(3).point.longitudinal_velocity_mps = 5.0;
+  modified_path.points.at(4).point.longitudinal_velocity_mps = 5.0;
+  insertStopPoint(createPoint(7.5, 0.0, 0.0), modified_path);
+
+  const auto constraints = calcVelocityConstraints(input_path, modified_path);
+  ASSERT_EQ(constraints.size(), 2U);
+  EXPECT_DOUBLE_EQ(constraints.at(0).start.x, 2.5);
+  ASSERT_TRUE(constraints.at(0).end);
+  EXPECT_DOUBLE_EQ(constraints.at(0).end->x, 4.0);
+  EXPECT_DOUBLE_EQ(constraints.at(0).velocity, 5.0);
+  EXPECT_DOUBLE_EQ(constraints.at(1).start.x, 7.5);
+  EXPECT_FALSE(constraints.at(1).end);
+  EXPECT_DOUBLE_EQ(constraints.at(1).velocity, 0.0);
+
+  // the constraints are merged with the path modified by another module
+  auto output_path = input_path;
+  output_path.points.at(3).point.longitudinal_velocity_mps = 3.0;
+  const auto first_stop_idx = applyVelocityConstraints(constraints, output_path);
+
+  const std::vector<double> expected_x{0.0, 1.0, 2.0, 2.5, 3.0, 4.0, 5.0,
+                                       6.0, 7.0, 7.5, 8.0, 9.0, 10.0};
+  const std::vector<double> expected_v{10.0, 10.0, 10.0, 5.0, 3.0, 10.0, 10.0,
+                                       10.0, 10.0, 0.0,  0.0, 0.0, 0.0};
+  ASSERT_EQ(output_path.points.size(), expected_x.size());
+  for (size_t i = 0; i < expected_x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(output_path.points.at(i).point.pose.position.x, expected_x.at(i));
+    EXPECT_DOUBLE_EQ(output_path.points.at(i).point.longitudinal_velocity_mps, expected_v.at(i));
+  }
+  ASSERT_TRUE(first_stop_idx);
+  EXPECT_EQ(*first_stop_idx, 9U);
+}
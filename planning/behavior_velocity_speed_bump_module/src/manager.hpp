@@ -36,6 +36,9 @@ public:
 
   const char * getModuleName() override { return "speed_bump"; }
 
+  // the slow down section only depends on the path shape and the speed bump
+  bool isTwoPhaseSupported() const override { return true; }
+
 private:
   SpeedBumpModule::PlannerParam planner_param_;
 
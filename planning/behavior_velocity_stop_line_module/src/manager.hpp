@@ -41,6 +41,9 @@ public:
 
   const char * getModuleName() override { return "stop_line"; }
 
+  // the stop point only depends on the path shape, the stop line and the ego state
+  bool isTwoPhaseSupported() const override { return true; }
+
 private:
   StopLineModule::PlannerParam planner_param_;
 
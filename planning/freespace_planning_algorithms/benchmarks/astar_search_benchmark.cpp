@@ -0,0 +1,101 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "freespace_planning_algorithms/astar_search.hpp"
+
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+#include <nav_msgs/msg/occupancy_grid.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace fpa = freespace_planning_algorithms;
+
+// Runs A* on a costmap, start and goal read from a rosbag, e.g. the ones dumped by the tests in
+// /tmp/fpalgos-*. The topics can be given to read recorded bags as well.
+// usage: astar_search_benchmark <bag_uri> [costmap_topic] [start_topic] [goal_topic]
+int main(int argc, char ** argv)
+{
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <bag_uri> [costmap_topic] [start_topic] [goal_topic]"
+              << std::endl;
+    return 1;
+  }
+  const std::string bag_uri = argv[1];
+  const std::string costmap_topic = argc > 2 ? argv[2] : "costmap";
+  const std::string start_topic = argc > 3 ? argv[3] : "start";
+  const std::string goal_topic = argc > 4 ? argv[4] : "goal";
+
+  nav_msgs::msg::OccupancyGrid costmap;
+  geometry_msgs::msg::Pose start_pose;
+  geometry_msgs::msg::Pose goal_pose;
+  {
+    rclcpp::Serialization<nav_msgs::msg::OccupancyGrid> costmap_serialization;
+    rclcpp::Serialization<geometry_msgs::msg::Pose> pose_serialization;
+    rosbag2_cpp::Reader reader;
+    reader.open(bag_uri);
+    while (reader.has_next()) {
+      const auto bag_message = reader.read_next();
+      rclcpp::SerializedMessage serialized_msg(*bag_message->serialized_data);
+      if (bag_message->topic_name == costmap_topic) {
+        costmap_serialization.deserialize_message(&serialized_msg, &costmap);
+      } else if (bag_message->topic_name == start_topic) {
+        pose_serialization.deserialize_message(&serialized_msg, &start_pose);
+      } else if (bag_message->topic_name == goal_topic) {
+        pose_serialization.deserialize_message(&serialized_msg, &goal_pose);
+      }
+    }
+  }
+
+  // same configuration as the tests
+  const fpa::PlannerCommonParam planner_common_param{
+    10 * 1000.0, 9.0, 14.0, 3, 144, 1.0, 1.0, 0.5, 2.0, 6.0, 100};
+  const fpa::VehicleShape vehicle_shape(5.5, 2.75, 1.5);
+
+  constexpr int trial_num = 10;
+  for (const bool use_obstacle_heuristic : {false, true}) {
+    const fpa::AstarParam astar_param{false, true, 1.0, use_obstacle_heuristic};
+    fpa::AstarSearch astar(planner_common_param, vehicle_shape, astar_param);
+
+    const auto set_map_start = std::chrono::steady_clock::now();
+    astar.setMap(costmap);
+    const auto set_map_end = std::chrono::steady_clock::now();
+
+    int success_num = 0;
+    double length = 0.0;
+    const auto plan_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < trial_num; ++i) {
+      if (astar.makePlan(start_pose, goal_pose)) {
+        ++success_num;
+        length = astar.getWaypoints().compute_length();
+      }
+    }
+    const auto plan_end = std::chrono::steady_clock::now();
+
+    std::cout << "use_obstacle_heuristic: " << std::boolalpha << use_obstacle_heuristic
+              << ", setMap: "
+              << std::chrono::duration<double, std::milli>(set_map_end - set_map_start).count()
+              << " [ms], makePlan: "
+              << std::chrono::duration<double, std::milli>(plan_end - plan_start).count() /
+                   trial_num
+              << " [ms], success: " << success_num << "/" << trial_num << ", length: " << length
+              << " [m]" << std::endl;
+  }
+
+  return 0;
+}
@@ -158,7 +158,11 @@ protected:
     // NOTE: Accessing by .at() instead makes 1.2 times slower here.
     // Also, boundary check is already done in isOutOfRange before calling this function.
     // So, basically .at() is not necessary.
-    return is_obstacle_table_[index.y][index.x];
+    return is_obstacle_table_[index.y * costmap_.info.width + index.x];
+  }
+  inline double getObstacleDistanceSq(const IndexXYT & index) const
+  {
+    return obstacle_distance_sq_table_[index.y * costmap_.info.width + index.x];
   }
 
   PlannerCommonParam planner_common_param_;
@@ -173,8 +177,17 @@ protected:
   // vehicle vertex indexes cache
   std::vector<std::vector<IndexXY>> vertex_indexes_table_;
 
-  // is_obstacle's table
-  std::vector<std::vector<bool>> is_obstacle_table_;
+  // collision indexes within this squared radius [cell^2] from the base index, for each angle
+  std::vector<double> coll_outer_radius_sq_table_;
+
+  // squared radius [cell^2] within which all indexes are collision indexes, for each angle
+  std::vector<double> coll_inner_radius_sq_table_;
+
+  // is_obstacle's table, row-major and bit-packed
+  std::vector<bool> is_obstacle_table_;
+
+  // squared distance to the nearest obstacle [cell^2], row-major
+  std::vector<double> obstacle_distance_sq_table_;
 
   // pose in costmap frame
   geometry_msgs::msg::Pose start_pose_;
@@ -24,6 +24,7 @@
 #include <std_msgs/msg/header.hpp>
 
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <queue>
@@ -43,7 +44,8 @@ struct AstarParam
   bool use_back;               // backward search
 
   // search configs
-  double distance_heuristic_weight;  // obstacle threshold on grid [0,255]
+  double distance_heuristic_weight;     // obstacle threshold on grid [0,255]
+  bool use_obstacle_heuristic = false;  // also use the 2D shortest distance avoiding obstacles
 };
 
 struct AstarNode
@@ -120,7 +122,8 @@ public:
       AstarParam{
         node.declare_parameter<bool>("astar.only_behind_solutions"),
         node.declare_parameter<bool>("astar.use_back"),
-        node.declare_parameter<double>("astar.distance_heuristic_weight")})
+        node.declare_parameter<double>("astar.distance_heuristic_weight"),
+        node.declare_parameter<bool>("astar.use_obstacle_heuristic")})
   {
   }
 
@@ -131,7 +134,7 @@ public:
 
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
 
-  inline int getKey(const IndexXYT & index)
+  inline int getKey(const IndexXYT & index) const
   {
     return (index.theta + (index.y * x_scale_ + index.x) * y_scale_);
   }
@@ -142,13 +145,25 @@ private:
   void setPath(const AstarNode & goal);
   bool setStartNode();
   bool setGoalNode();
+  void computeObstacleHeuristicTable();
   double estimateCost(const geometry_msgs::msg::Pose & pose) const;
   bool isGoal(const AstarNode & node) const;
   geometry_msgs::msg::Pose node2pose(const AstarNode & node) const;
 
   AstarNode * getNodeRef(const IndexXYT & index)
   {
-    return &(graph_.emplace(getKey(index), AstarNode()).first->second);
+    const int key = getKey(index);
+    int & node_index = node_index_table_[key];
+    if (node_index < 0) {
+      node_index = static_cast<int>(visited_keys_.size());
+      visited_keys_.push_back(key);
+      if (static_cast<size_t>(node_index) < graph_.size()) {
+        graph_[node_index] = AstarNode();
+      } else {
+        graph_.emplace_back();
+      }
+    }
+    return &graph_[node_index];
   }
 
   // Algorithm specific param
@@ -156,7 +171,18 @@ private:
 
   // hybrid astar variables
   TransitionTable transition_table_;
-  std::unordered_map<uint, AstarNode> graph_;
+
+  // node arena. nodes are reused across plans and never move, so pointers to them stay valid.
+  std::deque<AstarNode> graph_;
+
+  // index of the node in graph_ for each (x, y, theta) key, or -1 if not visited
+  std::vector<int> node_index_table_;
+
+  // keys visited in the current plan, in the order of the nodes in graph_
+  std::vector<int> visited_keys_;
+
+  // 2D shortest distance to the goal avoiding obstacles [m], row-major
+  std::vector<double> obstacle_heuristic_table_;
 
   std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
 
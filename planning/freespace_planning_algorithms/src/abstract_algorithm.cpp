@@ -17,6 +17,8 @@
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/math/normalization.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -24,6 +26,82 @@ namespace freespace_planning_algorithms
 using tier4_autoware_utils::createQuaternionFromYaw;
 using tier4_autoware_utils::normalizeRadian;
 
+namespace
+{
+constexpr double distance_inf = std::numeric_limits<double>::infinity();
+
+// 1D squared Euclidean distance transform of sampled function f (Felzenszwalb & Huttenlocher).
+// v and z are working buffers of size n and n + 1.
+void distanceTransform1d(
+  const std::vector<double> & f, std::vector<double> & d, std::vector<int> & v,
+  std::vector<double> & z, const int n)
+{
+  int k = -1;
+  for (int q = 0; q < n; ++q) {
+    if (f[q] == distance_inf) {
+      continue;
+    }
+    double s = -distance_inf;
+    while (k >= 0) {
+      s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+      if (s > z[k]) {
+        break;
+      }
+      --k;
+    }
+    ++k;
+    v[k] = q;
+    z[k] = k == 0 ? -distance_inf : s;
+    z[k + 1] = distance_inf;
+  }
+
+  if (k < 0) {
+    std::fill(d.begin(), d.begin() + n, distance_inf);
+    return;
+  }
+
+  int j = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[j + 1] < q) {
+      ++j;
+    }
+    d[q] = (q - v[j]) * (q - v[j]) + f[v[j]];
+  }
+}
+
+// squared distance to the nearest obstacle cell for all cells of a row-major grid [cell^2]
+std::vector<double> computeObstacleDistanceSq(
+  const std::vector<bool> & is_obstacle_table, const int width, const int height)
+{
+  std::vector<double> distance_sq(is_obstacle_table.size(), distance_inf);
+  const int n = std::max(width, height);
+  std::vector<double> f(n);
+  std::vector<double> d(n);
+  std::vector<int> v(n);
+  std::vector<double> z(n + 1);
+
+  // columns
+  for (int x = 0; x < width; ++x) {
+    for (int y = 0; y < height; ++y) {
+      f[y] = is_obstacle_table[y * width + x] ? 0.0 : distance_inf;
+    }
+    distanceTransform1d(f, d, v, z, height);
+    for (int y = 0; y < height; ++y) {
+      distance_sq[y * width + x] = d[y];
+    }
+  }
+
+  // rows
+  for (int y = 0; y < height; ++y) {
+    std::copy(distance_sq.begin() + y * width, distance_sq.begin() + (y + 1) * width, f.begin());
+    distanceTransform1d(f, d, v, z, width);
+    std::copy(d.begin(), d.begin() + width, distance_sq.begin() + y * width);
+  }
+
+  return distance_sq;
+}
+}  // namespace
+
 geometry_msgs::msg::Pose transformPose(
   const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::TransformStamped & transform)
 {
@@ -109,19 +187,17 @@ void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & cost
   const auto width = costmap_.info.width;
 
   // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
+  is_obstacle_table_.assign(height * width, false);
   for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
     for (uint32_t j = 0; j < width; j++) {
       const int cost = costmap_.data[i * width + j];
 
       if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
+        is_obstacle_table_[i * width + j] = true;
       }
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
+  obstacle_distance_sq_table_ = computeObstacleDistanceSq(is_obstacle_table_, width, height);
 
   // construct collision indexes table
   if (is_collision_table_initialized == false) {
@@ -130,6 +206,34 @@ void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & cost
       computeCollisionIndexes(i, indexes_2d, vertex_indexes_2d);
       coll_indexes_table_.push_back(indexes_2d);
       vertex_indexes_table_.push_back(vertex_indexes_2d);
+
+      // radius of the smallest circle containing all the collision indexes, and of the largest
+      // circle whose indexes are all collision indexes. with these two, most of the collision
+      // checks are decided from the obstacle distance of the base index.
+      double outer_radius_sq = 0.0;
+      int min_x = 0, max_x = 0, min_y = 0, max_y = 0;
+      for (const auto & index : indexes_2d) {
+        outer_radius_sq = std::max(outer_radius_sq, 1.0 * index.x * index.x + index.y * index.y);
+        min_x = std::min(min_x, index.x);
+        max_x = std::max(max_x, index.x);
+        min_y = std::min(min_y, index.y);
+        max_y = std::max(max_y, index.y);
+      }
+      double inner_radius_sq = distance_inf;
+      for (int x = min_x - 1; x <= max_x + 1; ++x) {
+        for (int y = min_y - 1; y <= max_y + 1; ++y) {
+          const bool is_coll_index = std::binary_search(
+            indexes_2d.begin(), indexes_2d.end(), IndexXY{x, y},
+            [](const IndexXY & left, const IndexXY & right) {
+              return left.x != right.x ? left.x < right.x : left.y < right.y;
+            });
+          if (!is_coll_index) {
+            inner_radius_sq = std::min(inner_radius_sq, 1.0 * x * x + y * y);
+          }
+        }
+      }
+      coll_outer_radius_sq_table_.push_back(outer_radius_sq);
+      coll_inner_radius_sq_table_.push_back(inner_radius_sq);
     }
     is_collision_table_initialized = true;
   }
@@ -219,6 +323,17 @@ bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index) con
     }
   }
 
+  // decide by the distance from the base index to the nearest obstacle if possible
+  if (!isOutOfRange(base_index)) {
+    const double obstacle_distance_sq = getObstacleDistanceSq(base_index);
+    if (obstacle_distance_sq > coll_outer_radius_sq_table_[base_index.theta]) {
+      return false;
+    }
+    if (obstacle_distance_sq < coll_inner_radius_sq_table_[base_index.theta]) {
+      return true;
+    }
+  }
+
   const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
   for (const auto & coll_index_2d : coll_indexes_2d) {
     int idx_theta = 0;  // whatever. Yaw is nothing to do with collision detection between grids.
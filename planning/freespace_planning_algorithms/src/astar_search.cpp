@@ -25,6 +25,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -130,10 +134,12 @@ void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
 {
   AbstractPlanningAlgorithm::setMap(costmap);
 
-  clearNodes();
+  x_scale_ = costmap_.info.width;
+  node_index_table_.assign(
+    costmap_.info.width * costmap_.info.height * planner_common_param_.theta_size, -1);
+  visited_keys_.clear();
 
-  x_scale_ = costmap_.info.height;
-  graph_.reserve(100000);
+  clearNodes();
 }
 
 bool AstarSearch::makePlan(
@@ -142,11 +148,16 @@ bool AstarSearch::makePlan(
   start_pose_ = global2local(costmap_, start_pose);
   goal_pose_ = global2local(costmap_, goal_pose);
 
-  if (!setStartNode()) {
+  if (!setGoalNode()) {
     return false;
   }
 
-  if (!setGoalNode()) {
+  // the heuristic cost of the start node depends on this table
+  if (astar_param_.use_obstacle_heuristic) {
+    computeObstacleHeuristicTable();
+  }
+
+  if (!setStartNode()) {
     return false;
   }
 
@@ -159,14 +170,21 @@ void AstarSearch::clearNodes()
   // point to deleted node.
   openlist_ = std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison>();
 
-  graph_ = std::unordered_map<uint, AstarNode>();
+  // only reset the visited keys instead of the whole table. the nodes in graph_ are kept and
+  // overwritten when they are visited again.
+  for (const auto key : visited_keys_) {
+    node_index_table_[key] = -1;
+  }
+  visited_keys_.clear();
 }
 
 bool AstarSearch::setStartNode()
 {
+  clearNodes();
+
   const auto index = pose2index(costmap_, start_pose_, planner_common_param_.theta_size);
 
-  if (detectCollision(index)) {
+  if (isOutOfRange(index) || detectCollision(index)) {
     return false;
   }
 
@@ -198,6 +216,53 @@ bool AstarSearch::setGoalNode()
   return true;
 }
 
+void AstarSearch::computeObstacleHeuristicTable()
+{
+  const int width = costmap_.info.width;
+  const int height = costmap_.info.height;
+  const double resolution = costmap_.info.resolution;
+
+  obstacle_heuristic_table_.assign(width * height, std::numeric_limits<double>::infinity());
+
+  // Dijkstra from the goal index on the 8-connected grid
+  using QueueElement = std::pair<double, int>;
+  std::priority_queue<QueueElement, std::vector<QueueElement>, std::greater<QueueElement>> queue;
+
+  const auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
+  const int goal_key = goal_index.y * width + goal_index.x;
+  obstacle_heuristic_table_[goal_key] = 0.0;
+  queue.emplace(0.0, goal_key);
+
+  constexpr std::array<std::array<int, 2>, 8> neighbors{
+    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+  const double straight_cost = resolution;
+  const double diagonal_cost = resolution * std::sqrt(2.0);
+
+  while (!queue.empty()) {
+    const auto [cost, key] = queue.top();
+    queue.pop();
+    if (cost > obstacle_heuristic_table_[key]) {
+      continue;
+    }
+
+    const int x = key % width;
+    const int y = key / width;
+    for (const auto & neighbor : neighbors) {
+      const IndexXYT next_index{x + neighbor[0], y + neighbor[1], 0};
+      if (isOutOfRange(next_index) || isObs(next_index)) {
+        continue;
+      }
+      const int next_key = next_index.y * width + next_index.x;
+      const double next_cost =
+        cost + (neighbor[0] != 0 && neighbor[1] != 0 ? diagonal_cost : straight_cost);
+      if (next_cost < obstacle_heuristic_table_[next_key]) {
+        obstacle_heuristic_table_[next_key] = next_cost;
+        queue.emplace(next_cost, next_key);
+      }
+    }
+  }
+}
+
 double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose) const
 {
   double total_cost = 0.0;
@@ -212,6 +277,18 @@ double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose) const
     total_cost += tier4_autoware_utils::calcDistance2d(pose, goal_pose_) *
                   astar_param_.distance_heuristic_weight;
   }
+
+  // the Reeds-Shepp distance ignores obstacles and the 2D distance ignores the kinematics, so take
+  // the larger one
+  if (astar_param_.use_obstacle_heuristic && !obstacle_heuristic_table_.empty()) {
+    const auto index = pose2index(costmap_, pose, planner_common_param_.theta_size);
+    if (!isOutOfRange(index)) {
+      total_cost = std::max(
+        total_cost,
+        obstacle_heuristic_table_[index.y * costmap_.info.width + index.x] *
+          astar_param_.distance_heuristic_weight);
+    }
+  }
   return total_cost;
 }
 
@@ -255,7 +332,7 @@ bool AstarSearch::search()
       setYaw(&next_pose.orientation, current_node->theta + transition.shift_theta);
       const auto next_index = pose2index(costmap_, next_pose, planner_common_param_.theta_size);
 
-      if (detectCollision(next_index)) {
+      if (isOutOfRange(next_index) || detectCollision(next_index)) {
         continue;
       }
 
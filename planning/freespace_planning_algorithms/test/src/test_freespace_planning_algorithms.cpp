@@ -199,7 +199,8 @@ fpa::PlannerCommonParam get_default_planner_params()
     obstacle_threshold};
 }
 
-std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
+std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(
+  bool use_multi, bool use_obstacle_heuristic = false)
 {
   auto planner_common_param = get_default_planner_params();
   if (use_multi) {
@@ -211,8 +212,8 @@ std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_astar(bool use_multi)
   const bool only_behind_solutions = false;
   const bool use_back = true;
   const double distance_heuristic_weight = 1.0;
-  const auto astar_param =
-    fpa::AstarParam{only_behind_solutions, use_back, distance_heuristic_weight};
+  const auto astar_param = fpa::AstarParam{
+    only_behind_solutions, use_back, distance_heuristic_weight, use_obstacle_heuristic};
 
   auto algo = std::make_unique<fpa::AstarSearch>(planner_common_param, vehicle_shape, astar_param);
   return algo;
@@ -234,6 +235,7 @@ std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_rrtstar(bool informed,
 enum AlgorithmType {
   ASTAR_SINGLE,
   ASTAR_MULTI,
+  ASTAR_OBSTACLE_HEURISTIC,
   RRTSTAR_FASTEST,
   RRTSTAR_UPDATE,
   RRTSTAR_INFORMED_UPDATE,
@@ -242,6 +244,7 @@ enum AlgorithmType {
 std::unordered_map<AlgorithmType, std::string> rosbag_dir_prefix_table(
   {{ASTAR_SINGLE, "fpalgos-astar_single"},
    {ASTAR_MULTI, "fpalgos-astar_multi"},
+   {ASTAR_OBSTACLE_HEURISTIC, "fpalgos-astar_obstacle_heuristic"},
    {RRTSTAR_FASTEST, "fpalgos-rrtstar_fastest"},
    {RRTSTAR_UPDATE, "fpalgos-rrtstar_update"},
    {RRTSTAR_INFORMED_UPDATE, "fpalgos-rrtstar_informed_update"}});
@@ -253,6 +256,8 @@ bool test_algorithm(enum AlgorithmType algo_type, bool dump_rosbag = false)
     algo = configure_astar(true);
   } else if (algo_type == AlgorithmType::ASTAR_MULTI) {
     algo = configure_astar(false);
+  } else if (algo_type == AlgorithmType::ASTAR_OBSTACLE_HEURISTIC) {
+    algo = configure_astar(true, true);
   } else if (algo_type == AlgorithmType::RRTSTAR_FASTEST) {
     algo = configure_rrtstar(false, false);
   } else if (algo_type == AlgorithmType::RRTSTAR_UPDATE) {
@@ -364,6 +369,11 @@ TEST(AstarSearchTestSuite, MultiCurvature)
   EXPECT_TRUE(test_algorithm(AlgorithmType::ASTAR_MULTI));
 }
 
+TEST(AstarSearchTestSuite, ObstacleHeuristic)
+{
+  EXPECT_TRUE(test_algorithm(AlgorithmType::ASTAR_OBSTACLE_HEURISTIC));
+}
+
 TEST(RRTStarTestSuite, Fastest)
 {
   EXPECT_TRUE(test_algorithm(AlgorithmType::RRTSTAR_FASTEST));
@@ -38,6 +38,7 @@ public:
     double over_a_weight;
     double over_j_weight;
     double jerk_filter_ds;
+    int qp_horizon_point_num;  // min number of points of the optimization problem (0: no padding)
   };
 
   explicit JerkFilteredSmoother(rclcpp::Node & node);
@@ -57,6 +58,10 @@ public:
 private:
   Param smoother_param_;
   autoware::common::osqp::OSQPInterface qp_solver_;
+  // solution of the previous optimization to warm start the next one
+  std::vector<double> prev_optval_;
+  std::vector<double> prev_arclength_;
+  geometry_msgs::msg::Point prev_front_position_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   TrajectoryPoints forwardJerkFilter(
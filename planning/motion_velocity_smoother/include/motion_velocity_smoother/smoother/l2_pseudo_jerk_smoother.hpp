@@ -36,6 +36,7 @@ public:
     double pseudo_jerk_weight;
     double over_v_weight;
     double over_a_weight;
+    int qp_horizon_point_num;  // min number of points of the optimization problem (0: no padding)
   };
 
   explicit L2PseudoJerkSmoother(rclcpp::Node & node);
@@ -54,6 +55,10 @@ public:
 private:
   Param smoother_param_;
   autoware::common::osqp::OSQPInterface qp_solver_;
+  // solution of the previous optimization to warm start the next one
+  std::vector<double> prev_optval_;
+  std::vector<double> prev_arclength_;
+  geometry_msgs::msg::Point prev_front_position_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("l2_pseudo_jerk_smoother")};
 };
 }  // namespace motion_velocity_smoother
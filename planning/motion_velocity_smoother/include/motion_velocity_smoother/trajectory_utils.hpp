@@ -77,6 +77,20 @@ std::vector<double> calcVelocityProfileWithConstantJerkAndAccelerationLimit(
 
 double calcStopDistance(const TrajectoryPoints & trajectory, const size_t closest);
 
+/**
+ * @brief shift the optimization variables of the previous cycle to the current trajectory
+ * @param prev_variables variables given as num_blocks blocks of the variables of each point,
+ * followed by the other variables which are copied as they are
+ * @param prev_arclength arc length of the points of the previous cycle
+ * @param arclength arc length of the points of the current cycle
+ * @param travelled_dist arc length from the previous front point to the current front point
+ * @return variables of the current points, linearly interpolated with the arc length (empty if
+ * the sizes of the previous variables are inconsistent)
+ */
+std::vector<double> shiftOptimizationVariables(
+  const std::vector<double> & prev_variables, const std::vector<double> & prev_arclength,
+  const std::vector<double> & arclength, const double travelled_dist, const size_t num_blocks);
+
 }  // namespace motion_velocity_smoother::trajectory_utils
 
 #endif  // MOTION_VELOCITY_SMOOTHER__TRAJECTORY_UTILS_HPP_
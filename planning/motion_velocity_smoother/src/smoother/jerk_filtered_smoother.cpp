@@ -17,6 +17,7 @@
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -37,6 +38,7 @@ JerkFilteredSmoother::JerkFilteredSmoother(rclcpp::Node & node) : SmootherBase(n
   p.over_a_weight = node.declare_parameter<double>("over_a_weight");
   p.over_j_weight = node.declare_parameter<double>("over_j_weight");
   p.jerk_filter_ds = node.declare_parameter<double>("jerk_filter_ds");
+  p.qp_horizon_point_num = node.declare_parameter<int>("qp_horizon_point_num");
 
   qp_solver_.updateMaxIter(20000);
   qp_solver_.updateRhoInterval(0);  // 0 means automatic
@@ -142,23 +144,29 @@ bool JerkFilteredSmoother::apply(
   // Clip trajectory from 0 to zero_vel_id (the size becomes zero_vel_id_ + 1)
   const size_t N = *zero_vel_id + 1;
 
+  // The optimization problem is padded with stop points up to qp_horizon_point_num so that its
+  // sparsity pattern does not change and the solver workspace can be updated instead of set up.
+  // The padded points are decoupled from the others and do not change the solution.
+  const size_t M =
+    std::max(N, static_cast<size_t>(std::max(smoother_param_.qp_horizon_point_num, 0)));
+
   output = opt_resampled_trajectory;
 
   const std::vector<double> interval_dist_arr =
     trajectory_utils::calcTrajectoryIntervalDistance(opt_resampled_trajectory);
 
-  std::vector<double> v_max_arr(N, 0.0);
+  std::vector<double> v_max_arr(M, 0.0);
   for (size_t i = 0; i < N; ++i) {
     v_max_arr.at(i) = opt_resampled_trajectory.at(i).longitudinal_velocity_mps;
   }
 
   /*
    * x = [
-   *      b[0], b[1], ..., b[N],               : 0~N
-   *      a[0], a[1], .... a[N],               : N~2N
-   *      delta[0], ..., delta[N],             : 2N~3N
-   *      sigma[0], sigma[1], ...., sigma[N],  : 3N~4N
-   *      gamma[0], gamma[1], ..., gamma[N]    : 4N~5N
+   *      b[0], b[1], ..., b[M],               : 0~M
+   *      a[0], a[1], .... a[M],               : M~2M
+   *      delta[0], ..., delta[M],             : 2M~3M
+   *      sigma[0], sigma[1], ...., sigma[M],  : 3M~4M
+   *      gamma[0], gamma[1], ..., gamma[M]    : 4M~5M
    *     ]
    *
    * b[i]  : velocity^2
@@ -167,21 +175,25 @@ bool JerkFilteredSmoother::apply(
    * gamma : jerk_min < pseudo_jerk[i] * ref_vel[i] - gamma[i] < jerk_max
    */
   const uint32_t IDX_B0 = 0;
-  const uint32_t IDX_A0 = N;
-  const uint32_t IDX_DELTA0 = 2 * N;
-  const uint32_t IDX_SIGMA0 = 3 * N;
-  const uint32_t IDX_GAMMA0 = 4 * N;
+  const uint32_t IDX_A0 = M;
+  const uint32_t IDX_DELTA0 = 2 * M;
+  const uint32_t IDX_SIGMA0 = 3 * M;
+  const uint32_t IDX_GAMMA0 = 4 * M;
 
-  const uint32_t l_variables = 5 * N;
-  const uint32_t l_constraints = 4 * N + 1;
+  const uint32_t l_variables = 5 * M;
+  const uint32_t l_constraints = 4 * M + 1;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
+  // The matrices are banded, and built as sparse matrices from triplets.
+  // All the entries are stored even if the value is zero, so that the sparsity pattern depends
+  // only on M.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(2 * M + 2 * M + 3 * (M - 1) + 3 * (M - 1) + 2);
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(4 * (M - 1) + 3 * M);
   std::vector<double> q(l_variables, 0.0);
 
   /**************************************************************/
@@ -192,18 +204,22 @@ bool JerkFilteredSmoother::apply(
 
   // jerk: d(ai)/ds * v_ref -> minimize weight * ((a1 - a0) / ds * v_ref)^2 * ds
   const double smooth_weight = smoother_param_.jerk_weight;
-  for (size_t i = 0; i < N - 1; ++i) {
-    const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
-    const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
-    const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+  for (size_t i = 0; i < M - 1; ++i) {
+    double jerk_weight = 0.0;
+    if (i < N - 1) {
+      const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
+      const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
+      const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
+      jerk_weight = smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    }
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i, jerk_weight);
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i + 1, -jerk_weight);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i, -jerk_weight);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i + 1, jerk_weight);
   }
 
   // |v_max_i^2 - b_i|/v_max^2 -> minimize (-bi) * ds / v_max^2
-  for (size_t i = 0; i < N; ++i) {
+  for (size_t i = 0; i < M; ++i) {
     if (v_max_arr.at(i) > 0.01) {
       // Note that if v_max[i] is too small, we did not minimize the corresponding -b[i]
       double v_weight_term = -1.0 / (v_max_arr.at(i) * v_max_arr.at(i));
@@ -212,9 +228,9 @@ bool JerkFilteredSmoother::apply(
       }
       q.at(IDX_B0 + i) += v_weight_term;
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+    P_triplets.emplace_back(IDX_DELTA0 + i, IDX_DELTA0 + i, over_v_weight);  // over velocity cost
+    P_triplets.emplace_back(IDX_SIGMA0 + i, IDX_SIGMA0 + i, over_a_weight);  // over accel cost
+    P_triplets.emplace_back(IDX_GAMMA0 + i, IDX_GAMMA0 + i, over_j_weight);  // over jerk cost
   }
 
   /**************************************************************/
@@ -234,17 +250,17 @@ bool JerkFilteredSmoother::apply(
   size_t constr_idx = 0;
 
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
-  for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
+  for (size_t i = 0; i < M; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 1.0);       // b_i
+    A_triplets.emplace_back(constr_idx, IDX_DELTA0 + i, -1.0);  // -delta_i
     upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
     lower_bound[constr_idx] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
-  for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
+  for (size_t i = 0; i < M; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);       // a_i
+    A_triplets.emplace_back(constr_idx, IDX_SIGMA0 + i, -1.0);  // -sigma_i
 
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
@@ -259,53 +275,94 @@ bool JerkFilteredSmoother::apply(
 
   // Soft Constraint Jerk Limit: jerk_min < pseudo_jerk[i] * ref_vel[i] - gamma[i] < jerk_max
   // -> jerk_min * ds < (a[i+1] - a[i]) * ref_vel[i] - gamma[i] * ds < jerk_max * ds
-  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
-    const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
-    upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
-    lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
+  // The coefficients are zero for the padded points.
+  for (size_t i = 0; i < M - 1; ++i, ++constr_idx) {
+    const double ref_vel = i < N - 1 ? 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1)) : 0.0;
+    const double ds = i < N - 1 ? interval_dist_arr.at(i) : 0.0;
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -ref_vel);     // -a[i] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, ref_vel);  //  a[i+1] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_GAMMA0 + i, -ds);      // -gamma[i] * ds
+    upper_bound[constr_idx] = j_max * ds;                          //  jerk_max * ds
+    lower_bound[constr_idx] = j_min * ds;                          //  jerk_min * ds
   }
 
   // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
-  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
+  // b(i+1) = 0 for the padded points.
+  for (size_t i = 0; i < M - 1; ++i, ++constr_idx) {
+    const bool is_padded = i >= N - 1;
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, is_padded ? 0.0 : -1.0);  // b(i)
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i + 1, 1.0);                 // b(i+1)
+    A_triplets.emplace_back(
+      constr_idx, IDX_A0 + i, is_padded ? 0.0 : -2.0 * interval_dist_arr.at(i));  // a(i) * ds
     upper_bound[constr_idx] = 0.0;
     lower_bound[constr_idx] = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
+    A_triplets.emplace_back(constr_idx, IDX_B0, 1.0);  // b0
     upper_bound[constr_idx] = v0 * v0;
     lower_bound[constr_idx] = v0 * v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
+    A_triplets.emplace_back(constr_idx, IDX_A0, 1.0);  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
     ++constr_idx;
   }
 
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
+  // arc length of the points of the optimization problem, where the padded points are at the end
+  std::vector<double> arclength = trajectory_utils::calcArclengthArray(opt_resampled_trajectory);
+  arclength.resize(N);
+  arclength.resize(M, arclength.back());
+
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  // The solver workspace is updated when the sparsity pattern is unchanged, and warm started from
+  // the previous solution shifted by the travelled distance.
+  const auto P_csc = autoware::common::osqp::calCSCMatrixTrapezoidal(P);
+  const auto A_csc = autoware::common::osqp::calCSCMatrix(A);
+  if (prev_optval_.empty()) {
+    qp_solver_.initializeProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+  } else {
+    qp_solver_.updateProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+    const double travelled_dist = motion_utils::calcSignedArcLength(
+      opt_resampled_trajectory, prev_front_position_, static_cast<size_t>(0));
+    const auto initial_optval = trajectory_utils::shiftOptimizationVariables(
+      prev_optval_, prev_arclength_, arclength, travelled_dist, 5);
+    if (initial_optval.size() == l_variables) {
+      qp_solver_.setPrimalVariables(initial_optval);
+    } else {
+      qp_solver_.setPrimalVariables(std::vector<double>(l_variables, 0.0));
+    }
+    // The duals of the previous problem belong to the constraints of the previous points, which
+    // are not shifted with the primal variables, so they are reset.
+    qp_solver_.setDualVariables(std::vector<double>(l_constraints, 0.0));
+  }
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     RCLCPP_WARN(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+    prev_optval_.clear();
     return false;
   }
   const auto has_nan =
     std::any_of(optval.begin(), optval.end(), [](const auto v) { return std::isnan(v); });
   if (has_nan) {
     RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
+    prev_optval_.clear();
     return false;
   }
 
+  prev_optval_ = optval;
+  prev_arclength_ = arclength;
+  prev_front_position_ = opt_resampled_trajectory.front().pose.position;
+
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
     std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
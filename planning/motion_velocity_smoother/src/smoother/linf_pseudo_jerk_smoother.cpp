@@ -17,6 +17,7 @@
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 #include <algorithm>
 #include <chrono>
@@ -31,6 +32,7 @@ LinfPseudoJerkSmoother::LinfPseudoJerkSmoother(rclcpp::Node & node) : SmootherBa
   p.pseudo_jerk_weight = node.declare_parameter<double>("pseudo_jerk_weight");
   p.over_v_weight = node.declare_parameter<double>("over_v_weight");
   p.over_a_weight = node.declare_parameter<double>("over_a_weight");
+  p.qp_horizon_point_num = node.declare_parameter<int>("qp_horizon_point_num");
 
   qp_solver_.updateMaxIter(20000);
   qp_solver_.updateRhoInterval(5000);
@@ -73,29 +75,38 @@ bool LinfPseudoJerkSmoother::apply(
     return false;
   }
 
+  // The optimization problem is padded with stop points up to qp_horizon_point_num so that its
+  // sparsity pattern does not change and the solver workspace can be updated instead of set up.
+  // The padded points are decoupled from the others and do not change the solution.
+  const size_t M{
+    std::max(N, static_cast<size_t>(std::max(smoother_param_.qp_horizon_point_num, 0)))};
+
   std::vector<double> interval_dist_arr = trajectory_utils::calcTrajectoryIntervalDistance(input);
 
-  std::vector<double> v_max(N, 0.0);
+  std::vector<double> v_max(M, 0.0);
   for (size_t i = 0; i < N; ++i) {
     v_max.at(i) = input.at(i).longitudinal_velocity_mps;
   }
 
   /*
-   * x = [b0, b1, ..., bN, |  a0, a1, ..., aN, | delta0, delta1, ..., deltaN, | sigma0, sigma1, ...,
-   * sigmaN, | psi] in R^{4N+1} b: velocity^2 a: acceleration delta: 0 < bi < v_max^2 + delta sigma:
+   * x = [b0, b1, ..., bM, |  a0, a1, ..., aM, | delta0, delta1, ..., deltaM, | sigma0, sigma1, ...,
+   * sigmaM, | psi] in R^{4M+1} b: velocity^2 a: acceleration delta: 0 < bi < v_max^2 + delta sigma:
    * a_min < ai - sigma < a_max psi: a'*curr_v -  psi < 0, - a'*curr_v - psi < 0 (<=> |a'|*curr_v <
    * psi)
    */
-  const size_t l_variables{4 * N + 1};
-  const size_t l_constraints{3 * N + 1 + 2 * (N - 1)};
+  const size_t l_variables{4 * M + 1};
+  const size_t l_constraints{3 * M + 1 + 2 * (M - 1)};
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(
-    l_constraints, l_variables);  // the matrix size depends on constraint numbers.
+  // The matrices are built as sparse matrices from triplets. All the entries are stored even if
+  // the value is zero, so that the sparsity pattern depends only on M.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(2 * M + 2 * M + 3 * (M - 1) + 2 + 6 * (M - 1));
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(2 * M);
   std::vector<double> q(l_variables, 0.0);
 
   const double a_max{base_param_.max_accel};
@@ -109,16 +120,16 @@ bool LinfPseudoJerkSmoother::apply(
     q[i] = -1.0;                          // |v_max^2 - b| -> minimize (-bi)
   }
 
-  for (unsigned int i = 2 * N; i < 3 * N; ++i) {  // over velocity cost
-    P(i, i) += over_v_weight;
+  for (unsigned int i = 2 * M; i < 3 * M; ++i) {  // over velocity cost
+    P_triplets.emplace_back(i, i, over_v_weight);
   }
 
-  for (unsigned int i = 3 * N; i < 4 * N; ++i) {  // over acceleration cost
-    P(i, i) += over_a_weight;
+  for (unsigned int i = 3 * M; i < 4 * M; ++i) {  // over acceleration cost
+    P_triplets.emplace_back(i, i, over_a_weight);
   }
 
   // pseudo jerk (Linf): minimize psi, subject to |a'|*curr_v < psi
-  q[4 * N] = smooth_weight;
+  q[4 * M] = smooth_weight;
 
   /* design constraint matrix
   0 < b - delta < v_max^2
@@ -128,20 +139,20 @@ bool LinfPseudoJerkSmoother::apply(
   converted to v with sqrt. If the weight of delta^2 is large (the value of delta is very small),
   b is almost 0, and is not a big problem.
   */
-  for (unsigned int i = 0; i < N; ++i) {
-    const int j = 2 * N + i;
-    A(i, i) = 1.0;   // b_i
-    A(i, j) = -1.0;  // -delta_i
+  for (unsigned int i = 0; i < M; ++i) {
+    const int j = 2 * M + i;
+    A_triplets.emplace_back(i, i, 1.0);   // b_i
+    A_triplets.emplace_back(i, j, -1.0);  // -delta_i
     upper_bound[i] = v_max[i] * v_max[i];
     lower_bound[i] = 0.0;
   }
 
   // a_min < a - sigma < a_max
-  for (unsigned int i = N; i < 2 * N; ++i) {
-    const int j = 2 * N + i;
-    A(i, i) = 1.0;   // a_i
-    A(i, j) = -1.0;  // -sigma_i
-    if (i != N && v_max[i - N] < std::numeric_limits<double>::epsilon()) {
+  for (unsigned int i = M; i < 2 * M; ++i) {
+    const int j = 2 * M + i;
+    A_triplets.emplace_back(i, i, 1.0);   // a_i
+    A_triplets.emplace_back(i, j, -1.0);  // -sigma_i
+    if (i != M && v_max[i - M] < std::numeric_limits<double>::epsilon()) {
       upper_bound[i] = 0.0;
       lower_bound[i] = 0.0;
     } else {
@@ -151,12 +162,14 @@ bool LinfPseudoJerkSmoother::apply(
   }
 
   // b' = 2a
-  for (unsigned int i = 2 * N; i < 3 * N - 1; ++i) {
-    const unsigned int j = i - 2 * N;
-    const double ds_inv = 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
-    A(i, j) = -ds_inv;
-    A(i, j + 1) = ds_inv;
-    A(i, j + N) = -2.0;
+  // b(i+1) = 0 for the padded points.
+  for (unsigned int i = 2 * M; i < 3 * M - 1; ++i) {
+    const unsigned int j = i - 2 * M;
+    const bool is_padded = j >= N - 1;
+    const double ds_inv = is_padded ? 1.0 : 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
+    A_triplets.emplace_back(i, j, is_padded ? 0.0 : -ds_inv);
+    A_triplets.emplace_back(i, j + 1, ds_inv);
+    A_triplets.emplace_back(i, j + M, is_padded ? 0.0 : -2.0);
     upper_bound[i] = 0.0;
     lower_bound[i] = 0.0;
   }
@@ -164,64 +177,101 @@ bool LinfPseudoJerkSmoother::apply(
   // initial condition
   const double v0 = initial_vel;
   {
-    const unsigned int i = 3 * N - 1;
-    A(i, 0) = 1.0;  // b0
+    const unsigned int i = 3 * M - 1;
+    A_triplets.emplace_back(i, 0, 1.0);  // b0
     upper_bound[i] = v0 * v0;
     lower_bound[i] = v0 * v0;
 
-    A(i + 1, N) = 1.0;  // a0
+    A_triplets.emplace_back(i + 1, M, 1.0);  // a0
     upper_bound[i + 1] = initial_acc;
     lower_bound[i + 1] = initial_acc;
   }
 
   // constraint for slack variable (a[i+1] - a[i] <= psi[i], a[i] - a[i+1] <= psi[i])
-  for (unsigned int i = 3 * N + 1; i < 4 * N; ++i) {
-    const unsigned int ia = i - (3 * N + 1) + N;
-    const unsigned int ip = 4 * N;
-    const unsigned int j = i - (3 * N + 1);
-    const double ds_inv = 1.0 / std::max(interval_dist_arr.at(j), 0.0001);
-
-    A(i, ia) = -ds_inv;
-    A(i, ia + 1) = ds_inv;
-    A(i, ip) = -1;
+  // The coefficients of a are zero for the padded points.
+  for (unsigned int i = 3 * M + 1; i < 4 * M; ++i) {
+    const unsigned int ia = i - (3 * M + 1) + M;
+    const unsigned int ip = 4 * M;
+    const unsigned int j = i - (3 * M + 1);
+    const double ds_inv = j < N - 1 ? 1.0 / std::max(interval_dist_arr.at(j), 0.0001) : 0.0;
+
+    A_triplets.emplace_back(i, ia, -ds_inv);
+    A_triplets.emplace_back(i, ia + 1, ds_inv);
+    A_triplets.emplace_back(i, ip, -1);
     lower_bound[i] = -OSQP_INFTY;
     upper_bound[i] = 0;
 
-    A(i + N - 1, ia) = ds_inv;
-    A(i + N - 1, ia + 1) = -ds_inv;
-    A(i + N - 1, ip) = -1;
-    lower_bound[i + N - 1] = -OSQP_INFTY;
-    upper_bound[i + N - 1] = 0;
+    A_triplets.emplace_back(i + M - 1, ia, ds_inv);
+    A_triplets.emplace_back(i + M - 1, ia + 1, -ds_inv);
+    A_triplets.emplace_back(i + M - 1, ip, -1);
+    lower_bound[i + M - 1] = -OSQP_INFTY;
+    upper_bound[i + M - 1] = 0;
   }
 
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
+  // arc length of the points of the optimization problem, where the padded points are at the end
+  std::vector<double> arclength = trajectory_utils::calcArclengthArray(input);
+  arclength.resize(M, arclength.back());
+
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
     std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
 
   // execute optimization
+  // The solver workspace is updated when the sparsity pattern is unchanged, and warm started from
+  // the previous solution shifted by the travelled distance.
   const auto ts2 = std::chrono::system_clock::now();
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  const auto P_csc = autoware::common::osqp::calCSCMatrixTrapezoidal(P);
+  const auto A_csc = autoware::common::osqp::calCSCMatrix(A);
+  if (prev_optval_.empty()) {
+    qp_solver_.initializeProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+  } else {
+    qp_solver_.updateProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+    const double travelled_dist = motion_utils::calcSignedArcLength(
+      input, prev_front_position_, static_cast<size_t>(0));
+    const auto initial_optval = trajectory_utils::shiftOptimizationVariables(
+      prev_optval_, prev_arclength_, arclength, travelled_dist, 4);
+    if (initial_optval.size() == l_variables) {
+      qp_solver_.setPrimalVariables(initial_optval);
+    } else {
+      qp_solver_.setPrimalVariables(std::vector<double>(l_variables, 0.0));
+    }
+    // The duals of the previous problem belong to the constraints of the previous points, which
+    // are not shifted with the primal variables, so they are reset.
+    qp_solver_.setDualVariables(std::vector<double>(l_constraints, 0.0));
+  }
+  const auto result = qp_solver_.optimize();
 
-  // [b0, b1, ..., bN, |  a0, a1, ..., aN, |
-  //  delta0, delta1, ..., deltaN, | sigma0, sigma1, ..., sigmaN]
+  // [b0, b1, ..., bM, |  a0, a1, ..., aM, |
+  //  delta0, delta1, ..., deltaM, | sigma0, sigma1, ..., sigmaM, | psi]
   const std::vector<double> optval = std::get<0>(result);
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     RCLCPP_WARN(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+    prev_optval_.clear();
     return false;
   }
   const auto has_nan =
     std::any_of(optval.begin(), optval.end(), [](const auto v) { return std::isnan(v); });
   if (has_nan) {
     RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
+    prev_optval_.clear();
     return false;
   }
 
+  prev_optval_ = optval;
+  prev_arclength_ = arclength;
+  prev_front_position_ = input.front().pose.position;
+
   /* get velocity & acceleration */
   for (unsigned int i = 0; i < N; ++i) {
     double v = optval.at(i);
     output.at(i).longitudinal_velocity_mps = std::sqrt(std::max(v, 0.0));
-    output.at(i).acceleration_mps2 = optval.at(i + N);
+    output.at(i).acceleration_mps2 = optval.at(i + M);
   }
   for (unsigned int i = N; i < output.size(); ++i) {
     output.at(i).longitudinal_velocity_mps = 0.0;
@@ -233,7 +283,7 @@ bool LinfPseudoJerkSmoother::apply(
   // for (unsigned int i = 0; i < N; ++i) {
   //   ROS_DEBUG(
   //     "i = %d, v: %f, v_max: %f a: %f, b: %f, delta: %f, sigma: %f", i, std::sqrt(optval.at(i)),
-  //     v_max[i], optval.at(i + N), optval.at(i), optval.at(i + 2 * N), optval.at(i + 3 * N));
+  //     v_max[i], optval.at(i + M), optval.at(i), optval.at(i + 2 * M), optval.at(i + 3 * M));
   // }
 
   qp_solver_.logUnsolvedStatus("[motion_velocity_smoother]");
@@ -609,5 +609,43 @@ double calcStopDistance(const TrajectoryPoints & trajectory, const size_t closes
   return stop_dist;
 }
 
+std::vector<double> shiftOptimizationVariables(
+  const std::vector<double> & prev_variables, const std::vector<double> & prev_arclength,
+  const std::vector<double> & arclength, const double travelled_dist, const size_t num_blocks)
+{
+  const size_t prev_num = prev_arclength.size();
+  const size_t num = arclength.size();
+  if (prev_num == 0 || prev_variables.size() < num_blocks * prev_num) {
+    return {};
+  }
+
+  const size_t num_others = prev_variables.size() - num_blocks * prev_num;
+  std::vector<double> variables(num_blocks * num + num_others);
+
+  size_t prev_idx = 0;
+  for (size_t i = 0; i < num; ++i) {
+    // the arc length of the current point from the previous front point
+    const double s = arclength.at(i) + travelled_dist;
+    while (prev_idx + 1 < prev_num - 1 && prev_arclength.at(prev_idx + 1) < s) {
+      ++prev_idx;
+    }
+
+    const size_t next_idx = std::min(prev_idx + 1, prev_num - 1);
+    const double ds = prev_arclength.at(next_idx) - prev_arclength.at(prev_idx);
+    const double ratio =
+      ds < 1.0e-6 ? 0.0 : std::clamp((s - prev_arclength.at(prev_idx)) / ds, 0.0, 1.0);
+    for (size_t block = 0; block < num_blocks; ++block) {
+      const double prev_value = prev_variables.at(block * prev_num + prev_idx);
+      const double next_value = prev_variables.at(block * prev_num + next_idx);
+      variables.at(block * num + i) = prev_value + ratio * (next_value - prev_value);
+    }
+  }
+
+  std::copy(
+    prev_variables.end() - num_others, prev_variables.end(), variables.end() - num_others);
+
+  return variables;
+}
+
 }  // namespace trajectory_utils
 }  // namespace motion_velocity_smoother
@@ -61,3 +61,26 @@ TEST(TestTrajectoryUtils, CalcTrajectoryCurvatureFrom3Points)
     }
   }
 }
+
+TEST(TestTrajectoryUtils, ShiftOptimizationVariables)
+{
+  using motion_velocity_smoother::trajectory_utils::shiftOptimizationVariables;
+
+  // 2 blocks of 3 points, followed by 1 other variable
+  const std::vector<double> prev_variables = {0.0, 1.0, 2.0, 10.0, 20.0, 30.0, 100.0};
+  const std::vector<double> prev_arclength = {0.0, 1.0, 2.0};
+
+  // shifted by 0.5 m, and the points beyond the previous range are clamped
+  const std::vector<double> arclength = {0.0, 1.0, 2.0, 3.0};
+  const auto variables =
+    shiftOptimizationVariables(prev_variables, prev_arclength, arclength, 0.5, 2);
+  const std::vector<double> expected = {0.5, 1.5, 2.0, 2.0, 15.0, 25.0, 30.0, 30.0, 100.0};
+  ASSERT_EQ(variables.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(variables.at(i), expected.at(i), 1.0e-6) << "i = " << i;
+  }
+
+  // inconsistent size
+  EXPECT_TRUE(shiftOptimizationVariables({0.0, 1.0}, prev_arclength, arclength, 0.0, 2).empty());
+  EXPECT_TRUE(shiftOptimizationVariables({}, {}, arclength, 0.0, 2).empty());
+}
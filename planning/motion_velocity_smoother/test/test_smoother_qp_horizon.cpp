@@ -0,0 +1,103 @@
+// Copyright 2024 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+#include "motion_velocity_smoother/smoother/l2_pseudo_jerk_smoother.hpp"
+#include "motion_velocity_smoother/smoother/linf_pseudo_jerk_smoother.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using motion_velocity_smoother::JerkFilteredSmoother;
+using motion_velocity_smoother::L2PseudoJerkSmoother;
+using motion_velocity_smoother::LinfPseudoJerkSmoother;
+using motion_velocity_smoother::trajectory_utils::TrajectoryPoints;
+
+namespace
+{
+// straight trajectory with 1 m intervals, which slows down in the middle and stops at the end
+TrajectoryPoints genTrajectory(const size_t front_idx)
+{
+  TrajectoryPoints trajectory;
+  for (size_t i = front_idx; i < 60; ++i) {
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position.x = static_cast<double>(i);
+    p.pose.orientation.w = 1.0;
+    p.longitudinal_velocity_mps = 30 <= i && i < 35 ? 3.0 : 10.0;
+    trajectory.push_back(p);
+  }
+  trajectory.back().longitudinal_velocity_mps = 0.0;
+  return trajectory;
+}
+
+std::shared_ptr<rclcpp::Node> generateNode(const std::string & name, const std::string & algorithm)
+{
+  const auto motion_velocity_smoother_dir =
+    ament_index_cpp::get_package_share_directory("motion_velocity_smoother");
+  auto node_options = rclcpp::NodeOptions{};
+  node_options.arguments(
+    {"--ros-args", "--params-file",
+     motion_velocity_smoother_dir + "/config/default_motion_velocity_smoother.param.yaml",
+     "--params-file", motion_velocity_smoother_dir + "/config/default_common.param.yaml",
+     "--params-file", motion_velocity_smoother_dir + "/config/" + algorithm + ".param.yaml"});
+  return std::make_shared<rclcpp::Node>(name, node_options);
+}
+
+// The smoothers declare their parameters, so each of them is created with its own node. The
+// padded one solves the problem padded up to qp_horizon_point_num in every cycle, and both are
+// warm started from the second cycle.
+template <class Smoother>
+void testPaddedProblem(const std::string & algorithm)
+{
+  const auto node = generateNode(algorithm + "_smoother", algorithm);
+  const auto padded_node = generateNode("padded_" + algorithm + "_smoother", algorithm);
+  Smoother smoother(*node);
+  Smoother padded_smoother(*padded_node);
+  ASSERT_EQ(smoother.getParam().qp_horizon_point_num, 0);
+  auto padded_param = padded_smoother.getParam();
+  padded_param.qp_horizon_point_num = 300;
+  padded_smoother.setParam(padded_param);
+
+  for (size_t front_idx = 0; front_idx < 3; ++front_idx) {
+    const auto input = genTrajectory(front_idx);
+    TrajectoryPoints output;
+    TrajectoryPoints padded_output;
+    std::vector<TrajectoryPoints> debug_trajectories;
+    ASSERT_TRUE(smoother.apply(5.0, 0.0, input, output, debug_trajectories));
+    ASSERT_TRUE(padded_smoother.apply(5.0, 0.0, input, padded_output, debug_trajectories));
+
+    ASSERT_EQ(output.size(), padded_output.size());
+    ASSERT_LT(output.size(), static_cast<size_t>(padded_param.qp_horizon_point_num));
+    for (size_t i = 0; i < output.size(); ++i) {
+      EXPECT_NEAR(
+        output.at(i).longitudinal_velocity_mps, padded_output.at(i).longitudinal_velocity_mps, 0.05)
+        << algorithm << ", front_idx = " << front_idx << ", i = " << i;
+    }
+  }
+}
+}  // namespace
+
+TEST(TestSmootherQpHorizon, PaddedProblemMatchesUnpadded)
+{
+  rclcpp::init(0, nullptr);
+  testPaddedProblem<L2PseudoJerkSmoother>("L2");
+  testPaddedProblem<LinfPseudoJerkSmoother>("Linf");
+  testPaddedProblem<JerkFilteredSmoother>("JerkFiltered");
+  rclcpp::shutdown();
+}
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__DISTORTION_CORRECTOR_HPP_
 #define POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__DISTORTION_CORRECTOR_HPP_
 
+#include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <rclcpp/rclcpp.hpp>
 
 #include <geometry_msgs/msg/twist_stamped.hpp>
@@ -42,12 +44,28 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
 using rcl_interfaces::msg::SetParametersResult;
 using sensor_msgs::msg::PointCloud2;
 
+// Rigid transform applied to the points stamped at a sample of the ego trajectory
+struct BucketTransform
+{
+  Eigen::Matrix3f rotation;
+  Eigen::Vector3f translation;
+};
+
+// Transform the points by the trajectory sampled every time_resolution from first_stamp.
+// The transform of each point is linearly interpolated between the two samples around its time
+// stamp. The x, y and z fields must be FLOAT32 and the time stamp field FLOAT64.
+void transformPointsByTrajectory(
+  const std::vector<BucketTransform> & trajectory, const double first_stamp,
+  const double time_resolution, const size_t time_stamp_offset, const size_t x_offset,
+  const size_t y_offset, const size_t z_offset, PointCloud2 & points);
+
 class DistortionCorrectorComponent : public rclcpp::Node
 {
 public:
@@ -63,6 +81,12 @@ private:
     tf2::Transform * tf2_transform_ptr);
 
   bool undistortPointCloud(const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points);
+  bool undistortPointCloud3d(const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points);
+
+  // Ego poses sampled at trajectory_time_resolution_ from first_stamp, relative to reference_stamp
+  void computeEgoTrajectory(
+    const double first_stamp, const double reference_stamp, const size_t size,
+    std::vector<BucketTransform> & trajectory);
 
   rclcpp::Subscription<PointCloud2>::SharedPtr input_points_sub_;
   rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_;
@@ -81,6 +105,11 @@ private:
   std::string base_link_frame_ = "base_link";
   std::string time_stamp_field_name_;
   bool use_imu_;
+  bool use_3d_distortion_correction_;
+  double trajectory_time_resolution_;
+
+  // Reused across scans to avoid allocations
+  std::vector<BucketTransform> ego_trajectory_;
 };
 
 }  // namespace pointcloud_preprocessor
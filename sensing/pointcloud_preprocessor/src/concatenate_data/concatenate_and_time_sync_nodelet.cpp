@@ -54,9 +54,14 @@
 #include <pcl_ros/transforms.hpp>
 
 #include <pcl_conversions/pcl_conversions.h>
+#include <tf2_eigen/tf2_eigen.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -67,6 +72,88 @@
 
 namespace pointcloud_preprocessor
 {
+namespace
+{
+struct XYZIFieldOffsets
+{
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+  std::optional<uint32_t> intensity;
+};
+
+/**
+ * @brief find the offsets of the float32 x, y, z and intensity fields
+ * @return std::nullopt if the x, y or z field is missing, the rows are shorter than width points or
+ * the data is shorter than its layout
+ */
+std::optional<XYZIFieldOffsets> findXYZIFieldOffsets(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  const auto find_offset = [&cloud](const std::string & name) -> std::optional<uint32_t> {
+    for (const auto & field : cloud.fields) {
+      if (
+        field.name == name && field.datatype == sensor_msgs::msg::PointField::FLOAT32 &&
+        field.offset + sizeof(float) <= cloud.point_step) {
+        return field.offset;
+      }
+    }
+    return std::nullopt;
+  };
+
+  const auto x = find_offset("x");
+  const auto y = find_offset("y");
+  const auto z = find_offset("z");
+  if (!x || !y || !z) {
+    return std::nullopt;
+  }
+  if (static_cast<size_t>(cloud.row_step) < static_cast<size_t>(cloud.width) * cloud.point_step) {
+    return std::nullopt;
+  }
+  if (
+    cloud.height > 0 && cloud.data.size() < static_cast<size_t>(cloud.row_step) * cloud.height) {
+    return std::nullopt;
+  }
+  return XYZIFieldOffsets{*x, *y, *z, find_offset("intensity")};
+}
+
+/**
+ * @brief transform the points with the matrix and write them to the output as PointXYZI
+ * @details non-finite points are written without being transformed, and the intensity is set to
+ * zero if the input does not have it
+ */
+void transformToXYZI(
+  const sensor_msgs::msg::PointCloud2 & input, const XYZIFieldOffsets & offsets,
+  const Eigen::Matrix4f & transform, PointXYZI * output)
+{
+  const Eigen::Matrix3f rotation = transform.topLeftCorner<3, 3>();
+  const Eigen::Vector3f translation = transform.topRightCorner<3, 1>();
+  const auto read_float = [](const uint8_t * ptr) {
+    float value;
+    std::memcpy(&value, ptr, sizeof(float));
+    return value;
+  };
+
+  size_t index = 0;
+  for (uint32_t row = 0; row < input.height; ++row) {
+    const uint8_t * point_ptr = input.data.data() + static_cast<size_t>(row) * input.row_step;
+    for (uint32_t col = 0; col < input.width; ++col, ++index, point_ptr += input.point_step) {
+      Eigen::Vector3f point(
+        read_float(point_ptr + offsets.x), read_float(point_ptr + offsets.y),
+        read_float(point_ptr + offsets.z));
+      if (std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z())) {
+        point = rotation * point + translation;
+      }
+      PointXYZI & output_point = output[index];
+      output_point.x = point.x();
+      output_point.y = point.y();
+      output_point.z = point.z();
+      output_point.intensity =
+        offsets.intensity ? read_float(point_ptr + *offsets.intensity) : 0.0f;
+    }
+  }
+}
+}  // namespace
+
 PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchronizerComponent(
   const rclcpp::NodeOptions & node_options)
 : Node("point_cloud_concatenator_component", node_options),
@@ -114,6 +201,9 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
     publish_synchronized_pointcloud_ = declare_parameter("publish_synchronized_pointcloud", false);
   }
 
+  // One thread per input, kept between the frames
+  worker_pool_ = std::make_unique<tier4_autoware_utils::WorkerPool>(input_topics_.size());
+
   // Initialize not_subscribed_topic_names_
   {
     for (const std::string & e : input_topics_) {
@@ -213,22 +303,27 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-void PointCloudConcatenateDataSynchronizerComponent::transformPointCloud(
-  const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out)
+bool PointCloudConcatenateDataSynchronizerComponent::lookupTransformToOutputFrame(
+  const std_msgs::msg::Header & header, Eigen::Matrix4f & transform)
 {
-  // Transform the point clouds into the specified output frame
-  if (output_frame_ != in->header.frame_id) {
-    // TODO(YamatoAndo): use TF2
-    if (!pcl_ros::transformPointCloud(output_frame_, *in, *out, *tf2_buffer_)) {
-      RCLCPP_ERROR(
-        this->get_logger(),
-        "[transformPointCloud] Error converting first input dataset from %s to %s.",
-        in->header.frame_id.c_str(), output_frame_.c_str());
-      return;
-    }
-  } else {
-    out = std::make_shared<PointCloud2>(*in);
-  }
+  if (output_frame_ == header.frame_id) {
+    transform = Eigen::Matrix4f::Identity();
+    return true;
+  }
+
+  try {
+    const auto transform_stamped = tf2_buffer_->lookupTransform(
+      output_frame_, header.frame_id, rclcpp::Time(header.stamp),
+      rclcpp::Duration::from_seconds(0.0));
+    transform = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  } catch (const tf2::TransformException & ex) {
+    RCLCPP_ERROR(
+      this->get_logger(),
+      "[lookupTransformToOutputFrame] Error converting first input dataset from %s to %s: %s",
+      header.frame_id.c_str(), output_frame_.c_str(), ex.what());
+    return false;
+  }
+  return true;
 }
 
 /**
@@ -332,16 +427,39 @@ PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   std::reverse(pc_stamps.begin(), pc_stamps.end());
   const auto oldest_stamp = pc_stamps.back();
 
-  // Step2. Calculate compensation transform and concatenate with the oldest stamp
+  // Step2. Compose the transform to the output frame and the compensation transform to the oldest
+  // stamp, and assign a slice of the output to each input
+  struct ConcatInput
+  {
+    std::string topic_name;
+    PointCloud2::ConstSharedPtr cloud;
+    XYZIFieldOffsets offsets;
+    Eigen::Matrix4f transform;
+    size_t begin;
+    size_t size;
+    bool is_transformed;
+  };
+  std::vector<ConcatInput> concat_inputs;
+  size_t concat_point_num = 0;
   for (const auto & e : cloud_stdmap_) {
-    if (e.second != nullptr) {
-      if (e.second->data.size() == 0) {
-        continue;
-      }
-      sensor_msgs::msg::PointCloud2::SharedPtr transformed_cloud_ptr(
-        new sensor_msgs::msg::PointCloud2());
-      transformPointCloud(e.second, transformed_cloud_ptr);
+    if (e.second == nullptr) {
+      not_subscribed_topic_names_.insert(e.first);
+      continue;
+    }
+    if (e.second->data.size() == 0) {
+      continue;
+    }
 
+    ConcatInput concat_input{e.first, e.second, {}, Eigen::Matrix4f::Identity(), 0, 0, false};
+    const auto offsets = findXYZIFieldOffsets(*e.second);
+    if (!offsets) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        get_logger(), *get_clock(), std::chrono::milliseconds(10000).count(),
+        "Input pointcloud of " << e.first
+                               << " does not have valid x, y and z fields or a consistent layout.");
+    }
+    Eigen::Matrix4f sensor_to_output_transform;
+    if (offsets && lookupTransformToOutputFrame(e.second->header, sensor_to_output_transform)) {
       // calculate transforms to oldest stamp
       Eigen::Matrix4f adjust_to_old_data_transform = Eigen::Matrix4f::Identity();
       rclcpp::Time transformed_stamp = rclcpp::Time(e.second->header.stamp);
@@ -351,29 +469,60 @@ PointCloudConcatenateDataSynchronizerComponent::combineClouds(
         adjust_to_old_data_transform = new_to_old_transform * adjust_to_old_data_transform;
         transformed_stamp = std::min(transformed_stamp, stamp);
       }
-      sensor_msgs::msg::PointCloud2::SharedPtr transformed_delay_compensated_cloud_ptr(
-        new sensor_msgs::msg::PointCloud2());
-      pcl_ros::transformPointCloud(
-        adjust_to_old_data_transform, *transformed_cloud_ptr,
-        *transformed_delay_compensated_cloud_ptr);
-
-      // concatenate
-      if (concat_cloud_ptr == nullptr) {
-        concat_cloud_ptr =
-          std::make_shared<sensor_msgs::msg::PointCloud2>(*transformed_delay_compensated_cloud_ptr);
-      } else {
-        pcl::concatenatePointCloud(
-          *concat_cloud_ptr, *transformed_delay_compensated_cloud_ptr, *concat_cloud_ptr);
-      }
-      // gather transformed clouds
-      transformed_delay_compensated_cloud_ptr->header.stamp = oldest_stamp;
-      transformed_delay_compensated_cloud_ptr->header.frame_id = output_frame_;
-      transformed_clouds[e.first] = transformed_delay_compensated_cloud_ptr;
-    } else {
-      not_subscribed_topic_names_.insert(e.first);
+      concat_input.offsets = *offsets;
+      concat_input.transform = adjust_to_old_data_transform * sensor_to_output_transform;
+      concat_input.size = static_cast<size_t>(e.second->width) * e.second->height;
+      concat_input.is_transformed = true;
     }
+    concat_input.begin = concat_point_num;
+    concat_point_num += concat_input.size;
+    concat_inputs.push_back(concat_input);
   }
+
+  // As before, nothing is published if no input could be transformed
+  const bool has_transformed_input = std::any_of(
+    concat_inputs.begin(), concat_inputs.end(),
+    [](const ConcatInput & concat_input) { return concat_input.is_transformed; });
+  if (!has_transformed_input) {
+    return transformed_clouds;
+  }
+
+  // Step3. Transform and convert each input into its slice of the output in parallel
+  concat_cloud_ptr = std::make_shared<PointCloud2>();
+  PointCloud2Modifier<PointXYZI> concat_modifier{*concat_cloud_ptr, output_frame_};
+  concat_modifier.resize(concat_point_num);
+  auto * concat_points = reinterpret_cast<PointXYZI *>(concat_cloud_ptr->data.data());
+  const auto write_concat_input = [&](const ConcatInput & concat_input) {
+    if (concat_input.size > 0) {
+      transformToXYZI(
+        *concat_input.cloud, concat_input.offsets, concat_input.transform,
+        concat_points + concat_input.begin);
+    }
+  };
+  std::atomic<size_t> next_input_idx{0};
+  worker_pool_->run([&](const size_t /*worker_index*/) {
+    for (size_t i = next_input_idx++; i < concat_inputs.size(); i = next_input_idx++) {
+      write_concat_input(concat_inputs.at(i));
+    }
+  });
   concat_cloud_ptr->header.stamp = oldest_stamp;
+
+  // gather transformed clouds
+  if (publish_synchronized_pointcloud_) {
+    for (const auto & concat_input : concat_inputs) {
+      if (!concat_input.is_transformed) {
+        continue;
+      }
+      auto transformed_cloud_ptr = std::make_shared<PointCloud2>();
+      PointCloud2Modifier<PointXYZI> transformed_modifier{*transformed_cloud_ptr, output_frame_};
+      transformed_modifier.resize(concat_input.size);
+      std::copy(
+        concat_points + concat_input.begin, concat_points + concat_input.begin + concat_input.size,
+        reinterpret_cast<PointXYZI *>(transformed_cloud_ptr->data.data()));
+      transformed_cloud_ptr->header.stamp = oldest_stamp;
+      transformed_clouds[concat_input.topic_name] = transformed_cloud_ptr;
+    }
+  }
   return transformed_clouds;
 }
 
@@ -383,8 +532,14 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
   sensor_msgs::msg::PointCloud2::SharedPtr concat_cloud_ptr = nullptr;
   not_subscribed_topic_names_.clear();
 
+  stop_watch_ptr_->tic("concat_time");
   const auto & transformed_raw_points =
     PointCloudConcatenateDataSynchronizerComponent::combineClouds(concat_cloud_ptr);
+  const double concat_time_ms = stop_watch_ptr_->toc("concat_time", true);
+  size_t concat_copied_bytes = concat_cloud_ptr ? concat_cloud_ptr->data.size() : 0;
+  for (const auto & e : transformed_raw_points) {
+    concat_copied_bytes += e.second ? e.second->data.size() : 0;
+  }
 
   for (const auto & e : cloud_stdmap_) {
     if (e.second != nullptr) {
@@ -402,7 +557,7 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
 
   // publish concatenated pointcloud
   if (concat_cloud_ptr) {
-    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(*concat_cloud_ptr);
+    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(std::move(*concat_cloud_ptr));
     pub_output_->publish(std::move(output));
   } else {
     RCLCPP_WARN(this->get_logger(), "concat_cloud_ptr is nullptr, skipping pointcloud publish.");
@@ -412,7 +567,7 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
   if (publish_synchronized_pointcloud_) {
     for (const auto & e : transformed_raw_points) {
       if (e.second) {
-        auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(*e.second);
+        auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(std::move(*e.second));
         transformed_raw_pc_publisher_map_[e.first]->publish(std::move(output));
       } else {
         RCLCPP_WARN(
@@ -436,46 +591,10 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
       "debug/cyclic_time_ms", cyclic_time_ms);
     debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
       "debug/processing_time_ms", processing_time_ms);
-  }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void PointCloudConcatenateDataSynchronizerComponent::convertToXYZICloud(
-  const sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
-  sensor_msgs::msg::PointCloud2::SharedPtr & output_ptr)
-{
-  output_ptr->header = input_ptr->header;
-
-  PointCloud2Modifier<PointXYZI> output_modifier{*output_ptr, input_ptr->header.frame_id};
-  output_modifier.reserve(input_ptr->width);
-
-  bool has_intensity = std::any_of(
-    input_ptr->fields.begin(), input_ptr->fields.end(),
-    [](auto & field) { return field.name == "intensity"; });
-
-  sensor_msgs::PointCloud2Iterator<float> it_x(*input_ptr, "x");
-  sensor_msgs::PointCloud2Iterator<float> it_y(*input_ptr, "y");
-  sensor_msgs::PointCloud2Iterator<float> it_z(*input_ptr, "z");
-
-  if (has_intensity) {
-    sensor_msgs::PointCloud2Iterator<float> it_i(*input_ptr, "intensity");
-    for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z, ++it_i) {
-      PointXYZI point;
-      point.x = *it_x;
-      point.y = *it_y;
-      point.z = *it_z;
-      point.intensity = *it_i;
-      output_modifier.push_back(std::move(point));
-    }
-  } else {
-    for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z) {
-      PointXYZI point;
-      point.x = *it_x;
-      point.y = *it_y;
-      point.z = *it_z;
-      point.intensity = 0.0f;
-      output_modifier.push_back(std::move(point));
-    }
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/concat_time_ms", concat_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/concat_copied_bytes", static_cast<double>(concat_copied_bytes));
   }
 }
 
@@ -499,14 +618,10 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr, const std::string & topic_name)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  sensor_msgs::msg::PointCloud2::SharedPtr xyzi_input_ptr(new sensor_msgs::msg::PointCloud2());
-  auto input = std::make_shared<sensor_msgs::msg::PointCloud2>(*input_ptr);
-  if (input->data.empty()) {
+  // the input is stored as is, and converted to XYZI when it is concatenated
+  if (input_ptr->data.empty()) {
     RCLCPP_WARN_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), 1000, "Empty sensor points!");
-  } else {
-    // convert to XYZI pointcloud if pointcloud is not empty
-    convertToXYZICloud(input, xyzi_input_ptr);
   }
 
   const bool is_already_subscribed_this = (cloud_stdmap_[topic_name] != nullptr);
@@ -515,7 +630,7 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
     [](const auto & e) { return e.second != nullptr; });
 
   if (is_already_subscribed_this) {
-    cloud_stdmap_tmp_[topic_name] = xyzi_input_ptr;
+    cloud_stdmap_tmp_[topic_name] = input_ptr;
 
     if (!is_already_subscribed_tmp) {
       auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -528,7 +643,7 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
       timer_->reset();
     }
   } else {
-    cloud_stdmap_[topic_name] = xyzi_input_ptr;
+    cloud_stdmap_[topic_name] = input_ptr;
 
     const bool is_subscribed_all = std::all_of(
       std::begin(cloud_stdmap_), std::end(cloud_stdmap_),
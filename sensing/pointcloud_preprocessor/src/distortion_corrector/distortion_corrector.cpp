@@ -16,12 +16,25 @@
 
 #include "tier4_autoware_utils/math/trigonometry.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <deque>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
+namespace
+{
+// A scan longer than this is not expected, and the trajectory would be too large to precompute
+constexpr double max_scan_duration_sec = 1.0;
+// The trajectory of a scan has at most max_scan_duration_sec / min_trajectory_time_resolution
+// samples
+constexpr double min_trajectory_time_resolution = 1e-5;
+}  // namespace
+
 /** @brief Constructor. */
 DistortionCorrectorComponent::DistortionCorrectorComponent(const rclcpp::NodeOptions & options)
 : Node("distortion_corrector_node", options)
@@ -39,6 +52,17 @@ DistortionCorrectorComponent::DistortionCorrectorComponent(const rclcpp::NodeOpt
   // Parameter
   time_stamp_field_name_ = declare_parameter("time_stamp_field_name", "time_stamp");
   use_imu_ = declare_parameter("use_imu", true);
+  use_3d_distortion_correction_ = declare_parameter("use_3d_distortion_correction", false);
+  trajectory_time_resolution_ = declare_parameter("trajectory_time_resolution", 0.001);
+  if (
+    trajectory_time_resolution_ < min_trajectory_time_resolution ||
+    trajectory_time_resolution_ > max_scan_duration_sec) {
+    RCLCPP_WARN_STREAM(
+      get_logger(), "trajectory_time_resolution must be in [" << min_trajectory_time_resolution
+                                                              << ", " << max_scan_duration_sec
+                                                              << "]. Use 0.001 instead.");
+    trajectory_time_resolution_ = 0.001;
+  }
 
   // Publisher
   undistorted_points_pub_ =
@@ -126,7 +150,11 @@ void DistortionCorrectorComponent::onPointCloud(PointCloud2::UniquePtr points_ms
   tf2::Transform tf2_base_link_to_sensor{};
   getTransform(points_msg->header.frame_id, base_link_frame_, &tf2_base_link_to_sensor);
 
-  undistortPointCloud(tf2_base_link_to_sensor, *points_msg);
+  if (use_3d_distortion_correction_) {
+    undistortPointCloud3d(tf2_base_link_to_sensor, *points_msg);
+  } else {
+    undistortPointCloud(tf2_base_link_to_sensor, *points_msg);
+  }
 
   if (debug_publisher_) {
     auto pipeline_latency_ms =
@@ -317,6 +345,283 @@ bool DistortionCorrectorComponent::undistortPointCloud(
   return true;
 }
 
+void DistortionCorrectorComponent::computeEgoTrajectory(
+  const double first_stamp, const double reference_stamp, const size_t size,
+  std::vector<BucketTransform> & trajectory)
+{
+  // For performance, do not instantiate `rclcpp::Time` inside of the for-loop
+  std::vector<double> twist_stamps;
+  twist_stamps.reserve(twist_queue_.size());
+  for (const auto & twist : twist_queue_) {
+    twist_stamps.push_back(rclcpp::Time(twist.header.stamp).seconds());
+  }
+  const bool use_imu = use_imu_ && !angular_velocity_queue_.empty();
+  std::vector<double> imu_stamps;
+  if (use_imu) {
+    imu_stamps.reserve(angular_velocity_queue_.size());
+    for (const auto & angular_velocity : angular_velocity_queue_) {
+      imu_stamps.push_back(rclcpp::Time(angular_velocity.header.stamp).seconds());
+    }
+  }
+
+  auto find_index = [](const std::vector<double> & stamps, const double t) {
+    const auto it = std::lower_bound(stamps.begin(), stamps.end(), t);
+    return it == stamps.end() ? stamps.size() - 1 : static_cast<size_t>(it - stamps.begin());
+  };
+  size_t twist_index = find_index(twist_stamps, first_stamp);
+  size_t imu_index = use_imu ? find_index(imu_stamps, first_stamp) : 0;
+
+  const auto dt = static_cast<float>(trajectory_time_resolution_);
+  Eigen::Matrix3f rotation = Eigen::Matrix3f::Identity();
+  Eigen::Vector3f translation = Eigen::Vector3f::Zero();
+  trajectory.resize(size);
+  for (size_t k = 0; k < size; ++k) {
+    trajectory[k].rotation = rotation;
+    trajectory[k].translation = translation;
+
+    const double t = first_stamp + static_cast<double>(k) * trajectory_time_resolution_;
+    while (twist_index < twist_stamps.size() - 1 && t > twist_stamps[twist_index]) {
+      ++twist_index;
+    }
+    const auto & twist = twist_queue_[twist_index].twist;
+    Eigen::Vector3f v(
+      static_cast<float>(twist.linear.x), static_cast<float>(twist.linear.y),
+      static_cast<float>(twist.linear.z));
+    Eigen::Vector3f w(
+      static_cast<float>(twist.angular.x), static_cast<float>(twist.angular.y),
+      static_cast<float>(twist.angular.z));
+    if (std::abs(t - twist_stamps[twist_index]) > 0.1) {
+      RCLCPP_WARN_STREAM_THROTTLE(
+        get_logger(), *get_clock(), 10000 /* ms */,
+        "twist time_stamp is too late. Could not interpolate.");
+      v.setZero();
+      w.setZero();
+    }
+
+    if (use_imu) {
+      while (imu_index < imu_stamps.size() - 1 && t > imu_stamps[imu_index]) {
+        ++imu_index;
+      }
+      if (std::abs(t - imu_stamps[imu_index]) > 0.1) {
+        RCLCPP_WARN_STREAM_THROTTLE(
+          get_logger(), *get_clock(), 10000 /* ms */,
+          "imu time_stamp is too late. Could not interpolate.");
+      } else {
+        const auto & angular_velocity = angular_velocity_queue_[imu_index].vector;
+        w = Eigen::Vector3f(
+          static_cast<float>(angular_velocity.x), static_cast<float>(angular_velocity.y),
+          static_cast<float>(angular_velocity.z));
+      }
+    }
+
+    // The twist and the angular velocity are expressed in base_link
+    translation += rotation * (v * dt);
+    const float angle = w.norm() * dt;
+    if (angle > 1e-9f) {
+      rotation = rotation * Eigen::AngleAxisf(angle, w.normalized()).toRotationMatrix();
+    }
+  }
+
+  // Express the trajectory relative to the ego pose at the reference time
+  const auto reference_index = std::min(
+    static_cast<size_t>(std::lround((reference_stamp - first_stamp) / trajectory_time_resolution_)),
+    size - 1);
+  const Eigen::Matrix3f reference_rotation_inv = trajectory[reference_index].rotation.transpose();
+  const Eigen::Vector3f reference_translation = trajectory[reference_index].translation;
+  for (auto & pose : trajectory) {
+    pose.translation = reference_rotation_inv * (pose.translation - reference_translation);
+    pose.rotation = reference_rotation_inv * pose.rotation;
+  }
+}
+
+void transformPointsByTrajectory(
+  const std::vector<BucketTransform> & trajectory, const double first_stamp,
+  const double time_resolution, const size_t time_stamp_offset, const size_t x_offset,
+  const size_t y_offset, const size_t z_offset, PointCloud2 & points)
+{
+  if (trajectory.empty() || points.point_step == 0) {
+    return;
+  }
+
+  const size_t point_step = points.point_step;
+  const size_t num_points = points.data.size() / point_step;
+  const size_t last_index = trajectory.size() - 1;
+  const double inv_resolution = 1.0 / time_resolution;
+  uint8_t * data = points.data.data();
+
+  // Sample position of each point, e.g. 2.5 for a point between the 2nd and the 3rd samples
+  auto get_sample_position = [&](const size_t i) {
+    double time_stamp;
+    std::memcpy(&time_stamp, data + i * point_step + time_stamp_offset, sizeof(double));
+    return std::clamp(
+      (time_stamp - first_stamp) * inv_resolution, 0.0, static_cast<double>(last_index));
+  };
+  auto get_bucket_index = [&](const double sample_position) {
+    return std::min(static_cast<size_t>(sample_position), last_index);
+  };
+
+  // Points are stored in scan order, so consecutive points mostly fall in the same time bucket
+  // and are transformed in runs sharing the two samples around the bucket.
+  size_t begin = 0;
+  while (begin < num_points) {
+    const size_t bucket_index = get_bucket_index(get_sample_position(begin));
+    size_t end = begin + 1;
+    while (end < num_points && get_bucket_index(get_sample_position(end)) == bucket_index) {
+      ++end;
+    }
+
+    // The rotation changes little within a bucket, so it is interpolated linearly as well
+    const BucketTransform & pose = trajectory[bucket_index];
+    const BucketTransform & next_pose = trajectory[std::min(bucket_index + 1, last_index)];
+    const Eigen::Matrix3f rotation_diff = next_pose.rotation - pose.rotation;
+    const Eigen::Vector3f translation_diff = next_pose.translation - pose.translation;
+    for (size_t i = begin; i < end; ++i) {
+      const auto ratio = static_cast<float>(get_sample_position(i) - bucket_index);
+      uint8_t * point_ptr = data + i * point_step;
+      Eigen::Vector3f point;
+      std::memcpy(&point.x(), point_ptr + x_offset, sizeof(float));
+      std::memcpy(&point.y(), point_ptr + y_offset, sizeof(float));
+      std::memcpy(&point.z(), point_ptr + z_offset, sizeof(float));
+      const Eigen::Vector3f undistorted_point = (pose.rotation + ratio * rotation_diff) * point +
+                                                pose.translation + ratio * translation_diff;
+      std::memcpy(point_ptr + x_offset, &undistorted_point.x(), sizeof(float));
+      std::memcpy(point_ptr + y_offset, &undistorted_point.y(), sizeof(float));
+      std::memcpy(point_ptr + z_offset, &undistorted_point.z(), sizeof(float));
+    }
+    begin = end;
+  }
+}
+
+bool DistortionCorrectorComponent::undistortPointCloud3d(
+  const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points)
+{
+  if (points.data.empty() || twist_queue_.empty()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "input_pointcloud->points or twist_queue_ is empty.");
+    return false;
+  }
+
+  auto find_field = [&points](const std::string & name) {
+    return std::find_if(
+      std::cbegin(points.fields), std::cend(points.fields),
+      [&name](const sensor_msgs::msg::PointField & field) { return field.name == name; });
+  };
+  const auto time_stamp_field_it = find_field(time_stamp_field_name_);
+  if (
+    time_stamp_field_it == points.fields.cend() ||
+    time_stamp_field_it->datatype != sensor_msgs::msg::PointField::FLOAT64) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "Required field time stamp doesn't exist in the point cloud.");
+    return false;
+  }
+  const auto x_field_it = find_field("x");
+  const auto y_field_it = find_field("y");
+  const auto z_field_it = find_field("z");
+  if (
+    x_field_it == points.fields.cend() || y_field_it == points.fields.cend() ||
+    z_field_it == points.fields.cend()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "Required field x, y or z doesn't exist in the point cloud.");
+    return false;
+  }
+  if (
+    x_field_it->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+    y_field_it->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+    z_field_it->datatype != sensor_msgs::msg::PointField::FLOAT32) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "Required field x, y or z of the point cloud is not FLOAT32.");
+    return false;
+  }
+  // The fields are read with memcpy, so each of them must be within a point
+  const size_t point_step = points.point_step;
+  const auto is_within_point = [point_step](const auto & field_it, const size_t size) {
+    return field_it->offset + size <= point_step;
+  };
+  if (
+    points.data.size() < point_step || !is_within_point(time_stamp_field_it, sizeof(double)) ||
+    !is_within_point(x_field_it, sizeof(float)) || !is_within_point(y_field_it, sizeof(float)) ||
+    !is_within_point(z_field_it, sizeof(float))) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "The fields of the point cloud exceed its point_step.");
+    return false;
+  }
+
+  const size_t num_points = points.data.size() / point_step;
+  const size_t time_stamp_offset = time_stamp_field_it->offset;
+  const uint8_t * data = points.data.data();
+
+  auto read_time_stamp = [&](const size_t i) {
+    double time_stamp;
+    std::memcpy(&time_stamp, data + i * point_step + time_stamp_offset, sizeof(double));
+    return time_stamp;
+  };
+
+  const double first_point_time_stamp_sec = read_time_stamp(0);
+  double min_time_stamp_sec = first_point_time_stamp_sec;
+  double max_time_stamp_sec = first_point_time_stamp_sec;
+  for (size_t i = 1; i < num_points; ++i) {
+    const double time_stamp = read_time_stamp(i);
+    min_time_stamp_sec = std::min(min_time_stamp_sec, time_stamp);
+    max_time_stamp_sec = std::max(max_time_stamp_sec, time_stamp);
+  }
+
+  if (max_time_stamp_sec - min_time_stamp_sec > max_scan_duration_sec) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "The point time stamps span more than " << max_scan_duration_sec
+                                              << " [s]. Use the 2D distortion correction instead.");
+    return undistortPointCloud(tf2_base_link_to_sensor, points);
+  }
+
+  // Align the samples to the first point, which is left unchanged as in the 2D correction
+  const double trajectory_start_sec =
+    first_point_time_stamp_sec -
+    std::ceil((first_point_time_stamp_sec - min_time_stamp_sec) / trajectory_time_resolution_) *
+      trajectory_time_resolution_;
+  const size_t trajectory_size =
+    std::max(
+      static_cast<size_t>(
+        std::ceil((max_time_stamp_sec - trajectory_start_sec) / trajectory_time_resolution_)),
+      size_t{1}) +
+    1;
+  computeEgoTrajectory(
+    trajectory_start_sec, first_point_time_stamp_sec, trajectory_size, ego_trajectory_);
+
+  // Compose the sensor transform into each sample, so that each point needs a single transform
+  if (points.header.frame_id != base_link_frame_) {
+    const tf2::Matrix3x3 & basis = tf2_base_link_to_sensor.getBasis();
+    const tf2::Vector3 & origin = tf2_base_link_to_sensor.getOrigin();
+    Eigen::Matrix3f base_link_to_sensor_rotation;
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 3; ++col) {
+        base_link_to_sensor_rotation(row, col) = static_cast<float>(basis[row][col]);
+      }
+    }
+    const Eigen::Vector3f base_link_to_sensor_translation(
+      static_cast<float>(origin.x()), static_cast<float>(origin.y()),
+      static_cast<float>(origin.z()));
+    const Eigen::Matrix3f sensor_to_base_link_rotation = base_link_to_sensor_rotation.transpose();
+    const Eigen::Vector3f sensor_to_base_link_translation =
+      -sensor_to_base_link_rotation * base_link_to_sensor_translation;
+    for (auto & pose : ego_trajectory_) {
+      pose.translation = base_link_to_sensor_rotation *
+                           (pose.rotation * sensor_to_base_link_translation + pose.translation) +
+                         base_link_to_sensor_translation;
+      pose.rotation = base_link_to_sensor_rotation * pose.rotation * sensor_to_base_link_rotation;
+    }
+  }
+
+  transformPointsByTrajectory(
+    ego_trajectory_, trajectory_start_sec, trajectory_time_resolution_, time_stamp_offset,
+    x_field_it->offset, y_field_it->offset, z_field_it->offset, points);
+  return true;
+}
+
 }  // namespace pointcloud_preprocessor
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -0,0 +1,145 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/distortion_corrector/distortion_corrector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+namespace
+{
+constexpr double velocity = 10.0;
+constexpr double vertical_velocity = 0.5;
+constexpr double yaw_rate = 0.5;
+
+// Exact ego pose at time t of a constant twist, used as the per point correction
+BucketTransform calcEgoPose(const double t)
+{
+  BucketTransform pose;
+  pose.rotation = Eigen::AngleAxisf(static_cast<float>(yaw_rate * t), Eigen::Vector3f::UnitZ())
+                    .toRotationMatrix();
+  pose.translation = Eigen::Vector3f(
+    static_cast<float>(velocity / yaw_rate * std::sin(yaw_rate * t)),
+    static_cast<float>(velocity / yaw_rate * (1.0 - std::cos(yaw_rate * t))),
+    static_cast<float>(vertical_velocity * t));
+  return pose;
+}
+
+struct Point
+{
+  float x;
+  float y;
+  float z;
+  double time_stamp;
+};
+
+PointCloud2 createPointCloud(const std::vector<Point> & points)
+{
+  PointCloud2 cloud;
+  const auto add_field = [&cloud](
+                           const std::string & name, const size_t offset, const uint8_t type) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = static_cast<uint32_t>(offset);
+    field.datatype = type;
+    field.count = 1;
+    cloud.fields.push_back(field);
+  };
+  add_field("x", offsetof(Point, x), sensor_msgs::msg::PointField::FLOAT32);
+  add_field("y", offsetof(Point, y), sensor_msgs::msg::PointField::FLOAT32);
+  add_field("z", offsetof(Point, z), sensor_msgs::msg::PointField::FLOAT32);
+  add_field("time_stamp", offsetof(Point, time_stamp), sensor_msgs::msg::PointField::FLOAT64);
+  cloud.height = 1;
+  cloud.width = static_cast<uint32_t>(points.size());
+  cloud.point_step = sizeof(Point);
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.data.resize(cloud.row_step);
+  std::memcpy(cloud.data.data(), points.data(), cloud.data.size());
+  return cloud;
+}
+
+Point readPoint(const PointCloud2 & cloud, const size_t i)
+{
+  Point point;
+  std::memcpy(&point, cloud.data.data() + i * cloud.point_step, sizeof(Point));
+  return point;
+}
+}  // namespace
+
+TEST(DistortionCorrector3d, MatchesPerPointCorrection)
+{
+  // a 0.1 [s] scan of points around the ego vehicle
+  constexpr size_t num_points = 1000;
+  constexpr double scan_duration = 0.1;
+  std::vector<Point> points;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double t = scan_duration * static_cast<double>(i) / num_points;
+    const double azimuth = 2.0 * M_PI * static_cast<double>(i) / num_points;
+    points.push_back(
+      {static_cast<float>(20.0 * std::cos(azimuth)), static_cast<float>(20.0 * std::sin(azimuth)),
+       1.0f, t});
+  }
+  auto cloud = createPointCloud(points);
+
+  // the trajectory is sampled much more coarsely than the points
+  constexpr double time_resolution = 0.01;
+  std::vector<BucketTransform> trajectory;
+  for (double t = 0.0; t < scan_duration + time_resolution; t += time_resolution) {
+    trajectory.push_back(calcEgoPose(t));
+  }
+
+  transformPointsByTrajectory(
+    trajectory, 0.0, time_resolution, offsetof(Point, time_stamp), offsetof(Point, x),
+    offsetof(Point, y), offsetof(Point, z), cloud);
+
+  // the nearest sample alone would be up to velocity * time_resolution / 2 = 0.05 [m] off
+  constexpr double tolerance = 1e-3;
+  for (size_t i = 0; i < num_points; ++i) {
+    const auto & point = points.at(i);
+    const auto pose = calcEgoPose(point.time_stamp);
+    const Eigen::Vector3f expected =
+      pose.rotation * Eigen::Vector3f(point.x, point.y, point.z) + pose.translation;
+    const auto result = readPoint(cloud, i);
+    EXPECT_NEAR(result.x, expected.x(), tolerance) << "point " << i;
+    EXPECT_NEAR(result.y, expected.y(), tolerance) << "point " << i;
+    EXPECT_NEAR(result.z, expected.z(), tolerance) << "point " << i;
+    EXPECT_EQ(result.time_stamp, point.time_stamp);
+  }
+}
+
+TEST(DistortionCorrector3d, ClampsPointsOutsideOfTrajectory)
+{
+  const std::vector<Point> points{{1.0f, 0.0f, 0.0f, -1.0}, {1.0f, 0.0f, 0.0f, 1.0}};
+  auto cloud = createPointCloud(points);
+
+  const std::vector<BucketTransform> trajectory{calcEgoPose(0.0), calcEgoPose(0.01)};
+  transformPointsByTrajectory(
+    trajectory, 0.0, 0.01, offsetof(Point, time_stamp), offsetof(Point, x), offsetof(Point, y),
+    offsetof(Point, z), cloud);
+
+  const Eigen::Vector3f last_point =
+    trajectory.back().rotation * Eigen::Vector3f::UnitX() + trajectory.back().translation;
+  EXPECT_FLOAT_EQ(readPoint(cloud, 0).x, 1.0f);
+  EXPECT_FLOAT_EQ(readPoint(cloud, 0).y, 0.0f);
+  EXPECT_FLOAT_EQ(readPoint(cloud, 1).x, last_point.x());
+  EXPECT_FLOAT_EQ(readPoint(cloud, 1).y, last_point.y());
+}
+}  // namespace pointcloud_preprocessor